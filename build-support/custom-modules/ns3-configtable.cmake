@@ -145,6 +145,9 @@ macro(write_configtable)
   string(APPEND out "DPDK NetDevice                : ")
   check_on_or_off("NS3_DPDK" "ENABLE_DPDKDEVNET")
 
+  string(APPEND out "Event allocation pool         : ")
+  check_on_or_off("NS3_EVENT_POOL" "NS3_EVENT_POOL")
+
   string(APPEND out "Emulation FdNetDevice         : ")
   check_on_or_off("ENABLE_EMU" "ENABLE_EMUNETDEV")
 
@@ -166,6 +169,9 @@ macro(write_configtable)
   string(APPEND out "MPI Support                   : ")
   check_on_or_off("NS3_MPI" "MPI_FOUND")
 
+  string(APPEND out "Multithreaded Simulation      : ")
+  check_on_or_off("NS3_MTP" "NS3_MTP")
+
   string(APPEND out "ns-3 Click Integration        : ")
   check_on_or_off("ON" "NS3_CLICK")
 
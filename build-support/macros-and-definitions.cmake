@@ -379,6 +379,16 @@ macro(process_options)
     add_definitions(-DENABLE_DES_METRICS)
   endif()
 
+  if(${NS3_EVENT_POOL})
+    add_definitions(-DNS3_EVENT_POOL)
+  endif()
+
+  # Multithreaded parallel simulation requires thread-safe reference counting
+  # and packet buffers throughout the code base, not only in the mtp module
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+  endif()
+
   if(${NS3_SANITIZE} AND ${NS3_SANITIZE_MEMORY})
     message(
       FATAL_ERROR
@@ -1185,6 +1195,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${NS3_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
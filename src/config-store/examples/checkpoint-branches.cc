@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config-store-module.h"
+#include "ns3/core-module.h"
+
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * @ingroup configstore-examples
+ *
+ * @brief Example model with a slow warm-up, which counts packets
+ * arriving at a configurable interval.
+ */
+class WarmUpExample : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::WarmUpExample")
+                                .SetParent<Object>()
+                                .AddConstructor<WarmUpExample>()
+                                .AddAttribute("Interval",
+                                              "The interval between the arrivals",
+                                              TimeValue(Seconds(1)),
+                                              MakeTimeAccessor(&WarmUpExample::m_interval),
+                                              MakeTimeChecker());
+        return tid;
+    }
+
+    /** Start the arrivals. */
+    void Start()
+    {
+        m_event = Simulator::Schedule(m_interval, &WarmUpExample::Arrive, this);
+    }
+
+    uint32_t m_arrivals{0}; ///< Number of arrivals
+
+  private:
+    /** Count an arrival and schedule the next one. */
+    void Arrive()
+    {
+        m_arrivals++;
+        m_event = Simulator::Schedule(m_interval, &WarmUpExample::Arrive, this);
+    }
+
+    Time m_interval; ///< Interval between the arrivals
+    EventId m_event; ///< Next arrival
+};
+
+NS_OBJECT_ENSURE_REGISTERED(WarmUpExample);
+
+// Warm the model up for 30 s, write a snapshot of the checkpoint, then
+// run three variants of the interval from the checkpoint until 60 s.
+int
+main(int argc, char* argv[])
+{
+    std::string snapshot = "checkpoint-branches.txt";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("snapshot", "The snapshot file name", snapshot);
+    cmd.Parse(argc, argv);
+
+    Ptr<WarmUpExample> model = CreateObject<WarmUpExample>();
+    // Root the model in the configuration namespace, like the NodeList
+    Config::RegisterRootNamespaceObject(model);
+    model->Start();
+    Simulator::Stop(Seconds(60));
+
+    Checkpoint::SaveAt(Seconds(30), snapshot);
+    std::vector<std::string> intervals = {"1s", "500ms", "250ms"};
+    std::vector<std::string> results = Simulator::RunBranches(
+        Seconds(30),
+        intervals.size(),
+        [&intervals](uint32_t i) {
+            Config::Set("/$ns3::WarmUpExample/Interval", StringValue(intervals[i]));
+        },
+        [model]() {
+            std::ostringstream oss;
+            oss << model->m_arrivals;
+            return oss.str();
+        });
+
+    std::cout << "Arrivals at the checkpoint: " << model->m_arrivals << std::endl;
+    for (std::size_t i = 0; i < intervals.size(); ++i)
+    {
+        std::cout << "Interval " << intervals[i] << ": " << results[i] << " arrivals" << std::endl;
+    }
+
+    Checkpoint checkpoint(snapshot);
+    std::cout << "Snapshot at " << checkpoint.GetTime().As(Time::S) << " with "
+              << checkpoint.GetEvents().size() << " pending events" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "checkpoint.h"
+
+#include "raw-text-config.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Checkpoint");
+
+namespace
+{
+
+/** The prefix of the checkpoint comments in a snapshot. */
+const std::string CHECKPOINT_PREFIX = "# checkpoint ";
+
+} // unnamed namespace
+
+void
+Checkpoint::Save(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    {
+        RawTextConfigSave config;
+        config.SetFilename(filename);
+        config.Default();
+        config.Global();
+        config.Attributes();
+    }
+
+    std::vector<EventId> events = Simulator::GetPendingEvents();
+    std::ofstream os(filename, std::ios::app);
+    NS_ABORT_MSG_UNLESS(os.is_open(), "Cannot write the checkpoint " << filename);
+    os << CHECKPOINT_PREFIX << "time " << Simulator::Now().GetTimeStep() << std::endl;
+    for (const auto& event : events)
+    {
+        os << CHECKPOINT_PREFIX << "event " << event.GetTs() << " " << event.GetContext() << " "
+           << event.GetUid() << std::endl;
+    }
+    NS_LOG_INFO("Checkpoint at " << Simulator::Now() << " with " << events.size()
+                                 << " pending events written to " << filename);
+}
+
+EventId
+Checkpoint::SaveAt(const Time& at, const std::string& filename)
+{
+    NS_LOG_FUNCTION(at << filename);
+    NS_ASSERT_MSG(at >= Simulator::Now(), "The checkpoint " << at << " is in the past");
+    return Simulator::Schedule(at - Simulator::Now(), &Checkpoint::Save, filename);
+}
+
+Checkpoint::Checkpoint(const std::string& filename)
+    : m_filename(filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    std::ifstream is(filename);
+    NS_ABORT_MSG_UNLESS(is.is_open(), "Cannot read the checkpoint " << filename);
+    bool found = false;
+    for (std::string line; std::getline(is, line);)
+    {
+        if (line.compare(0, CHECKPOINT_PREFIX.size(), CHECKPOINT_PREFIX) != 0)
+        {
+            continue;
+        }
+        std::istringstream iss(line.substr(CHECKPOINT_PREFIX.size()));
+        std::string type;
+        iss >> type;
+        if (type == "time")
+        {
+            int64_t ts;
+            iss >> ts;
+            m_time = TimeStep(ts);
+            found = !iss.fail();
+        }
+        else if (type == "event")
+        {
+            uint64_t ts;
+            Event event;
+            iss >> ts >> event.context >> event.uid;
+            NS_ABORT_MSG_IF(iss.fail(), "Ill-formed checkpoint event: " << line);
+            event.time = TimeStep(ts);
+            m_events.push_back(event);
+        }
+    }
+    NS_ABORT_MSG_UNLESS(found, "No checkpoint time in " << filename);
+}
+
+Time
+Checkpoint::GetTime() const
+{
+    return m_time;
+}
+
+const std::vector<Checkpoint::Event>&
+Checkpoint::GetEvents() const
+{
+    return m_events;
+}
+
+void
+Checkpoint::ConfigureDefaults() const
+{
+    NS_LOG_FUNCTION(this);
+    RawTextConfigLoad config;
+    config.SetFilename(m_filename);
+    config.Default();
+    config.Global();
+}
+
+void
+Checkpoint::ConfigureAttributes() const
+{
+    NS_LOG_FUNCTION(this);
+    RawTextConfigLoad config;
+    config.SetFilename(m_filename);
+    config.Attributes();
+}
+
+} // namespace ns3
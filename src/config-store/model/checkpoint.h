@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup configstore
+ *
+ * @brief Save and restore snapshots of the state of a simulation.
+ *
+ * A snapshot is a raw text ConfigStore file, which can also be loaded
+ * by a ConfigStore, with the default values, the global values and the
+ * attributes of every object reachable from the configuration roots,
+ * such as the NodeList, followed by comments describing the simulation
+ * time and the pending events of the checkpoint.
+ *
+ * The events are described by their time, context and uid only: the
+ * functions they invoke cannot be written to a file.  A snapshot thus
+ * restores the attribute state of a scenario rebuilt by the same
+ * program, not the state of the protocols.  To resume several variants
+ * from the complete state of a warmed-up simulation, including the
+ * pending events, use Simulator::RunBranches(), which keeps the state
+ * of the checkpoint in memory and forks a process per variant.
+ *
+ * Example usage:
+ *
+ * @code
+ *     BuildScenario();
+ *     Checkpoint::SaveAt(Seconds(30), "warm.txt");
+ *     Simulator::Run();
+ *
+ *     // Later, in another run of the same program
+ *     BuildScenario();
+ *     Checkpoint checkpoint("warm.txt");
+ *     checkpoint.ConfigureAttributes();
+ * @endcode
+ */
+class Checkpoint
+{
+  public:
+    /** A pending event of a snapshot. */
+    struct Event
+    {
+        Time time;        //!< Time of the event
+        uint32_t context; //!< Context of the event
+        uint32_t uid;     //!< Uid of the event
+    };
+
+    /**
+     * Write a snapshot of the current state of the simulation.
+     * @param [in] filename The snapshot file name.
+     */
+    static void Save(const std::string& filename);
+
+    /**
+     * Schedule a snapshot of the simulation.
+     * @param [in] at The simulation time of the snapshot.
+     * @param [in] filename The snapshot file name.
+     * @returns The event which writes the snapshot.
+     */
+    static EventId SaveAt(const Time& at, const std::string& filename);
+
+    /**
+     * Read a snapshot.
+     * @param [in] filename The snapshot file name.
+     */
+    Checkpoint(const std::string& filename);
+
+    /**
+     * Get the simulation time of the snapshot.
+     * @returns The time of the snapshot.
+     */
+    Time GetTime() const;
+
+    /**
+     * Get the pending events of the snapshot.
+     * @returns The events, in the order they were to be executed.
+     */
+    const std::vector<Event>& GetEvents() const;
+
+    /** Restore the default and global values of the snapshot. */
+    void ConfigureDefaults() const;
+
+    /** Restore the attributes of the snapshot, on the objects which exist. */
+    void ConfigureAttributes() const;
+
+  private:
+    std::string m_filename;      //!< The snapshot file name
+    Time m_time;                 //!< The time of the snapshot
+    std::vector<Event> m_events; //!< The pending events of the snapshot
+};
+
+} // namespace ns3
+
+#endif /* CHECKPOINT_H */
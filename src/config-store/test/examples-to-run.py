@@ -7,5 +7,6 @@
 #
 # See test.py for more information.
 cpp_examples = [
+    ("checkpoint-branches", "True", "False"),
     ("config-store-save", "True", "False"),
 ]
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/global-value.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-examples
+ * @ingroup simulator
+ * Benchmark of Simulator::ScheduleWithContext called from foreign threads.
+ *
+ * Several producer threads schedule events into the running simulation,
+ * as FdNetDevice reader threads or traffic injection threads do. The
+ * main thread runs the simulation and polls until every event has been
+ * received. The program prints the schedule throughput of the producers
+ * and the end-to-end throughput of the simulation thread.
+ *
+ * @code
+ * ./ns3 run "cross-thread-schedule-benchmark --producers=4 --events=1000000"
+ * @endcode
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/** Number of cross-thread events executed by the simulation thread. */
+uint64_t g_received = 0;
+/** Number of cross-thread events to execute. */
+uint64_t g_total = 0;
+/** Number of producers which have not finished yet. */
+std::atomic<uint32_t> g_running{0};
+
+/** Event scheduled by the producers. */
+void
+Receive()
+{
+    g_received++;
+}
+
+/**
+ * Poll until every event has been received, so that the simulation
+ * does not run out of events while the producers are running.
+ */
+void
+Poll()
+{
+    if (g_received == g_total && g_running == 0)
+    {
+        Simulator::Stop();
+        return;
+    }
+    Simulator::Schedule(MicroSeconds(1), &Poll);
+}
+
+/**
+ * Producer thread body.
+ *
+ * @param [in] id The producer id, used as the event context.
+ * @param [in] events The number of events to schedule.
+ * @param [out] elapsed The wall clock time of the producer, in ms.
+ */
+void
+Produce(uint32_t id, uint64_t events, int64_t* elapsed)
+{
+    SystemWallClockMs clock;
+    clock.Start();
+    for (uint64_t i = 0; i < events; ++i)
+    {
+        Simulator::ScheduleWithContext(id, TimeStep(0), &Receive);
+    }
+    *elapsed = clock.End();
+    g_running--;
+}
+
+} // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t producers = 4;
+    uint64_t events = 200000;
+    std::string simulatorType = "ns3::DefaultSimulatorImpl";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("producers", "Number of producer threads", producers);
+    cmd.AddValue("events", "Number of events scheduled by each producer", events);
+    cmd.AddValue("simulator", "The simulator implementation", simulatorType);
+    cmd.Parse(argc, argv);
+
+    GlobalValue::Bind("SimulatorImplementationType", StringValue(simulatorType));
+
+    g_total = producers * events;
+    g_running = producers;
+    Simulator::Schedule(MicroSeconds(1), &Poll);
+
+    SystemWallClockMs clock;
+    clock.Start();
+    std::vector<int64_t> elapsed(producers, 0);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < producers; ++i)
+    {
+        threads.emplace_back(&Produce, i, events, &elapsed[i]);
+    }
+    Simulator::Run();
+    int64_t total = clock.End();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    int64_t slowest = 1;
+    for (auto ms : elapsed)
+    {
+        slowest = std::max(slowest, ms);
+    }
+    total = std::max<int64_t>(total, 1);
+    std::cout << producers << " producers scheduled " << g_total << " events in " << slowest
+              << " ms (" << g_total * 1000 / slowest << " events/s)" << std::endl;
+    std::cout << "Simulation thread received " << g_received << " events in " << total << " ms ("
+              << g_received * 1000 / total << " events/s)" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
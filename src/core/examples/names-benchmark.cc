@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/names.h"
+#include "ns3/object.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-examples
+ * @ingroup config
+ * Benchmark of the Names registry.
+ *
+ * The program registers a number of names, arranged as nodes which each
+ * have nine named devices, as a scenario which names every node and
+ * device does. It then times Names::Add(), the lookup of the objects by
+ * their full path and by their context and name, and the reverse
+ * lookups Names::FindName() and Names::FindPath().
+ *
+ * @code
+ * ./ns3 run "names-benchmark --names=1000000"
+ * @endcode
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/** The clock used to time the operations. */
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Print the average cost of an operation.
+ *
+ * @param [in] what The operation.
+ * @param [in] start The start time of the operations.
+ * @param [in] count The number of operations.
+ */
+void
+Report(const std::string& what, Clock::time_point start, std::size_t count)
+{
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    std::cout << what << ": " << elapsed.count() / count << " ns/op" << std::endl;
+}
+
+} // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t names = 1000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("names", "Number of names to register", names);
+    cmd.Parse(argc, argv);
+
+    const uint32_t devices = 9;
+    uint32_t nodes = names / (devices + 1);
+    std::vector<Ptr<Object>> objects;
+    objects.reserve(nodes * (devices + 1));
+    for (uint32_t i = 0; i < nodes * (devices + 1); i++)
+    {
+        objects.push_back(CreateObject<Object>());
+    }
+    std::cout << "registering " << objects.size() << " names" << std::endl;
+
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < nodes; i++)
+    {
+        Ptr<Object> node = objects[i * (devices + 1)];
+        Names::Add("node" + std::to_string(i), node);
+        for (uint32_t j = 1; j <= devices; j++)
+        {
+            Names::Add(node, "dev" + std::to_string(j), objects[i * (devices + 1) + j]);
+        }
+    }
+    Report("Add", start, objects.size());
+
+    std::vector<std::string> paths;
+    paths.reserve(objects.size());
+    for (const auto& object : objects)
+    {
+        paths.push_back(Names::FindPath(object));
+    }
+
+    std::size_t found = 0;
+    start = Clock::now();
+    for (const auto& path : paths)
+    {
+        found += Names::Find<Object>(path) != nullptr;
+    }
+    Report("Find(path)", start, paths.size());
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < nodes; i++)
+    {
+        Ptr<Object> node = objects[i * (devices + 1)];
+        for (uint32_t j = 1; j <= devices; j++)
+        {
+            found += Names::Find<Object>(node, "dev" + std::to_string(j)) != nullptr;
+        }
+    }
+    Report("Find(context, name)", start, nodes * devices);
+
+    std::size_t length = 0;
+    start = Clock::now();
+    for (const auto& object : objects)
+    {
+        length += Names::FindName(object).size();
+    }
+    Report("FindName", start, objects.size());
+
+    start = Clock::now();
+    for (const auto& object : objects)
+    {
+        length += Names::FindPath(object).size();
+    }
+    Report("FindPath", start, objects.size());
+
+    std::cout << "(" << found << " objects found, " << length << " characters)" << std::endl;
+
+    Names::Clear();
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-examples
+ * @ingroup randomvariable
+ * Throughput benchmark of the random number generation algorithms.
+ *
+ * For each RngStream backend, the program times the generation of
+ * uniform random numbers one at a time and in batches, the same through
+ * an ExponentialRandomVariable, and RngStream::Advance() by a large
+ * number of values.
+ *
+ * @code
+ * ./ns3 run "rng-benchmark --values=100000000"
+ * @endcode
+ */
+
+using namespace ns3;
+
+namespace
+{
+
+/** The clock used to time the operations. */
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Print the throughput of an operation.
+ *
+ * @param [in] what The operation.
+ * @param [in] start The start time of the operations.
+ * @param [in] count The number of values generated.
+ */
+void
+Report(const std::string& what, Clock::time_point start, uint64_t count)
+{
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    std::cout << "  " << what << ": " << count / elapsed.count() / 1e6 << " Mvalues/s, "
+              << elapsed.count() * 1e9 / count << " ns/value" << std::endl;
+}
+
+/**
+ * Time the generation of random numbers with a backend.
+ *
+ * @param [in] name The name of the backend.
+ * @param [in] backend The backend.
+ * @param [in] values The number of values to generate.
+ * @param [in] batch The number of values generated at once.
+ * @returns The sum of the values, so that they are not optimized away.
+ */
+double
+Run(const std::string& name, RngStream::Backend backend, uint64_t values, uint32_t batch)
+{
+    std::cout << name << ":" << std::endl;
+    double sum = 0;
+
+    RngStream rng(RngSeedManager::GetSeed(), 0, RngSeedManager::GetRun(), backend);
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < values; i++)
+    {
+        sum += rng.RandU01();
+    }
+    Report("RandU01()", start, values);
+
+    std::vector<double> buffer(batch);
+    start = Clock::now();
+    for (uint64_t i = 0; i < values; i += batch)
+    {
+        rng.RandU01(buffer);
+        sum += buffer[0];
+    }
+    Report("RandU01(span)", start, values);
+
+    RngSeedManager::SetBackend(backend);
+    auto exponential = CreateObject<ExponentialRandomVariable>();
+    exponential->SetStream(0);
+    start = Clock::now();
+    for (uint64_t i = 0; i < values; i++)
+    {
+        sum += exponential->GetValue();
+    }
+    Report("ExponentialRandomVariable::GetValue()", start, values);
+
+    start = Clock::now();
+    for (uint64_t i = 0; i < values; i += batch)
+    {
+        exponential->GetValues(buffer);
+        sum += buffer[0];
+    }
+    Report("ExponentialRandomVariable::GetValues()", start, values);
+
+    const uint32_t jumps = 1000;
+    start = Clock::now();
+    for (uint32_t i = 0; i < jumps; i++)
+    {
+        rng.Advance((1ULL << 60) + i);
+        sum += rng.RandU01();
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    std::cout << "  Advance(2^60): " << elapsed.count() / jumps << " ns/op" << std::endl;
+
+    return sum;
+}
+
+} // unnamed namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t values = 10000000;
+    uint32_t batch = 1024;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("values", "Number of random values to generate per test", values);
+    cmd.AddValue("batch", "Number of random values generated at once", batch);
+    cmd.Parse(argc, argv);
+
+    double sum = Run("MRG32k3a", RngStream::MRG32K3A, values, batch);
+    sum += Run("Philox4x32-10", RngStream::PHILOX4X32_10, values, batch);
+    std::cout << "(sum " << sum << ")" << std::endl;
+
+    return 0;
+}
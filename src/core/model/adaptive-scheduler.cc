@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "adaptive-scheduler.h"
+
+#include "assert.h"
+#include "calendar-scheduler.h"
+#include "double.h"
+#include "event-impl.h"
+#include "heap-scheduler.h"
+#include "ladder-scheduler.h"
+#include "log.h"
+#include "map-scheduler.h"
+#include "object-factory.h"
+#include "uinteger.h"
+
+#include <bit>
+#include <sstream>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::AdaptiveScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AdaptiveScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(AdaptiveScheduler);
+
+TypeId
+AdaptiveScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::AdaptiveScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<AdaptiveScheduler>()
+            .AddAttribute("Backend",
+                          "The initial backend, until the end of the first window.",
+                          TypeIdValue(MapScheduler::GetTypeId()),
+                          MakeTypeIdAccessor(&AdaptiveScheduler::SetBackend),
+                          MakeTypeIdChecker())
+            .AddAttribute("SmallBackend",
+                          "The backend for the small queues.",
+                          TypeIdValue(HeapScheduler::GetTypeId()),
+                          MakeTypeIdAccessor(&AdaptiveScheduler::m_smallBackend),
+                          MakeTypeIdChecker())
+            .AddAttribute("NarrowBackend",
+                          "The backend for the large queues with a narrow "
+                          "distribution of the insert horizons.",
+                          TypeIdValue(CalendarScheduler::GetTypeId()),
+                          MakeTypeIdAccessor(&AdaptiveScheduler::m_narrowBackend),
+                          MakeTypeIdChecker())
+            .AddAttribute("WideBackend",
+                          "The backend for the large queues with a wide "
+                          "distribution of the insert horizons.",
+                          TypeIdValue(LadderScheduler::GetTypeId()),
+                          MakeTypeIdAccessor(&AdaptiveScheduler::m_wideBackend),
+                          MakeTypeIdChecker())
+            .AddAttribute("RemoveBackend",
+                          "The backend for the queues with frequent removals.",
+                          TypeIdValue(MapScheduler::GetTypeId()),
+                          MakeTypeIdAccessor(&AdaptiveScheduler::m_removeBackend),
+                          MakeTypeIdChecker())
+            .AddAttribute("SamplePeriod",
+                          "The number of events removed from the head in a window.",
+                          UintegerValue(100000),
+                          MakeUintegerAccessor(&AdaptiveScheduler::m_samplePeriod),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SmallQueueSize",
+                          "The mean number of pending events below which a queue is small.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&AdaptiveScheduler::m_smallSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("NarrowOctaves",
+                          "The maximum number of octaves holding 90% of the insert "
+                          "horizons of a narrow distribution.",
+                          UintegerValue(6),
+                          MakeUintegerAccessor(&AdaptiveScheduler::m_narrowOctaves),
+                          MakeUintegerChecker<uint32_t>(1, 64))
+            .AddAttribute("RemoveThreshold",
+                          "The fraction of the inserted events removed with Remove() "
+                          "above which removals are frequent.",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&AdaptiveScheduler::m_removeThreshold),
+                          MakeDoubleChecker<double>(0, 1));
+    return tid;
+}
+
+AdaptiveScheduler::AdaptiveScheduler()
+    : m_backend(nullptr),
+      m_size(0),
+      m_now(0),
+      m_switches(0),
+      m_removedNext(0),
+      m_sizeSum(0),
+      m_inserted(0),
+      m_removed(0),
+      m_cancelled(0),
+      m_horizons{}
+{
+    NS_LOG_FUNCTION(this);
+}
+
+AdaptiveScheduler::~AdaptiveScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+AdaptiveScheduler::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_backend = nullptr;
+    Scheduler::DoDispose();
+}
+
+TypeId
+AdaptiveScheduler::GetBackendTypeId() const
+{
+    return m_backend->GetInstanceTypeId();
+}
+
+uint32_t
+AdaptiveScheduler::GetSwitchCount() const
+{
+    return m_switches;
+}
+
+void
+AdaptiveScheduler::SetBackend(TypeId tid)
+{
+    NS_LOG_FUNCTION(this << tid.GetName());
+    ObjectFactory factory;
+    factory.SetTypeId(tid);
+    Ptr<Scheduler> backend = factory.Create<Scheduler>();
+    if (m_backend)
+    {
+        // Insert in order, which is the cheapest order for most backends
+        while (!m_backend->IsEmpty())
+        {
+            backend->Insert(m_backend->RemoveNext());
+        }
+        m_backend->Dispose();
+    }
+    m_backend = backend;
+}
+
+void
+AdaptiveScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(ev.key.m_ts >= m_now);
+    m_horizons[std::bit_width(ev.key.m_ts - m_now)]++;
+    m_inserted++;
+    m_size++;
+    m_backend->Insert(ev);
+}
+
+bool
+AdaptiveScheduler::IsEmpty() const
+{
+    return m_size == 0;
+}
+
+Scheduler::Event
+AdaptiveScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_backend->PeekNext();
+}
+
+void
+AdaptiveScheduler::Sample(const Event& ev)
+{
+    m_sizeSum += m_size;
+    m_size--;
+    m_removedNext++;
+    m_now = ev.key.m_ts;
+    if (ev.impl != nullptr && ev.impl->IsCancelled())
+    {
+        m_cancelled++;
+    }
+}
+
+Scheduler::Event
+AdaptiveScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_removedNext >= m_samplePeriod)
+    {
+        EndWindow();
+    }
+    Event ev = m_backend->RemoveNext();
+    Sample(ev);
+    return ev;
+}
+
+void
+AdaptiveScheduler::RemoveNextBatch(std::vector<Event>& batch)
+{
+    NS_LOG_FUNCTION(this);
+    if (m_removedNext >= m_samplePeriod)
+    {
+        EndWindow();
+    }
+    std::size_t first = batch.size();
+    m_backend->RemoveNextBatch(batch);
+    for (std::size_t i = first; i < batch.size(); ++i)
+    {
+        Sample(batch[i]);
+    }
+}
+
+void
+AdaptiveScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_backend->Remove(ev);
+    m_size--;
+    m_removed++;
+}
+
+void
+AdaptiveScheduler::RemoveCancelled(std::vector<Event>& removed)
+{
+    NS_LOG_FUNCTION(this);
+    std::size_t first = removed.size();
+    m_backend->RemoveCancelled(removed);
+    m_size -= removed.size() - first;
+    // Counted like the cancelled events which reach the head
+    m_cancelled += removed.size() - first;
+}
+
+void
+AdaptiveScheduler::GetEvents(std::vector<Event>& events)
+{
+    NS_LOG_FUNCTION(this);
+    m_backend->GetEvents(events);
+}
+
+TypeId
+AdaptiveScheduler::Select(std::string& reason) const
+{
+    std::ostringstream oss;
+    uint64_t meanSize = m_sizeSum / m_removedNext;
+    if (m_inserted > 0 && m_removed > m_removeThreshold * m_inserted)
+    {
+        oss << m_removed << " of " << m_inserted << " events removed early";
+        reason = oss.str();
+        return m_removeBackend;
+    }
+    if (meanSize < m_smallSize)
+    {
+        oss << "mean queue size " << meanSize;
+        reason = oss.str();
+        return m_smallBackend;
+    }
+    // The cancelled events are mostly timers far in the future
+    if (m_cancelled * 2 > m_removedNext)
+    {
+        oss << m_cancelled << " of " << m_removedNext << " events cancelled";
+        reason = oss.str();
+        return m_wideBackend;
+    }
+    // Simultaneous events pile up in the same buckets of a calendar
+    if (m_horizons[0] * 4 > m_inserted)
+    {
+        oss << m_horizons[0] << " of " << m_inserted << " events inserted at the current time";
+        reason = oss.str();
+        return m_wideBackend;
+    }
+
+    // Octaves holding the central 90% of the other horizons
+    uint64_t delayed = m_inserted - m_horizons[0];
+    uint64_t low = delayed / 20;
+    uint64_t high = delayed - low;
+    uint64_t count = 0;
+    std::size_t first = 0;
+    std::size_t last = 0;
+    for (std::size_t i = 1; i < m_horizons.size(); ++i)
+    {
+        if (count <= low)
+        {
+            first = i;
+        }
+        count += m_horizons[i];
+        if (count >= high)
+        {
+            last = i;
+            break;
+        }
+    }
+    std::size_t octaves = last - first + 1;
+    oss << "mean queue size " << meanSize << ", horizons over " << octaves << " octaves";
+    reason = oss.str();
+    return octaves <= m_narrowOctaves ? m_narrowBackend : m_wideBackend;
+}
+
+void
+AdaptiveScheduler::EndWindow()
+{
+    NS_LOG_FUNCTION(this);
+    std::string reason;
+    TypeId tid = Select(reason);
+    NS_LOG_LOGIC("selected " << tid.GetName() << ": " << reason);
+    if (tid != m_backend->GetInstanceTypeId())
+    {
+        NS_LOG_INFO("switching from " << m_backend->GetInstanceTypeId().GetName() << " to "
+                                      << tid.GetName() << " with " << m_size
+                                      << " events: " << reason);
+        SetBackend(tid);
+        m_switches++;
+    }
+    m_removedNext = 0;
+    m_sizeSum = 0;
+    m_inserted = 0;
+    m_removed = 0;
+    m_cancelled = 0;
+    m_horizons.fill(0);
+}
+
+} // namespace ns3
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ADAPTIVE_SCHEDULER_H
+#define ADAPTIVE_SCHEDULER_H
+
+#include "ptr.h"
+#include "scheduler.h"
+#include "type-id.h"
+
+#include <array>
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::AdaptiveScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief an event scheduler which selects its implementation at run time
+ *
+ * This event scheduler keeps its events in a backend Scheduler, and
+ * samples how the simulation uses it over windows of `SamplePeriod`
+ * calls to RemoveNext():
+ *
+ * - the mean number of pending events,
+ * - the distribution of the insert horizons, that is the delays between
+ *   the current time and the timestamps of the new events, in octaves,
+ * - the fraction of the new events scheduled for the current time,
+ * - the fraction of the events which are cancelled when they reach the
+ *   head of the queue, and the fraction removed early with Remove().
+ *
+ * At the end of each window it selects the backend suited to these
+ * statistics, in this order:
+ *
+ * Condition                                       | Backend attribute
+ * :---------------------------------------------- | :----------------
+ * Remove() calls above `RemoveThreshold`          | `RemoveBackend`
+ * Mean queue size below `SmallQueueSize`          | `SmallBackend`
+ * Most events cancelled, or many simultaneous     | `WideBackend`
+ * Horizons within `NarrowOctaves` octaves         | `NarrowBackend`
+ * Otherwise                                       | `WideBackend`
+ *
+ * When the selected backend differs from the current one, the events
+ * are migrated to a new instance, in order, and the reason of the
+ * switch is logged at the INFO level.  The migration costs a RemoveNext()
+ * and an Insert() per pending event, so the windows should be much
+ * longer than the queue.
+ *
+ * @par Time Complexity
+ *
+ * Operation         | Amortized %Time | Reason
+ * :---------------- | :-------------- | :-----
+ * Insert()          | Backend         | Histogram update, then backend
+ * IsEmpty()         | Constant        | Explicit queue size
+ * PeekNext()        | Backend         | Backend
+ * Remove()          | Backend         | Backend
+ * RemoveNext()      | Backend         | Backend; migration every window at most
+ * RemoveCancelled() | Backend         | Backend
+ * GetEvents()       | Backend         | Backend
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 65 counters + backend            | Horizon histogram
+ * Per Event | Backend                          | Backend
+ */
+class AdaptiveScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    AdaptiveScheduler();
+    /** Destructor. */
+    ~AdaptiveScheduler() override;
+
+    /**
+     * Get the type of the current backend.
+     * @returns The TypeId of the backend.
+     */
+    TypeId GetBackendTypeId() const;
+
+    /**
+     * Get the number of backend switches.
+     * @returns The number of migrations to a new backend.
+     */
+    uint32_t GetSwitchCount() const;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+    void RemoveNextBatch(std::vector<Scheduler::Event>& batch) override;
+    void RemoveCancelled(std::vector<Scheduler::Event>& removed) override;
+    void GetEvents(std::vector<Scheduler::Event>& events) override;
+
+  private:
+    void DoDispose() override;
+
+    /**
+     * Migrate the events to a new backend.
+     *
+     * @param [in] tid The type of the new backend.
+     */
+    void SetBackend(TypeId tid);
+    /**
+     * Account for an event removed from the head of the queue.
+     *
+     * @param [in] ev The event.
+     */
+    void Sample(const Scheduler::Event& ev);
+    /**
+     * Select the backend for the statistics of the window.
+     *
+     * @param [out] reason The reason of the selection.
+     * @returns The type of the selected backend.
+     */
+    TypeId Select(std::string& reason) const;
+    /** Select the backend at the end of a window, and reset the statistics. */
+    void EndWindow();
+
+    /** The backend holding the events. */
+    Ptr<Scheduler> m_backend;
+    /** Number of events in the queue. */
+    std::size_t m_size;
+    /** Timestamp of the last event removed from the head. */
+    uint64_t m_now;
+    /** Number of backend switches. */
+    uint32_t m_switches;
+
+    /** @name Attributes */
+    /** @{ */
+    TypeId m_smallBackend;    //!< The backend for small queues
+    TypeId m_narrowBackend;   //!< The backend for narrow horizon distributions
+    TypeId m_wideBackend;     //!< The backend for wide horizon distributions
+    TypeId m_removeBackend;   //!< The backend for frequent removals
+    uint32_t m_samplePeriod;  //!< The number of RemoveNext() per window
+    uint32_t m_smallSize;     //!< The mean size of the small queues
+    uint32_t m_narrowOctaves; //!< The spread of the narrow distributions
+    double m_removeThreshold; //!< The fraction of the inserts removed early
+    /** @} */
+
+    /** @name Statistics of the current window */
+    /** @{ */
+    uint64_t m_removedNext; //!< Events removed from the head
+    uint64_t m_sizeSum;     //!< Sum of the queue sizes at each removal
+    uint64_t m_inserted;    //!< Events inserted
+    uint64_t m_removed;     //!< Events removed with Remove()
+    uint64_t m_cancelled;   //!< Cancelled events removed from the head
+    /** Inserts by horizon: 0 for the current time, else the bit width of the delay. */
+    std::array<uint64_t, 65> m_horizons;
+    /** @} */
+};
+
+} // namespace ns3
+
+#endif /* ADAPTIVE_SCHEDULER_H */
@@ -15,6 +15,7 @@
 #include "log.h"
 #include "type-id.h"
 
+#include <algorithm>
 #include <list>
 #include <string>
 #include <utility>
@@ -272,6 +273,41 @@ CalendarScheduler::Remove(const Event& ev)
     NS_ASSERT(false);
 }
 
+void
+CalendarScheduler::RemoveCancelled(std::vector<Scheduler::Event>& removed)
+{
+    NS_LOG_FUNCTION(this);
+    for (uint32_t bucket = 0; bucket < m_nBuckets; bucket++)
+    {
+        for (auto i = m_buckets[bucket].begin(); i != m_buckets[bucket].end();)
+        {
+            if (i->impl->IsCancelled())
+            {
+                removed.push_back(*i);
+                i = m_buckets[bucket].erase(i);
+                m_qSize--;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+    ResizeDown();
+}
+
+void
+CalendarScheduler::GetEvents(std::vector<Scheduler::Event>& events)
+{
+    NS_LOG_FUNCTION(this);
+    std::size_t first = events.size();
+    for (uint32_t bucket = 0; bucket < m_nBuckets; bucket++)
+    {
+        events.insert(events.end(), m_buckets[bucket].begin(), m_buckets[bucket].end());
+    }
+    std::sort(events.begin() + first, events.end());
+}
+
 void
 CalendarScheduler::ResizeUp()
 {
@@ -48,13 +48,15 @@ class EventImpl;
  *
  * @par Time Complexity
  *
- * Operation    | Amortized %Time | Reason
- * :----------- | :-------------- | :-----
- * Insert()     | ~Constant       | Ordering within bucket; possible resize
- * IsEmpty()    | Constant        | Explicit queue size
- * PeekNext()   | ~Constant       | Search buckets
- * Remove()     | ~Constant       | Search within bucket; possible resize
- * RemoveNext() | ~Constant       | Search buckets; possible resize
+ * Operation         | Amortized %Time | Reason
+ * :---------------- | :-------------- | :-----
+ * Insert()          | ~Constant       | Ordering within bucket; possible resize
+ * IsEmpty()         | Constant        | Explicit queue size
+ * PeekNext()        | ~Constant       | Search buckets
+ * Remove()          | ~Constant       | Search within bucket; possible resize
+ * RemoveNext()      | ~Constant       | Search buckets; possible resize
+ * RemoveCancelled() | Linear          | Filter buckets; possible resize
+ * GetEvents()       | Linearithmic    | Copy buckets and sort
  *
  * @par Memory Complexity
  *
@@ -99,6 +101,8 @@ class CalendarScheduler : public Scheduler
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
     void Remove(const Scheduler::Event& ev) override;
+    void RemoveCancelled(std::vector<Scheduler::Event>& removed) override;
+    void GetEvents(std::vector<Scheduler::Event>& events) override;
 
   private:
     /** Double the number of buckets if necessary. */
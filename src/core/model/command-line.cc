@@ -296,6 +296,12 @@ CommandLine::HandleHardOptions(const std::vector<std::string>& args) const
             PrintTypeIds(std::cout);
             std::exit(0);
         }
+        else if (name == "PrintStartupProfile")
+        {
+            // method below never returns.
+            TypeId::PrintStartupProfile(std::cout);
+            std::exit(0);
+        }
         else if (name == "PrintGlobals")
         {
             // method below never returns.
@@ -425,6 +431,7 @@ CommandLine::PrintHelp(std::ostream& os) const
        << "    --PrintGroup=[group]:        Print all TypeIds of group.\n"
        << "    --PrintTypeIds:              Print all TypeIds.\n"
        << "    --PrintAttributes=[typeid]:  Print all attributes of typeid.\n"
+       << "    --PrintStartupProfile:       Print the startup time of the TypeIds.\n"
        << "    --PrintVersion:              Print the ns-3 version.\n"
        << "    --PrintHelp:                 Print this help message.\n"
        << std::endl;
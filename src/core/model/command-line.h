@@ -57,6 +57,7 @@ namespace ns3
    --PrintGroup=[group]:        Print all TypeIds of group.
    --PrintTypeIds:              Print all TypeIds.
    --PrintAttributes=[typeid]:  Print all attributes of typeid.
+   --PrintStartupProfile:       Print the startup time of the TypeIds.
    --PrintVersion:              Print the ns-3 version.
    --PrintHelp:                 Print this help message. \endverbatim
  *
@@ -180,6 +181,7 @@ namespace ns3
        --PrintGroup=[group]:        Print all TypeIds of group.
        --PrintTypeIds:              Print all TypeIds.
        --PrintAttributes=[typeid]:  Print all attributes of typeid.
+       --PrintStartupProfile:       Print the startup time of the TypeIds.
        --PrintVersion:              Print the ns-3 version.
        --PrintHelp:                 Print this help message. \endverbatim
  *
@@ -15,8 +15,16 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
 #include <sstream>
 
+#ifdef NS3_MTP
+#include <mutex>
+#endif
+
 /**
  * @file
  * @ingroup config-impl
@@ -190,6 +198,8 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * @ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once into a list of index ranges.
  */
 class ArrayMatcher
 {
@@ -207,8 +217,23 @@ class ArrayMatcher
      * @returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the number of indexes which can match, if it is smaller than
+     * a limit.
+     *
+     * @param [in] limit The limit.
+     * @param [out] indexes The indexes which can match, in increasing order.
+     * @returns \c true if there are fewer than \p limit indexes.
+     */
+    bool GetIndexes(std::size_t limit, std::vector<std::size_t>* indexes) const;
 
   private:
+    /**
+     * Parse a Config path specification.
+     *
+     * @param [in] element The Config path specification.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -219,6 +244,8 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** The ranges of matching indexes, inclusive. */
+    std::vector<std::pair<std::size_t, std::size_t>> m_ranges;
 
 }; // class ArrayMatcher
 
@@ -226,68 +253,89 @@ ArrayMatcher::ArrayMatcher(std::string element)
     : m_element(element)
 {
     NS_LOG_FUNCTION(this << element);
+    Parse(element);
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        m_ranges.emplace_back(0, std::numeric_limits<std::size_t>::max());
+        return;
     }
     std::string::size_type tmp;
-    tmp = m_element.find('|');
+    tmp = element.find('|');
     if (tmp != std::string::npos)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        Parse(element.substr(0, tmp - 0));
+        Parse(element.substr(tmp + 1, element.size() - (tmp + 1)));
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
+        {
+            m_ranges.emplace_back(min, max);
+        }
+        return;
+    }
+    uint32_t value;
+    if (StringToUint32(element, &value))
+    {
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    for (const auto& [min, max] : m_ranges)
+    {
+        if (i >= min && i <= max)
         {
             NS_LOG_DEBUG("Array " << i << " matches " << m_element);
             return true;
         }
-        else
+    }
+    NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
+    return false;
+}
+
+bool
+ArrayMatcher::GetIndexes(std::size_t limit, std::vector<std::size_t>* indexes) const
+{
+    NS_LOG_FUNCTION(this << limit << indexes);
+    std::size_t count = 0;
+    for (const auto& [min, max] : m_ranges)
+    {
+        if (max - min >= limit - count)
         {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
             return false;
         }
+        count += max - min + 1;
     }
-    uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    indexes->clear();
+    for (const auto& [min, max] : m_ranges)
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-        return true;
+        for (std::size_t i = min; i <= max; i++)
+        {
+            indexes->push_back(i);
+        }
     }
-    NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-    return false;
+    std::sort(indexes->begin(), indexes->end());
+    indexes->erase(std::unique(indexes->begin(), indexes->end()), indexes->end());
+    return true;
 }
 
 bool
@@ -303,6 +351,14 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 /**
  * @ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * The path is split into its segments once, and the attributes which
+ * match a segment are looked up once for each TypeId, so that resolving
+ * a path through many objects of the same types does not compare
+ * strings for each object. The objects are still visited one by one:
+ * the cost of a path with wildcards grows with the number of objects
+ * its wildcards select, such as all the devices of all the nodes, not
+ * with the number of attributes or trace sources it matches.
  */
 class Resolver
 {
@@ -326,23 +382,43 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
+    /** A segment of the Config path. */
+    struct Segment
+    {
+        std::string item;     //!< The segment
+        ArrayMatcher matcher; //!< The segment as an array index
+        TypeId tid;           //!< The TypeId of a \c $ segment
+        bool tidValid;        //!< Whether \c tid has been looked up
+    };
+
+    /** An attribute of an object which matches a segment. */
+    struct AttributeMatch
+    {
+        std::string name;                        //!< The attribute name
+        Ptr<const AttributeAccessor> accessor;   //!< The attribute accessor
+        bool isPointer;                          //!< Pointer or container attribute
+    };
+
     /** Ensure the Config path starts and ends with a '/'. */
     void Canonicalize();
     /**
      * Parse the next element in the Config path.
      *
-     * @param [in] path The remaining portion of the Config path.
+     * @param [in] index The index of the next segment of the Config path.
      * @param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t index, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * @param [in] path The remaining Config path.
-     * @param [in,out] vector The resulting list of matching objects.
+     * @param [in] index The index of the next segment of the Config path.
+     * @param [in] root The object holding the container.
+     * @param [in] accessor The accessor of the container attribute.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t index,
+                        Ptr<Object> root,
+                        const ObjectPtrContainerAccessor* accessor);
     /**
      * Handle one object found on the path.
      *
@@ -355,6 +431,20 @@ class Resolver
      * @returns The current Config path.
      */
     std::string GetResolvedPath() const;
+    /**
+     * Get the pointer and container attributes of a TypeId and its
+     * parents which match a segment.
+     *
+     * The matches are cached until the attributes of a TypeId change,
+     * as told by TypeId::GetAttributeChangeCount().
+     *
+     * @param [in] tid The TypeId.
+     * @param [in] item The segment, or \c *.
+     * @returns The matching attributes, in lookup order.
+     */
+    static std::shared_ptr<const std::vector<AttributeMatch>> GetAttributeMatches(
+        TypeId tid,
+        const std::string& item);
     /**
      * Handle one found object.
      *
@@ -367,6 +457,8 @@ class Resolver
     std::vector<std::string> m_workStack;
     /** The Config path. */
     std::string m_path;
+    /** The segments of the Config path. */
+    std::vector<Segment> m_segments;
 
 }; // class Resolver
 
@@ -375,6 +467,15 @@ Resolver::Resolver(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
     Canonicalize();
+    std::string::size_type start = 1;
+    std::string::size_type next = m_path.find('/', start);
+    while (next != std::string::npos)
+    {
+        std::string item = m_path.substr(start, next - start);
+        m_segments.push_back({item, ArrayMatcher(item), TypeId(), false});
+        start = next + 1;
+        next = m_path.find('/', start);
+    }
 }
 
 Resolver::~Resolver()
@@ -407,7 +508,7 @@ Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -432,14 +533,76 @@ Resolver::DoResolveOne(Ptr<Object> object)
     DoOne(object, GetResolvedPath());
 }
 
+std::shared_ptr<const std::vector<Resolver::AttributeMatch>>
+Resolver::GetAttributeMatches(TypeId tid, const std::string& item)
+{
+    static std::map<std::pair<uint16_t, std::string>,
+                    std::shared_ptr<const std::vector<AttributeMatch>>>
+        cache;
+    static uint64_t cacheChanges = 0;
+#ifdef NS3_MTP
+    // the partitions may resolve paths concurrently
+    static std::mutex mutex;
+    std::lock_guard lock(mutex);
+#endif
+    uint64_t changes = TypeId::GetAttributeChangeCount();
+    if (changes != cacheChanges)
+    {
+        // The matches which are still used by a resolver stay alive
+        cache.clear();
+        cacheChanges = changes;
+    }
+    auto key = std::make_pair(tid.GetUid(), item);
+    auto it = cache.find(key);
+    if (it != cache.end())
+    {
+        return it->second;
+    }
+
+    auto matches = std::make_shared<std::vector<AttributeMatch>>();
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (info.name != item && item != "*")
+            {
+                continue;
+            }
+            if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter())
+            {
+                continue;
+            }
+            // attempt to cast to a pointer checker.
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                matches->push_back({info.name, info.accessor, true});
+            }
+            // attempt to cast to an object vector.
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                         nullptr &&
+                     dynamic_cast<const ObjectPtrContainerAccessor*>(
+                         PeekPointer(info.accessor)) != nullptr)
+            {
+                matches->push_back({info.name, info.accessor, false});
+            }
+            // this could be anything else and we don't know what to do with it.
+            // So, we just ignore it.
+        }
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    cache.emplace(key, matches);
+    return matches;
+}
+
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t index, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << index << root);
 
-    if (next == std::string::npos)
+    if (index == m_segments.size())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -455,8 +618,8 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    Segment& segment = m_segments[index];
+    const std::string& item = segment.item;
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -467,11 +630,10 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
+        if (item.compare(0, 5, "Names") == 0)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(index + 1, root);
             m_workStack.pop_back();
             return;
         }
@@ -488,7 +650,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(index + 1, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -508,83 +670,61 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     if (dollarPos == 0)
     {
         // This is a call to GetObject
-        std::string tidString = item.substr(1, item.size() - 1);
-        NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
-        Ptr<Object> object = root->GetObject<Object>(tid);
+        if (!segment.tidValid)
+        {
+            segment.tid = TypeId::LookupByName(item.substr(1, item.size() - 1));
+            segment.tidValid = true;
+        }
+        NS_LOG_DEBUG("GetObject=" << item << " on path=" << GetResolvedPath());
+        Ptr<Object> object = root->GetObject<Object>(segment.tid);
         if (!object)
         {
-            NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
+            NS_LOG_DEBUG("GetObject (" << item << ") failed on path=" << GetResolvedPath());
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(index + 1, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
-        bool foundMatch = false;
-
-        do
+        auto matches = GetAttributeMatches(root->GetInstanceTypeId(), item);
+        for (const auto& match : *matches)
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (match.isPointer)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << match.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                match.accessor->Get(PeekPointer(root), pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                m_workStack.push_back(match.name);
+                DoResolve(index + 1, object);
+                m_workStack.pop_back();
             }
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << match.name
+                                                     << " on path=" << GetResolvedPath());
+                m_workStack.push_back(match.name);
+                DoArrayResolve(
+                    index + 1,
+                    root,
+                    static_cast<const ObjectPtrContainerAccessor*>(PeekPointer(match.accessor)));
+                m_workStack.pop_back();
+            }
+        }
 
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
-
-        if (!foundMatch)
+        if (matches->empty())
         {
             NS_LOG_DEBUG("Requested item=" << item
                                            << " does not exist on path=" << GetResolvedPath());
@@ -594,29 +734,62 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t index,
+                         Ptr<Object> root,
+                         const ObjectPtrContainerAccessor* accessor)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << index << root << accessor);
+    if (index == m_segments.size())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const ArrayMatcher& matcher = m_segments[index].matcher;
+
+    // When few indexes can match, get them directly from the container,
+    // as long as the container is indexed by position like a vector
+    std::size_t n;
+    std::vector<std::size_t> indexes;
+    std::vector<Ptr<Object>> objects;
+    if (accessor->GetN(PeekPointer(root), &n) && matcher.GetIndexes(n, &indexes))
+    {
+        bool byPosition = true;
+        for (auto i : indexes)
+        {
+            // An index past the end may still be the key of another item
+            if (i >= n)
+            {
+                byPosition = false;
+                break;
+            }
+            std::size_t key;
+            objects.push_back(accessor->GetItem(PeekPointer(root), i, &key));
+            if (key != i)
+            {
+                byPosition = false;
+                break;
+            }
+        }
+        if (byPosition)
+        {
+            for (std::size_t j = 0; j < objects.size(); j++)
+            {
+                m_workStack.push_back(std::to_string(indexes[j]));
+                DoResolve(index + 1, objects[j]);
+                m_workStack.pop_back();
+            }
+            return;
+        }
+    }
 
-    ArrayMatcher matcher = ArrayMatcher(item);
+    ObjectPtrContainerValue container;
+    accessor->Get(PeekPointer(root), container);
     ObjectPtrContainerValue::Iterator it;
     for (it = container.Begin(); it != container.End(); ++it)
     {
         if (matcher.Matches((*it).first))
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
+            m_workStack.push_back(std::to_string((*it).first));
+            DoResolve(index + 1, (*it).second);
             m_workStack.pop_back();
         }
     }
@@ -639,6 +812,8 @@ class ConfigImpl : public Singleton<ConfigImpl>
     bool ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb);
     /** @copydoc ns3::Config::ConnectFailSafe() */
     bool ConnectFailSafe(std::string path, const CallbackBase& cb);
+    /** @copydoc ns3::Config::ConnectMany() */
+    void ConnectMany(const std::vector<std::pair<std::string, CallbackBase>>& connections);
     /** @copydoc ns3::Config::DisconnectWithoutContext() */
     void DisconnectWithoutContext(std::string path, const CallbackBase& cb);
     /** @copydoc ns3::Config::Disconnect() */
@@ -751,6 +926,43 @@ ConfigImpl::ConnectFailSafe(std::string path, const CallbackBase& cb)
     return container.ConnectFailSafe(leaf, cb);
 }
 
+void
+ConfigImpl::ConnectMany(const std::vector<std::pair<std::string, CallbackBase>>& connections)
+{
+    NS_LOG_FUNCTION(this << connections.size());
+
+    // Group the trace sources by their leading path, keeping the order
+    // of the first occurrence of each leading path.
+    std::vector<std::string> roots;
+    std::map<std::string, std::vector<std::size_t>> leaves;
+    for (std::size_t i = 0; i < connections.size(); i++)
+    {
+        std::string root;
+        std::string leaf;
+        ParsePath(connections[i].first, &root, &leaf);
+        auto& indexes = leaves[root];
+        if (indexes.empty())
+        {
+            roots.push_back(root);
+        }
+        indexes.push_back(i);
+    }
+
+    for (const auto& root : roots)
+    {
+        MatchContainer container = LookupMatches(root);
+        for (auto i : leaves[root])
+        {
+            const auto& [path, cb] = connections[i];
+            std::string leaf = path.substr(root.size() + 1);
+            if (!container.ConnectFailSafe(leaf, cb))
+            {
+                NS_FATAL_ERROR("Could not connect callback to " << path);
+            }
+        }
+    }
+}
+
 void
 ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
 {
@@ -980,6 +1192,13 @@ ConnectFailSafe(std::string path, const CallbackBase& cb)
     return ConfigImpl::Get()->ConnectFailSafe(path, cb);
 }
 
+void
+ConnectMany(const std::vector<std::pair<std::string, CallbackBase>>& connections)
+{
+    NS_LOG_FUNCTION(connections.size());
+    ConfigImpl::Get()->ConnectMany(connections);
+}
+
 void
 Disconnect(std::string path, const CallbackBase& cb)
 {
@@ -11,6 +11,7 @@
 #include "ptr.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -163,6 +164,20 @@ void Connect(std::string path, const CallbackBase& cb);
  * @returns \c true if any trace sources could be connected.
  */
 bool ConnectFailSafe(std::string path, const CallbackBase& cb);
+/**
+ * @ingroup config
+ * @param [in] connections The paths to match trace sources, and the
+ *             callbacks to connect to them.
+ *
+ * This function is equivalent to calling Config::Connect on each
+ * path and callback pair, but resolves the objects of the paths which
+ * share the same leading path, up to the trace source name, only once.
+ * This makes connecting several trace sources of the same objects, as
+ * tracing helpers do, much faster in large topologies.
+ * If no matching trace sources are found for one of the paths, this
+ * method will throw a fatal error.
+ */
+void ConnectMany(const std::vector<std::pair<std::string, CallbackBase>>& connections);
 /**
  * @ingroup config
  * @param [in] path A path to match trace sources.
@@ -9,10 +9,15 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "double.h"
+#include "enum.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
+#include <algorithm>
 #include <cmath>
 
 /**
@@ -37,7 +42,42 @@ DefaultSimulatorImpl::GetTypeId()
     static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
                             .SetParent<SimulatorImpl>()
                             .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+                            .AddConstructor<DefaultSimulatorImpl>()
+                            .AddAttribute("DispatchMode",
+                                          "How the events are taken from the scheduler "
+                                          "and executed.",
+                                          EnumValue(DISPATCH_SINGLE),
+                                          MakeEnumAccessor<DispatchMode>(
+                                              &DefaultSimulatorImpl::m_dispatchMode),
+                                          MakeEnumChecker(DISPATCH_SINGLE,
+                                                          "Single",
+                                                          DISPATCH_BATCH,
+                                                          "Batch",
+                                                          DISPATCH_BATCH_BY_CONTEXT,
+                                                          "BatchByContext"))
+                            .AddAttribute("CompactionThreshold",
+                                          "Fraction of cancelled events among the pending "
+                                          "events above which the cancelled events are "
+                                          "removed from the scheduler; 0 disables it.",
+                                          DoubleValue(0.5),
+                                          MakeDoubleAccessor(
+                                              &DefaultSimulatorImpl::m_compactionThreshold),
+                                          MakeDoubleChecker<double>(0, 1))
+                            .AddAttribute("CompactionMinEvents",
+                                          "Minimum number of pending events for the "
+                                          "cancelled events to be removed from the scheduler.",
+                                          UintegerValue(1024),
+                                          MakeUintegerAccessor(
+                                              &DefaultSimulatorImpl::m_compactionMinEvents),
+                                          MakeUintegerChecker<uint32_t>())
+                            .AddAttribute("EventProfile",
+                                          "Output file prefix of the wall clock profile of "
+                                          "the events, written at Simulator::Destroy; "
+                                          "empty disables the profiler.",
+                                          StringValue(""),
+                                          MakeStringAccessor(
+                                              &DefaultSimulatorImpl::m_eventProfile),
+                                          MakeStringChecker());
     return tid;
 }
 
@@ -51,7 +91,15 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
+    m_eventsWithContext = nullptr;
+    m_dispatchMode = DISPATCH_SINGLE;
+    m_batchNext = 0;
+    m_batchUid = 0;
+    m_batchByContext = false;
+    m_cancelledEvents = 0;
+    m_compactedEvents = 0;
+    m_compactionThreshold = 0.5;
+    m_compactionMinEvents = 1024;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -66,11 +114,20 @@ DefaultSimulatorImpl::DoDispose()
     NS_LOG_FUNCTION(this);
     ProcessEventsWithContext();
 
+    for (; m_batchNext < m_batch.size(); m_batchNext++)
+    {
+        if (m_batch[m_batchNext].impl != nullptr)
+        {
+            m_batch[m_batchNext].impl->Unref();
+        }
+    }
+    m_batch.clear();
     while (!m_events->IsEmpty())
     {
         Scheduler::Event next = m_events->RemoveNext();
         next.impl->Unref();
     }
+    m_cancelledEvents = 0;
     m_events = nullptr;
     SimulatorImpl::DoDispose();
 }
@@ -89,6 +146,11 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+    if (m_profiler)
+    {
+        m_profiler->Write(m_eventProfile);
+        m_profiler = nullptr;
+    }
 }
 
 void
@@ -119,7 +181,87 @@ void
 DefaultSimulatorImpl::ProcessOneEvent()
 {
     Scheduler::Event next = m_events->RemoveNext();
+    if (m_cancelledEvents > 0 && next.impl->IsCancelled())
+    {
+        m_cancelledEvents--;
+    }
+    InvokeEvent(next);
+}
 
+void
+DefaultSimulatorImpl::ProcessOneBatch()
+{
+    if (m_batch.empty())
+    {
+        m_events->RemoveNextBatch(m_batch);
+        m_batchNext = 0;
+        m_batchUid = m_uid;
+        m_batchByContext = (m_dispatchMode == DISPATCH_BATCH_BY_CONTEXT);
+        for (std::size_t i = 0; m_cancelledEvents > 0 && i < m_batch.size(); i++)
+        {
+            if (m_batch[i].impl->IsCancelled())
+            {
+                m_cancelledEvents--;
+            }
+        }
+        if (m_batchByContext)
+        {
+            // The batch is in uid order, which the stable sort keeps within a context
+            std::stable_sort(m_batch.begin(),
+                             m_batch.end(),
+                             [](const Scheduler::Event& a, const Scheduler::Event& b) {
+                                 return a.key.m_context < b.key.m_context;
+                             });
+        }
+    }
+    while (m_batchNext < m_batch.size() && !m_stop)
+    {
+        Scheduler::Event next = m_batch[m_batchNext];
+        m_batchNext++;
+        if (next.impl != nullptr)
+        {
+            InvokeEvent(next);
+        }
+    }
+    if (m_batchNext == m_batch.size())
+    {
+        m_batch.clear();
+        // Every event of the batch has been executed, whatever their order
+        m_currentUid = m_batchUid - 1;
+    }
+}
+
+bool
+DefaultSimulatorImpl::IsInCurrentBatch(const EventId& id) const
+{
+    return !m_batch.empty() && id.GetTs() == m_currentTs && id.GetUid() < m_batchUid;
+}
+
+std::size_t
+DefaultSimulatorImpl::FindInBatch(const EventId& id) const
+{
+    // The part of the batch not executed yet is sorted by (context, uid) or by uid
+    auto first = m_batch.begin() + m_batchNext;
+    auto it = std::lower_bound(first,
+                               m_batch.end(),
+                               id,
+                               [this](const Scheduler::Event& ev, const EventId& key) {
+                                   if (m_batchByContext && ev.key.m_context != key.GetContext())
+                                   {
+                                       return ev.key.m_context < key.GetContext();
+                                   }
+                                   return ev.key.m_uid < key.GetUid();
+                               });
+    if (it != m_batch.end() && it->key.m_uid == id.GetUid())
+    {
+        return it - m_batch.begin();
+    }
+    return m_batch.size();
+}
+
+void
+DefaultSimulatorImpl::InvokeEvent(const Scheduler::Event& next)
+{
     PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
 
     NS_ASSERT(next.key.m_ts >= m_currentTs);
@@ -130,7 +272,16 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        m_profiler->Start(next.impl, next.key.m_context);
+        next.impl->Invoke();
+        m_profiler->Stop();
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -139,36 +290,42 @@ DefaultSimulatorImpl::ProcessOneEvent()
 bool
 DefaultSimulatorImpl::IsFinished() const
 {
-    return m_events->IsEmpty() || m_stop;
+    return (m_events->IsEmpty() && m_batch.empty()) || m_stop;
 }
 
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    // Cheap check on every event: other threads rarely schedule
+    if (m_eventsWithContext.load(std::memory_order_relaxed) == nullptr)
     {
         return;
     }
 
-    // swap queues
-    EventsWithContext eventsWithContext;
+    // Take the whole stack at once, then reverse it to restore the
+    // order in which the events were scheduled
+    EventWithContext* stack = m_eventsWithContext.exchange(nullptr, std::memory_order_acquire);
+    EventWithContext* eventsWithContext = nullptr;
+    while (stack != nullptr)
     {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
+        EventWithContext* next = stack->next;
+        stack->next = eventsWithContext;
+        eventsWithContext = stack;
+        stack = next;
     }
-    while (!eventsWithContext.empty())
+    while (eventsWithContext != nullptr)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
+        EventWithContext* event = eventsWithContext;
+        eventsWithContext = event->next;
         Scheduler::Event ev;
-        ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
-        ev.key.m_context = event.context;
+        ev.impl = event->event;
+        ev.key.m_ts = m_currentTs + event->timestamp;
+        ev.key.m_context = event->context;
         ev.key.m_uid = m_uid;
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
+        delete event;
     }
 }
 
@@ -180,15 +337,26 @@ DefaultSimulatorImpl::Run()
     m_mainThreadId = std::this_thread::get_id();
     ProcessEventsWithContext();
     m_stop = false;
+    if (!m_eventProfile.empty() && !m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>();
+    }
 
-    while (!m_events->IsEmpty() && !m_stop)
+    while (!IsFinished())
     {
-        ProcessOneEvent();
+        if (m_dispatchMode == DISPATCH_SINGLE && m_batch.empty())
+        {
+            ProcessOneEvent();
+        }
+        else
+        {
+            ProcessOneBatch();
+        }
     }
 
     // If the simulator stopped naturally by lack of events, make a
     // consistency test to check that we didn't lose any events along the way.
-    NS_ASSERT(!m_events->IsEmpty() || m_unscheduledEvents == 0);
+    NS_ASSERT(!m_events->IsEmpty() || !m_batch.empty() || m_unscheduledEvents == 0);
 }
 
 void
@@ -248,15 +416,17 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
     }
     else
     {
-        EventWithContext ev;
-        ev.context = context;
+        auto ev = new EventWithContext;
+        ev->context = context;
         // Current time added in ProcessEventsWithContext()
-        ev.timestamp = delay.GetTimeStep();
-        ev.event = event;
+        ev->timestamp = delay.GetTimeStep();
+        ev->event = event;
+        ev->next = m_eventsWithContext.load(std::memory_order_relaxed);
+        while (!m_eventsWithContext.compare_exchange_weak(ev->next,
+                                                          ev,
+                                                          std::memory_order_release,
+                                                          std::memory_order_relaxed))
         {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
         }
     }
 }
@@ -327,7 +497,15 @@ DefaultSimulatorImpl::Remove(const EventId& id)
     event.key.m_ts = id.GetTs();
     event.key.m_context = id.GetContext();
     event.key.m_uid = id.GetUid();
-    m_events->Remove(event);
+    if (IsInCurrentBatch(id))
+    {
+        // The event is in the current batch and has not been executed yet
+        m_batch[FindInBatch(id)].impl = nullptr;
+    }
+    else
+    {
+        m_events->Remove(event);
+    }
     event.impl->Cancel();
     // whenever we remove an event from the event list, we have to unref it.
     event.impl->Unref();
@@ -338,10 +516,44 @@ DefaultSimulatorImpl::Remove(const EventId& id)
 void
 DefaultSimulatorImpl::Cancel(const EventId& id)
 {
-    if (!IsExpired(id))
+    if (IsExpired(id))
+    {
+        return;
+    }
+    id.PeekEventImpl()->Cancel();
+    if (id.GetUid() == EventId::UID::DESTROY || IsInCurrentBatch(id))
+    {
+        // Not in the scheduler
+        return;
+    }
+    // The event stays in the scheduler until it reaches its head
+    m_cancelledEvents++;
+    if (m_compactionThreshold > 0 && m_unscheduledEvents >= 0 &&
+        static_cast<uint64_t>(m_unscheduledEvents) >= m_compactionMinEvents &&
+        m_cancelledEvents > m_compactionThreshold * m_unscheduledEvents)
+    {
+        Compact();
+    }
+}
+
+void
+DefaultSimulatorImpl::Compact()
+{
+    std::vector<Scheduler::Event> removed;
+    m_events->RemoveCancelled(removed);
+    NS_LOG_LOGIC("removed " << removed.size() << " cancelled events out of "
+                            << m_unscheduledEvents);
+    NS_ASSERT(removed.size() >= m_cancelledEvents);
+    for (const auto& ev : removed)
     {
-        id.PeekEventImpl()->Cancel();
+        ev.impl->Unref();
     }
+    m_unscheduledEvents -= removed.size();
+    // Counted like the cancelled events which reach the head of the scheduler,
+    // so that the event count does not depend on the compaction
+    m_eventCount += removed.size();
+    m_compactedEvents += removed.size();
+    m_cancelledEvents = 0;
 }
 
 bool
@@ -363,6 +575,12 @@ DefaultSimulatorImpl::IsExpired(const EventId& id) const
         }
         return true;
     }
+    if (IsInCurrentBatch(id))
+    {
+        // The events of the current batch may not execute in uid order
+        return id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled() ||
+               FindInBatch(id) == m_batch.size();
+    }
     return id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
            (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
            id.PeekEventImpl()->IsCancelled();
@@ -386,4 +604,44 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_cancelledEvents;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetCompactedEventCount() const
+{
+    return m_compactedEvents;
+}
+
+std::vector<EventId>
+DefaultSimulatorImpl::GetPendingEvents()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::GetPendingEvents Thread-unsafe invocation!");
+    // Include the events scheduled by the other threads
+    ProcessEventsWithContext();
+
+    // The rest of the current batch is ahead of the scheduler
+    std::vector<Scheduler::Event> events(m_batch.begin() + m_batchNext, m_batch.end());
+    m_events->GetEvents(events);
+
+    std::vector<EventId> pending;
+    pending.reserve(events.size());
+    for (const auto& ev : events)
+    {
+        if (ev.impl != nullptr && !ev.impl->IsCancelled())
+        {
+            pending.emplace_back(Ptr<EventImpl>(ev.impl, true),
+                                 ev.key.m_ts,
+                                 ev.key.m_context,
+                                 ev.key.m_uid);
+        }
+    }
+    return pending;
+}
+
 } // namespace ns3
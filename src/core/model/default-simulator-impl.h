@@ -9,11 +9,16 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
+#include "scheduler.h"
 #include "simulator-impl.h"
 
+#include <atomic>
 #include <list>
-#include <mutex>
+#include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 /**
  * @file
@@ -24,9 +29,6 @@
 namespace ns3
 {
 
-// Forward
-class Scheduler;
-
 /**
  * @ingroup simulator
  *
@@ -41,6 +43,29 @@ class DefaultSimulatorImpl : public SimulatorImpl
      */
     static TypeId GetTypeId();
 
+    /**
+     * How the events are taken from the scheduler and executed.
+     */
+    enum DispatchMode
+    {
+        /** Remove and execute the events one at a time. */
+        DISPATCH_SINGLE,
+        /**
+         * Remove all the events with the next timestamp with
+         * Scheduler::RemoveNextBatch, and execute them in uid order.
+         * The execution order is the same as with DISPATCH_SINGLE.
+         */
+        DISPATCH_BATCH,
+        /**
+         * Remove all the events with the next timestamp and execute them
+         * sorted by context, so that the events of a node run together.
+         * The events of a given context still execute in uid order, but
+         * the events of different contexts with the same timestamp no
+         * longer execute in the order they were scheduled.
+         */
+        DISPATCH_BATCH_BY_CONTEXT,
+    };
+
     /** Constructor. */
     DefaultSimulatorImpl();
     /** Destructor. */
@@ -66,16 +91,62 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
+    uint64_t GetCancelledEventCount() const override;
+    uint64_t GetCompactedEventCount() const override;
+    std::vector<EventId> GetPendingEvents() override;
 
   private:
     void DoDispose() override;
 
     /** Process the next event. */
     void ProcessOneEvent();
+    /**
+     * Process all the events with the next timestamp.
+     *
+     * If the simulation is stopped by one of the events, the events of
+     * the batch which have not been executed stay in m_batch, and are
+     * executed by the next call, before the events of the scheduler.
+     */
+    void ProcessOneBatch();
+    /**
+     * Execute an event removed from the scheduler.
+     *
+     * @param [in] next The event.
+     */
+    void InvokeEvent(const Scheduler::Event& next);
+    /**
+     * Find an event in the part of the current batch which has not been
+     * executed yet.
+     *
+     * @param [in] id The event.
+     * @returns The index of the event in m_batch, or the size of m_batch.
+     */
+    std::size_t FindInBatch(const EventId& id) const;
+    /**
+     * Check if an event belongs to the current batch, whether it has been
+     * executed or not.
+     *
+     * @param [in] id The event.
+     * @returns \c true if the event has been removed from the scheduler
+     * with the current batch.
+     */
+    bool IsInCurrentBatch(const EventId& id) const;
+    /**
+     * Remove the cancelled events from the scheduler.
+     *
+     * Called when the cancelled events make up more than
+     * m_compactionThreshold of the pending events.
+     */
+    void Compact();
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
 
-    /** Wrap an event with its execution context. */
+    /**
+     * Wrap an event with its execution context.
+     *
+     * The events scheduled from other threads are linked together
+     * through \c next in a lock-free stack.
+     */
     struct EventWithContext
     {
         /** The event context. */
@@ -84,19 +155,18 @@ class DefaultSimulatorImpl : public SimulatorImpl
         uint64_t timestamp;
         /** The event implementation. */
         EventImpl* event;
+        /** The event pushed before this one. */
+        EventWithContext* next;
     };
 
-    /** Container type for the events from a different context. */
-    typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * Head of the multiple-producer, single-consumer stack of events
+     * scheduled from a different thread, most recent first.
+     *
+     * Other threads push with a compare-and-swap; the main thread takes
+     * the whole stack with a single exchange in ProcessEventsWithContext().
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    std::atomic<EventWithContext*> m_eventsWithContext;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -107,6 +177,35 @@ class DefaultSimulatorImpl : public SimulatorImpl
     /** The event priority queue. */
     Ptr<Scheduler> m_events;
 
+    /** The dispatch mode. */
+    DispatchMode m_dispatchMode;
+    /**
+     * The events with the current timestamp removed from the scheduler,
+     * in execution order, or empty outside of ProcessOneBatch().
+     * Removed events have a null implementation.
+     */
+    std::vector<Scheduler::Event> m_batch;
+    /** Index in m_batch of the next event to execute. */
+    std::size_t m_batchNext;
+    /** Flag \c true if m_batch is sorted by context. */
+    bool m_batchByContext;
+    /** Next event unique id when the current batch was removed. */
+    uint32_t m_batchUid;
+
+    /** Number of cancelled events in the scheduler. */
+    uint64_t m_cancelledEvents;
+    /** Number of cancelled events removed by Compact(). */
+    uint64_t m_compactedEvents;
+    /** Fraction of cancelled pending events which triggers Compact(), or 0. */
+    double m_compactionThreshold;
+    /** Minimum number of pending events to consider Compact(). */
+    uint32_t m_compactionMinEvents;
+
+    /** Output file prefix of the event profile, or empty. */
+    std::string m_eventProfile;
+    /** The event profiler, while profiling. */
+    std::unique_ptr<EventProfiler> m_profiler;
+
     /** Next event unique id. */
     uint32_t m_uid;
     /** Unique id of the current event. */
@@ -9,6 +9,10 @@
 #include "event-impl.h"
 
 #include "log.h"
+#include "memory-accounting.h"
+
+#include <algorithm>
+#include <new>
 
 /**
  * @file
@@ -21,15 +25,239 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/**
+ * Size of the last event allocated by the calling thread, for the
+ * constructor, which runs right after operator new.
+ */
+thread_local std::size_t g_allocatedSize = 0;
+
+/**
+ * Get the memory account of the events.
+ * @returns The account.
+ */
+MemoryAccounting::Account*
+GetEventAccount()
+{
+    static auto account = MemoryAccounting::GetAccount("ns3::EventImpl");
+    return account;
+}
+
+} // unnamed namespace
+
+#ifdef NS3_EVENT_POOL
+namespace
+{
+
+/** Granularity of the pool size classes, in bytes. */
+constexpr std::size_t POOL_GRANULARITY = 16;
+/** Number of pool size classes; larger events use the heap directly. */
+constexpr std::size_t POOL_CLASSES = 16;
+
+/** A free block, linked through its first word. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< Next free block of the same size class
+};
+
+/** A size class of the pool. */
+struct SizeClass
+{
+    FreeBlock* free;    //!< Free list
+    uint64_t hits;      //!< Allocations served from the free list
+    uint64_t misses;    //!< Allocations of new blocks
+    uint64_t inUse;     //!< Blocks currently allocated
+    uint64_t highWater; //!< Largest number of blocks allocated at once
+    uint64_t cached;    //!< Number of blocks in the free list
+};
+
+/**
+ * The event pool of a thread.
+ *
+ * This is trivially destructible, so that events released during the
+ * destruction of static objects can still check the \c released flag.
+ */
+struct Pool
+{
+    SizeClass classes[POOL_CLASSES]; //!< The size classes
+    uint64_t oversize;               //!< Events too large for the pool
+    uint64_t bytesInUse;             //!< Pool memory currently allocated
+    uint64_t highWaterBytes;         //!< Largest pool memory allocated at once
+    bool released;                   //!< The free lists have been released at thread exit
+};
+
+/** The event pool of the calling thread. */
+thread_local Pool g_pool;
+
+/** Release the free blocks of the pool when its thread exits. */
+struct PoolReleaser
+{
+    /** Make sure this thread's instance is constructed. */
+    void Register()
+    {
+    }
+
+    /** Destructor. */
+    ~PoolReleaser()
+    {
+        for (auto& sizeClass : g_pool.classes)
+        {
+            while (sizeClass.free != nullptr)
+            {
+                FreeBlock* block = sizeClass.free;
+                sizeClass.free = block->next;
+                ::operator delete(block);
+            }
+            sizeClass.cached = 0;
+        }
+        g_pool.released = true;
+    }
+};
+
+/** Releases the pool of the calling thread at its exit. */
+thread_local PoolReleaser g_poolReleaser;
+
+} // unnamed namespace
+#endif /* NS3_EVENT_POOL */
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    g_allocatedSize = size;
+#ifdef NS3_EVENT_POOL
+    std::size_t index = (size - 1) / POOL_GRANULARITY;
+    if (index >= POOL_CLASSES || g_pool.released)
+    {
+        g_pool.oversize++;
+        return ::operator new(size);
+    }
+    SizeClass& sizeClass = g_pool.classes[index];
+    void* p;
+    if (sizeClass.free != nullptr)
+    {
+        FreeBlock* block = sizeClass.free;
+        sizeClass.free = block->next;
+        sizeClass.cached--;
+        sizeClass.hits++;
+        p = block;
+    }
+    else
+    {
+        g_poolReleaser.Register();
+        sizeClass.misses++;
+        p = ::operator new((index + 1) * POOL_GRANULARITY);
+    }
+    sizeClass.inUse++;
+    sizeClass.highWater = std::max(sizeClass.highWater, sizeClass.inUse);
+    g_pool.bytesInUse += (index + 1) * POOL_GRANULARITY;
+    g_pool.highWaterBytes = std::max(g_pool.highWaterBytes, g_pool.bytesInUse);
+    return p;
+#else
+    return ::operator new(size);
+#endif
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+#ifdef NS3_EVENT_POOL
+    std::size_t index = (size - 1) / POOL_GRANULARITY;
+    if (index >= POOL_CLASSES)
+    {
+        ::operator delete(p);
+        return;
+    }
+    // Events may be released by another thread than the one which
+    // allocated them: the block then joins the pool of this thread.
+    SizeClass& sizeClass = g_pool.classes[index];
+    if (sizeClass.inUse > 0)
+    {
+        sizeClass.inUse--;
+        g_pool.bytesInUse -= (index + 1) * POOL_GRANULARITY;
+    }
+    if (g_pool.released ||
+        sizeClass.cached >= POOL_MAX_CACHED_BYTES / ((index + 1) * POOL_GRANULARITY))
+    {
+        ::operator delete(p);
+        return;
+    }
+    // This thread may never have allocated an event
+    g_poolReleaser.Register();
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = sizeClass.free;
+    sizeClass.free = block;
+    sizeClass.cached++;
+#else
+    ::operator delete(p);
+#endif
+}
+
+EventImpl::PoolStatistics
+EventImpl::GetPoolStatistics()
+{
+    PoolStatistics stats{};
+#ifdef NS3_EVENT_POOL
+    stats.enabled = true;
+    stats.oversize = g_pool.oversize;
+    stats.highWaterBytes = g_pool.highWaterBytes;
+    for (std::size_t i = 0; i < POOL_CLASSES; ++i)
+    {
+        const SizeClass& sizeClass = g_pool.classes[i];
+        stats.hits += sizeClass.hits;
+        stats.misses += sizeClass.misses;
+        if (sizeClass.hits + sizeClass.misses > 0 || sizeClass.cached > 0)
+        {
+            stats.classes.push_back({(i + 1) * POOL_GRANULARITY,
+                                     sizeClass.hits,
+                                     sizeClass.misses,
+                                     sizeClass.inUse,
+                                     sizeClass.highWater,
+                                     sizeClass.cached});
+        }
+    }
+#endif
+    return stats;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const EventImpl::PoolStatistics& stats)
+{
+    if (!stats.enabled)
+    {
+        return os << "event pool disabled";
+    }
+    os << "hits " << stats.hits << " misses " << stats.misses << " oversize " << stats.oversize
+       << " high water " << stats.highWaterBytes << " bytes";
+    for (const auto& sizeClass : stats.classes)
+    {
+        os << "; " << sizeClass.size << " B: hits " << sizeClass.hits << " misses "
+           << sizeClass.misses << " in use " << sizeClass.inUse << " high water "
+           << sizeClass.highWater << " cached " << sizeClass.cached;
+    }
+    return os;
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
+    if (m_accountedSize > 0)
+    {
+        MemoryAccounting::Release(GetEventAccount(), m_accountedSize);
+    }
 }
 
 EventImpl::EventImpl()
-    : m_cancel(false)
+    : m_cancel(false),
+      m_accountedSize(0)
 {
     NS_LOG_FUNCTION(this);
+    if (MemoryAccounting::IsEnabled())
+    {
+        m_accountedSize = std::clamp<std::size_t>(g_allocatedSize, sizeof(EventImpl), UINT16_MAX);
+        MemoryAccounting::Allocate(GetEventAccount(), m_accountedSize);
+    }
 }
 
 void
@@ -56,4 +284,10 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+const void*
+EventImpl::GetFunction() const
+{
+    return nullptr;
+}
+
 } // namespace ns3
@@ -10,7 +10,14 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
+#include <ostream>
 #include <stdint.h>
+#include <vector>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 /**
  * @file
@@ -55,6 +62,78 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * Get the address of the function called by the event, if known.
+     *
+     * Events created by MakeEvent() from a function pointer return the
+     * function, and those created from a method pointer an identity of
+     * the method: its address, or its offset in the virtual table for a
+     * virtual method.  The other events return \c nullptr.  The
+     * EventProfiler uses it with the type of the event to tell the
+     * events apart.
+     *
+     * @returns The function address, or \c nullptr.
+     */
+    virtual const void* GetFunction() const;
+
+    /**
+     * Allocate the memory of an event.
+     *
+     * When ns-3 is built with NS3_EVENT_POOL (the default) events are
+     * allocated from per-thread free lists of size classes, so that
+     * scheduling an event in steady state does not call the heap
+     * allocator. Larger events are allocated from the heap.
+     *
+     * @param [in] size The size of the event.
+     * @returns The event memory.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release the memory of an event to the pool of the calling thread.
+     *
+     * Events may be released by another thread than the one which
+     * allocated them, for example when other threads schedule events
+     * for the simulation thread. The free list of each size class
+     * therefore keeps at most POOL_MAX_CACHED_BYTES, and returns the
+     * other blocks to the heap.
+     *
+     * @param [in] p The event memory.
+     * @param [in] size The size of the event.
+     */
+    static void operator delete(void* p, std::size_t size);
+
+    /** The maximum number of bytes in the free list of a size class of a thread. */
+    static constexpr std::size_t POOL_MAX_CACHED_BYTES = 1 << 20;
+
+    /** Allocation statistics of one size class of the event pool. */
+    struct PoolSizeClassStatistics
+    {
+        std::size_t size;   //!< Size of the blocks in bytes
+        uint64_t hits;      //!< Allocations served from the free list
+        uint64_t misses;    //!< Allocations which needed a new block from the heap
+        uint64_t inUse;     //!< Blocks currently allocated
+        uint64_t highWater; //!< Largest number of blocks allocated at once
+        uint64_t cached;    //!< Free blocks kept for reuse
+    };
+
+    /** Allocation statistics of the event pool. */
+    struct PoolStatistics
+    {
+        bool enabled;                                 //!< Pool built in
+        uint64_t hits;                                //!< Total allocations from the free lists
+        uint64_t misses;                              //!< Total allocations from the heap
+        uint64_t oversize;                            //!< Events too large for the pool
+        uint64_t highWaterBytes;                      //!< Largest pool memory in use at once
+        std::vector<PoolSizeClassStatistics> classes; //!< Size classes used or cached
+    };
+
+    /**
+     * Get the allocation statistics of the event pool of the calling
+     * thread.
+     *
+     * @returns The statistics.
+     */
+    static PoolStatistics GetPoolStatistics();
 
   protected:
     /**
@@ -66,9 +145,26 @@ class EventImpl : public SimpleRefCount<EventImpl>
     virtual void Notify() = 0;
 
   private:
+#ifdef NS3_MTP
+    /** Has this event been cancelled; may be read by other partitions. */
+    std::atomic<bool> m_cancel;
+#else
     bool m_cancel; /**< Has this event been cancelled. */
+#endif
+    /** Size of the event counted by the MemoryAccounting, or 0. */
+    uint16_t m_accountedSize;
 };
 
+/**
+ * @ingroup events
+ * Output streamer for the event pool statistics.
+ *
+ * @param [in,out] os The output stream.
+ * @param [in] stats The statistics.
+ * @returns The stream.
+ */
+std::ostream& operator<<(std::ostream& os, const EventImpl::PoolStatistics& stats);
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
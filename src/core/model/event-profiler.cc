@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#include "event-profiler.h"
+
+#include "demangle.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifndef __WIN32__
+#include <dlfcn.h>
+#endif
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+namespace
+{
+
+/**
+ * @ingroup simulator
+ * Find the end of an argument in a demangled name.
+ *
+ * @param [in] name The demangled name.
+ * @param [in] start The start of the argument.
+ * @returns The index of the ',', '>' or ')' which ends the argument, or
+ * \c std::string::npos.
+ */
+std::size_t
+FindArgumentEnd(const std::string& name, std::size_t start)
+{
+    int depth = 0;
+    for (std::size_t i = start; i < name.size(); ++i)
+    {
+        char c = name[i];
+        if (depth == 0 && (c == ',' || c == '>' || c == ')'))
+        {
+            return i;
+        }
+        if (c == '<' || c == '(' || c == '[' || c == '{')
+        {
+            depth++;
+        }
+        else if (c == '>' || c == ')' || c == ']' || c == '}')
+        {
+            depth--;
+        }
+    }
+    return std::string::npos;
+}
+
+/**
+ * @ingroup simulator
+ * Get the type of the first argument of the MakeEvent() function in the
+ * name of an event class created by MakeEvent(): the type of the
+ * function pointer, method pointer or lambda of the event.
+ *
+ * @param [in] name The demangled name of the event class.
+ * @returns The type of the argument, or \p name if there is none.
+ */
+std::string
+GetMakeEventArgument(const std::string& name)
+{
+    const std::string prefix = "MakeEvent<";
+    std::size_t start = name.find(prefix);
+    if (start == std::string::npos)
+    {
+        return name;
+    }
+    // Skip the template arguments
+    std::size_t end = start + prefix.size();
+    while (end < name.size() && name[end] != '>')
+    {
+        end = FindArgumentEnd(name, end + (name[end] == ',' ? 1 : 0));
+        if (end == std::string::npos)
+        {
+            return name;
+        }
+    }
+    if (end + 1 >= name.size() || name[end + 1] != '(')
+    {
+        return name;
+    }
+    start = end + 2;
+    end = FindArgumentEnd(name, start);
+    if (end == std::string::npos)
+    {
+        return name;
+    }
+    return name.substr(start, end - start);
+}
+
+/**
+ * @ingroup simulator
+ * Get the name of a context in the profile.
+ *
+ * @param [in] context The context.
+ * @returns The name.
+ */
+std::string
+GetContextName(uint32_t context)
+{
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return "no context";
+    }
+    return "context " + std::to_string(context);
+}
+
+} // unnamed namespace
+
+EventProfiler::EventProfiler()
+    : m_lastKey{nullptr, nullptr, 0},
+      m_last(nullptr)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+EventProfiler::GetEventName(const std::type_info& type, const void* function)
+{
+    std::string name = GetMakeEventArgument(Demangle(type.name()));
+    if (function == nullptr)
+    {
+        return name;
+    }
+#ifndef __WIN32__
+    Dl_info info;
+    if (dladdr(function, &info) != 0 && info.dli_sname != nullptr &&
+        info.dli_saddr == function)
+    {
+        return Demangle(info.dli_sname);
+    }
+#endif
+    std::ostringstream oss;
+    oss << name << " at " << function;
+    return oss.str();
+}
+
+std::vector<EventProfiler::Record>
+EventProfiler::GetRecords() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Record> records;
+    records.reserve(m_stats.size());
+    for (const auto& [key, stats] : m_stats)
+    {
+        if (stats.calls == 0)
+        {
+            continue;
+        }
+        records.push_back({GetEventName(*key.type, key.function),
+                           key.context,
+                           stats.calls,
+                           stats.totalNs,
+                           stats.maxNs});
+    }
+    std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+        if (a.totalNs != b.totalNs)
+        {
+            return a.totalNs > b.totalNs;
+        }
+        return a.context < b.context || (a.context == b.context && a.name < b.name);
+    });
+    return records;
+}
+
+void
+EventProfiler::Write(const std::string& prefix) const
+{
+    NS_LOG_FUNCTION(this << prefix);
+    std::vector<Record> records = GetRecords();
+
+    std::ofstream folded(prefix + ".folded");
+    std::ofstream csv(prefix + ".csv");
+    if (!folded.is_open() || !csv.is_open())
+    {
+        NS_FATAL_ERROR("EventProfiler: cannot open " << prefix << ".folded or " << prefix
+                                                     << ".csv");
+    }
+
+    csv << "context,event,calls,total_ns,mean_ns,max_ns" << std::endl;
+    for (const auto& record : records)
+    {
+        // The folded format separates the frames with ';'
+        std::string frame = record.name;
+        std::replace(frame.begin(), frame.end(), ';', ':');
+        folded << GetContextName(record.context) << ";" << frame << " " << record.totalNs
+               << std::endl;
+
+        std::string quoted;
+        for (char c : record.name)
+        {
+            quoted += c;
+            if (c == '"')
+            {
+                quoted += c;
+            }
+        }
+        csv << (record.context == Simulator::NO_CONTEXT ? -1 : int64_t(record.context)) << ",\""
+            << quoted << "\"," << record.calls << "," << record.totalNs << ","
+            << record.totalNs / record.calls << "," << record.maxNs << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "event-impl.h"
+
+#include <chrono>
+#include <stdint.h>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * @brief Wall clock profiler of the simulation events.
+ *
+ * Where DesMetrics records the graph of the scheduled events, the
+ * EventProfiler measures where the wall clock time of a simulation
+ * goes. It accumulates the number of calls and the wall clock time of
+ * the events for each pair of context and event type. The event type is
+ * the function bound by MakeEvent(): the name of a method or function,
+ * the class and signature of a virtual method, or the enclosing scope of
+ * a lambda.
+ *
+ * The DefaultSimulatorImpl profiles its events when its \c EventProfile
+ * attribute names an output file prefix, and writes the profile with
+ * Write() at Simulator::Destroy():
+ *
+ * - \c prefix.folded holds one line per context and event type, in the
+ *   folded stack format of the flame graph tools, weighted by the wall
+ *   clock time in nanoseconds:
+ *   @code
+ *   $ flamegraph.pl --countname ns prefix.folded > prefix.svg
+ *   @endcode
+ * - \c prefix.csv holds the calls, total, mean and maximum time of each
+ *   context and event type, sorted by decreasing total time.
+ *
+ * The profiler reads a steady clock twice per event and updates a hash
+ * table entry, which is cached for consecutive events of the same type.
+ */
+class EventProfiler
+{
+  public:
+    /** The profile of the events of one type in one context. */
+    struct Record
+    {
+        std::string name;  //!< Event type
+        uint32_t context;  //!< Context of the events
+        uint64_t calls;    //!< Number of events executed
+        uint64_t totalNs;  //!< Total wall clock time, in ns
+        uint64_t maxNs;    //!< Longest event, in ns
+    };
+
+    EventProfiler();
+
+    /**
+     * Start timing an event, just before it is invoked.
+     *
+     * @param [in] event The event.
+     * @param [in] context The context of the event.
+     */
+    void Start(const EventImpl* event, uint32_t context);
+    /** Stop timing the event passed to the last call to Start(). */
+    void Stop();
+
+    /**
+     * Get the profile.
+     *
+     * @returns One record per context and event type, sorted by
+     * decreasing total time.
+     */
+    std::vector<Record> GetRecords() const;
+
+    /**
+     * Write the profile to \c prefix.folded and \c prefix.csv.
+     *
+     * @param [in] prefix The output file prefix.
+     */
+    void Write(const std::string& prefix) const;
+
+    /**
+     * Get a readable name for an event type.
+     *
+     * @param [in] type The dynamic type of the event.
+     * @param [in] function The function of the event, or \c nullptr.
+     * @returns The name.
+     */
+    static std::string GetEventName(const std::type_info& type, const void* function);
+
+  private:
+    /** The clock used to time the events. */
+    using Clock = std::chrono::steady_clock;
+
+    /** The key of the profile records. */
+    struct Key
+    {
+        const std::type_info* type; //!< Dynamic type of the event
+        const void* function;       //!< Function of the event
+        uint32_t context;           //!< Context of the event
+
+        /**
+         * @param [in] other The other key.
+         * @returns \c true if the keys are equal.
+         */
+        bool operator==(const Key& other) const
+        {
+            return type == other.type && function == other.function && context == other.context;
+        }
+    };
+
+    /** Hash of a Key. */
+    struct KeyHash
+    {
+        /**
+         * @param [in] key The key.
+         * @returns The hash of the key.
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            std::size_t h = std::hash<const void*>()(key.type);
+            h = h * 31 + std::hash<const void*>()(key.function);
+            return h * 31 + key.context;
+        }
+    };
+
+    /** The accumulated profile of a key. */
+    struct Stats
+    {
+        uint64_t calls{0};   //!< Number of events
+        uint64_t totalNs{0}; //!< Total time, in ns
+        uint64_t maxNs{0};   //!< Longest event, in ns
+    };
+
+    std::unordered_map<Key, Stats, KeyHash> m_stats; //!< The profile
+    Key m_lastKey;                                   //!< Key of m_last
+    Stats* m_last;                                   //!< Record of the last key
+    Clock::time_point m_start;                       //!< Start of the current event
+};
+
+/********************************************************************
+ *  Implementation of the inline methods.
+ ********************************************************************/
+
+inline void
+EventProfiler::Start(const EventImpl* event, uint32_t context)
+{
+    Key key{&typeid(*event), event->GetFunction(), context};
+    if (m_last == nullptr || !(key == m_lastKey))
+    {
+        m_last = &m_stats[key];
+        m_lastKey = key;
+    }
+    m_start = Clock::now();
+}
+
+inline void
+EventProfiler::Stop()
+{
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count();
+    auto elapsed = static_cast<uint64_t>(ns);
+    m_last->calls++;
+    m_last->totalNs += elapsed;
+    if (elapsed > m_last->maxNs)
+    {
+        m_last->maxNs = elapsed;
+    }
+}
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -14,6 +14,8 @@
 #include "event-impl.h"
 #include "log.h"
 
+#include <algorithm>
+
 /**
  * @file
  * @ingroup scheduler
@@ -225,6 +227,16 @@ HeapScheduler::Remove(const Event& ev)
             NS_ASSERT(m_heap[i].impl == ev.impl);
             Exch(i, Last());
             m_heap.pop_back();
+            if (IsBottom(i))
+            {
+                return;
+            }
+            // The former last event may be earlier than the parent of its new slot
+            while (!IsRoot(i) && IsLessStrictly(i, Parent(i)))
+            {
+                Exch(i, Parent(i));
+                i = Parent(i);
+            }
             TopDown(i);
             return;
         }
@@ -232,4 +244,37 @@ HeapScheduler::Remove(const Event& ev)
     NS_ASSERT(false);
 }
 
+void
+HeapScheduler::RemoveCancelled(std::vector<Scheduler::Event>& removed)
+{
+    NS_LOG_FUNCTION(this);
+    std::size_t last = Root();
+    for (std::size_t i = Root(); i < m_heap.size(); i++)
+    {
+        if (m_heap[i].impl->IsCancelled())
+        {
+            removed.push_back(m_heap[i]);
+        }
+        else
+        {
+            m_heap[last++] = m_heap[i];
+        }
+    }
+    m_heap.resize(last);
+    // Rebuild the heap bottom-up
+    for (std::size_t i = Last() / 2; i >= Root(); i--)
+    {
+        TopDown(i);
+    }
+}
+
+void
+HeapScheduler::GetEvents(std::vector<Scheduler::Event>& events)
+{
+    NS_LOG_FUNCTION(this);
+    std::size_t first = events.size();
+    events.insert(events.end(), m_heap.begin() + Root(), m_heap.end());
+    std::sort(events.begin() + first, events.end());
+}
+
 } // namespace ns3
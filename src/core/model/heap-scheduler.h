@@ -44,13 +44,15 @@ namespace ns3
  *
  * @par Time Complexity
  *
- * Operation    | Amortized %Time | Reason
- * :----------- | :-------------- | :-----
- * Insert()     | Logarithmic     | Heapify
- * IsEmpty()    | Constant        | Explicit queue size
- * PeekNext()   | Constant        | Heap kept sorted
- * Remove()     | Logarithmic     | Search, heapify
- * RemoveNext() | Logarithmic     | Heapify
+ * Operation         | Amortized %Time | Reason
+ * :---------------- | :-------------- | :-----
+ * Insert()          | Logarithmic     | Heapify
+ * IsEmpty()         | Constant        | Explicit queue size
+ * PeekNext()        | Constant        | Heap kept sorted
+ * Remove()          | Logarithmic     | Search, heapify
+ * RemoveNext()      | Logarithmic     | Heapify
+ * RemoveCancelled() | Linear          | Filter and rebuild
+ * GetEvents()       | Linearithmic    | Copy and sort
  *
  * @par Memory Complexity
  *
@@ -79,6 +81,8 @@ class HeapScheduler : public Scheduler
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
     void Remove(const Scheduler::Event& ev) override;
+    void RemoveCancelled(std::vector<Scheduler::Event>& removed) override;
+    void GetEvents(std::vector<Scheduler::Event>& events) override;
 
   private:
     /** Event list type:  vector of Events, managed as a heap. */
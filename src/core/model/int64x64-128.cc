@@ -127,6 +127,14 @@ int64x64_t::Div(const int64x64_t& o)
 uint128_t
 int64x64_t::Udiv(const uint128_t a, const uint128_t b)
 {
+    // An integral divisor, such as a count or a rate, takes a single
+    // division: the long division below skips its 64 trailing zeros,
+    // then divides the remainder once, with the same truncated result.
+    if (!(b & HP_MASK_LO))
+    {
+        return a / (b >> 64);
+    }
+
     uint128_t rem = a;
     uint128_t den = b;
     uint128_t quo = rem / den;
@@ -120,6 +120,14 @@ int64x64_t::Div(const int64x64_t& o)
 cairo_uint128_t
 int64x64_t::Udiv(const cairo_uint128_t a, const cairo_uint128_t b)
 {
+    // An integral divisor, such as a count or a rate, takes a single
+    // division: the long division below skips its 64 trailing zeros,
+    // then divides the remainder once, with the same truncated result.
+    if (b.lo == 0)
+    {
+        return _cairo_uint128_divrem(a, _cairo_uint64_to_uint128(b.hi)).quo;
+    }
+
     cairo_uint128_t den = b;
     cairo_uquorem128_t qr = _cairo_uint128_divrem(a, b);
     cairo_uint128_t result = qr.quo;
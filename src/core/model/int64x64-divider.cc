@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "int64x64-divider.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup highprec
+ * Implementation of the ns3::Int64x64Divider class.
+ */
+
+namespace ns3
+{
+
+Int64x64Divider::Int64x64Divider()
+    : Int64x64Divider(0)
+{
+}
+
+Int64x64Divider::Int64x64Divider(uint64_t divisor)
+    : m_divisor(divisor),
+      m_quotient(0),
+      m_remainder(0),
+      m_magic(0),
+      m_shift1(0),
+      m_shift2(0)
+{
+#if defined(INT64X64_USE_128) && !defined(PYTHON_SCAN)
+    // Divide() falls back to the int64x64_t division without a magic number
+    if (divisor == 0 || divisor >= (1ULL << 63))
+    {
+        return;
+    }
+    // 2^64 = m_quotient * divisor + m_remainder
+    m_quotient = std::numeric_limits<uint64_t>::max() / divisor;
+    m_remainder = std::numeric_limits<uint64_t>::max() % divisor + 1;
+
+    // Granlund and Montgomery, figure 4.1, with N = 64 and l = ceil (log2 (divisor))
+    const int l = std::bit_width(divisor - 1);
+    const uint128_t one = 1;
+    m_magic = static_cast<uint64_t>((((one << l) - divisor) << 64) / divisor + 1);
+    m_shift1 = std::min(l, 1);
+    m_shift2 = std::max(l - 1, 0);
+#endif
+}
+
+uint64_t
+Int64x64Divider::GetDivisor() const
+{
+    return m_divisor;
+}
+
+int64x64_t
+Int64x64Divider::Divide(uint64_t numerator) const
+{
+#if defined(INT64X64_USE_128) && !defined(PYTHON_SCAN)
+    if (m_magic == 0 || numerator >= (1ULL << 63))
+    {
+        return int64x64_t(numerator) / int64x64_t(m_divisor);
+    }
+    // numerator * 2^64 / divisor
+    //   = numerator * m_quotient + numerator * m_remainder / divisor
+    const uint128_t scaled = static_cast<uint128_t>(numerator) * m_remainder;
+    uint64_t fraction;
+    if (scaled >> 64)
+    {
+        fraction = static_cast<uint64_t>(scaled / m_divisor);
+    }
+    else
+    {
+        const auto x = static_cast<uint64_t>(scaled);
+        const auto t = static_cast<uint64_t>((static_cast<uint128_t>(m_magic) * x) >> 64);
+        fraction = (t + ((x - t) >> m_shift1)) >> m_shift2;
+    }
+    const uint128_t quotient = static_cast<uint128_t>(numerator) * m_quotient + fraction;
+    return int64x64_t(static_cast<int64_t>(quotient >> 64), static_cast<uint64_t>(quotient));
+#else
+    return int64x64_t(numerator) / int64x64_t(m_divisor);
+#endif
+}
+
+} // namespace ns3
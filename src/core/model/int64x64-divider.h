@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef INT64X64_DIVIDER_H
+#define INT64X64_DIVIDER_H
+
+#include "int64x64.h"
+
+#include <stdint.h>
+
+/**
+ * @file
+ * @ingroup highprec
+ * Declaration of the ns3::Int64x64Divider class.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup highprec
+ * Repeated divisions of integers by the same integer divisor.
+ *
+ * The divisions by a rate, such as the transmission time of a packet,
+ * divide many numerators by the same divisor.  This class computes the
+ * reciprocal of the divisor once, then replaces each division by
+ * multiplications, with the method of Granlund and Montgomery,
+ * "Division by Invariant Integers using Multiplication" (PLDI 1994).
+ *
+ * The quotient is bit-identical to the int64x64_t division:
+ *
+ * @code
+ *     Int64x64Divider divider (rate);
+ *     NS_ASSERT (divider.Divide (bits) == int64x64_t (bits) / int64x64_t (rate));
+ * @endcode
+ *
+ * Divide() falls back to the int64x64_t division for the divisors
+ * and numerators out of [1, 2^63), or without a native 128-bit
+ * integer type.
+ */
+class Int64x64Divider
+{
+  public:
+    /** Construct a divider by zero, like an int64x64_t division by zero. */
+    Int64x64Divider();
+    /**
+     * Construct a divider, and compute the reciprocal of the divisor.
+     *
+     * @param [in] divisor The divisor.
+     */
+    explicit Int64x64Divider(uint64_t divisor);
+
+    /**
+     * Get the divisor.
+     * @returns The divisor.
+     */
+    uint64_t GetDivisor() const;
+
+    /**
+     * Divide an integer by the divisor.
+     *
+     * @param [in] numerator The numerator.
+     * @returns The truncated Q64.64 quotient, identical to
+     *          `int64x64_t (numerator) / int64x64_t (divisor)`.
+     */
+    int64x64_t Divide(uint64_t numerator) const;
+
+  private:
+    uint64_t m_divisor;   //!< The divisor
+    uint64_t m_quotient;  //!< floor ((2^64 - 1) / divisor)
+    uint64_t m_remainder; //!< 2^64 - m_quotient * divisor, in [1, divisor]
+    uint64_t m_magic;     //!< The multiplier of the 64-bit divisions
+    uint8_t m_shift1;     //!< The first shift of the 64-bit divisions
+    uint8_t m_shift2;     //!< The second shift of the 64-bit divisions
+};
+
+} // namespace ns3
+
+#endif /* INT64X64_DIVIDER_H */
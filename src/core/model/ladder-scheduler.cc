@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_nRungs(0),
+      m_size(0)
+{
+    NS_LOG_FUNCTION(this);
+    // Rungs are never reallocated, so that references to their buckets stay valid
+    m_rungs.reserve(MAX_RUNGS);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::size_t
+LadderScheduler::FindRung(uint64_t ts) const
+{
+    std::size_t i = 0;
+    while (i < m_nRungs && ts < m_rungs[i].currentStart)
+    {
+        ++i;
+    }
+    return i;
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+    }
+    else
+    {
+        std::size_t i = FindRung(ts);
+        if (i < m_nRungs)
+        {
+            Rung& rung = m_rungs[i];
+            std::size_t bucket = (ts - rung.start) / rung.width;
+            NS_ASSERT(bucket >= rung.current && bucket < rung.nBuckets);
+            rung.buckets[bucket].push_back(ev);
+            rung.count++;
+        }
+        else
+        {
+            InsertBottom(ev);
+        }
+    }
+    m_size++;
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+void
+LadderScheduler::InsertBottom(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.key.m_ts << ev.key.m_uid);
+    auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>());
+    m_bottom.insert(it, ev);
+
+    // A crowded bottom makes insertions linear: spread it over a new rung
+    if (m_bottom.size() > THRESHOLD && m_nRungs < MAX_RUNGS &&
+        m_bottom.front().key.m_ts != m_bottom.back().key.m_ts)
+    {
+        uint64_t end = m_nRungs > 0 ? m_rungs[m_nRungs - 1].currentStart : m_topStart;
+        SpawnRung(m_bottom, m_bottom.back().key.m_ts, end);
+    }
+}
+
+void
+LadderScheduler::SpawnRung(Events& events, uint64_t start, uint64_t end)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << end);
+    NS_ASSERT(m_nRungs < MAX_RUNGS && !events.empty() && start < end);
+    if (m_rungs.size() == m_nRungs)
+    {
+        m_rungs.emplace_back();
+    }
+    Rung& rung = m_rungs[m_nRungs++];
+
+    // One bucket per event on average over the actual spread of the events
+    uint64_t span = end - start;
+    uint64_t n = events.size();
+    rung.width = std::max<uint64_t>(1, span / n + (span % n != 0 ? 1 : 0));
+    rung.nBuckets = span / rung.width + (span % rung.width != 0 ? 1 : 0);
+    rung.start = start;
+    rung.current = 0;
+    rung.currentStart = start;
+    rung.count = events.size();
+    if (rung.buckets.size() < rung.nBuckets)
+    {
+        rung.buckets.resize(rung.nBuckets);
+    }
+    for (const auto& ev : events)
+    {
+        rung.buckets[(ev.key.m_ts - start) / rung.width].push_back(ev);
+    }
+    events.clear();
+}
+
+void
+LadderScheduler::FillBottom(Events& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    NS_ASSERT(m_bottom.empty());
+    m_bottom.swap(events);
+    std::sort(m_bottom.begin(), m_bottom.end(), std::greater<>());
+}
+
+void
+LadderScheduler::Refill()
+{
+    NS_LOG_FUNCTION(this);
+    while (m_bottom.empty() && m_size > 0)
+    {
+        if (m_nRungs == 0)
+        {
+            // The ladder is exhausted: the top becomes the first rung
+            NS_ASSERT(!m_top.empty());
+            uint64_t start = m_topMin;
+            m_topStart = m_topMax + 1;
+            if (m_top.size() <= THRESHOLD || m_topMin == m_topMax)
+            {
+                FillBottom(m_top);
+            }
+            else
+            {
+                SpawnRung(m_top, start, m_topStart);
+            }
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.count == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+        while (rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+            rung.currentStart += rung.width;
+        }
+        Events& bucket = rung.buckets[rung.current];
+        uint64_t end = rung.currentStart + rung.width;
+        rung.count -= bucket.size();
+        rung.current++;
+        rung.currentStart = end;
+        if (bucket.size() <= THRESHOLD || rung.width == 1 || m_nRungs == MAX_RUNGS)
+        {
+            FillBottom(bucket);
+        }
+        else
+        {
+            auto first = std::min_element(bucket.begin(), bucket.end());
+            SpawnRung(bucket, first->key.m_ts, end);
+        }
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_bottom.empty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_bottom.empty());
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    m_size--;
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t ts = ev.key.m_ts;
+    Events* events = &m_bottom;
+    Rung* rung = nullptr;
+    if (ts >= m_topStart)
+    {
+        events = &m_top;
+    }
+    else
+    {
+        std::size_t i = FindRung(ts);
+        if (i < m_nRungs)
+        {
+            rung = &m_rungs[i];
+            events = &rung->buckets[(ts - rung->start) / rung->width];
+        }
+    }
+
+    if (events == &m_bottom)
+    {
+        auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>());
+        NS_ASSERT(it != m_bottom.end() && *it == ev);
+        m_bottom.erase(it);
+    }
+    else
+    {
+        // Unsorted container: swap with the last event
+        auto it = std::find(events->begin(), events->end(), ev);
+        NS_ASSERT(it != events->end());
+        *it = events->back();
+        events->pop_back();
+        if (rung != nullptr)
+        {
+            rung->count--;
+        }
+    }
+    m_size--;
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+} // namespace ns3
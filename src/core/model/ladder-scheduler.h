@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are kept in three tiers:
+ *
+ * - **Top**: an unsorted vector of the events far in the future, at or
+ *   after `m_topStart`.
+ * - **Ladder**: a stack of rungs, each an array of unsorted buckets
+ *   of uniform width.  Every rung covers the current bucket of the
+ *   rung above it, with a finer width.
+ * - **Bottom**: a short sorted vector of the earliest events.
+ *
+ * New events are appended to the top, or to the bucket of the first
+ * rung covering their timestamp, or inserted in order in the bottom.
+ * When the bottom is exhausted the next non-empty bucket of the lowest
+ * rung is either sorted into the bottom, if it holds no more than
+ * `THRESHOLD` events, or spread over a new, finer rung.  When the
+ * ladder is exhausted the top becomes the first rung.
+ *
+ * The rung widths are derived from the actual spread of the events
+ * they receive, so that the buckets hold a few events each whatever the
+ * event distribution.  There is no global resize like in the
+ * CalendarScheduler: every event is moved at most once per rung.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Constant        | Append to top or bucket; bounded bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom is kept non-empty
+ * Remove()     | Linear          | Search in top or bucket
+ * RemoveNext() | ~Constant       | Bucket transfers amortized over events
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | `MAX_RUNGS` rungs of buckets     | `std::vector`
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Container type for the events of a tier or bucket. */
+    typedef std::vector<Scheduler::Event> Events;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        /** The buckets; only the first `nBuckets` are in use. */
+        std::vector<Events> buckets;
+        /** Number of buckets in use. */
+        std::size_t nBuckets;
+        /** Bucket width, in time steps. */
+        uint64_t width;
+        /** Start timestamp of the first bucket. */
+        uint64_t start;
+        /** Index of the current bucket. */
+        std::size_t current;
+        /** Start timestamp of the current bucket. */
+        uint64_t currentStart;
+        /** Number of events in the buckets. */
+        std::size_t count;
+    };
+
+    /**
+     * Maximum number of events sorted into the bottom at once;
+     * larger buckets are spread over a new rung.
+     */
+    static constexpr std::size_t THRESHOLD = 50;
+    /** Maximum number of rungs. */
+    static constexpr std::size_t MAX_RUNGS = 8;
+
+    /**
+     * Insert an event in the sorted bottom.
+     *
+     * @param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+    /**
+     * Find the rung covering a timestamp below the top.
+     *
+     * @param [in] ts The timestamp.
+     * @returns The rung index, or the number of rungs for the bottom.
+     */
+    std::size_t FindRung(uint64_t ts) const;
+    /**
+     * Push a new rung spreading a set of events.
+     *
+     * @param [in,out] events The events, which are moved to the rung.
+     * @param [in] start The start timestamp of the rung.
+     * @param [in] end The end timestamp of the rung, excluded.
+     */
+    void SpawnRung(Events& events, uint64_t start, uint64_t end);
+    /**
+     * Sort a set of events into the empty bottom.
+     *
+     * @param [in,out] events The events, which are moved to the bottom.
+     */
+    void FillBottom(Events& events);
+    /** Refill the bottom from the ladder or the top if it is empty. */
+    void Refill();
+
+    /** The unsorted events at or after `m_topStart`. */
+    Events m_top;
+    /** Start timestamp of the top. */
+    uint64_t m_topStart;
+    /** Smallest timestamp in the top. */
+    uint64_t m_topMin;
+    /** Largest timestamp in the top. */
+    uint64_t m_topMax;
+    /** The rungs; only the first `m_nRungs` are in use. */
+    std::vector<Rung> m_rungs;
+    /** Number of rungs in use. */
+    std::size_t m_nRungs;
+    /** The earliest events, sorted in decreasing order. */
+    Events m_bottom;
+    /** Number of events in the queue. */
+    std::size_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -101,4 +101,29 @@ ListScheduler::Remove(const Event& ev)
     NS_ASSERT(false);
 }
 
+void
+ListScheduler::RemoveCancelled(std::vector<Scheduler::Event>& removed)
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = m_events.begin(); i != m_events.end();)
+    {
+        if (i->impl->IsCancelled())
+        {
+            removed.push_back(*i);
+            i = m_events.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void
+ListScheduler::GetEvents(std::vector<Scheduler::Event>& events)
+{
+    NS_LOG_FUNCTION(this);
+    events.insert(events.end(), m_events.begin(), m_events.end());
+}
+
 } // namespace ns3
@@ -35,13 +35,15 @@ class EventImpl;
  *
  * @par Time Complexity
  *
- * Operation    | Amortized %Time | Reason
- * :----------- | :-------------- | :-----
- * Insert()     | Linear          | Linear search in `std::list`
- * IsEmpty()    | Constant        | `std::list::size()`
- * PeekNext()   | Constant        | `std::list::front()`
- * Remove()     | Linear          | Linear search in `std::list`
- * RemoveNext() | Constant        | `std::list::pop_front()`
+ * Operation         | Amortized %Time | Reason
+ * :---------------- | :-------------- | :-----
+ * Insert()          | Linear          | Linear search in `std::list`
+ * IsEmpty()         | Constant        | `std::list::size()`
+ * PeekNext()        | Constant        | `std::list::front()`
+ * Remove()          | Linear          | Linear search in `std::list`
+ * RemoveNext()      | Constant        | `std::list::pop_front()`
+ * RemoveCancelled() | Linear          | `std::list::erase()` while iterating
+ * GetEvents()       | Linear          | Iteration
  *
  * @par Memory Complexity
  *
@@ -71,6 +73,8 @@ class ListScheduler : public Scheduler
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
     void Remove(const Scheduler::Event& ev) override;
+    void RemoveCancelled(std::vector<Scheduler::Event>& removed) override;
+    void GetEvents(std::vector<Scheduler::Event>& events) override;
 
   private:
     /** Event list type: a simple list of Events. */
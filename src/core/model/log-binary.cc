@@ -0,0 +1,969 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "log-binary.h"
+
+#include "environment-variable.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "nstime.h"
+#include "simulator.h"
+#include "time-printer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+
+#ifndef __WIN32__
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file
+ * @ingroup logbinary
+ * Binary logging backend implementation.
+ *
+ * The binary log file starts with a header:
+ * - the magic string "NS3BLOG" and a nul character,
+ * - the format version, as an uint32_t,
+ * - the Time resolution, as an uint32_t.
+ *
+ * It is followed by frames, which start with a type character:
+ * - 'S': a logging statement: its identifier, as an uint32_t, its kind,
+ *   as an uint8_t, and the names of its log component and of its function,
+ *   as strings;
+ * - 'R': records, as their total size, as an uint32_t, followed by the
+ *   records of one thread.
+ *
+ * Each record starts with its size, as an uint32_t, the identifier of its
+ * statement, as an uint32_t, the level, as an int32_t, the prefix flags,
+ * as an uint32_t, a sequence number, as an uint64_t, the time step, as an
+ * int64_t, and the context, as an uint32_t.  The values follow, as a tag
+ * and a value.  The strings are written as their length, as an uint32_t,
+ * and their characters.  The numbers are in the byte order of the host.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup logbinary
+ * The buffers of a record being built.
+ */
+struct LogBinaryBuffers
+{
+    std::vector<char> record; //!< The record.
+    std::ostringstream text;  //!< Formats the values which are not recorded as such.
+    std::stringbuf context;   //!< Receives the output of NS_LOG_APPEND_CONTEXT.
+};
+
+} // namespace ns3
+
+namespace
+{
+
+using ns3::LogBinaryBuffers;
+
+/** The magic string at the start of the binary log files. */
+const char MAGIC[8] = {'N', 'S', '3', 'B', 'L', 'O', 'G', '\0'};
+
+/** The version of the binary log format. */
+const uint32_t VERSION = 1;
+
+/** The size of the ring buffer of each thread, a power of 2. */
+const std::size_t RING_SIZE = 1 << 20;
+
+/** The size of the header of a record. */
+const std::size_t RECORD_HEADER_SIZE = 36;
+
+/** The prefix flags of the records. */
+enum RecordFlags : uint32_t
+{
+    HAS_TIME = 0x1,     //!< The time prefix is printed.
+    HAS_NODE = 0x2,     //!< The node prefix is printed.
+    HAS_FUNCTION = 0x4, //!< The function prefix is printed.
+    HAS_LEVEL = 0x8,    //!< The level prefix is printed.
+};
+
+/** A logging statement. */
+struct Site
+{
+    std::string component; //!< The name of the log component.
+    std::string function;  //!< The name of the function.
+    uint8_t kind;          //!< The kind of statement.
+};
+
+/**
+ * A single producer, single consumer ring buffer of records.
+ *
+ * The thread which logs appends the records at the head, and the
+ * background thread writes them to the file from the tail.
+ */
+struct Ring
+{
+    Ring()
+        : data(RING_SIZE)
+    {
+    }
+
+    std::vector<char> data;           //!< The ring buffer.
+    std::atomic<uint64_t> head{0};    //!< The total number of bytes written.
+    std::atomic<uint64_t> tail{0};    //!< The total number of bytes read.
+    std::atomic<bool> pending{false}; //!< Whether a drain was requested.
+};
+
+/**
+ * The state of the binary logging.
+ *
+ * This is allocated once and never deleted, so that the messages logged
+ * by the static destructors do not use a destroyed object.
+ */
+class BinaryLogger
+{
+  public:
+    /**
+     * Get the binary logger.
+     * @returns The binary logger.
+     */
+    static BinaryLogger& Get()
+    {
+        static auto logger = new BinaryLogger();
+        return *logger;
+    }
+
+    /**
+     * Start or stop writing the records to a file.
+     * @param [in] filename The name of the file, or an empty string to stop.
+     */
+    void SetOutput(const std::string& filename);
+
+    /**
+     * Register a logging statement.
+     * @param [in] site The statement.
+     * @returns The identifier of the statement.
+     */
+    uint32_t Register(Site site);
+
+    /**
+     * Get the ring buffer of the current thread.
+     * @returns The ring buffer.
+     */
+    Ring& GetRing();
+
+    /**
+     * Append a record to the ring buffer of the current thread.
+     * @param [in] record The record.
+     */
+    void Push(const std::vector<char>& record);
+
+    /** Write all the records to the file. */
+    void Flush();
+
+    std::atomic<bool> m_enabled{false};  //!< Whether the binary logging is enabled.
+    std::atomic<uint64_t> m_sequence{0}; //!< The next sequence number.
+    std::atomic<uint64_t> m_dropped{0};  //!< The records dropped since the logging stopped.
+
+  private:
+    BinaryLogger();
+
+#ifndef __WIN32__
+    /**
+     * Prepare the binary logging for a fork(): write all the records, and
+     * keep the background thread and the other loggers out of the state
+     * of the logger until the fork is done.
+     */
+    static void PrepareFork();
+    /** Resume the binary logging in the parent process after a fork(). */
+    static void ResumeParent();
+    /**
+     * Start the binary logging of a child process after a fork(), in a file
+     * of its own, since the background thread of the parent does not exist
+     * in the child process.
+     */
+    static void ResumeChild();
+#endif
+
+    /** Write the records periodically, in the background thread. */
+    void Run();
+    /**
+     * Write the new statements and the records to the file.
+     * The mutex must be locked.
+     */
+    void Drain();
+
+    std::mutex m_mutex;                         //!< Protects the members below.
+    std::condition_variable m_wakeup;           //!< Wakes up the background thread.
+    std::vector<Site> m_sites;                  //!< The registered statements.
+    std::size_t m_sitesWritten{0};              //!< The statements written to the file.
+    std::vector<std::shared_ptr<Ring>> m_rings; //!< The ring buffers of all the threads.
+    std::ofstream m_file;                       //!< The binary log file.
+    std::string m_filename;                     //!< The name of the binary log file.
+    std::thread m_thread;                       //!< The background thread.
+    bool m_stop{false};                         //!< Whether the background thread must stop.
+    std::atomic<uint64_t> m_generation{0};      //!< The number of times logging was started.
+};
+
+/** Stop the binary logging, and write the last records, at the end of the program. */
+struct BinaryLoggerCloser
+{
+    ~BinaryLoggerCloser()
+    {
+        BinaryLogger::Get().SetOutput("");
+    }
+};
+
+/** The closer of the binary log file. */
+BinaryLoggerCloser g_binaryLoggerCloser;
+
+/**
+ * Write a value to a stream.
+ * @param [in] os The stream.
+ * @param [in] value The value.
+ */
+template <typename T>
+void
+Write(std::ostream& os, const T& value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * Write a string to a stream.
+ * @param [in] os The stream.
+ * @param [in] value The string.
+ */
+void
+WriteString(std::ostream& os, const std::string& value)
+{
+    Write<uint32_t>(os, value.size());
+    os.write(value.data(), value.size());
+}
+
+/**
+ * The per thread state of the binary logging.
+ */
+struct ThreadState
+{
+    /**
+     * The buffers of the records being built, one for each message logged
+     * while formatting the values of another one.
+     */
+    std::vector<std::unique_ptr<LogBinaryBuffers>> buffers;
+    std::size_t depth{0};       //!< The number of records being built.
+    std::shared_ptr<Ring> ring; //!< The ring buffer of the thread.
+    uint64_t generation{0};     //!< The generation of the ring buffer.
+};
+
+/**
+ * Get the binary logging state of the current thread.
+ * @returns The state.
+ */
+ThreadState&
+GetThreadState()
+{
+    static thread_local ThreadState state;
+    return state;
+}
+
+/**
+ * Get the mutex which serializes the redirections of \c std::clog to the
+ * records, for NS_LOG_APPEND_CONTEXT.
+ * @returns The mutex.
+ */
+std::recursive_mutex&
+GetContextMutex()
+{
+    static auto mutex = new std::recursive_mutex;
+    return *mutex;
+}
+
+/**
+ * Get the buffers of a new record of the current thread.
+ * @returns The buffers.
+ */
+LogBinaryBuffers&
+PushBuffers()
+{
+    ThreadState& state = GetThreadState();
+    if (state.depth == state.buffers.size())
+    {
+        state.buffers.push_back(std::make_unique<LogBinaryBuffers>());
+    }
+    return *state.buffers[state.depth++];
+}
+
+BinaryLogger::BinaryLogger()
+{
+#ifndef __WIN32__
+    pthread_atfork(&BinaryLogger::PrepareFork,
+                   &BinaryLogger::ResumeParent,
+                   &BinaryLogger::ResumeChild);
+#endif
+    auto [found, filename] = ns3::EnvironmentVariable::Get("NS_LOG_BINARY");
+    if (found && !filename.empty())
+    {
+        SetOutput(filename);
+    }
+}
+
+void
+BinaryLogger::SetOutput(const std::string& filename)
+{
+    if (m_thread.joinable())
+    {
+        m_enabled = false;
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeup.notify_one();
+        m_thread.join();
+        std::lock_guard lock(m_mutex);
+        Drain();
+        m_file.close();
+        m_rings.clear();
+        m_stop = false;
+    }
+    if (filename.empty())
+    {
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+    {
+        NS_FATAL_ERROR("Cannot open the binary log file " << filename);
+    }
+    m_filename = filename;
+    m_file.write(MAGIC, sizeof(MAGIC));
+    Write<uint32_t>(m_file, VERSION);
+    Write<uint32_t>(m_file, ns3::Time::GetResolution());
+    m_sitesWritten = 0;
+    ++m_generation;
+    m_thread = std::thread(&BinaryLogger::Run, this);
+    m_enabled = true;
+}
+
+#ifndef __WIN32__
+void
+BinaryLogger::PrepareFork()
+{
+    BinaryLogger& logger = Get();
+    // In the same order as the loggers
+    GetContextMutex().lock();
+    logger.m_mutex.lock();
+    if (logger.m_file.is_open())
+    {
+        // The child must not write the buffered records again
+        logger.Drain();
+        logger.m_file.flush();
+    }
+}
+
+void
+BinaryLogger::ResumeParent()
+{
+    BinaryLogger& logger = Get();
+    logger.m_mutex.unlock();
+    GetContextMutex().unlock();
+}
+
+void
+BinaryLogger::ResumeChild()
+{
+    BinaryLogger& logger = Get();
+    bool enabled = logger.m_enabled;
+    logger.m_enabled = false;
+    if (logger.m_thread.joinable())
+    {
+        // The background thread of the parent does not exist here: forget
+        // it without joining it, and the state of its condition variable
+        new (&logger.m_thread) std::thread();
+        new (&logger.m_wakeup) std::condition_variable();
+    }
+    if (logger.m_file.is_open())
+    {
+        logger.m_file.close();
+    }
+    logger.m_rings.clear();
+    logger.m_stop = false;
+    // The mutexes were locked by the thread of the parent, which the
+    // recursive mutex does not recognize in the child
+    new (&logger.m_mutex) std::mutex();
+    new (&GetContextMutex()) std::recursive_mutex();
+    if (enabled)
+    {
+        logger.SetOutput(logger.m_filename + "." + std::to_string(getpid()));
+    }
+}
+#endif
+
+uint32_t
+BinaryLogger::Register(Site site)
+{
+    std::lock_guard lock(m_mutex);
+    m_sites.push_back(std::move(site));
+    return m_sites.size() - 1;
+}
+
+Ring&
+BinaryLogger::GetRing()
+{
+    ThreadState& state = GetThreadState();
+    uint64_t generation = m_generation.load(std::memory_order_acquire);
+    if (state.generation != generation || !state.ring)
+    {
+        state.ring = std::make_shared<Ring>();
+        state.generation = generation;
+        std::lock_guard lock(m_mutex);
+        m_rings.push_back(state.ring);
+    }
+    return *state.ring;
+}
+
+void
+BinaryLogger::Push(const std::vector<char>& record)
+{
+    if (record.size() > RING_SIZE / 2)
+    {
+        // Write the records of this thread first, to keep them in order
+        GetRing();
+        std::lock_guard lock(m_mutex);
+        Drain();
+        m_file.put('R');
+        Write<uint32_t>(m_file, record.size());
+        m_file.write(record.data(), record.size());
+        return;
+    }
+
+    uint64_t generation = m_generation.load(std::memory_order_acquire);
+    Ring& ring = GetRing();
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    while (head + record.size() - ring.tail.load(std::memory_order_acquire) > RING_SIZE)
+    {
+        // No background thread makes room once the logging is stopped, or
+        // restarted with new rings: drop the record rather than waiting.
+        if (!m_enabled.load(std::memory_order_acquire) ||
+            m_generation.load(std::memory_order_acquire) != generation)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Wait for the background thread to make room
+        if (!ring.pending.exchange(true))
+        {
+            m_wakeup.notify_one();
+        }
+        std::this_thread::yield();
+    }
+    std::size_t start = head & (RING_SIZE - 1);
+    std::size_t first = std::min(record.size(), RING_SIZE - start);
+    std::memcpy(ring.data.data() + start, record.data(), first);
+    std::memcpy(ring.data.data(), record.data() + first, record.size() - first);
+    ring.head.store(head + record.size(), std::memory_order_release);
+}
+
+void
+BinaryLogger::Flush()
+{
+    std::lock_guard lock(m_mutex);
+    if (m_file.is_open())
+    {
+        Drain();
+        m_file.flush();
+    }
+}
+
+void
+BinaryLogger::Run()
+{
+    std::unique_lock lock(m_mutex);
+    while (!m_stop)
+    {
+        m_wakeup.wait_for(lock, std::chrono::milliseconds(10));
+        Drain();
+    }
+}
+
+void
+BinaryLogger::Drain()
+{
+    for (; m_sitesWritten < m_sites.size(); ++m_sitesWritten)
+    {
+        const Site& site = m_sites[m_sitesWritten];
+        m_file.put('S');
+        Write<uint32_t>(m_file, m_sitesWritten);
+        Write<uint8_t>(m_file, site.kind);
+        WriteString(m_file, site.component);
+        WriteString(m_file, site.function);
+    }
+    for (const auto& ring : m_rings)
+    {
+        ring->pending = false;
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        if (head == tail)
+        {
+            continue;
+        }
+        std::size_t size = head - tail;
+        std::size_t start = tail & (RING_SIZE - 1);
+        std::size_t first = std::min(size, RING_SIZE - start);
+        m_file.put('R');
+        Write<uint32_t>(m_file, size);
+        m_file.write(ring->data.data() + start, first);
+        m_file.write(ring->data.data(), size - first);
+        ring->tail.store(head, std::memory_order_release);
+    }
+}
+
+/**
+ * Read a value from a stream.
+ * @param [in] is The stream.
+ * @param [out] value The value.
+ * @returns \c true if the value was read.
+ */
+template <typename T>
+bool
+Read(std::istream& is, T& value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/**
+ * Read a string from a stream.
+ * @param [in] is The stream.
+ * @param [out] value The string.
+ * @returns \c true if the string was read.
+ */
+bool
+ReadString(std::istream& is, std::string& value)
+{
+    uint32_t size;
+    if (!Read(is, size))
+    {
+        return false;
+    }
+    value.resize(size);
+    return static_cast<bool>(is.read(value.data(), size));
+}
+
+/**
+ * Read a value from a record.
+ * @param [in,out] data The position in the record, which is advanced.
+ * @returns The value.
+ */
+template <typename T>
+T
+Extract(const char*& data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return value;
+}
+
+/**
+ * Print a record as the text its message would have printed.
+ * @param [in] os The output stream.
+ * @param [in] sites The logging statements.
+ * @param [in] record The record.
+ * @returns \c false if the record is invalid.
+ */
+bool
+PrintRecord(std::ostream& os, const std::vector<Site>& sites, const std::string& record)
+{
+    const char* data = record.data();
+    const char* end = data + record.size();
+    Extract<uint32_t>(data); // size
+    auto id = Extract<uint32_t>(data);
+    auto level = Extract<int32_t>(data);
+    auto flags = Extract<uint32_t>(data);
+    Extract<uint64_t>(data); // sequence
+    auto time = Extract<int64_t>(data);
+    auto context = Extract<uint32_t>(data);
+    if (id >= sites.size())
+    {
+        return false;
+    }
+    const Site& site = sites[id];
+
+    std::ostringstream line;
+    line.setf(std::ios_base::boolalpha);
+    if (flags & HAS_TIME)
+    {
+        ns3::DefaultTimePrinter(line, ns3::TimeStep(time));
+        line << " ";
+    }
+    if (flags & HAS_NODE)
+    {
+        if (context == ns3::Simulator::NO_CONTEXT)
+        {
+            line << "-1";
+        }
+        else
+        {
+            line << context;
+        }
+        line << " ";
+    }
+
+    bool prefix = false;
+    auto printPrefix = [&]() {
+        if (prefix)
+        {
+            return;
+        }
+        prefix = true;
+        if (site.kind != ns3::LogBinaryRecord::MESSAGE)
+        {
+            line << site.component << ":" << site.function << "(";
+            return;
+        }
+        if (flags & HAS_FUNCTION)
+        {
+            line << site.component << ":" << site.function << "(): ";
+        }
+        if (flags & HAS_LEVEL)
+        {
+            line << "[" << ns3::LogComponent::GetLevelLabel(static_cast<ns3::LogLevel>(level))
+                 << "] ";
+        }
+    };
+
+    while (data < end)
+    {
+        auto tag = static_cast<ns3::LogBinaryRecord::Tag>(Extract<uint8_t>(data));
+        if (tag != ns3::LogBinaryRecord::CONTEXT)
+        {
+            printPrefix();
+        }
+        switch (tag)
+        {
+        case ns3::LogBinaryRecord::BOOL:
+            line << Extract<bool>(data);
+            break;
+        case ns3::LogBinaryRecord::CHAR:
+            line << Extract<char>(data);
+            break;
+        case ns3::LogBinaryRecord::INT:
+            line << Extract<int64_t>(data);
+            break;
+        case ns3::LogBinaryRecord::UINT:
+            line << Extract<uint64_t>(data);
+            break;
+        case ns3::LogBinaryRecord::DOUBLE:
+            line << Extract<double>(data);
+            break;
+        case ns3::LogBinaryRecord::POINTER:
+            line << reinterpret_cast<const void*>(Extract<uint64_t>(data));
+            break;
+        case ns3::LogBinaryRecord::SEPARATOR:
+            line << ", ";
+            break;
+        case ns3::LogBinaryRecord::STRING:
+        case ns3::LogBinaryRecord::QUOTED:
+        case ns3::LogBinaryRecord::CONTEXT: {
+            auto size = Extract<uint32_t>(data);
+            if (data + size > end)
+            {
+                return false;
+            }
+            std::string_view value(data, size);
+            data += size;
+            if (tag == ns3::LogBinaryRecord::QUOTED)
+            {
+                line << "\"" << value << "\"";
+            }
+            else
+            {
+                line << value;
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    printPrefix();
+    if (site.kind != ns3::LogBinaryRecord::MESSAGE)
+    {
+        line << ")";
+    }
+    os << line.str() << std::endl;
+    return true;
+}
+
+} // unnamed namespace
+
+namespace ns3
+{
+
+void
+LogSetBinaryOutput(const std::string& filename)
+{
+    BinaryLogger::Get().SetOutput(filename);
+}
+
+bool
+LogIsBinaryEnabled()
+{
+    return BinaryLogger::Get().m_enabled.load(std::memory_order_relaxed);
+}
+
+void
+LogBinaryFlush()
+{
+    BinaryLogger::Get().Flush();
+}
+
+uint64_t
+LogBinaryGetDropped()
+{
+    return BinaryLogger::Get().m_dropped.load(std::memory_order_relaxed);
+}
+
+bool
+LogBinaryDecode(std::istream& is, std::ostream& os)
+{
+    char magic[sizeof(MAGIC)];
+    uint32_t version;
+    uint32_t resolution;
+    if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC) ||
+        !Read(is, version) || version != VERSION || !Read(is, resolution) ||
+        resolution >= Time::LAST)
+    {
+        return false;
+    }
+    if (resolution != Time::GetResolution())
+    {
+        Time::SetResolution(static_cast<Time::Unit>(resolution));
+    }
+
+    std::vector<Site> sites;
+    std::vector<std::pair<uint64_t, std::string>> records;
+    char type;
+    while (is.get(type))
+    {
+        if (type == 'S')
+        {
+            uint32_t id;
+            Site site;
+            if (!Read(is, id) || !Read(is, site.kind) || !ReadString(is, site.component) ||
+                !ReadString(is, site.function))
+            {
+                return false;
+            }
+            sites.resize(std::max<std::size_t>(sites.size(), id + 1));
+            sites[id] = site;
+        }
+        else if (type == 'R')
+        {
+            std::string frame;
+            if (!ReadString(is, frame))
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i + RECORD_HEADER_SIZE <= frame.size();)
+            {
+                const char* data = frame.data() + i;
+                auto size = Extract<uint32_t>(data);
+                data += 12;
+                auto sequence = Extract<uint64_t>(data);
+                if (size < RECORD_HEADER_SIZE || i + size > frame.size())
+                {
+                    return false;
+                }
+                records.emplace_back(sequence, frame.substr(i, size));
+                i += size;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // The records of the different threads are merged in the order they
+    // were logged
+    std::stable_sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (const auto& [sequence, record] : records)
+    {
+        if (!PrintRecord(os, sites, record))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t
+LogBinaryRecord::Register(const LogComponent& component, Kind kind, const char* function)
+{
+    return BinaryLogger::Get().Register({component.Name(), function, kind});
+}
+
+LogBinaryRecord::LogBinaryRecord(const LogComponent& component,
+                                 uint32_t site,
+                                 int32_t level,
+                                 Kind kind)
+    : m_buffers(&PushBuffers()),
+      m_data(m_buffers->record),
+      m_text(nullptr),
+      m_clog(nullptr),
+      m_parameters(kind == FUNCTION),
+      m_first(true)
+{
+    uint32_t flags = 0;
+    int64_t time = 0;
+    uint32_t context = Simulator::NO_CONTEXT;
+    if (component.IsEnabled(LOG_PREFIX_TIME) && LogGetTimePrinter() != nullptr)
+    {
+        flags |= HAS_TIME;
+        time = Simulator::Now().GetTimeStep();
+    }
+    if (component.IsEnabled(LOG_PREFIX_NODE) && LogGetNodePrinter() != nullptr)
+    {
+        flags |= HAS_NODE;
+        context = Simulator::GetContext();
+    }
+    if (component.IsEnabled(LOG_PREFIX_FUNC))
+    {
+        flags |= HAS_FUNCTION;
+    }
+    if (component.IsEnabled(LOG_PREFIX_LEVEL))
+    {
+        flags |= HAS_LEVEL;
+    }
+
+    uint64_t sequence = BinaryLogger::Get().m_sequence.fetch_add(1, std::memory_order_relaxed);
+    m_data.resize(RECORD_HEADER_SIZE);
+    char* data = m_data.data() + sizeof(uint32_t);
+    for (auto [value, size] : {std::pair<const void*, std::size_t>{&site, sizeof(site)},
+                               {&level, sizeof(level)},
+                               {&flags, sizeof(flags)},
+                               {&sequence, sizeof(sequence)},
+                               {&time, sizeof(time)},
+                               {&context, sizeof(context)}})
+    {
+        std::memcpy(data, value, size);
+        data += size;
+    }
+}
+
+LogBinaryRecord::~LogBinaryRecord()
+{
+    if (m_text != nullptr)
+    {
+        PutString(STRING, m_buffers->text.view());
+    }
+    if (LogIsBinaryEnabled())
+    {
+        auto size = static_cast<uint32_t>(m_data.size());
+        std::memcpy(m_data.data(), &size, sizeof(size));
+        BinaryLogger::Get().Push(m_data);
+    }
+    --GetThreadState().depth;
+}
+
+void
+LogBinaryRecord::BeginContext()
+{
+    // Unlocked by EndContext(); recursive for the messages logged by the context
+    GetContextMutex().lock();
+    m_clog = std::clog.rdbuf(&m_buffers->context);
+}
+
+void
+LogBinaryRecord::EndContext()
+{
+    std::clog.rdbuf(m_clog);
+    GetContextMutex().unlock();
+    std::stringbuf& context = m_buffers->context;
+    if (context.pubseekoff(0, std::ios_base::cur, std::ios_base::out) > 0)
+    {
+        PutString(CONTEXT, context.str());
+        context.str("");
+    }
+}
+
+LogBinaryRecord&
+LogBinaryRecord::operator<<(std::ostream& (*manipulator)(std::ostream&))
+{
+    Text() << manipulator;
+    return *this;
+}
+
+LogBinaryRecord&
+LogBinaryRecord::operator<<(std::ios_base& (*manipulator)(std::ios_base&))
+{
+    Text() << manipulator;
+    return *this;
+}
+
+void
+LogBinaryRecord::PutString(Tag tag, std::string_view value)
+{
+    std::size_t size = m_data.size();
+    auto length = static_cast<uint32_t>(value.size());
+    m_data.resize(size + 1 + sizeof(length) + length);
+    m_data[size] = static_cast<char>(tag);
+    std::memcpy(m_data.data() + size + 1, &length, sizeof(length));
+    std::memcpy(m_data.data() + size + 1 + sizeof(length), value.data(), length);
+}
+
+std::ostream&
+LogBinaryRecord::Text()
+{
+    if (m_text == nullptr)
+    {
+        std::ostringstream& text = m_buffers->text;
+        text.str("");
+        text.clear();
+        text.flags(std::ios_base::dec | std::ios_base::skipws | std::ios_base::boolalpha);
+        text.precision(6);
+        text.width(0);
+        text.fill(' ');
+        m_text = &text;
+    }
+    return *m_text;
+}
+
+void
+LogBinaryRecord::Separate()
+{
+    if (!m_parameters)
+    {
+        return;
+    }
+    if (m_first)
+    {
+        m_first = false;
+    }
+    else if (m_text != nullptr)
+    {
+        *m_text << ", ";
+    }
+    else
+    {
+        std::size_t size = m_data.size();
+        m_data.resize(size + 1);
+        m_data[size] = static_cast<char>(SEPARATOR);
+    }
+}
+
+} // namespace ns3
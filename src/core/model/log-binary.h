@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3_LOG_BINARY_H
+#define NS3_LOG_BINARY_H
+
+#include <cstring>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup logging
+ * Binary logging backend declarations.
+ */
+
+namespace ns3
+{
+
+class LogComponent;
+struct LogBinaryBuffers;
+
+/**
+ * @ingroup logging
+ * @defgroup logbinary Binary logging
+ *
+ * With binary logging, the NS_LOG_* macros no longer format their
+ * messages on \c std::clog.  Each message is written as a record made of
+ * the identifier of the logging statement, the simulation time, the
+ * context and the raw values of the arguments, in a lock-free ring buffer
+ * of the logging thread.  A background thread writes the records to a
+ * file, which the \c log-decode program in \c utils/ converts to the text
+ * the messages would have printed.
+ *
+ * Binary logging is enabled with LogSetBinaryOutput(), or with the
+ * \c NS_LOG_BINARY environment variable, which gives the name of the
+ * file.  The log components and levels are enabled as usual.
+ *
+ * The integers, floating point numbers, booleans, characters, strings and
+ * pointers are recorded as such.  The other values, and every value after
+ * them in the same message, are formatted in a string when the message is
+ * logged, so that the stream manipulators apply as in the text output.
+ * The time prefix is always printed by DefaultTimePrinter().
+ */
+
+/**
+ * @ingroup logbinary
+ * Start or stop the binary logging.
+ *
+ * The records are written to \pname{filename}, which is truncated.
+ * An empty name stops the binary logging, after all the records have been
+ * written, and the messages are printed on \c std::clog again.
+ *
+ * A child process created with fork(), for example by
+ * Simulator::RunReplications(), writes its records to a file of its own,
+ * named \pname{filename} followed by a dot and its process id.
+ *
+ * @param [in] filename The name of the binary log file.
+ */
+void LogSetBinaryOutput(const std::string& filename);
+
+/**
+ * @ingroup logbinary
+ * Check if the binary logging is enabled.
+ * @returns \c true if the messages are written to a binary log file.
+ */
+bool LogIsBinaryEnabled();
+
+/**
+ * @ingroup logbinary
+ * Wait until all the records logged so far are written to the file.
+ */
+void LogBinaryFlush();
+
+/**
+ * @ingroup logbinary
+ * Get the number of records dropped because the binary logging was stopped
+ * while the logging thread waited for room in its ring buffer.
+ * @returns The number of dropped records.
+ */
+uint64_t LogBinaryGetDropped();
+
+/**
+ * @ingroup logbinary
+ * Convert a binary log to the text the messages would have printed.
+ *
+ * @param [in] is The binary log.
+ * @param [out] os The output stream for the messages.
+ * @returns \c false if \pname{is} is not a valid binary log.
+ */
+bool LogBinaryDecode(std::istream& is, std::ostream& os);
+
+/**
+ * @ingroup logbinary
+ * Whether a type is a vector, which LogBinaryRecord records element by element.
+ * @tparam T The type.
+ */
+template <typename T>
+struct LogBinaryIsVector : std::false_type
+{
+};
+
+/**
+ * @ingroup logbinary
+ * Whether a type is a vector, which LogBinaryRecord records element by element.
+ * @tparam T The type of the elements.
+ * @tparam A The allocator.
+ */
+template <typename T, typename A>
+struct LogBinaryIsVector<std::vector<T, A>> : std::true_type
+{
+};
+
+/**
+ * @ingroup logbinary
+ * A message being recorded by a logging macro.
+ *
+ * The values streamed into the record are appended to a buffer of the
+ * logging thread; the destructor copies the record into the ring buffer.
+ */
+class LogBinaryRecord
+{
+  public:
+    /** The kinds of logging statements. */
+    enum Kind : uint8_t
+    {
+        MESSAGE,         //!< NS_LOG() and the macros of the levels.
+        FUNCTION,        //!< NS_LOG_FUNCTION().
+        FUNCTION_NOARGS, //!< NS_LOG_FUNCTION_NOARGS().
+    };
+
+    /** The types of the recorded values. */
+    enum Tag : uint8_t
+    {
+        BOOL,      //!< A bool.
+        CHAR,      //!< A character.
+        INT,       //!< A signed integer, as an int64_t.
+        UINT,      //!< An unsigned integer, as an uint64_t.
+        DOUBLE,    //!< A floating point number, as a double.
+        STRING,    //!< A string, as its length and characters.
+        QUOTED,    //!< A string printed in quotes.
+        POINTER,   //!< A pointer, as an uint64_t.
+        SEPARATOR, //!< The separator of the parameters of a function.
+        CONTEXT,   //!< The output of NS_LOG_APPEND_CONTEXT, as a string.
+    };
+
+    /**
+     * Register a logging statement.
+     *
+     * @param [in] component The log component of the statement.
+     * @param [in] kind The kind of the statement.
+     * @param [in] function The name of the function of the statement.
+     * @returns The identifier of the statement.
+     */
+    static uint32_t Register(const LogComponent& component, Kind kind, const char* function);
+
+    /**
+     * Start a record.
+     *
+     * @param [in] component The log component of the statement.
+     * @param [in] site The identifier of the statement.
+     * @param [in] level The level of the message.
+     * @param [in] kind The kind of the statement.
+     */
+    LogBinaryRecord(const LogComponent& component, uint32_t site, int32_t level, Kind kind);
+    /** Write the record to the ring buffer. */
+    ~LogBinaryRecord();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogBinaryRecord(const LogBinaryRecord&) = delete;
+    LogBinaryRecord& operator=(const LogBinaryRecord&) = delete;
+
+    /**
+     * Redirect \c std::clog to the record, for NS_LOG_APPEND_CONTEXT.
+     *
+     * This is only done in the files which define NS_LOG_APPEND_CONTEXT.
+     * \c std::clog is shared by all the threads, so that the threads
+     * redirect it one at a time, until EndContext().
+     */
+    void BeginContext();
+    /** Stop redirecting \c std::clog and record what was written. */
+    void EndContext();
+
+    /**
+     * Record a value.
+     *
+     * The value is forwarded unchanged to the \c operator<< of the types
+     * which are formatted as text, some of which take a non-const reference.
+     *
+     * @param [in] value The value.
+     * @returns This record, so it's chainable.
+     */
+    template <typename T>
+        requires(!LogBinaryIsVector<std::remove_cvref_t<T>>::value)
+    LogBinaryRecord& operator<<(T&& value);
+
+    /**
+     * Record the elements of a vector of function parameters.
+     *
+     * @param [in] vector The vector of parameters.
+     * @returns This record, so it's chainable.
+     */
+    template <typename T>
+    LogBinaryRecord& operator<<(const std::vector<T>& vector);
+
+    /**
+     * Apply a stream manipulator.
+     *
+     * @param [in] manipulator The manipulator.
+     * @returns This record, so it's chainable.
+     */
+    LogBinaryRecord& operator<<(std::ostream& (*manipulator)(std::ostream&));
+    /**
+     * Apply a stream manipulator.
+     *
+     * @param [in] manipulator The manipulator.
+     * @returns This record, so it's chainable.
+     */
+    LogBinaryRecord& operator<<(std::ios_base& (*manipulator)(std::ios_base&));
+
+  private:
+    /**
+     * Record a value with its tag.
+     *
+     * @param [in] tag The tag.
+     * @param [in] value The value.
+     */
+    template <typename T>
+    void Put(Tag tag, const T& value);
+    /**
+     * Record a string.
+     *
+     * @param [in] tag The tag.
+     * @param [in] value The string.
+     */
+    void PutString(Tag tag, std::string_view value);
+    /**
+     * Get the stream which formats the rest of the message.
+     * @returns The stream.
+     */
+    std::ostream& Text();
+    /** Record the separator before every function parameter after the first. */
+    void Separate();
+
+    LogBinaryBuffers* m_buffers; //!< The buffers of the record.
+    std::vector<char>& m_data;   //!< The record being built.
+    std::ostream* m_text;        //!< The stream formatting the rest of the message, if any.
+    std::streambuf* m_clog;      //!< The buffer of \c std::clog during NS_LOG_APPEND_CONTEXT.
+    bool m_parameters;           //!< Whether the values are function parameters.
+    bool m_first;                //!< Whether the next parameter is the first.
+};
+
+template <typename T>
+void
+LogBinaryRecord::Put(Tag tag, const T& value)
+{
+    std::size_t size = m_data.size();
+    m_data.resize(size + 1 + sizeof(T));
+    m_data[size] = static_cast<char>(tag);
+    std::memcpy(m_data.data() + size + 1, &value, sizeof(T));
+}
+
+template <typename T>
+    requires(!LogBinaryIsVector<std::remove_cvref_t<T>>::value)
+LogBinaryRecord&
+LogBinaryRecord::operator<<(T&& value)
+{
+    using U = std::remove_cvref_t<T>;
+    Separate();
+    if (m_text != nullptr)
+    {
+        // Once a value has been formatted, the rest of the message is
+        // formatted as well, in case it changed the state of the stream.
+        if constexpr (std::is_arithmetic_v<U>)
+        {
+            if (m_parameters)
+            {
+                *m_text << +value;
+                return *this;
+            }
+        }
+        else if constexpr (std::is_convertible_v<U, std::string>)
+        {
+            if (m_parameters)
+            {
+                *m_text << "\"" << value << "\"";
+                return *this;
+            }
+        }
+        *m_text << std::forward<T>(value);
+    }
+    else if constexpr (std::is_same_v<U, bool>)
+    {
+        // Function parameters are printed with the unary + operator
+        if (m_parameters)
+        {
+            Put<int64_t>(INT, value);
+        }
+        else
+        {
+            Put<bool>(BOOL, value);
+        }
+    }
+    else if constexpr (std::is_same_v<U, char> || std::is_same_v<U, signed char> ||
+                       std::is_same_v<U, unsigned char>)
+    {
+        if (m_parameters)
+        {
+            Put<int64_t>(INT, value);
+        }
+        else
+        {
+            Put<char>(CHAR, static_cast<char>(value));
+        }
+    }
+    else if constexpr (std::is_integral_v<U> && std::is_signed_v<U> && sizeof(U) <= 8)
+    {
+        Put<int64_t>(INT, value);
+    }
+    else if constexpr (std::is_integral_v<U> && std::is_unsigned_v<U> && sizeof(U) <= 8 &&
+                       !std::is_same_v<U, wchar_t> && !std::is_same_v<U, char8_t> &&
+                       !std::is_same_v<U, char16_t> && !std::is_same_v<U, char32_t>)
+    {
+        Put<uint64_t>(UINT, value);
+    }
+    else if constexpr (std::is_same_v<U, double> || std::is_same_v<U, float>)
+    {
+        Put<double>(DOUBLE, value);
+    }
+    else if constexpr (std::is_convertible_v<U, std::string_view>)
+    {
+        PutString(m_parameters ? QUOTED : STRING, value);
+    }
+    else if constexpr (std::is_pointer_v<U> &&
+                       (std::is_object_v<std::remove_pointer_t<U>> ||
+                        std::is_void_v<std::remove_pointer_t<U>>) &&
+                       !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<U>>, signed char> &&
+                       !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<U>>, unsigned char>)
+    {
+        Put<uint64_t>(POINTER, reinterpret_cast<uintptr_t>(value));
+    }
+    else if constexpr (requires { PeekPointer(value); })
+    {
+        // Ptr<T>, which is printed as the pointer
+        Put<uint64_t>(POINTER, reinterpret_cast<uintptr_t>(PeekPointer(value)));
+    }
+    else
+    {
+        Text() << std::forward<T>(value);
+    }
+    return *this;
+}
+
+template <typename T>
+LogBinaryRecord&
+LogBinaryRecord::operator<<(const std::vector<T>& vector)
+{
+    for (const auto& i : vector)
+    {
+        *this << i;
+    }
+    return *this;
+}
+
+} // namespace ns3
+
+#endif /* NS3_LOG_BINARY_H */
@@ -148,6 +148,46 @@
 #define NS_LOG_CONDITION
 #endif
 
+/**
+ * @ingroup logging
+ *
+ * Check if a macro expands to something, such as a NS_LOG_APPEND_CONTEXT
+ * defined by the file.
+ *
+ * @param [in] ... The expansion of the macro.
+ * @returns \c true if the expansion is not empty.
+ * @internal
+ * Logging implementation macro; should not be called directly.
+ */
+#define NS_LOG_IS_DEFINED(...) (false __VA_OPT__(|| true))
+
+/**
+ * @ingroup logging
+ *
+ * Record a message in the binary log.
+ *
+ * @param [in] level The log level.
+ * @param [in] kind The kind of logging statement.
+ * @param [in] msg The values to record.
+ * @internal
+ * Logging implementation macro; should not be called directly.
+ * The local names are prefixed so that they do not hide the variables
+ * used in \pname{msg}.
+ */
+#define NS_LOG_BINARY(level, kind, msg)                                                            \
+    {                                                                                              \
+        static const uint32_t ns3LogBinarySite =                                                   \
+            ns3::LogBinaryRecord::Register(g_log, kind, __FUNCTION__);                             \
+        ns3::LogBinaryRecord ns3LogBinaryRecord(g_log, ns3LogBinarySite, level, kind);             \
+        if constexpr (NS_LOG_IS_DEFINED(NS_LOG_APPEND_CONTEXT))                                    \
+        {                                                                                          \
+            ns3LogBinaryRecord.BeginContext();                                                     \
+            NS_LOG_APPEND_CONTEXT;                                                                 \
+            ns3LogBinaryRecord.EndContext();                                                       \
+        }                                                                                          \
+        ns3LogBinaryRecord << msg;                                                                 \
+    }
+
 /**
  * @ingroup logging
  *
@@ -173,6 +213,11 @@
     {                                                                                              \
         if (g_log.IsEnabled(level))                                                                \
         {                                                                                          \
+            if (ns3::LogIsBinaryEnabled())                                                         \
+            {                                                                                      \
+                NS_LOG_BINARY(level, ns3::LogBinaryRecord::MESSAGE, msg);                          \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -198,6 +243,11 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
+            if (ns3::LogIsBinaryEnabled())                                                         \
+            {                                                                                      \
+                NS_LOG_BINARY(ns3::LOG_FUNCTION, ns3::LogBinaryRecord::FUNCTION_NOARGS, "");       \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -232,6 +282,11 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
+            if (ns3::LogIsBinaryEnabled())                                                         \
+            {                                                                                      \
+                NS_LOG_BINARY(ns3::LOG_FUNCTION, ns3::LogBinaryRecord::FUNCTION, parameters);      \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
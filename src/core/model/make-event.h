@@ -10,6 +10,7 @@
 
 #include "warnings.h"
 
+#include <cstring>
 #include <functional>
 #include <tuple>
 #include <type_traits>
@@ -138,8 +139,22 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_function(function),
+              m_obj(obj),
+              m_arguments(args...)
+        {
+        }
+
+        const void* GetFunction() const override
         {
+            // The first word of a method pointer is the address of the
+            // method or, for a virtual method, its offset in the vtable.
+            const void* function = nullptr;
+            if constexpr (sizeof(MEM) >= sizeof(function))
+            {
+                std::memcpy(&function, &m_function, sizeof(function));
+            }
+            return function;
         }
 
       protected:
@@ -150,10 +165,15 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
       private:
         void Notify() override
         {
-            m_function();
+            std::apply([this](auto&... args) { std::invoke(m_function, m_obj, args...); },
+                       m_arguments);
         }
 
-        std::function<void()> m_function;
+        // The object and the arguments are stored in the event itself,
+        // rather than in a std::function which may allocate its own storage.
+        MEM m_function;
+        OBJ m_obj;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
@@ -172,6 +192,11 @@ MakeEvent(void (*f)(Us...), Ts... args)
         {
         }
 
+        const void* GetFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
       protected:
         ~EventFunctionImpl() override
         {
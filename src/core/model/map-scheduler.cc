@@ -92,6 +92,49 @@ MapScheduler::RemoveNext()
     return ev;
 }
 
+void
+MapScheduler::RemoveNextBatch(std::vector<Scheduler::Event>& batch)
+{
+    NS_LOG_FUNCTION(this);
+    auto begin = m_list.begin();
+    NS_ASSERT(begin != m_list.end());
+    auto end = begin;
+    for (; end != m_list.end() && end->first.m_ts == begin->first.m_ts; ++end)
+    {
+        batch.push_back(Event{end->second, end->first});
+    }
+    m_list.erase(begin, end);
+}
+
+void
+MapScheduler::RemoveCancelled(std::vector<Scheduler::Event>& removed)
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = m_list.begin(); i != m_list.end();)
+    {
+        if (i->second->IsCancelled())
+        {
+            removed.push_back(Event{i->second, i->first});
+            i = m_list.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void
+MapScheduler::GetEvents(std::vector<Scheduler::Event>& events)
+{
+    NS_LOG_FUNCTION(this);
+    events.reserve(events.size() + m_list.size());
+    for (const auto& [key, impl] : m_list)
+    {
+        events.push_back(Event{impl, key});
+    }
+}
+
 void
 MapScheduler::Remove(const Event& ev)
 {
@@ -33,13 +33,16 @@ namespace ns3
  *
  * @par Time Complexity
  *
- * Operation    | Amortized %Time | Reason
- * :----------- | :-------------- | :-----
- * Insert()     | Logarithmic     | `std::map::insert()`
- * IsEmpty()    | Constant        | `std::map::empty()`
- * PeekNext()   | Constant        | `std::map::begin()`
- * Remove()     | Logarithmic     | `std::map::find()`
- * RemoveNext() | Constant        | `std::map::begin()`
+ * Operation         | Amortized %Time | Reason
+ * :---------------- | :-------------- | :-----
+ * Insert()          | Logarithmic     | `std::map::insert()`
+ * IsEmpty()         | Constant        | `std::map::empty()`
+ * PeekNext()        | Constant        | `std::map::begin()`
+ * Remove()          | Logarithmic     | `std::map::find()`
+ * RemoveNext()      | Constant        | `std::map::begin()`
+ * RemoveCancelled() | Linear          | Iteration and `std::map::erase()`
+ * RemoveNextBatch() | Linear in batch | `std::map::erase()` of a range
+ * GetEvents()       | Linear          | Iteration
  *
  * @par Memory Complexity
  *
@@ -69,6 +72,9 @@ class MapScheduler : public Scheduler
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
     void Remove(const Scheduler::Event& ev) override;
+    void RemoveNextBatch(std::vector<Scheduler::Event>& batch) override;
+    void RemoveCancelled(std::vector<Scheduler::Event>& removed) override;
+    void GetEvents(std::vector<Scheduler::Event>& events) override;
 
   private:
     /** Event list type: a Map from EventKey to EventImpl. */
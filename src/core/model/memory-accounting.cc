@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "memory-accounting.h"
+
+#include "log.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
+
+/**
+ * @file
+ * @ingroup memoryaccounting
+ * ns3::MemoryAccounting implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MemoryAccounting");
+
+namespace
+{
+
+/** The accounts, which are never deleted. */
+struct Accounts
+{
+    std::mutex mutex;                                        //!< Protects the containers
+    std::deque<MemoryAccounting::Account> accounts;          //!< The accounts
+    std::map<std::string, MemoryAccounting::Account*> names; //!< The accounts by name
+    /** The accounts by TypeId uid, filled on first use. */
+    std::atomic<MemoryAccounting::Account*> types[UINT16_MAX + 1];
+};
+
+/**
+ * Get the accounts.
+ * @returns The accounts.
+ */
+Accounts&
+GetAccounts()
+{
+    // Leaked, so that the objects destroyed at exit can still be released
+    static auto accounts = new Accounts();
+    return *accounts;
+}
+
+} // unnamed namespace
+
+std::atomic<bool> MemoryAccounting::m_enabled{false};
+
+void
+MemoryAccounting::Enable(bool enable /* = true */)
+{
+    NS_LOG_FUNCTION(enable);
+    m_enabled.store(enable, std::memory_order_relaxed);
+}
+
+MemoryAccounting::Account*
+MemoryAccounting::GetAccount(const std::string& name)
+{
+    NS_LOG_FUNCTION(name);
+    Accounts& accounts = GetAccounts();
+    std::unique_lock lock{accounts.mutex};
+    auto it = accounts.names.find(name);
+    if (it != accounts.names.end())
+    {
+        return it->second;
+    }
+    Account& account = accounts.accounts.emplace_back();
+    account.name = name;
+    accounts.names[name] = &account;
+    return &account;
+}
+
+MemoryAccounting::Account*
+MemoryAccounting::GetAccount(TypeId tid)
+{
+    std::atomic<Account*>& type = GetAccounts().types[tid.GetUid()];
+    Account* account = type.load(std::memory_order_acquire);
+    if (account == nullptr)
+    {
+        account = GetAccount(tid.GetName());
+        account->size = tid.GetSize();
+        type.store(account, std::memory_order_release);
+    }
+    return account;
+}
+
+void
+MemoryAccounting::Allocate(Account* account, std::size_t bytes)
+{
+    account->instances.fetch_add(1, std::memory_order_relaxed);
+    account->allocated.fetch_add(1, std::memory_order_relaxed);
+    int64_t live = account->bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t peak = account->peakBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !account->peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+MemoryAccounting::Release(Account* account, std::size_t bytes)
+{
+    account->instances.fetch_sub(1, std::memory_order_relaxed);
+    account->bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+std::vector<MemoryAccounting::Usage>
+MemoryAccounting::GetUsage()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    std::vector<Usage> usage;
+    Accounts& accounts = GetAccounts();
+    {
+        std::unique_lock lock{accounts.mutex};
+        for (const auto& account : accounts.accounts)
+        {
+            uint64_t allocated = account.allocated.load(std::memory_order_relaxed);
+            if (allocated > 0)
+            {
+                usage.push_back({account.name,
+                                 account.instances.load(std::memory_order_relaxed),
+                                 account.bytes.load(std::memory_order_relaxed),
+                                 account.peakBytes.load(std::memory_order_relaxed),
+                                 allocated});
+            }
+        }
+    }
+    std::stable_sort(usage.begin(), usage.end(), [](const Usage& a, const Usage& b) {
+        return a.bytes > b.bytes;
+    });
+    return usage;
+}
+
+} // namespace ns3
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3_MEMORY_ACCOUNTING_H
+#define NS3_MEMORY_ACCOUNTING_H
+
+#include "type-id.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup memoryaccounting
+ * ns3::MemoryAccounting and ns3::MemoryAccounted declarations.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup debugging
+ * @defgroup memoryaccounting Memory accounting
+ *
+ * Opt-in accounting of the live instances and bytes of the simulation,
+ * per TypeId for the Objects and per subsystem for the packets and
+ * events.  See ShowMemory to print the usage periodically.
+ */
+
+/**
+ * @ingroup memoryaccounting
+ * Count the live instances and bytes of the simulation, by account.
+ *
+ * There is an account for each TypeId of the Objects, counting the size
+ * of the class registered with the TypeId, and for the subsystems which
+ * allocate memory outside of Objects:
+ *
+ * - \c ns3::Packet : the Packet instances,
+ * - \c ns3::Buffer : the data of the packet buffers,
+ * - \c ns3::PacketMetadata : the data of the packet metadata,
+ * - \c ns3::EventImpl : the scheduled events, with their bound arguments.
+ *
+ * The accounting is disabled by default, so that it costs a test of a
+ * flag per allocation.  Only the memory allocated while it is enabled
+ * is counted, until it is released, even if the accounting has been
+ * disabled in the meantime.
+ *
+ * The counters are atomic, so that memory can be accounted by several
+ * threads.
+ */
+class MemoryAccounting
+{
+  public:
+    /** The counters of an account. */
+    struct Account
+    {
+        std::string name;                   //!< Name of the account
+        std::size_t size{0};                //!< Size of the instances of a TypeId
+        std::atomic<int64_t> instances{0};  //!< Live instances
+        std::atomic<int64_t> bytes{0};      //!< Live bytes
+        std::atomic<int64_t> peakBytes{0};  //!< Largest number of live bytes
+        std::atomic<uint64_t> allocated{0}; //!< Total allocated instances
+    };
+
+    /** A snapshot of an account. */
+    struct Usage
+    {
+        std::string name;   //!< Name of the account
+        int64_t instances;  //!< Live instances
+        int64_t bytes;      //!< Live bytes
+        int64_t peakBytes;  //!< Largest number of live bytes
+        uint64_t allocated; //!< Total allocated instances
+    };
+
+    /**
+     * Start or stop the accounting of new allocations.
+     * @param [in] enable Whether to account for the new allocations.
+     */
+    static void Enable(bool enable = true);
+
+    /**
+     * Check if the new allocations are accounted.
+     * @returns \c true if the accounting is enabled.
+     */
+    static bool IsEnabled()
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the account of a subsystem, creating it if needed.
+     *
+     * The accounts are never deleted, so the result can be cached.
+     *
+     * @param [in] name The name of the account.
+     * @returns The account.
+     */
+    static Account* GetAccount(const std::string& name);
+
+    /**
+     * Get the account of the instances of a TypeId, creating it if needed.
+     * @param [in] tid The TypeId.
+     * @returns The account.
+     */
+    static Account* GetAccount(TypeId tid);
+
+    /**
+     * Account for an allocation.
+     * @param [in] account The account.
+     * @param [in] bytes The size of the allocation.
+     */
+    static void Allocate(Account* account, std::size_t bytes);
+
+    /**
+     * Account for the release of an allocation.
+     * @param [in] account The account.
+     * @param [in] bytes The size of the allocation.
+     */
+    static void Release(Account* account, std::size_t bytes);
+
+    /**
+     * Get the usage of the accounts which have been used.
+     * @returns The accounts, by decreasing live bytes.
+     */
+    static std::vector<Usage> GetUsage();
+
+  private:
+    static std::atomic<bool> m_enabled; //!< Whether the accounting is enabled
+};
+
+/**
+ * @ingroup memoryaccounting
+ * A member which accounts for the instances of the class holding it.
+ *
+ * The member counts \c sizeof(T) bytes in the account of the name given
+ * at construction, for the whole lifetime of its holder, including the
+ * copies.
+ *
+ * @tparam T \explicit The class holding the member.
+ */
+template <typename T>
+class MemoryAccounted
+{
+  public:
+    /**
+     * Account for a new instance.
+     * @param [in] name The name of the account, the same for every instance.
+     */
+    explicit MemoryAccounted(const char* name)
+        : m_accounted(MemoryAccounting::IsEnabled())
+    {
+        if (m_accounted)
+        {
+            MemoryAccounting::Allocate(GetAccount(name), sizeof(T));
+        }
+    }
+
+    /** Release the instance. */
+    ~MemoryAccounted()
+    {
+        if (m_accounted)
+        {
+            MemoryAccounting::Release(GetAccount(nullptr), sizeof(T));
+        }
+    }
+
+    // The copies are separate instances: they are built from a name
+    MemoryAccounted(const MemoryAccounted&) = delete;
+    MemoryAccounted& operator=(const MemoryAccounted&) = delete;
+
+  private:
+    /**
+     * Get the account of the class.
+     * @param [in] name The name of the account, on the first call.
+     * @returns The account.
+     */
+    static MemoryAccounting::Account* GetAccount(const char* name)
+    {
+        static MemoryAccounting::Account* account = MemoryAccounting::GetAccount(name);
+        return account;
+    }
+
+    bool m_accounted; //!< Whether this instance is accounted
+};
+
+} // namespace ns3
+
+#endif /* NS3_MEMORY_ACCOUNTING_H */
@@ -12,7 +12,8 @@
 #include "object.h"
 #include "singleton.h"
 
-#include <map>
+#include <string_view>
+#include <unordered_map>
 
 /**
  * @file
@@ -25,6 +26,26 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Names");
 
+/**
+ * @ingroup config
+ * Hash of the names, which also hashes name segments of a path
+ * without copying them.
+ */
+struct NameHash
+{
+    /** Allow lookups with std::string_view keys. */
+    using is_transparent = void;
+
+    /**
+     * @param [in] name The name.
+     * @returns The hash of the name.
+     */
+    std::size_t operator()(std::string_view name) const
+    {
+        return std::hash<std::string_view>()(name);
+    }
+};
+
 /**
  * @ingroup config
  *  Node in the naming tree.
@@ -59,20 +80,29 @@ class NameNode
     /** Destructor. */
     ~NameNode();
 
+    /**
+     * Set the full path of this NameNode and of its children from the
+     * path of its parent.
+     */
+    void UpdatePath();
+
     /** The parent NameNode. */
     NameNode* m_parent;
     /** The name of this NameNode. */
     std::string m_name;
+    /** The full path of this NameNode, cached for FindPath(). */
+    std::string m_path;
     /** The object corresponding to this NameNode. */
     Ptr<Object> m_object;
 
     /** Children of this NameNode. */
-    std::map<std::string, NameNode*> m_nameMap;
+    std::unordered_map<std::string, NameNode*, NameHash, std::equal_to<>> m_nameMap;
 };
 
 NameNode::NameNode()
     : m_parent(nullptr),
       m_name(""),
+      m_path(""),
       m_object(nullptr)
 {
 }
@@ -81,6 +111,7 @@ NameNode::NameNode(const NameNode& nameNode)
 {
     m_parent = nameNode.m_parent;
     m_name = nameNode.m_name;
+    m_path = nameNode.m_path;
     m_object = nameNode.m_object;
     m_nameMap = nameNode.m_nameMap;
 }
@@ -90,6 +121,7 @@ NameNode::operator=(const NameNode& rhs)
 {
     m_parent = rhs.m_parent;
     m_name = rhs.m_name;
+    m_path = rhs.m_path;
     m_object = rhs.m_object;
     m_nameMap = rhs.m_nameMap;
     return *this;
@@ -101,6 +133,7 @@ NameNode::NameNode(NameNode* parent, std::string name, Ptr<Object> object)
       m_object(object)
 {
     NS_LOG_FUNCTION(this << parent << name << object);
+    UpdatePath();
 }
 
 NameNode::~NameNode()
@@ -108,6 +141,17 @@ NameNode::~NameNode()
     NS_LOG_FUNCTION(this);
 }
 
+void
+NameNode::UpdatePath()
+{
+    NS_LOG_FUNCTION(this);
+    m_path = (m_parent ? m_parent->m_path : "") + "/" + m_name;
+    for (auto& child : m_nameMap)
+    {
+        child.second->UpdatePath();
+    }
+}
+
 /**
  * @ingroup config
  * The singleton root Names object.
@@ -259,13 +303,16 @@ class NamesPriv : public Singleton<NamesPriv>
      * @param [in] name The name to search for.
      * @returns \c true if \c name already exists as a child of \c node.
      */
-    bool IsDuplicateName(NameNode* node, std::string name);
+    bool IsDuplicateName(NameNode* node, std::string_view name);
 
     /** The root NameNode. */
     NameNode m_root;
 
-    /** Map from object pointers to their NameNodes. */
-    std::map<Ptr<Object>, NameNode*> m_objectMap;
+    /**
+     * Map from object pointers to their NameNodes.  The NameNodes hold
+     * a reference to their object, so the map does not.
+     */
+    std::unordered_map<const Object*, NameNode*> m_objectMap;
 };
 
 NamesPriv::NamesPriv()
@@ -274,6 +321,7 @@ NamesPriv::NamesPriv()
 
     m_root.m_parent = nullptr;
     m_root.m_name = "Names";
+    m_root.m_path = "/Names";
     m_root.m_object = nullptr;
 }
 
@@ -282,6 +330,7 @@ NamesPriv::~NamesPriv()
     NS_LOG_FUNCTION(this);
     Clear();
     m_root.m_name = "";
+    m_root.m_path = "";
 }
 
 void
@@ -302,6 +351,7 @@ NamesPriv::Clear()
 
     m_root.m_parent = nullptr;
     m_root.m_name = "Names";
+    m_root.m_path = "/Names";
     m_root.m_object = nullptr;
     m_root.m_nameMap.clear();
 }
@@ -410,7 +460,7 @@ NamesPriv::Add(Ptr<Object> context, std::string name, Ptr<Object> object)
 
     auto newNode = new NameNode(node, name, object);
     node->m_nameMap[name] = newNode;
-    m_objectMap[object] = newNode;
+    m_objectMap[PeekPointer(object)] = newNode;
 
     return true;
 }
@@ -533,6 +583,7 @@ NamesPriv::Rename(Ptr<Object> context, std::string oldname, std::string newname)
         NameNode* changeNode = i->second;
         node->m_nameMap.erase(i);
         changeNode->m_name = newname;
+        changeNode->UpdatePath();
         node->m_nameMap[newname] = changeNode;
         return true;
     }
@@ -543,7 +594,7 @@ NamesPriv::FindName(Ptr<Object> object)
 {
     NS_LOG_FUNCTION(this << object);
 
-    auto i = m_objectMap.find(object);
+    auto i = m_objectMap.find(PeekPointer(object));
     if (i == m_objectMap.end())
     {
         NS_LOG_LOGIC("Object does not exist in object map");
@@ -561,7 +612,7 @@ NamesPriv::FindPath(Ptr<Object> object)
 {
     NS_LOG_FUNCTION(this << object);
 
-    auto i = m_objectMap.find(object);
+    auto i = m_objectMap.find(PeekPointer(object));
     if (i == m_objectMap.end())
     {
         NS_LOG_LOGIC("Object does not exist in object map");
@@ -572,15 +623,8 @@ NamesPriv::FindPath(Ptr<Object> object)
     NS_ASSERT_MSG(p,
                   "NamesPriv::FindFullName(): Internal error: Invalid NameNode pointer from map");
 
-    std::string path;
-
-    do
-    {
-        path = "/" + p->m_name + path;
-        NS_LOG_LOGIC("path is " << path);
-    } while ((p = p->m_parent) != nullptr);
-
-    return path;
+    NS_LOG_LOGIC("path is " << p->m_path);
+    return p->m_path;
 }
 
 Ptr<Object>
@@ -602,19 +646,17 @@ NamesPriv::Find(std::string path)
     //
 
     NS_LOG_FUNCTION(this << path);
-    std::string namespaceName = "/Names/";
-    std::string remaining;
+    std::string_view namespaceName = "/Names/";
+    std::string_view remaining = path;
 
-    std::string::size_type offset = path.find(namespaceName);
-    if (offset == 0)
+    if (remaining.substr(0, namespaceName.size()) == namespaceName)
     {
         NS_LOG_LOGIC(path << " is a fully qualified name");
-        remaining = path.substr(namespaceName.size());
+        remaining.remove_prefix(namespaceName.size());
     }
     else
     {
         NS_LOG_LOGIC(path << " begins with a relative name");
-        remaining = path;
     }
 
     NameNode* node = &m_root;
@@ -624,57 +666,39 @@ NamesPriv::Find(std::string path)
     // the /Names name space and we have eaten the leading slash. e.g.,
     // remaining = "ClientNode/eth0"
     //
-    // The start of the search is always at the root of the name space.
+    // The start of the search is always at the root of the name space.  The
+    // segments are looked up in place, without copying them.
     //
     for (;;)
     {
         NS_LOG_LOGIC("Looking for the object of name " << remaining);
-        offset = remaining.find('/');
-        if (offset == std::string::npos)
+        std::string_view::size_type offset = remaining.find('/');
+        std::string_view segment = remaining.substr(0, offset);
+
+        auto i = node->m_nameMap.find(segment);
+        if (i == node->m_nameMap.end())
         {
-            //
-            // There are no remaining slashes so this is the last segment of the
-            // specified name.  We're done when we find it
-            //
-            auto i = node->m_nameMap.find(remaining);
-            if (i == node->m_nameMap.end())
-            {
-                NS_LOG_LOGIC("Name does not exist in name map");
-                return nullptr;
-            }
-            else
-            {
-                NS_LOG_LOGIC("Name parsed, found object");
-                return i->second->m_object;
-            }
+            NS_LOG_LOGIC("Name does not exist in name map");
+            return nullptr;
         }
-        else
+        if (offset == std::string_view::npos)
         {
             //
-            // There are more slashes so this is an intermediate segment of the
-            // specified name.  We need to "recurse" when we find this segment.
+            // There are no remaining slashes so this is the last segment of the
+            // specified name.  We're done when we find it
             //
-            offset = remaining.find('/');
-            std::string segment = remaining.substr(0, offset);
-
-            auto i = node->m_nameMap.find(segment);
-            if (i == node->m_nameMap.end())
-            {
-                NS_LOG_LOGIC("Name does not exist in name map");
-                return nullptr;
-            }
-            else
-            {
-                node = i->second;
-                remaining = remaining.substr(offset + 1);
-                NS_LOG_LOGIC("Intermediate segment parsed");
-                continue;
-            }
+            NS_LOG_LOGIC("Name parsed, found object");
+            return i->second->m_object;
         }
-    }
 
-    NS_ASSERT_MSG(node, "NamesPriv::Find(): Internal error:  this can't happen");
-    return nullptr;
+        //
+        // There are more slashes so this is an intermediate segment of the
+        // specified name.  We need to "recurse" when we find this segment.
+        //
+        node = i->second;
+        remaining.remove_prefix(offset + 1);
+        NS_LOG_LOGIC("Intermediate segment parsed");
+    }
 }
 
 Ptr<Object>
@@ -729,7 +753,7 @@ NamesPriv::IsNamed(Ptr<Object> object)
 {
     NS_LOG_FUNCTION(this << object);
 
-    auto i = m_objectMap.find(object);
+    auto i = m_objectMap.find(PeekPointer(object));
     if (i == m_objectMap.end())
     {
         NS_LOG_LOGIC("Object does not exist in object map, returning NameNode 0");
@@ -743,7 +767,7 @@ NamesPriv::IsNamed(Ptr<Object> object)
 }
 
 bool
-NamesPriv::IsDuplicateName(NameNode* node, std::string name)
+NamesPriv::IsDuplicateName(NameNode* node, std::string_view name)
 {
     NS_LOG_FUNCTION(this << node << name);
 
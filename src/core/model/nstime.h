@@ -516,6 +516,20 @@ class Time
             return Time();
         }
 
+        // Optimization: an integral value in a coarser unit, such as
+        // Seconds (1.0), scales exactly as in FromInteger, without the
+        // conversion to int64x64_t.  The bound keeps the product below
+        // the overflow check of int64x64_t::Mul.
+        Information* info = PeekInformation(unit);
+        if (info->isValid && info->fromMul && std::fabs(value) * info->factor < 0x1p62)
+        {
+            auto integral = static_cast<int64_t>(value);
+            if (integral == value)
+            {
+                return Time(integral * info->factor);
+            }
+        }
+
         return From(int64x64_t(value), unit);
     }
 
@@ -37,11 +37,13 @@
     {                                                                                              \
         Object##type##RegistrationClass()                                                          \
         {                                                                                          \
-            NS_WARNING_PUSH_DEPRECATED;                                                            \
-            ns3::TypeId tid = type::GetTypeId();                                                   \
-            tid.SetSize(sizeof(type));                                                             \
-            tid.GetParent();                                                                       \
-            NS_WARNING_POP;                                                                        \
+            ns3::TypeId::Register(#type, []() {                                                    \
+                NS_WARNING_PUSH_DEPRECATED;                                                        \
+                ns3::TypeId tid = type::GetTypeId();                                               \
+                tid.SetSize(sizeof(type));                                                         \
+                tid.GetParent();                                                                   \
+                NS_WARNING_POP;                                                                    \
+            });                                                                                    \
         }                                                                                          \
     } Object##type##RegistrationVariable
 
@@ -76,9 +78,11 @@
     {                                                                                              \
         Object##type##param##RegistrationClass()                                                   \
         {                                                                                          \
-            ns3::TypeId tid = type<param>::GetTypeId();                                            \
-            tid.SetSize(sizeof(type<param>));                                                      \
-            tid.GetParent();                                                                       \
+            ns3::TypeId::Register(#type "<" #param ">", []() {                                     \
+                ns3::TypeId tid = type<param>::GetTypeId();                                        \
+                tid.SetSize(sizeof(type<param>));                                                  \
+                tid.GetParent();                                                                   \
+            });                                                                                    \
         }                                                                                          \
     } Object##type##param##RegistrationVariable
 
@@ -114,9 +118,11 @@
     {                                                                                              \
         Object##type##param1##param2##RegistrationClass()                                          \
         {                                                                                          \
-            ns3::TypeId tid = type<param1, param2>::GetTypeId();                                   \
-            tid.SetSize(sizeof(type<param1, param2>));                                             \
-            tid.GetParent();                                                                       \
+            ns3::TypeId::Register(#type "<" #param1 "," #param2 ">", []() {                        \
+                ns3::TypeId tid = type<param1, param2>::GetTypeId();                               \
+                tid.SetSize(sizeof(type<param1, param2>));                                         \
+                tid.GetParent();                                                                   \
+            });                                                                                    \
         }                                                                                          \
     } Object##type##param1##param2##RegistrationVariable
 
@@ -7,7 +7,10 @@
  */
 #include "object-factory.h"
 
+#include "environment-variable.h"
 #include "log.h"
+#include "pointer.h"
+#include "string.h"
 
 #include <sstream>
 
@@ -32,6 +35,7 @@ ObjectFactory::SetTypeId(TypeId tid)
 {
     NS_LOG_FUNCTION(this << tid.GetName());
     m_tid = tid;
+    Recompile();
 }
 
 void
@@ -39,6 +43,7 @@ ObjectFactory::SetTypeId(std::string tid)
 {
     NS_LOG_FUNCTION(this << tid);
     m_tid = TypeId::LookupByName(tid);
+    Recompile();
 }
 
 bool
@@ -69,6 +74,7 @@ ObjectFactory::DoSet(const std::string& name, const AttributeValue& value)
         return;
     }
     m_parameters.Add(name, info.checker, value.Copy());
+    Recompile();
 }
 
 TypeId
@@ -85,16 +91,139 @@ ObjectFactory::Create() const
     NS_ASSERT_MSG(
         m_tid.GetUid(),
         "ObjectFactory::Create - can't use an ObjectFactory without setting a TypeId first.");
-    Callback<ObjectBase*> cb = m_tid.GetConstructor();
-    ObjectBase* base = cb();
+    return DoCreate(*Compile());
+}
+
+Ptr<const ObjectFactory::Plan>
+ObjectFactory::Compile() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(
+        m_tid.GetUid(),
+        "ObjectFactory::Compile - can't use an ObjectFactory without setting a TypeId first.");
+    uint64_t changes = TypeId::GetAttributeChangeCount();
+    if (m_plan && m_plan->m_attributeChanges == changes)
+    {
+        return m_plan;
+    }
+
+    Ptr<Plan> plan = ns3::Create<Plan>();
+    plan->m_tid = m_tid;
+    plan->m_constructor = m_tid.GetConstructor();
+    plan->m_attributeChanges = changes;
+
+    // Resolve the values as ObjectBase::ConstructSelf() does
+    TypeId tid = m_tid;
+    do
+    {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            Ptr<const AttributeValue> value = m_parameters.Find(info.checker);
+            if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+            {
+                if (!value)
+                {
+                    continue;
+                }
+                NS_FATAL_ERROR("Attribute name=" << info.name << " tid=" << tid.GetName()
+                                                 << ": initial value cannot be set using "
+                                                    "attributes");
+            }
+            if (!value)
+            {
+                auto [found, val] =
+                    EnvironmentVariable::Get("NS_ATTRIBUTE_DEFAULT", tid.GetAttributeFullName(i));
+                if (found)
+                {
+                    value = ns3::Create<StringValue>(val);
+                }
+            }
+            if (!value)
+            {
+                value = info.initialValue;
+            }
+
+            Plan::Step step{info.accessor, info.checker, value, true};
+            if (!info.checker->Check(*value))
+            {
+                if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+                {
+                    // Each Object gets its own pointed-to Object
+                    step.checked = false;
+                }
+                else
+                {
+                    step.value = info.checker->CreateValidValue(*value);
+                    if (!step.value)
+                    {
+                        // The value can not be set, as in ObjectBase::ConstructSelf()
+                        continue;
+                    }
+                }
+            }
+            plan->m_steps.push_back(step);
+        }
+        tid = tid.GetParent();
+    } while (tid != ObjectBase::GetTypeId());
+
+#ifndef NS3_MTP
+    m_plan = plan;
+#endif
+    return plan;
+}
+
+void
+ObjectFactory::Recompile()
+{
+    NS_LOG_FUNCTION(this);
+    m_plan = nullptr;
+#ifdef NS3_MTP
+    // The partitions of a multithreaded simulation may share a factory,
+    // so that Compile() does not store the plan; it is compiled here,
+    // while the factory is configured, instead.
+    m_plan = Compile();
+#endif
+}
+
+Ptr<Object>
+ObjectFactory::DoCreate(const Plan& plan)
+{
+    NS_LOG_FUNCTION(&plan);
+    ObjectBase* base = plan.m_constructor();
     auto derived = dynamic_cast<Object*>(base);
     NS_ASSERT(derived != nullptr);
-    derived->SetTypeId(m_tid);
-    derived->Construct(m_parameters);
+    derived->SetTypeId(plan.m_tid);
+    for (const auto& step : plan.m_steps)
+    {
+        if (step.checked)
+        {
+            step.accessor->Set(derived, *step.value);
+        }
+        else if (Ptr<AttributeValue> v = step.checker->CreateValidValue(*step.value))
+        {
+            step.accessor->Set(derived, *v);
+        }
+    }
+    derived->NotifyConstructionCompleted();
     Ptr<Object> object = Ptr<Object>(derived, false);
     return object;
 }
 
+Ptr<Object>
+ObjectFactory::Plan::Create() const
+{
+    NS_LOG_FUNCTION(this);
+    return DoCreate(*this);
+}
+
+TypeId
+ObjectFactory::Plan::GetTypeId() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_tid;
+}
+
 std::ostream&
 operator<<(std::ostream& os, const ObjectFactory& factory)
 {
@@ -178,6 +307,7 @@ operator>>(std::istream& is, ObjectFactory& factory)
                 else
                 {
                     factory.m_parameters.Add(name, info.checker, val);
+                    factory.Recompile();
                 }
             }
         }
@@ -9,9 +9,13 @@
 #define OBJECT_FACTORY_H
 
 #include "attribute-construction-list.h"
+#include "callback.h"
 #include "object.h"
+#include "simple-ref-count.h"
 #include "type-id.h"
 
+#include <vector>
+
 /**
  * @file
  * @ingroup object
@@ -120,7 +124,90 @@ class ObjectFactory
     template <typename T>
     Ptr<T> Create() const;
 
+    /**
+     * @brief An immutable plan to construct Objects, compiled by
+     * ObjectFactory::Compile().
+     *
+     * The plan holds the accessor and the value of each attribute to set
+     * at construction, in the order of ObjectBase::ConstructSelf(), with
+     * the values already resolved from the factory, the environment or
+     * the attribute defaults, and already checked and converted from
+     * strings, so that creating an Object only calls the accessors.
+     * Values which create an Object, such as a PointerValue given as a
+     * string, are still converted for each created Object, so that
+     * each gets its own instance.
+     *
+     * A plan does not follow the later changes to the attribute
+     * defaults; ObjectFactory::Create() recompiles its plan when the
+     * defaults change.
+     */
+    class Plan : public SimpleRefCount<Plan>
+    {
+      public:
+        /**
+         * Create an Object instance of the compiled TypeId.
+         *
+         * @returns A new object instance.
+         */
+        Ptr<Object> Create() const;
+        /**
+         * Create an Object instance of the requested type.
+         *
+         * @tparam T \explicit The requested Object type.
+         * @returns A new object instance.
+         */
+        template <typename T>
+        Ptr<T> Create() const;
+        /**
+         * Get the TypeId which will be created by this plan.
+         * @returns The TypeId.
+         */
+        TypeId GetTypeId() const;
+
+      private:
+        friend class ObjectFactory;
+
+        /** An attribute to set at construction. */
+        struct Step
+        {
+            Ptr<const AttributeAccessor> accessor; //!< The attribute accessor
+            Ptr<const AttributeChecker> checker;   //!< The attribute checker
+            Ptr<const AttributeValue> value;       //!< The value to set
+            bool checked;                          //!< Whether value can be set as is
+        };
+
+        TypeId m_tid;                         //!< The TypeId to create
+        Callback<ObjectBase*> m_constructor;  //!< The constructor of the TypeId
+        std::vector<Step> m_steps;            //!< The attributes to set
+        uint64_t m_attributeChanges;          //!< The attribute changes compiled
+    };
+
+    /**
+     * Compile the configuration of this factory into a construction plan.
+     *
+     * The plan is cached by the factory, and used by Create(), until the
+     * configuration of the factory or the attribute defaults change.
+     * Creating many Objects from a factory, as the helpers do, thus
+     * resolves the attributes only once.
+     *
+     * With NS3_MTP, the partitions may create Objects from a shared
+     * factory concurrently, so that the plan is compiled when the factory
+     * is configured, and this method does not change the factory: after
+     * a change of the attribute defaults, it compiles a new plan for each
+     * call.
+     *
+     * @returns The construction plan.
+     */
+    Ptr<const Plan> Compile() const;
+
   private:
+    /**
+     * Create an Object following a construction plan.
+     *
+     * @param [in] plan The construction plan.
+     * @returns A new object instance.
+     */
+    static Ptr<Object> DoCreate(const Plan& plan);
     /**
      * Set an attribute to be set during construction.
      *
@@ -128,6 +215,11 @@ class ObjectFactory
      * @param [in] value The value of the attribute to set.
      */
     void DoSet(const std::string& name, const AttributeValue& value);
+    /**
+     * Drop the cached construction plan after a change of the
+     * configuration. With NS3_MTP, compile the new plan.
+     */
+    void Recompile();
     /**
      * Print the factory configuration on an output stream.
      *
@@ -158,6 +250,11 @@ class ObjectFactory
      * objects by this factory.
      */
     AttributeConstructionList m_parameters;
+    /**
+     * The cached construction plan, if any. With NS3_MTP, only the
+     * methods which configure the factory change it.
+     */
+    mutable Ptr<const Plan> m_plan;
 };
 
 std::ostream& operator<<(std::ostream& os, const ObjectFactory& factory);
@@ -201,6 +298,18 @@ ObjectFactory::Create() const
     return obj;
 }
 
+template <typename T>
+Ptr<T>
+ObjectFactory::Plan::Create() const
+{
+    Ptr<Object> object = Create();
+    auto obj = object->GetObject<T>();
+    NS_ASSERT_MSG(obj != nullptr,
+                  "ObjectFactory::Plan::Create error: incompatible types ("
+                      << T::GetTypeId().GetName() << " and " << object->GetInstanceTypeId() << ")");
+    return obj;
+}
+
 template <typename... Args>
 ObjectFactory::ObjectFactory(const std::string& typeId, Args&&... args)
 {
@@ -12,9 +12,11 @@
 #include "assert.h"
 #include "attribute.h"
 #include "log.h"
+#include "memory-accounting.h"
 #include "object-factory.h"
 #include "string.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
@@ -37,6 +39,27 @@ NS_LOG_COMPONENT_DEFINE("Object");
 
 NS_OBJECT_ENSURE_REGISTERED(Object);
 
+namespace
+{
+
+/** The number of GetObject() lookups found in the cache of the aggregates. */
+uint64_t g_getObjectCacheHits = 0;
+/** The number of GetObject() lookups which searched the aggregates. */
+uint64_t g_getObjectCacheMisses = 0;
+
+} // unnamed namespace
+
+void
+Object::Aggregates::ClearCache()
+{
+    cacheNext = 0;
+    for (uint32_t i = 0; i < GET_OBJECT_CACHE_SIZE; i++)
+    {
+        cacheTids[i] = 0;
+        cacheObjects[i] = nullptr;
+    }
+}
+
 Object::AggregateIterator::AggregateIterator()
     : m_object(nullptr),
       m_current(0)
@@ -97,18 +120,25 @@ Object::Object()
     : m_tid(Object::GetTypeId()),
       m_disposed(false),
       m_initialized(false),
+      m_accounted(false),
       m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
       m_getObjectCount(0)
 {
     NS_LOG_FUNCTION(this);
     m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
+    m_aggregates->ClearCache();
 }
 
 Object::~Object()
 {
     // remove this object from the aggregate list
     NS_LOG_FUNCTION(this);
+    if (m_accounted)
+    {
+        MemoryAccounting::Account* account = MemoryAccounting::GetAccount(m_tid);
+        MemoryAccounting::Release(account, std::max(account->size, sizeof(Object)));
+    }
     uint32_t n = m_aggregates->n;
     for (uint32_t i = 0; i < n; i++)
     {
@@ -121,6 +151,7 @@ Object::~Object()
             m_aggregates->n--;
         }
     }
+    m_aggregates->ClearCache();
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
@@ -135,11 +166,13 @@ Object::Object(const Object& o)
     : m_tid(o.m_tid),
       m_disposed(false),
       m_initialized(false),
+      m_accounted(false),
       m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
       m_getObjectCount(0)
 {
     m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
+    m_aggregates->ClearCache();
 }
 
 void
@@ -155,7 +188,24 @@ Object::DoGetObject(TypeId tid) const
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(CheckLoose());
 
-    // First check if the object is in the normal aggregates.
+#ifndef NS3_MTP
+    // First check if the object was found by a previous lookup.
+    // The partitions of a multithreaded simulation may look up the
+    // objects shared with other partitions concurrently, so that the
+    // cache, and the sort of the aggregates below, are disabled with
+    // NS3_MTP: the lookups then leave the aggregates unchanged.
+    for (uint32_t i = 0; i < GET_OBJECT_CACHE_SIZE; i++)
+    {
+        if (m_aggregates->cacheTids[i] == tid.GetUid())
+        {
+            g_getObjectCacheHits++;
+            return m_aggregates->cacheObjects[i];
+        }
+    }
+    g_getObjectCacheMisses++;
+#endif
+
+    // Then check if the object is in the normal aggregates.
     uint32_t n = m_aggregates->n;
     TypeId objectTid = Object::GetTypeId();
     for (uint32_t i = 0; i < n; i++)
@@ -168,6 +218,7 @@ Object::DoGetObject(TypeId tid) const
         }
         if (cur == tid)
         {
+#ifndef NS3_MTP
             // This is an attempt to 'cache' the result of this lookup.
             // the idea is that if we perform a lookup for a TypeId on this object,
             // we are likely to perform the same lookup later so, we make sure
@@ -178,6 +229,13 @@ Object::DoGetObject(TypeId tid) const
             current->m_getObjectCount++;
             // then, update the sort
             UpdateSortedArray(m_aggregates, i);
+            // remember the match for all the aggregates; the unidirectional
+            // aggregates below are not cached since they are not shared.
+            uint32_t next = m_aggregates->cacheNext;
+            m_aggregates->cacheTids[next] = tid.GetUid();
+            m_aggregates->cacheObjects[next] = current;
+            m_aggregates->cacheNext = (next + 1) % GET_OBJECT_CACHE_SIZE;
+#endif
             // finally, return the match
             return const_cast<Object*>(current);
         }
@@ -308,6 +366,7 @@ Object::AggregateObject(Ptr<Object> o)
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
     auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
     aggregates->n = total;
+    aggregates->ClearCache();
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -421,12 +480,37 @@ Object::GetAggregateIterator() const
     return AggregateIterator(this);
 }
 
+uint64_t
+Object::GetObjectCacheHits()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return g_getObjectCacheHits;
+}
+
+uint64_t
+Object::GetObjectCacheMisses()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return g_getObjectCacheMisses;
+}
+
 void
 Object::SetTypeId(TypeId tid)
 {
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(Check());
+    if (m_accounted)
+    {
+        MemoryAccounting::Account* account = MemoryAccounting::GetAccount(m_tid);
+        MemoryAccounting::Release(account, std::max(account->size, sizeof(Object)));
+    }
     m_tid = tid;
+    m_accounted = MemoryAccounting::IsEnabled();
+    if (m_accounted)
+    {
+        MemoryAccounting::Account* account = MemoryAccounting::GetAccount(m_tid);
+        MemoryAccounting::Allocate(account, std::max(account->size, sizeof(Object)));
+    }
 }
 
 void
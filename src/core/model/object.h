@@ -240,6 +240,25 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      */
     AggregateIterator GetAggregateIterator() const;
 
+    /**
+     * Get the number of GetObject() lookups found in the cache of the
+     * aggregates, over all the Objects.
+     *
+     * Together with GetObjectCacheMisses(), this measures the hit rate
+     * of the cache. The cache is disabled, and both counts stay 0, in
+     * the builds with multithreaded simulation support (NS3_MTP).
+     *
+     * @returns The number of lookups found in the cache.
+     */
+    static uint64_t GetObjectCacheHits();
+    /**
+     * Get the number of GetObject() lookups which searched the
+     * aggregates, over all the Objects.
+     *
+     * @returns The number of lookups not found in the cache.
+     */
+    static uint64_t GetObjectCacheMisses();
+
     /**
      * Invoke DoInitialize on all Objects aggregated to this one.
      *
@@ -360,9 +379,22 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /**
+     * The number of GetObject() lookups cached by each aggregate.
+     *
+     * The lookups of the common types, such as the Ipv4 or the
+     * MobilityModel of a Node, are repeated for each packet, so they
+     * fit in a small cache.
+     */
+    static constexpr uint32_t GET_OBJECT_CACHE_SIZE = 4;
+
     /**
      * The list of Objects aggregated to this one.
      *
+     * The list also caches the results of the last GetObject() lookups
+     * of any of the aggregated Objects, and the cache is cleared when the
+     * list changes.
+     *
      * This data structure uses a classic C-style trick to
      * hold an array of variable size without performing
      * two memory allocations: the declaration of the structure
@@ -374,8 +406,17 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      */
     struct Aggregates
     {
+        /** Forget the results of the previous GetObject() lookups. */
+        void ClearCache();
+
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /** The next entry of the cache to replace. */
+        uint32_t cacheNext;
+        /** The TypeId uids of the last GetObject() lookups, 0 if unused. */
+        uint16_t cacheTids[GET_OBJECT_CACHE_SIZE];
+        /** The Objects found by the last GetObject() lookups. */
+        Object* cacheObjects[GET_OBJECT_CACHE_SIZE];
         /** The array of Objects. */
         Object* buffer[1];
     };
@@ -457,6 +498,11 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * \c false otherwise
      */
     bool m_initialized;
+    /**
+     * Set to \c true if this object is counted by the MemoryAccounting,
+     * \c false otherwise.
+     */
+    bool m_accounted;
     /**
      * A pointer to an array of 'aggregates'.
      *
@@ -27,6 +27,7 @@
 #include <algorithm> // upper_bound
 #include <cmath>
 #include <iostream>
+#include <mutex>
 #include <numbers>
 
 /**
@@ -42,6 +43,14 @@ NS_LOG_COMPONENT_DEFINE("RandomVariableStream");
 
 NS_OBJECT_ENSURE_REGISTERED(RandomVariableStream);
 
+namespace
+{
+/** The list of existing streams, for RandomVariableStream::ReseedAll(). */
+RandomVariableStream* g_streams = nullptr;
+/** Protects g_streams. */
+std::mutex g_streamsMutex;
+} // unnamed namespace
+
 TypeId
 RandomVariableStream::GetTypeId()
 {
@@ -68,16 +77,58 @@ RandomVariableStream::GetTypeId()
 }
 
 RandomVariableStream::RandomVariableStream()
-    : m_rng(nullptr)
+    : m_rng(nullptr),
+      m_streamIndex(0),
+      m_prevStream(nullptr)
 {
     NS_LOG_FUNCTION(this);
+    std::lock_guard lock(g_streamsMutex);
+    m_nextStream = g_streams;
+    if (g_streams != nullptr)
+    {
+        g_streams->m_prevStream = this;
+    }
+    g_streams = this;
 }
 
 RandomVariableStream::~RandomVariableStream()
 {
+    {
+        std::lock_guard lock(g_streamsMutex);
+        if (m_prevStream != nullptr)
+        {
+            m_prevStream->m_nextStream = m_nextStream;
+        }
+        else
+        {
+            g_streams = m_nextStream;
+        }
+        if (m_nextStream != nullptr)
+        {
+            m_nextStream->m_prevStream = m_prevStream;
+        }
+    }
     delete m_rng;
 }
 
+void
+RandomVariableStream::ReseedAll()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    std::lock_guard lock(g_streamsMutex);
+    uint32_t seed = RngSeedManager::GetSeed();
+    uint64_t run = RngSeedManager::GetRun();
+    RngStream::Backend backend = RngSeedManager::GetBackend();
+    for (auto stream = g_streams; stream != nullptr; stream = stream->m_nextStream)
+    {
+        if (stream->m_rng != nullptr)
+        {
+            delete stream->m_rng;
+            stream->m_rng = new RngStream(seed, stream->m_streamIndex, run, backend);
+        }
+    }
+}
+
 void
 RandomVariableStream::SetAntithetic(bool isAntithetic)
 {
@@ -100,6 +151,16 @@ RandomVariableStream::GetInteger()
     return value;
 }
 
+void
+RandomVariableStream::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    for (double& value : values)
+    {
+        value = GetValue();
+    }
+}
+
 void
 RandomVariableStream::SetStream(int64_t stream)
 {
@@ -114,7 +175,7 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t nextStream = RngSeedManager::GetNextStreamIndex();
         NS_ASSERT(nextStream <= ((1ULL) << 63));
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " automatic stream: " << nextStream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_streamIndex = nextStream;
     }
     else
     {
@@ -123,8 +184,12 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t base = ((1ULL) << 63);
         uint64_t target = base + stream;
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " configured stream: " << stream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_streamIndex = target;
     }
+    m_rng = new RngStream(RngSeedManager::GetSeed(),
+                          m_streamIndex,
+                          RngSeedManager::GetRun(),
+                          RngSeedManager::GetBackend());
     m_stream = stream;
 }
 
@@ -218,6 +283,28 @@ UniformRandomVariable::GetInteger()
     return v;
 }
 
+void
+UniformRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    Peek()->RandU01(values);
+    // Same operations as GetValue(double,double), in loops which the
+    // compiler can vectorize
+    double min = m_min;
+    double max = m_max;
+    for (double& v : values)
+    {
+        v = min + v * (max - min);
+    }
+    if (IsAntithetic())
+    {
+        for (double& v : values)
+        {
+            v = min + (max - v);
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
 TypeId
@@ -443,6 +530,34 @@ ExponentialRandomVariable::GetValue()
     return GetValue(m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    if (m_bound != 0)
+    {
+        // The rejected values draw more uniform random numbers
+        for (double& v : values)
+        {
+            v = GetValue(m_mean, m_bound);
+        }
+        return;
+    }
+    Peek()->RandU01(values);
+    if (IsAntithetic())
+    {
+        for (double& v : values)
+        {
+            v = (1 - v);
+        }
+    }
+    double mean = m_mean;
+    for (double& v : values)
+    {
+        v = -mean * std::log(v);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId
@@ -778,6 +893,18 @@ NormalRandomVariable::GetValue()
     return GetValue(m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    // The values are generated in pairs, with rejections, so only the
+    // virtual calls are saved.
+    for (double& v : values)
+    {
+        v = GetValue(m_mean, m_variance, m_bound);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId
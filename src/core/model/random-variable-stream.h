@@ -20,6 +20,7 @@
 #include "type-id.h"
 
 #include <map>
+#include <span>
 #include <stdint.h>
 
 /**
@@ -143,6 +144,29 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * @brief Get the next random values drawn from the distribution.
+     *
+     * The values are the same as those returned by as many calls to
+     * GetValue().  The base implementation calls GetValue() for each
+     * value; the common distributions draw the uniform random numbers of
+     * all the values at once and then transform them.
+     *
+     * @param [out] values The random values.
+     */
+    virtual void GetValues(std::span<double> values);
+
+    /**
+     * @brief Recreate the RngStream of every existing RandomVariableStream
+     * from the current seed, run number and backend of the RngSeedManager.
+     *
+     * Each stream keeps its stream number and restarts at the beginning
+     * of its substream for the new run, as if it had been created after
+     * RngSeedManager::SetRun().  Simulator::RunReplications() uses this
+     * to give each replication its own run number.
+     */
+    static void ReseedAll();
+
   protected:
     /**
      * @brief Get the pointer to the underlying RngStream.
@@ -160,6 +184,14 @@ class RandomVariableStream : public Object
     /** The stream number for the RngStream. */
     int64_t m_stream;
 
+    /** The index of the RngStream, automatically allocated or not. */
+    uint64_t m_streamIndex;
+
+    /** Previous stream in the list of existing streams. */
+    RandomVariableStream* m_prevStream;
+    /** Next stream in the list of existing streams. */
+    RandomVariableStream* m_nextStream;
+
 }; // class RandomVariableStream
 
 /**
@@ -273,6 +305,8 @@ class UniformRandomVariable : public RandomVariableStream
      */
     uint32_t GetInteger() override;
 
+    void GetValues(std::span<double> values) override;
+
   private:
     /** The lower bound on values that can be returned by this RNG stream. */
     double m_min;
@@ -582,6 +616,7 @@ class ExponentialRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The mean value of the unbounded exponential distribution. */
@@ -1020,6 +1055,7 @@ class NormalRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The mean value for the normal distribution returned by this RNG stream. */
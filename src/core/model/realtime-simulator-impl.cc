@@ -11,6 +11,7 @@
 #include "enum.h"
 #include "event-impl.h"
 #include "fatal-error.h"
+#include "integer.h"
 #include "log.h"
 #include "pointer.h"
 #include "ptr.h"
@@ -19,10 +20,16 @@
 #include "synchronizer.h"
 #include "wall-clock-synchronizer.h"
 
+#include <bit>
 #include <cmath>
 #include <mutex>
 #include <thread>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 /**
  * @file
  * @ingroup realtime
@@ -59,7 +66,29 @@ RealtimeSimulatorImpl::GetTypeId()
                           "SynchronizationMode=HardLimit)",
                           TimeValue(Seconds(0.1)),
                           MakeTimeAccessor(&RealtimeSimulatorImpl::m_hardLimit),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("CatchUpPolicy",
+                          "What to do when an event starts late.",
+                          EnumValue(CATCH_UP_ALL),
+                          MakeEnumAccessor<CatchUpPolicy>(&RealtimeSimulatorImpl::m_catchUpPolicy),
+                          MakeEnumChecker(CATCH_UP_ALL, "All", CATCH_UP_SLIP, "Slip"))
+            .AddAttribute("CatchUpLimit",
+                          "Maximum lateness caught up with CatchUpPolicy=Slip; the real time "
+                          "origin slips by any excess.",
+                          TimeValue(MilliSeconds(10)),
+                          MakeTimeAccessor(&RealtimeSimulatorImpl::m_catchUpLimit),
+                          MakeTimeChecker(Time(0)))
+            .AddAttribute("CpuAffinity",
+                          "The CPU to pin the simulator thread to while running, "
+                          "or -1 to leave it to the operating system.",
+                          IntegerValue(-1),
+                          MakeIntegerAccessor(&RealtimeSimulatorImpl::m_cpuAffinity),
+                          MakeIntegerChecker<int32_t>(-1))
+            .AddTraceSource("Lateness",
+                            "The real time by which each event starts late, "
+                            "or a negative value if it starts early.",
+                            MakeTraceSourceAccessor(&RealtimeSimulatorImpl::m_lateness),
+                            "ns3::Time::TracedCallback");
     return tid;
 }
 
@@ -75,6 +104,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_latenessHistogram.assign(65, 0);
 
     m_main = std::this_thread::get_id();
 
@@ -302,6 +332,7 @@ RealtimeSimulatorImpl::ProcessOneEvent()
     // whatever event is at the head of this list if the list is in time order.
     //
     Scheduler::Event next;
+    Time lateness;
 
     {
         std::unique_lock lock{m_mutex};
@@ -342,16 +373,33 @@ RealtimeSimulatorImpl::ProcessOneEvent()
 
         //
         // We're about to run the event and we've done our best to synchronize this
-        // event execution time to real time.  Now, if we're in SYNC_HARD_LIMIT mode
-        // we have to decide if we've done a good enough job and if we haven't, we've
-        // been asked to commit ritual suicide.
+        // event execution time to real time.  Record how well we did, and apply the
+        // catch-up policy if the event is late.
+        //
+        uint64_t tsFinal = m_synchronizer->GetCurrentRealtime();
+        int64_t tsLate = static_cast<int64_t>(tsFinal - m_currentTs);
+        lateness = TimeStep(tsLate);
+        int64_t nsLate = lateness.GetNanoSeconds();
+        m_latenessHistogram[nsLate > 0 ? std::bit_width(static_cast<uint64_t>(nsLate)) : 0]++;
+
+        if (m_catchUpPolicy == CATCH_UP_SLIP && tsLate > m_catchUpLimit.GetTimeStep())
+        {
+            uint64_t tsSlip = tsLate - m_catchUpLimit.GetTimeStep();
+            NS_LOG_LOGIC("slip " << tsSlip);
+            m_synchronizer->Slip(tsSlip);
+            tsFinal -= tsSlip;
+        }
+
+        //
+        // Now, if we're in SYNC_HARD_LIMIT mode we have to decide if we've done a
+        // good enough job and if we haven't, we've been asked to commit ritual
+        // suicide.
         //
         // We check the simulation time against the current real time to make this
         // judgement.
         //
         if (m_synchronizationMode == SYNC_HARD_LIMIT)
         {
-            uint64_t tsFinal = m_synchronizer->GetCurrentRealtime();
             uint64_t tsJitter;
 
             if (tsFinal >= m_currentTs)
@@ -377,6 +425,7 @@ RealtimeSimulatorImpl::ProcessOneEvent()
     // event list so we can execute it outside a critical section without fear of someone
     // changing things out from under us.
 
+    m_lateness(lateness);
     EventImpl* event = next.impl;
     m_synchronizer->EventStart();
     event->Invoke();
@@ -417,6 +466,7 @@ RealtimeSimulatorImpl::Run()
 
     // Set the current threadId as the main threadId
     m_main = std::this_thread::get_id();
+    PinThread();
 
     m_stop = false;
     m_running = true;
@@ -465,9 +515,67 @@ RealtimeSimulatorImpl::Run()
                       "RealtimeSimulatorImpl::Run(): Empty queue and unprocessed events");
     }
 
+    UnpinThread();
     m_running = false;
 }
 
+#ifdef __linux__
+/** The CPU affinity of the thread before RealtimeSimulatorImpl::PinThread(). */
+static thread_local cpu_set_t g_savedCpus;
+/** Whether RealtimeSimulatorImpl::PinThread() changed the CPU affinity of the thread. */
+static thread_local bool g_pinned = false;
+#endif
+
+void
+RealtimeSimulatorImpl::PinThread()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_cpuAffinity < 0)
+    {
+        return;
+    }
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (m_cpuAffinity >= CPU_SETSIZE)
+    {
+        NS_LOG_WARN("Invalid CPU " << m_cpuAffinity);
+        return;
+    }
+    CPU_SET(m_cpuAffinity, &cpus);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(g_savedCpus), &g_savedCpus) != 0)
+    {
+        NS_LOG_WARN("Cannot get the CPU affinity of the simulator thread");
+        return;
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+    {
+        NS_LOG_WARN("Cannot pin the simulator thread to CPU " << m_cpuAffinity);
+        return;
+    }
+    g_pinned = true;
+#else
+    NS_LOG_WARN("CpuAffinity is not supported on this platform");
+#endif
+}
+
+void
+RealtimeSimulatorImpl::UnpinThread()
+{
+    NS_LOG_FUNCTION(this);
+#ifdef __linux__
+    if (!g_pinned)
+    {
+        return;
+    }
+    g_pinned = false;
+    if (pthread_setaffinity_np(pthread_self(), sizeof(g_savedCpus), &g_savedCpus) != 0)
+    {
+        NS_LOG_WARN("Cannot restore the CPU affinity of the simulator thread");
+    }
+#endif
+}
+
 bool
 RealtimeSimulatorImpl::Running() const
 {
@@ -819,4 +927,20 @@ RealtimeSimulatorImpl::GetHardLimit() const
     return m_hardLimit;
 }
 
+std::vector<uint64_t>
+RealtimeSimulatorImpl::GetLatenessHistogram() const
+{
+    NS_LOG_FUNCTION(this);
+    std::unique_lock lock{m_mutex};
+    return m_latenessHistogram;
+}
+
+void
+RealtimeSimulatorImpl::ResetLatenessHistogram()
+{
+    NS_LOG_FUNCTION(this);
+    std::unique_lock lock{m_mutex};
+    m_latenessHistogram.assign(m_latenessHistogram.size(), 0);
+}
+
 } // namespace ns3
@@ -10,14 +10,17 @@
 #include "assert.h"
 #include "event-impl.h"
 #include "log.h"
+#include "nstime.h"
 #include "ptr.h"
 #include "scheduler.h"
 #include "simulator-impl.h"
 #include "synchronizer.h"
+#include "traced-callback.h"
 
 #include <list>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 /**
  * @file
@@ -71,6 +74,26 @@ class RealtimeSimulatorImpl : public SimulatorImpl
         SYNC_HARD_LIMIT,
     };
 
+    /**
+     * What to do when an event starts late.
+     */
+    enum CatchUpPolicy
+    {
+        /**
+         * Run the late events back to back until the simulation time
+         * catches up with the real time.
+         */
+        CATCH_UP_ALL,
+        /**
+         * Catch up at most the CatchUpLimit: when an event is later than
+         * that, the real time origin is moved forward by the excess, so that
+         * the following events keep their spacing instead of running in a
+         * burst.  The SYNC_HARD_LIMIT check applies to the remaining lateness.
+         * @see the CatchUpLimit attribute
+         */
+        CATCH_UP_SLIP,
+    };
+
     /** Constructor. */
     RealtimeSimulatorImpl();
     /** Destructor. */
@@ -152,6 +175,20 @@ class RealtimeSimulatorImpl : public SimulatorImpl
      */
     Time GetHardLimit() const;
 
+    /**
+     * Get the histogram of the lateness of the events.
+     *
+     * The lateness of an event is the real time when it starts less its
+     * simulation time.  Bucket 0 counts the events which started on time
+     * or early, and bucket \f$ i > 0 \f$ the events which started
+     * \f$ [2^{i-1}, 2^i) \f$ ns late.
+     *
+     * @returns The number of events in each bucket.
+     */
+    std::vector<uint64_t> GetLatenessHistogram() const;
+    /** Clear the histogram of the lateness of the events. */
+    void ResetLatenessHistogram();
+
   private:
     /**
      * Is the simulator running?
@@ -172,6 +209,10 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     void ProcessOneEvent();
     /** Destructor implementation. */
     void DoDispose() override;
+    /** Pin the simulator thread to the configured CPU, if any. */
+    void PinThread();
+    /** Restore the CPU affinity of the simulator thread, if PinThread() changed it. */
+    void UnpinThread();
 
     /** Container type for events to be run at destroy time. */
     typedef std::list<EventId> DestroyEvents;
@@ -216,6 +257,24 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     /** The maximum allowable drift from real-time in SYNC_HARD_LIMIT mode. */
     Time m_hardLimit;
 
+    /** CatchUpPolicy policy. */
+    CatchUpPolicy m_catchUpPolicy;
+
+    /** The maximum lateness caught up in CATCH_UP_SLIP mode. */
+    Time m_catchUpLimit;
+
+    /** The CPU the simulator thread is pinned to, or -1. */
+    int32_t m_cpuAffinity;
+
+    /**
+     * Histogram of the lateness of the events, protected by #m_mutex.
+     * @see GetLatenessHistogram
+     */
+    std::vector<uint64_t> m_latenessHistogram;
+
+    /** Trace of the lateness of each event when it starts. */
+    TracedCallback<Time> m_lateness;
+
     /** Main thread. */
     std::thread::id m_main;
 };
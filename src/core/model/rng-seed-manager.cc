@@ -9,10 +9,15 @@
 
 #include "attribute-helper.h"
 #include "config.h"
+#include "enum.h"
 #include "global-value.h"
 #include "log.h"
 #include "uinteger.h"
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * @file
  * @ingroup randomvariable
@@ -29,7 +34,16 @@ NS_LOG_COMPONENT_DEFINE("RngSeedManager");
  * The next random number generator stream number to use
  * for automatic assignment.
  */
+#ifdef NS3_MTP
+static std::atomic<uint64_t> g_nextStreamIndex = 0;
+/**
+ * @relates RngSeedManager
+ * The stream index counter of the calling thread, if not the global one.
+ */
+static thread_local uint64_t* g_threadStreamIndex = nullptr;
+#else
 static uint64_t g_nextStreamIndex = 0;
+#endif
 /**
  * @relates RngSeedManager
  * @anchor GlobalValueRngSeed
@@ -59,6 +73,23 @@ static ns3::GlobalValue g_rngRun("RngRun",
                                  ns3::UintegerValue(1),
                                  ns3::MakeUintegerChecker<uint64_t>());
 
+/**
+ * @relates RngSeedManager
+ * @anchor GlobalValueRngBackend
+ * The random number generation algorithm of the streams.  MRG32k3a is the
+ * historical ns-3 generator; Philox4x32-10 is faster per value and can skip
+ * ahead in constant time, but gives different random numbers.
+ *
+ * This is accessible as "--RngBackend" from CommandLine.
+ */
+static ns3::GlobalValue g_rngBackend("RngBackend",
+                                     "The random number generation algorithm of all rng streams",
+                                     ns3::EnumValue(RngStream::MRG32K3A),
+                                     ns3::MakeEnumChecker(RngStream::MRG32K3A,
+                                                          "MRG32k3a",
+                                                          RngStream::PHILOX4X32_10,
+                                                          "Philox4x32-10"));
+
 uint32_t
 RngSeedManager::GetSeed()
 {
@@ -92,13 +123,33 @@ RngSeedManager::GetRun()
     return run;
 }
 
+void
+RngSeedManager::SetBackend(RngStream::Backend backend)
+{
+    NS_LOG_FUNCTION(backend);
+    Config::SetGlobal("RngBackend", EnumValue(backend));
+}
+
+RngStream::Backend
+RngSeedManager::GetBackend()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    EnumValue<RngStream::Backend> value;
+    g_rngBackend.GetValue(value);
+    return value.Get();
+}
+
 uint64_t
 RngSeedManager::GetNextStreamIndex()
 {
     NS_LOG_FUNCTION_NOARGS();
-    uint64_t next = g_nextStreamIndex;
-    g_nextStreamIndex++;
-    return next;
+#ifdef NS3_MTP
+    if (g_threadStreamIndex != nullptr)
+    {
+        return (*g_threadStreamIndex)++;
+    }
+#endif
+    return g_nextStreamIndex++;
 }
 
 void
@@ -107,4 +158,12 @@ RngSeedManager::ResetNextStreamIndex()
     g_nextStreamIndex = 0;
 }
 
+#ifdef NS3_MTP
+void
+RngSeedManager::SetThreadStreamIndexCounter(uint64_t* counter)
+{
+    g_threadStreamIndex = counter;
+}
+#endif
+
 } // namespace ns3
@@ -8,6 +8,8 @@
 #ifndef RNG_SEED_MANAGER_H
 #define RNG_SEED_MANAGER_H
 
+#include "rng-stream.h"
+
 #include <stdint.h>
 
 /**
@@ -88,6 +90,27 @@ class RngSeedManager
      */
     static uint64_t GetRun();
 
+    /**
+     * @brief Set the random number generation algorithm of the streams.
+     *
+     * The algorithm is used by the RandomVariableStream objects which
+     * are created, or whose stream is assigned, afterwards.  A simulation
+     * gives the same results for a given seed, run number and algorithm.
+     *
+     * @code
+     *   RngSeedManager::SetBackend(RngStream::PHILOX4X32_10);
+     * @endcode
+     *
+     * @param [in] backend The random number generation algorithm.
+     */
+    static void SetBackend(RngStream::Backend backend);
+    /**
+     * @brief Get the random number generation algorithm of the streams.
+     * @returns The random number generation algorithm.
+     * @see SetBackend
+     */
+    static RngStream::Backend GetBackend();
+
     /**
      * Get the next automatically assigned stream index.
      * @returns The next stream index.
@@ -98,6 +121,21 @@ class RngSeedManager
      * Resets the global stream index counter.
      */
     static void ResetNextStreamIndex();
+
+#ifdef NS3_MTP
+    /**
+     * Set the stream index counter of the calling thread.
+     *
+     * The MultithreadedSimulatorImpl gives each partition its own range
+     * of automatic stream indexes, so that the streams of the random
+     * variables created during the simulation do not depend on the order
+     * in which the threads execute the partitions.
+     *
+     * @param [in] counter The next stream index of the calling thread,
+     *             or nullptr to use the global counter.
+     */
+    static void SetThreadStreamIndexCounter(uint64_t* counter);
+#endif
 };
 
 /** Alias for compatibility. */
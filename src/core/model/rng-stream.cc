@@ -13,13 +13,14 @@
 #include "fatal-error.h"
 #include "log.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
 /**
  * @file
  * @ingroup rngimpl
- * ns3::RngStream and MRG32k3a implementations.
+ * ns3::RngStream, MRG32k3a and Philox4x32-10 implementations.
  */
 
 namespace ns3
@@ -321,50 +322,277 @@ void PowerOfTwoMatrix (int n, Matrix a1p, Matrix a2p)
 
 // clang-format on
 
+/** Namespace for Philox4x32-10 implementation details. */
+namespace Philox
+{
+
+/** First multiplier of the round function. */
+const uint32_t M0 = 0xD2511F53;
+
+/** Second multiplier of the round function. */
+const uint32_t M1 = 0xCD9E8D57;
+
+/** First increment of the key schedule, the golden ratio. */
+const uint32_t W0 = 0x9E3779B9;
+
+/** Second increment of the key schedule, sqrt(3) - 1. */
+const uint32_t W1 = 0xBB67AE85;
+
+/** The number of rounds. */
+const int ROUNDS = 10;
+
+/** Normalization of the 32 bit outputs to obtain randoms on (0,1). */
+const double norm = 1.0 / 4294967296.0;
+
+/**
+ * Compute the Philox4x32-10 block of a counter.
+ *
+ * @param [in] counter The counter.
+ * @param [in] key The key.
+ * @param [out] out The four random numbers of the block.
+ */
+inline void
+Block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4])
+{
+    uint32_t c0 = counter[0];
+    uint32_t c1 = counter[1];
+    uint32_t c2 = counter[2];
+    uint32_t c3 = counter[3];
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+    for (int i = 0; i < ROUNDS; ++i)
+    {
+        uint64_t p0 = static_cast<uint64_t>(M0) * c0;
+        uint64_t p1 = static_cast<uint64_t>(M1) * c2;
+        c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        c1 = static_cast<uint32_t>(p1);
+        c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c3 = static_cast<uint32_t>(p0);
+        k0 += W0;
+        k1 += W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/**
+ * Convert a 32 bit output to a random number on (0,1).
+ *
+ * @param [in] x The output.
+ * @returns The random number.
+ */
+inline double
+ToU01(uint32_t x)
+{
+    return (x + 0.5) * norm;
+}
+
+} // namespace Philox
+
 namespace ns3
 {
 
 using namespace MRG32k3a;
 
-double
-RngStream::RandU01()
+void
+RngStream::Generate(std::span<double> values)
 {
-    int32_t k;
-    double p1;
-    double p2;
-    double u;
-
-    /* Component 1 */
-    p1 = a12 * m_currentState[1] - a13n * m_currentState[0];
-    k = static_cast<int32_t>(p1 / m1);
-    p1 -= k * m1;
-    if (p1 < 0.0)
+    if (m_backend == PHILOX4X32_10)
     {
-        p1 += m1;
+        GeneratePhilox(values);
     }
-    m_currentState[0] = m_currentState[1];
-    m_currentState[1] = m_currentState[2];
-    m_currentState[2] = p1;
-
-    /* Component 2 */
-    p2 = a21 * m_currentState[5] - a23n * m_currentState[3];
-    k = static_cast<int32_t>(p2 / m2);
-    p2 -= k * m2;
-    if (p2 < 0.0)
+    else
     {
-        p2 += m2;
+        GenerateMrg32k3a(values);
     }
-    m_currentState[3] = m_currentState[4];
-    m_currentState[4] = m_currentState[5];
-    m_currentState[5] = p2;
+}
+
+void
+RngStream::GenerateMrg32k3a(std::span<double> values)
+{
+    // The divisions by the moduli are replaced by multiplications by their
+    // inverses.  The quotient may then be off by one, which the corrections
+    // below undo, so that the remainders are exactly those of the divisions.
+    const double invM1 = 1.0 / m1;
+    const double invM2 = 1.0 / m2;
+
+    // Keep the state in local variables, so that it stays in registers
+    double s0 = m_currentState[0];
+    double s1 = m_currentState[1];
+    double s2 = m_currentState[2];
+    double s3 = m_currentState[3];
+    double s4 = m_currentState[4];
+    double s5 = m_currentState[5];
+
+    for (double& u : values)
+    {
+        int32_t k;
+        double p1;
+        double p2;
+
+        /* Component 1 */
+        p1 = a12 * s1 - a13n * s0;
+        k = static_cast<int32_t>(p1 * invM1);
+        p1 -= k * m1;
+        if (p1 >= m1)
+        {
+            p1 -= m1;
+        }
+        else if (p1 < 0.0)
+        {
+            p1 += m1;
+            if (p1 < 0.0)
+            {
+                p1 += m1;
+            }
+        }
+        s0 = s1;
+        s1 = s2;
+        s2 = p1;
+
+        /* Component 2 */
+        p2 = a21 * s5 - a23n * s3;
+        k = static_cast<int32_t>(p2 * invM2);
+        p2 -= k * m2;
+        if (p2 >= m2)
+        {
+            p2 -= m2;
+        }
+        else if (p2 < 0.0)
+        {
+            p2 += m2;
+            if (p2 < 0.0)
+            {
+                p2 += m2;
+            }
+        }
+        s3 = s4;
+        s4 = s5;
+        s5 = p2;
 
-    /* Combination */
-    u = ((p1 > p2) ? (p1 - p2) * MRG32k3a::norm : (p1 - p2 + m1) * MRG32k3a::norm);
+        /* Combination */
+        u = ((p1 > p2) ? (p1 - p2) * MRG32k3a::norm : (p1 - p2 + m1) * MRG32k3a::norm);
+    }
 
-    return u;
+    m_currentState[0] = s0;
+    m_currentState[1] = s1;
+    m_currentState[2] = s2;
+    m_currentState[3] = s3;
+    m_currentState[4] = s4;
+    m_currentState[5] = s5;
 }
 
-RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
+void
+RngStream::GeneratePhilox(std::span<double> values)
+{
+    std::size_t i = 0;
+    // Use the rest of the last block first
+    while (i < values.size() && m_blockNext != 0)
+    {
+        values[i++] = Philox::ToU01(m_blockValues[m_blockNext]);
+        m_blockNext = (m_blockNext + 1) % 4;
+    }
+
+    uint32_t counter[4] = {0,
+                           0,
+                           static_cast<uint32_t>(m_substream),
+                           static_cast<uint32_t>(m_substream >> 32)};
+    uint32_t out[4];
+    for (; i + 4 <= values.size(); i += 4)
+    {
+        counter[0] = static_cast<uint32_t>(m_block);
+        counter[1] = static_cast<uint32_t>(m_block >> 32);
+        ++m_block;
+        Philox::Block(counter, m_key, out);
+        for (int j = 0; j < 4; ++j)
+        {
+            values[i + j] = Philox::ToU01(out[j]);
+        }
+    }
+
+    // Keep the values of a last block which is not used entirely
+    if (i < values.size())
+    {
+        counter[0] = static_cast<uint32_t>(m_block);
+        counter[1] = static_cast<uint32_t>(m_block >> 32);
+        ++m_block;
+        Philox::Block(counter, m_key, m_blockValues);
+        while (i < values.size())
+        {
+            values[i++] = Philox::ToU01(m_blockValues[m_blockNext++]);
+        }
+    }
+}
+
+void
+RngStream::Refill()
+{
+    m_count = std::min(std::max(2 * m_count, 1U), BUFFER_SIZE);
+    m_next = 0;
+    Generate(std::span<double>(m_buffer, m_count));
+}
+
+void
+RngStream::RandU01(std::span<double> values)
+{
+    // Return the numbers generated ahead first
+    std::size_t n = std::min<std::size_t>(m_count - m_next, values.size());
+    std::copy_n(m_buffer + m_next, n, values.begin());
+    m_next += n;
+    Generate(values.subspan(n));
+}
+
+void
+RngStream::Advance(uint64_t n)
+{
+    // Skip the numbers generated ahead first
+    uint64_t buffered = std::min<uint64_t>(m_count - m_next, n);
+    m_next += buffered;
+    n -= buffered;
+
+    if (m_backend == PHILOX4X32_10)
+    {
+        while (n > 0 && m_blockNext != 0)
+        {
+            m_blockNext = (m_blockNext + 1) % 4;
+            --n;
+        }
+        m_block += n / 4;
+        if (n % 4 != 0)
+        {
+            double skipped[3];
+            GeneratePhilox(std::span<double>(skipped, n % 4));
+        }
+        return;
+    }
+
+    // The state is advanced by A^n = A^(n mod 2) * (A^2)^(n / 2), since
+    // only the powers of A from A^2 are precalculated.
+    if (n % 2 != 0)
+    {
+        MatVecModM(A1p0, m_currentState, m_currentState, m1);
+        MatVecModM(A2p0, &m_currentState[3], &m_currentState[3], m2);
+    }
+    AdvanceNthBy(n / 2, 1, m_currentState);
+}
+
+RngStream::Backend
+RngStream::GetBackend() const
+{
+    return m_backend;
+}
+
+RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream, Backend backend)
+    : m_backend(backend),
+      m_key{0, 0},
+      m_substream(substream),
+      m_block(0),
+      m_blockValues{0, 0, 0, 0},
+      m_blockNext(0),
+      m_next(0),
+      m_count(0)
 {
     if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
@@ -374,16 +602,40 @@ RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
     {
         m_currentState[i] = seedNumber;
     }
+    if (m_backend == PHILOX4X32_10)
+    {
+        // The key is a hash of the seed and of the stream, computed with
+        // Philox itself, since the key is too short to hold both.
+        uint32_t counter[4] = {static_cast<uint32_t>(stream),
+                               static_cast<uint32_t>(stream >> 32),
+                               seedNumber,
+                               0};
+        uint32_t key[2] = {Philox::W0, Philox::W1};
+        uint32_t out[4];
+        Philox::Block(counter, key, out);
+        m_key[0] = out[0];
+        m_key[1] = out[1];
+        return;
+    }
     AdvanceNthBy(stream, 127, m_currentState);
     AdvanceNthBy(substream, 76, m_currentState);
 }
 
 RngStream::RngStream(const RngStream& r)
+    : m_backend(r.m_backend),
+      m_substream(r.m_substream),
+      m_block(r.m_block),
+      m_blockNext(r.m_blockNext),
+      m_next(r.m_next),
+      m_count(r.m_count)
 {
     for (int i = 0; i < 6; ++i)
     {
         m_currentState[i] = r.m_currentState[i];
     }
+    std::copy_n(r.m_key, 2, m_key);
+    std::copy_n(r.m_blockValues, 4, m_blockValues);
+    std::copy_n(r.m_buffer, m_count, m_buffer);
 }
 
 void
@@ -7,6 +7,7 @@
 
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
+#include <span>
 #include <stdint.h>
 #include <string>
 
@@ -34,18 +35,42 @@ namespace ns3
  * holds a static instance of this class.  The details of this
  * class are explained in:
  * http://www.iro.umontreal.ca/~lecuyer/myftp/papers/streams00.pdf
+ *
+ * The class can also use the counter-based generator Philox4x32-10,
+ * described in:
+ * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, "Parallel random
+ * numbers: as easy as 1, 2, 3", SC'11.
+ * Philox computes the numbers from a key, derived from the seed and the
+ * stream, and a counter made of the substream and of the position in the
+ * substream.  Its numbers are thus not the same as those of MRG32k3a, but
+ * the streams and substreams are used in the same way, and it can skip any
+ * number of values in constant time.
+ *
+ * The numbers are generated in small batches, which are kept in a
+ * buffer and returned one by one, so that most calls to RandU01() only
+ * read the buffer.  The batches grow from one to BUFFER_SIZE numbers as the
+ * stream is used, so that a stream which is rarely used does not generate
+ * numbers ahead.  The sequence of numbers is the same as without the buffer.
  */
 class RngStream
 {
   public:
+    /** The random number generation algorithms. */
+    enum Backend
+    {
+        MRG32K3A,     //!< The combined multiple-recursive generator MRG32k3a.
+        PHILOX4X32_10 //!< The counter-based generator Philox4x32-10.
+    };
+
     /**
      * Construct from explicit seed, stream and substream values.
      *
      * @param [in] seed The starting seed.
      * @param [in] stream The stream number.
      * @param [in] substream The sub-stream number.
+     * @param [in] backend The random number generation algorithm.
      */
-    RngStream(uint32_t seed, uint64_t stream, uint64_t substream);
+    RngStream(uint32_t seed, uint64_t stream, uint64_t substream, Backend backend = MRG32K3A);
     /**
      * Copy constructor.
      *
@@ -58,9 +83,69 @@ class RngStream
      *
      * @returns The next random.
      */
-    double RandU01();
+    double RandU01()
+    {
+        if (m_next == m_count)
+        {
+            Refill();
+        }
+        return m_buffer[m_next++];
+    }
+
+    /**
+     * Generate the next random numbers for this stream.
+     *
+     * The numbers are the same as those returned by as many calls to
+     * RandU01().
+     *
+     * @param [out] values The random numbers.
+     */
+    void RandU01(std::span<double> values);
+
+    /**
+     * Skip the next random numbers of this stream.
+     *
+     * This takes a constant time with Philox4x32-10, and a time
+     * logarithmic in \pname{n} with MRG32k3a.
+     *
+     * @param [in] n The number of random numbers to skip.
+     */
+    void Advance(uint64_t n);
+
+    /**
+     * Get the random number generation algorithm of this stream.
+     *
+     * @returns The random number generation algorithm.
+     */
+    Backend GetBackend() const;
+
+    /** The maximum number of random numbers generated ahead. */
+    static constexpr uint32_t BUFFER_SIZE = 16;
 
   private:
+    /**
+     * Generate the next batch of random numbers in the buffer.
+     */
+    void Refill();
+    /**
+     * Generate the next random numbers from the state of the RNG.
+     *
+     * @param [out] values The random numbers.
+     */
+    void Generate(std::span<double> values);
+    /**
+     * Generate the next random numbers with MRG32k3a.
+     *
+     * @param [out] values The random numbers.
+     */
+    void GenerateMrg32k3a(std::span<double> values);
+    /**
+     * Generate the next random numbers with Philox4x32-10.
+     *
+     * @param [out] values The random numbers.
+     */
+    void GeneratePhilox(std::span<double> values);
+
     /**
      * Advance \pname{state} of the RNG by leaps and bounds.
      *
@@ -70,8 +155,26 @@ class RngStream
      */
     void AdvanceNthBy(uint64_t nth, int by, double state[6]);
 
-    /** The RNG state vector. */
+    /** The random number generation algorithm. */
+    Backend m_backend;
+    /** The RNG state vector of MRG32k3a. */
     double m_currentState[6];
+    /** The Philox4x32-10 key, derived from the seed and the stream. */
+    uint32_t m_key[2];
+    /** The substream, the upper half of the Philox4x32-10 counter. */
+    uint64_t m_substream;
+    /** The next block, the lower half of the Philox4x32-10 counter. */
+    uint64_t m_block;
+    /** The output of the last Philox4x32-10 block. */
+    uint32_t m_blockValues[4];
+    /** The index of the next unused value of the last block, or 0 if none. */
+    uint32_t m_blockNext;
+    /** The random numbers generated ahead. */
+    double m_buffer[BUFFER_SIZE];
+    /** The index of the next random number in the buffer. */
+    uint32_t m_next;
+    /** The number of random numbers in the buffer. */
+    uint32_t m_count;
 };
 
 } // namespace ns3
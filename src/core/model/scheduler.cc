@@ -9,6 +9,7 @@
 #include "scheduler.h"
 
 #include "assert.h"
+#include "event-impl.h"
 #include "log.h"
 
 /**
@@ -36,4 +37,54 @@ Scheduler::GetTypeId()
     return tid;
 }
 
+void
+Scheduler::RemoveNextBatch(std::vector<Event>& batch)
+{
+    NS_LOG_FUNCTION(this);
+    Event first = RemoveNext();
+    batch.push_back(first);
+    while (!IsEmpty() && PeekNext().key.m_ts == first.key.m_ts)
+    {
+        batch.push_back(RemoveNext());
+    }
+}
+
+void
+Scheduler::RemoveCancelled(std::vector<Event>& removed)
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Event> events;
+    while (!IsEmpty())
+    {
+        Event ev = RemoveNext();
+        if (ev.impl->IsCancelled())
+        {
+            removed.push_back(ev);
+        }
+        else
+        {
+            events.push_back(ev);
+        }
+    }
+    for (const auto& ev : events)
+    {
+        Insert(ev);
+    }
+}
+
+void
+Scheduler::GetEvents(std::vector<Event>& events)
+{
+    NS_LOG_FUNCTION(this);
+    std::size_t first = events.size();
+    while (!IsEmpty())
+    {
+        events.push_back(RemoveNext());
+    }
+    for (std::size_t i = first; i < events.size(); ++i)
+    {
+        Insert(events[i]);
+    }
+}
+
 } // namespace ns3
@@ -12,6 +12,7 @@
 #include "object.h"
 
 #include <stdint.h>
+#include <vector>
 
 /**
  * @file
@@ -100,6 +101,14 @@ class EventImpl;
  *      <td class="markdownTableBodyLeft"> 0 </td>
  * </tr>
  * <tr class="markdownTableBody">
+ *      <td class="markdownTableBodyLeft"> LadderScheduler </td>
+ *      <td class="markdownTableBodyLeft"> Rungs of `std::vector` buckets </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> ~Constant </td>
+ *      <td class="markdownTableBodyLeft"> 8 rungs </td>
+ *      <td class="markdownTableBodyLeft"> 0 </td>
+ * </tr>
+ * <tr class="markdownTableBody">
  *      <td class="markdownTableBodyLeft"> ListScheduler </td>
  *      <td class="markdownTableBodyLeft"> `std::list` </td>
  *      <td class="markdownTableBodyLeft"> Linear </td>
@@ -215,6 +224,43 @@ class Scheduler : public Object
      * @param [in] ev The event to remove
      */
     virtual void Remove(const Event& ev) = 0;
+    /**
+     * Remove all the events which share the earliest timestamp.
+     *
+     * The events are appended to \p batch in increasing uid order,
+     * which is the order RemoveNext() would return them in.
+     * The default implementation calls PeekNext() and RemoveNext()
+     * until the timestamp changes; subclasses can override it when
+     * they can extract the batch more efficiently.
+     *
+     * This method cannot be invoked if the list is empty.
+     *
+     * @param [in,out] batch The vector to append the events to.
+     */
+    virtual void RemoveNextBatch(std::vector<Event>& batch);
+    /**
+     * Remove all the cancelled events from the event list.
+     *
+     * Cancelled events normally stay in the event list until they reach
+     * its head; this method lets the caller reclaim them earlier.
+     * The default implementation removes every event and inserts back
+     * those which are not cancelled; subclasses override it when they can
+     * filter their storage in a single pass.
+     *
+     * @param [in,out] removed The vector to append the removed events to.
+     */
+    virtual void RemoveCancelled(std::vector<Event>& removed);
+    /**
+     * Get all the events of the event list, leaving it unchanged.
+     *
+     * The events are appended to \p events in the order RemoveNext()
+     * would return them in, including the cancelled events.
+     * The default implementation removes every event and inserts them
+     * back; subclasses override it when they can copy their storage.
+     *
+     * @param [in,out] events The vector to append the events to.
+     */
+    virtual void GetEvents(std::vector<Event>& events);
 };
 
 /**
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup memoryaccounting
+ * ns3::ShowMemory implementation.
+ */
+
+#include "show-memory.h"
+
+#include "log.h"
+#include "simulator.h"
+#include "trace-source-accessor.h"
+
+#include <iomanip>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ShowMemory");
+
+NS_OBJECT_ENSURE_REGISTERED(ShowMemory);
+
+TypeId
+ShowMemory::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ShowMemory")
+            .SetParent<ObjectBase>()
+            .SetGroupName("Core")
+            .AddTraceSource("Usage",
+                            "The memory usage of the accounts, reported periodically.",
+                            MakeTraceSourceAccessor(&ShowMemory::m_usage),
+                            "ns3::ShowMemory::UsageTracedCallback");
+    return tid;
+}
+
+TypeId
+ShowMemory::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+ShowMemory::ShowMemory(const Time interval /* = Seconds (1) */,
+                       std::ostream& os /* = std::cout */)
+    : m_interval(interval),
+      m_event(),
+      m_os(&os),
+      m_top(10)
+{
+    NS_LOG_FUNCTION(this << interval);
+    NS_ASSERT_MSG(interval.IsStrictlyPositive(), "The interval must be positive");
+    MemoryAccounting::Enable();
+    m_event = Simulator::Schedule(m_interval, &ShowMemory::Report, this);
+}
+
+ShowMemory::~ShowMemory()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_event);
+}
+
+void
+ShowMemory::SetInterval(const Time interval)
+{
+    NS_LOG_FUNCTION(this << interval);
+    NS_ASSERT_MSG(interval.IsStrictlyPositive(), "The interval must be positive");
+    m_interval = interval;
+    Simulator::Cancel(m_event);
+    m_event = Simulator::Schedule(m_interval, &ShowMemory::Report, this);
+}
+
+void
+ShowMemory::SetStream(std::ostream& os)
+{
+    m_os = &os;
+}
+
+void
+ShowMemory::SetTop(uint32_t top)
+{
+    NS_LOG_FUNCTION(this << top);
+    m_top = top;
+}
+
+void
+ShowMemory::Report()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<MemoryAccounting::Usage> usage = MemoryAccounting::GetUsage();
+    m_usage(usage);
+
+    int64_t bytes = 0;
+    int64_t instances = 0;
+    for (const auto& account : usage)
+    {
+        bytes += account.bytes;
+        instances += account.instances;
+    }
+
+    // Save stream state
+    auto flags = m_os->flags();
+
+    DefaultTimePrinter(*m_os);
+    (*m_os) << " memory: " << bytes << " bytes in " << instances << " instances" << std::endl;
+    (*m_os) << std::right << std::setw(12) << "bytes" << std::setw(11) << "instances"
+            << std::setw(13) << "peak bytes"
+            << "  account" << std::endl;
+    for (std::size_t i = 0; i < usage.size() && i < m_top; ++i)
+    {
+        (*m_os) << std::setw(12) << usage[i].bytes << std::setw(11) << usage[i].instances
+                << std::setw(13) << usage[i].peakBytes << "  " << usage[i].name << std::endl;
+    }
+    (*m_os) << std::flush;
+
+    // Restore stream state
+    m_os->flags(flags);
+
+    m_event = Simulator::Schedule(m_interval, &ShowMemory::Report, this);
+}
+
+} // namespace ns3
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SHOW_MEMORY_H
+#define SHOW_MEMORY_H
+
+/**
+ * @file
+ * @ingroup memoryaccounting
+ * ns3::ShowMemory declaration.
+ */
+
+#include "event-id.h"
+#include "memory-accounting.h"
+#include "nstime.h"
+#include "object-base.h"
+#include "time-printer.h"
+#include "traced-callback.h"
+
+#include <iostream>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup memoryaccounting
+ * @ingroup debugging
+ *
+ * Periodically print the memory used by the simulation.
+ *
+ * The constructor enables the MemoryAccounting, so that the objects
+ * created afterwards are counted.  Every interval of simulation time,
+ * the live bytes and instances of the largest accounts are printed, and
+ * the usage of all the accounts is reported by the \c Usage trace source.
+ *
+ * Example usage:
+ *
+ * @code
+ *     int main (int arg, char ** argv)
+ *     {
+ *       ShowMemory memory (Seconds (10), std::cerr);
+ *       // Create your model
+ *
+ *       Simulator::Stop (Seconds (100));
+ *       Simulator::Run ();
+ *       Simulator::Destroy ();
+ *     }
+ * @endcode
+ *
+ * This generates output similar to the following:
+ *
+ * @code
+ *     +10.000000000s memory: 4415672 bytes in 23542 instances
+ *            bytes  instances   peak bytes  account
+ *          2097264      13107      2097264  ns3::Buffer
+ *          1048576      10000      1048576  ns3::PacketMetadata
+ *          ...
+ * @endcode
+ *
+ * Like ShowProgress, a ShowMemory schedules events until it is
+ * destroyed, so the simulation must be stopped by Simulator::Stop().
+ */
+class ShowMemory : public ObjectBase
+{
+  public:
+    /**
+     * Get the registered TypeId for this class.
+     * @returns The TypeId.
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * Constructor.
+     * @param [in] interval The simulation time interval between the reports.
+     * @param [in] os The stream to print on.
+     */
+    ShowMemory(const Time interval = Seconds(1), std::ostream& os = std::cout);
+
+    /** Destructor. */
+    ~ShowMemory() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    ShowMemory(const ShowMemory&) = delete;
+    ShowMemory& operator=(const ShowMemory&) = delete;
+
+    /**
+     * Set the simulation time interval between the reports.
+     * @param [in] interval The interval.
+     */
+    void SetInterval(const Time interval);
+
+    /**
+     * Set the output stream to print on.
+     * @param [in] os The output stream.
+     */
+    void SetStream(std::ostream& os);
+
+    /**
+     * Set the number of accounts printed in each report.
+     * @param [in] top The number of accounts with the most live bytes to print.
+     */
+    void SetTop(uint32_t top);
+
+    /**
+     * TracedCallback signature for the memory usage reports.
+     * @param [in] usage The usage of the accounts, by decreasing live bytes.
+     */
+    typedef void (*UsageTracedCallback)(const std::vector<MemoryAccounting::Usage>& usage);
+
+  private:
+    /** Report the memory usage and schedule the next report. */
+    void Report();
+
+    Time m_interval;    //!< The simulation time interval between the reports.
+    EventId m_event;    //!< The next report event.
+    std::ostream* m_os; //!< The output stream to use.
+    uint32_t m_top;     //!< The number of accounts to print.
+
+    /** The trace of the memory usage reports. */
+    TracedCallback<const std::vector<MemoryAccounting::Usage>&> m_usage;
+
+}; // class ShowMemory
+
+} // namespace ns3
+
+#endif /* SHOW_MEMORY_H */
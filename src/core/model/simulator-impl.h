@@ -16,6 +16,8 @@
 #include "object.h"
 #include "ptr.h"
 
+#include <vector>
+
 /**
  * @file
  * @ingroup simulator
@@ -90,6 +92,36 @@ class SimulatorImpl : public Object
     /** @copydoc Simulator::GetEventCount */
     virtual uint64_t GetEventCount() const = 0;
 
+    /**
+     * @copydoc Simulator::GetCancelledEventCount
+     *
+     * Implementations which do not track the cancelled events return 0.
+     */
+    virtual uint64_t GetCancelledEventCount() const
+    {
+        return 0;
+    }
+
+    /**
+     * @copydoc Simulator::GetCompactedEventCount
+     *
+     * Implementations which do not compact their scheduler return 0.
+     */
+    virtual uint64_t GetCompactedEventCount() const
+    {
+        return 0;
+    }
+
+    /**
+     * @copydoc Simulator::GetPendingEvents
+     *
+     * Implementations which cannot list their events return an empty list.
+     */
+    virtual std::vector<EventId> GetPendingEvents()
+    {
+        return {};
+    }
+
     /**
      * Hook called before processing each event.
      *
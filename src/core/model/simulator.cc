@@ -15,19 +15,31 @@
 #include "map-scheduler.h"
 #include "object-factory.h"
 #include "ptr.h"
+#include "random-variable-stream.h"
+#include "rng-seed-manager.h"
 #include "scheduler.h"
 #include "simulator-impl.h"
 #include "string.h"
 
 #include "ns3/core-config.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <deque>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <list>
+#include <thread>
 #include <vector>
 
+#ifndef __WIN32__
+#include <cerrno>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 /**
  * @file
  * @ingroup simulator
@@ -144,6 +156,7 @@ Simulator::Destroy()
      */
     LogSetTimePrinter(nullptr);
     LogSetNodePrinter(nullptr);
+    NS_LOG_INFO("Event pool: " << EventImpl::GetPoolStatistics());
     (*pimpl)->Destroy();
     (*pimpl)->Unref();
     *pimpl = nullptr;
@@ -171,6 +184,215 @@ Simulator::Run()
     GetImpl()->Run();
 }
 
+#ifndef __WIN32__
+namespace
+{
+
+/**
+ * @ingroup simulator
+ * Write a whole buffer to a file descriptor.
+ *
+ * @param [in] fd The file descriptor.
+ * @param [in] data The buffer.
+ * @param [in] size The buffer size.
+ * @return \c true on success.
+ */
+bool
+WriteAll(int fd, const char* data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, data, size);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+/**
+ * @ingroup simulator
+ * Read a file descriptor until the end of file.
+ *
+ * @param [in] fd The file descriptor.
+ * @return The data read.
+ */
+std::string
+ReadAll(int fd)
+{
+    std::string data;
+    char buffer[4096];
+    while (true)
+    {
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return data;
+        }
+        data.append(buffer, count);
+    }
+}
+
+/**
+ * @ingroup simulator
+ * Run functions in child processes created with fork(), and collect
+ * their results.
+ *
+ * @param [in] n The number of child processes.
+ * @param [in] jobs The maximum number of child processes running at once.
+ * @param [in] name The name of the child processes, for the messages.
+ * @param [in] child The function run by child process \c i, which
+ *             returns its result.
+ * @return The results of the child processes, in order.
+ */
+std::vector<std::string>
+RunChildren(uint32_t n,
+            uint32_t jobs,
+            const std::string& name,
+            const std::function<std::string(uint32_t)>& child)
+{
+    if (jobs == 0)
+    {
+        jobs = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    /// A running child process.
+    struct Child
+    {
+        uint32_t index; //!< Child index
+        pid_t pid;      //!< Process id
+        int fd;         //!< Read end of the result pipe
+    };
+
+    std::vector<std::string> results(n);
+    std::deque<Child> running;
+    auto reap = [&results, &running, &name]() {
+        Child child = running.front();
+        running.pop_front();
+        results[child.index] = ReadAll(child.fd);
+        close(child.fd);
+        int status = 0;
+        while (waitpid(child.pid, &status, 0) < 0 && errno == EINTR)
+        {
+        }
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            NS_FATAL_ERROR(name << " " << child.index << " failed with status " << status);
+        }
+    };
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        if (running.size() == jobs)
+        {
+            reap();
+        }
+        int fds[2];
+        if (pipe(fds) != 0)
+        {
+            NS_FATAL_ERROR(name << " " << i << ": pipe() failed, errno " << errno);
+        }
+        // Do not let the children flush the buffered output of the parent
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            NS_FATAL_ERROR(name << " " << i << ": fork() failed, errno " << errno);
+        }
+        if (pid == 0)
+        {
+            close(fds[0]);
+            for (const auto& other : running)
+            {
+                close(other.fd);
+            }
+            std::string result = child(i);
+            Simulator::Destroy();
+            LogBinaryFlush();
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            // Skip the destructors of the scenario shared with the parent
+            _exit(WriteAll(fds[1], result.data(), result.size()) ? 0 : 1);
+        }
+        close(fds[1]);
+        running.push_back({i, pid, fds[0]});
+    }
+    while (!running.empty())
+    {
+        reap();
+    }
+    return results;
+}
+
+} // unnamed namespace
+#endif
+
+std::vector<std::string>
+Simulator::RunReplications(uint32_t n,
+                           const std::function<void()>& setup,
+                           const std::function<std::string()>& collect,
+                           uint32_t jobs)
+{
+    NS_LOG_FUNCTION(n << jobs);
+#ifdef __WIN32__
+    NS_FATAL_ERROR("Simulator::RunReplications() requires fork()");
+#else
+    setup();
+    uint64_t firstRun = RngSeedManager::GetRun();
+    return RunChildren(n, jobs, "Replication", [firstRun, &collect](uint32_t i) {
+        NS_LOG_INFO("Replication " << i << " with run " << firstRun + i);
+        RngSeedManager::SetRun(firstRun + i);
+        RandomVariableStream::ReseedAll();
+        Run();
+        return collect();
+    });
+#endif
+}
+
+std::vector<std::string>
+Simulator::RunBranches(const Time& at,
+                       uint32_t n,
+                       const std::function<void(uint32_t)>& branch,
+                       const std::function<std::string()>& collect,
+                       uint32_t jobs)
+{
+    NS_LOG_FUNCTION(at << n << jobs);
+#ifdef __WIN32__
+    NS_FATAL_ERROR("Simulator::RunBranches() requires fork()");
+#else
+    NS_ASSERT_MSG(at >= Now(), "The checkpoint " << at << " is in the past");
+    if (at > Now())
+    {
+        EventId checkpoint = Stop(at - Now());
+        Run();
+        // The simulation may have ended before the checkpoint
+        Cancel(checkpoint);
+    }
+    NS_LOG_INFO("Checkpoint at " << Now() << " with " << GetPendingEvents().size()
+                                 << " pending events");
+    return RunChildren(n, jobs, "Branch", [&branch, &collect](uint32_t i) {
+        NS_LOG_INFO("Branch " << i);
+        branch(i);
+        Run();
+        return collect();
+    });
+#endif
+}
+
 void
 Simulator::Stop()
 {
@@ -315,6 +537,24 @@ Simulator::GetEventCount()
     return GetImpl()->GetEventCount();
 }
 
+uint64_t
+Simulator::GetCancelledEventCount()
+{
+    return GetImpl()->GetCancelledEventCount();
+}
+
+uint64_t
+Simulator::GetCompactedEventCount()
+{
+    return GetImpl()->GetCompactedEventCount();
+}
+
+std::vector<EventId>
+Simulator::GetPendingEvents()
+{
+    return GetImpl()->GetPendingEvents();
+}
+
 uint32_t
 Simulator::GetSystemId()
 {
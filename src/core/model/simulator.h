@@ -15,8 +15,10 @@
 #include "nstime.h"
 #include "object-factory.h"
 
+#include <functional>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 /**
  * @file
@@ -137,6 +139,73 @@ class Simulator
      */
     static void Run();
 
+    /**
+     * Run independent replications of a scenario built once.
+     *
+     * The \p setup function builds the scenario, including its initial
+     * events, once in the calling process.  Each replication then runs
+     * in a child process created with fork(), which shares the memory of
+     * the scenario copy-on-write.  Replication \c i sets the run number
+     * of the RngSeedManager to the current run number plus \c i, reseeds
+     * every existing RandomVariableStream with
+     * RandomVariableStream::ReseedAll(), calls Run(), and sends the
+     * string returned by \p collect back to the calling process.
+     *
+     * The random values drawn by \p setup are shared by all the
+     * replications.  A replication draws the same values as an
+     * independent run with its run number only for the streams whose
+     * values are all drawn after setup.
+     *
+     * The calling process does not run the simulation: it should call
+     * Destroy() when it no longer needs the scenario.  This method is
+     * only available on POSIX systems, and must not be used while other
+     * threads are running, since they are not copied in the children.
+     *
+     * @param [in] n The number of replications.
+     * @param [in] setup The function which builds the scenario.
+     * @param [in] collect The function which returns the result of a
+     *             replication, called after Run() in the child process.
+     * @param [in] jobs The maximum number of child processes running at
+     *             once, or 0 for the number of hardware threads.
+     * @return The results of the replications, in run number order.
+     */
+    static std::vector<std::string> RunReplications(uint32_t n,
+                                                    const std::function<void()>& setup,
+                                                    const std::function<std::string()>& collect,
+                                                    uint32_t jobs = 0);
+
+    /**
+     * Run variants of a simulation from a shared warmed-up state.
+     *
+     * The calling process runs the simulation until \p at, which is the
+     * checkpoint.  Each branch then runs in a child process created with
+     * fork(), which resumes from the state of the checkpoint, including
+     * the pending events, copy-on-write.  Branch \c i calls \p branch
+     * with \c i, which can change attributes with Config::Set() or reseed
+     * the random variables, calls Run() until the end of the simulation,
+     * and sends the string returned by \p collect back to the calling
+     * process.
+     *
+     * The calling process stays at the checkpoint: it can call
+     * RunBranches() again at the same time, or Run() to continue without
+     * changes.  The same restrictions as RunReplications() apply.
+     *
+     * @param [in] at The simulation time of the checkpoint.
+     * @param [in] n The number of branches.
+     * @param [in] branch The function which sets up a branch, called
+     *             before Run() in the child process.
+     * @param [in] collect The function which returns the result of a
+     *             branch, called after Run() in the child process.
+     * @param [in] jobs The maximum number of child processes running at
+     *             once, or 0 for the number of hardware threads.
+     * @return The results of the branches, in branch order.
+     */
+    static std::vector<std::string> RunBranches(const Time& at,
+                                                uint32_t n,
+                                                const std::function<void(uint32_t)>& branch,
+                                                const std::function<std::string()>& collect,
+                                                uint32_t jobs = 0);
+
     /**
      * Tell the Simulator the calling event should be the last one
      * executed.
@@ -205,6 +274,33 @@ class Simulator
      */
     static uint64_t GetEventCount();
 
+    /**
+     * Get the number of cancelled events still held by the event scheduler.
+     *
+     * Cancelled events stay in the scheduler until they reach its head,
+     * or until the simulator implementation compacts the scheduler.
+     * @returns The number of cancelled events in the scheduler.
+     */
+    static uint64_t GetCancelledEventCount();
+
+    /**
+     * Get the number of cancelled events removed from the event scheduler
+     * by compaction, before they reached its head.
+     * @returns The total number of events removed by compaction.
+     */
+    static uint64_t GetCompactedEventCount();
+
+    /**
+     * Get the events which are scheduled and not cancelled.
+     *
+     * The events are in the order they will be executed, without the
+     * events scheduled with ScheduleDestroy().  This must be called by
+     * the main thread of the simulation.
+     * @returns The pending events, or an empty list if the simulator
+     *          implementation cannot list its events.
+     */
+    static std::vector<EventId> GetPendingEvents();
+
     /**
      * @name Schedule events (in the same context) to run at a future time.
      */
@@ -69,6 +69,13 @@ Synchronizer::GetOrigin()
     return NanosecondToTimeStep(m_simOriginNano);
 }
 
+void
+Synchronizer::Slip(uint64_t ts)
+{
+    NS_LOG_FUNCTION(this << ts);
+    m_realtimeOriginNano += TimeStepToNanosecond(ts);
+}
+
 int64_t
 Synchronizer::GetDrift(uint64_t ts)
 {
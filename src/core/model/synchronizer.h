@@ -100,6 +100,18 @@ class Synchronizer : public Object
      */
     uint64_t GetOrigin();
 
+    /**
+     * @brief Let the real time clock run ahead of the simulation time.
+     *
+     * The origin of the real time is moved forward, so that the simulation
+     * time due now is reached after \pname{ts} more real time.  This is used
+     * to give up catching up with the real time after a large delay.
+     *
+     * @param [in] ts The slip, in Time resolution units.
+     * @see SetOrigin
+     */
+    void Slip(uint64_t ts);
+
     /**
      * @brief Retrieve the difference between the real time clock used to
      * synchronize the simulation and the simulation time (in
@@ -27,6 +27,12 @@ NS_LOG_COMPONENT_DEFINE("TimePrinter");
 
 void
 DefaultTimePrinter(std::ostream& os)
+{
+    DefaultTimePrinter(os, Simulator::Now());
+}
+
+void
+DefaultTimePrinter(std::ostream& os, const Time& time)
 {
     std::ios_base::fmtflags ff = os.flags(); // Save stream flags
     std::streamsize oldPrecision = os.precision();
@@ -50,7 +56,7 @@ DefaultTimePrinter(std::ostream& os)
         // default C++ precision of 5
         os << std::setprecision(5);
     }
-    os << Simulator::Now().As(Time::S);
+    os << time.As(Time::S);
 
     os << std::setprecision(oldPrecision);
     os.flags(ff); // Restore stream flags
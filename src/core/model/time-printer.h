@@ -20,6 +20,8 @@
 namespace ns3
 {
 
+class Time;
+
 /**
  * Function signature for features requiring a time formatter,
  * such as logging or ShowProgress.
@@ -38,6 +40,14 @@ typedef void (*TimePrinter)(std::ostream& os);
  */
 void DefaultTimePrinter(std::ostream& os);
 
+/**
+ * Print a time in the format of DefaultTimePrinter().
+ *
+ * @param [in,out] os The output stream to print on.
+ * @param [in] time The time to print.
+ */
+void DefaultTimePrinter(std::ostream& os, const Time& time);
+
 } // namespace ns3
 
 #endif /* TIME_H */
@@ -55,6 +55,13 @@ class TimerImpl
      * @returns The scheduled EventId.
      */
     virtual EventId Schedule(const Time& delay) = 0;
+    /**
+     * Create an event which invokes the callback with the current arguments,
+     * without scheduling it.
+     *
+     * @returns The event, which the caller owns.
+     */
+    virtual EventImpl* MakeEvent() = 0;
     /** Invoke the expire function. */
     virtual void Invoke() = 0;
 };
@@ -110,6 +117,12 @@ MakeTimerImpl(U(fn)(Ts...))
                 m_arguments);
         }
 
+        EventImpl* MakeEvent() override
+        {
+            return std::apply([this](Ts... args) { return ns3::MakeEvent(m_fn, args...); },
+                              m_arguments);
+        }
+
         void Invoke() override
         {
             std::apply([this](Ts... args) { (m_fn)(args...); }, m_arguments);
@@ -159,6 +172,13 @@ MakeTimerImpl(U (V::*memPtr)(Ts...), OBJ_PTR objPtr)
                 m_arguments);
         }
 
+        EventImpl* MakeEvent() override
+        {
+            return std::apply(
+                [this](Ts... args) { return ns3::MakeEvent(std::bind(m_memPtr, args...)); },
+                m_arguments);
+        }
+
         void Invoke() override
         {
             std::apply(m_memPtr, m_arguments);
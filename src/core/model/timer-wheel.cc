@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#include "timer-wheel.h"
+
+#include "assert.h"
+#include "global-value.h"
+#include "log.h"
+#include "make-event.h"
+#include "simulation-singleton.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::TimerWheel implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TimerWheel");
+
+/**
+ * @ingroup timer
+ * The tick length of the TimerWheel.
+ *
+ * Shorter ticks put fewer expirations at a time in the simulator event
+ * queue, at the cost of more frequent tick events.
+ */
+static GlobalValue g_timerWheelGranularity =
+    GlobalValue("TimerWheelGranularity",
+                "The tick length of the wheel of the timers in Timer::WHEEL_MODE",
+                TimeValue(MilliSeconds(1)),
+                MakeTimeChecker());
+
+bool
+TimerWheel::Entry::IsPending() const
+{
+    return !m_done;
+}
+
+Time
+TimerWheel::Entry::GetDelayLeft() const
+{
+    if (m_done)
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(m_ts - Simulator::Now().GetTimeStep());
+}
+
+void
+TimerWheel::Entry::Cancel()
+{
+    if (m_done)
+    {
+        return;
+    }
+    m_done = true;
+    // Release the bound arguments now; an event already scheduled in the
+    // simulator finds the entry done and does nothing
+    m_event = nullptr;
+    if (m_wheel != nullptr)
+    {
+        m_wheel->Unlink(this);
+    }
+}
+
+void
+TimerWheel::Entry::Expire()
+{
+    if (m_done)
+    {
+        return;
+    }
+    m_done = true;
+    Ptr<EventImpl> event = m_event;
+    m_event = nullptr;
+    event->Invoke();
+}
+
+TimerWheel::TimerWheel()
+    : m_now(Simulator::Now().GetTimeStep()),
+      m_seq(0),
+      m_size(0),
+      m_scheduledCount(0),
+      m_nextTick(NO_TICK)
+{
+    NS_LOG_FUNCTION(this);
+    TimeValue granularity;
+    g_timerWheelGranularity.GetValue(granularity);
+    m_granularity = std::max<int64_t>(granularity.Get().GetTimeStep(), 1);
+    m_now /= m_granularity;
+    m_slots.fill(nullptr);
+    m_tails.fill(nullptr);
+    m_occupied.fill(0);
+}
+
+TimerWheel::~TimerWheel()
+{
+    NS_LOG_FUNCTION(this);
+    for (uint32_t slot = 0; slot <= OVERFLOW_SLOT; slot++)
+    {
+        while (m_slots[slot] != nullptr)
+        {
+            m_slots[slot]->Cancel();
+        }
+    }
+    m_tickEvent.Cancel();
+}
+
+TimerWheel*
+TimerWheel::Get()
+{
+    return SimulationSingleton<TimerWheel>::Get();
+}
+
+Ptr<TimerWheel::Entry>
+TimerWheel::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(delay << event);
+    NS_ASSERT_MSG(delay.IsPositive(), "TimerWheel::Schedule(): Negative delay");
+    TimerWheel* wheel = Get();
+
+    // Catch up with the current time, without going past a slot which
+    // still has to be processed
+    uint64_t now = Simulator::Now().GetTimeStep();
+    if (now / wheel->m_granularity > wheel->m_now)
+    {
+        uint64_t next = wheel->GetNextTick();
+        wheel->m_now = std::min(now / wheel->m_granularity, next == NO_TICK ? next : next - 1);
+    }
+
+    Ptr<Entry> entry = Create<Entry>();
+    entry->m_ts = now + delay.GetTimeStep();
+    entry->m_seq = wheel->m_seq++;
+    entry->m_context = Simulator::GetContext();
+    entry->m_event = Ptr<EventImpl>(event, false);
+    wheel->Insert(PeekPointer(entry));
+    wheel->ScheduleTick();
+    return entry;
+}
+
+uint64_t
+TimerWheel::GetSize() const
+{
+    return m_size;
+}
+
+uint64_t
+TimerWheel::GetScheduledCount() const
+{
+    return m_scheduledCount;
+}
+
+Time
+TimerWheel::GetGranularity() const
+{
+    return TimeStep(m_granularity);
+}
+
+void
+TimerWheel::Insert(Entry* entry)
+{
+    uint64_t tick = entry->m_ts / m_granularity;
+    if (tick <= m_now)
+    {
+        ScheduleEntry(entry);
+        return;
+    }
+    // The lowest level whose slots cover both the current tick and the
+    // expiration tick
+    for (uint32_t level = 0; level < LEVELS; level++)
+    {
+        uint32_t shift = BITS * (level + 1);
+        if ((tick >> shift) == (m_now >> shift))
+        {
+            Link(entry, level * SLOTS + ((tick >> (BITS * level)) & (SLOTS - 1)));
+            return;
+        }
+    }
+    Link(entry, OVERFLOW_SLOT);
+}
+
+void
+TimerWheel::Link(Entry* entry, uint32_t slot)
+{
+    entry->Ref();
+    entry->m_wheel = this;
+    entry->m_slot = slot;
+    entry->m_prev = m_tails[slot];
+    entry->m_next = nullptr;
+    if (m_tails[slot] != nullptr)
+    {
+        m_tails[slot]->m_next = entry;
+    }
+    else
+    {
+        m_slots[slot] = entry;
+    }
+    m_tails[slot] = entry;
+    if (slot < OVERFLOW_SLOT)
+    {
+        m_occupied[slot / SLOTS] |= uint64_t(1) << (slot % SLOTS);
+    }
+    m_size++;
+}
+
+void
+TimerWheel::Unlink(Entry* entry)
+{
+    uint32_t slot = entry->m_slot;
+    if (entry->m_prev != nullptr)
+    {
+        entry->m_prev->m_next = entry->m_next;
+    }
+    else
+    {
+        m_slots[slot] = entry->m_next;
+    }
+    if (entry->m_next != nullptr)
+    {
+        entry->m_next->m_prev = entry->m_prev;
+    }
+    else
+    {
+        m_tails[slot] = entry->m_prev;
+    }
+    if (m_slots[slot] == nullptr && slot < OVERFLOW_SLOT)
+    {
+        m_occupied[slot / SLOTS] &= ~(uint64_t(1) << (slot % SLOTS));
+    }
+    entry->m_wheel = nullptr;
+    entry->m_prev = nullptr;
+    entry->m_next = nullptr;
+    m_size--;
+    entry->Unref();
+}
+
+void
+TimerWheel::ScheduleEntry(Entry* entry)
+{
+    m_scheduledCount++;
+    Time delay = TimeStep(entry->m_ts - Simulator::Now().GetTimeStep());
+    Simulator::ScheduleWithContext(entry->m_context,
+                                   delay,
+                                   MakeEvent(&Entry::Expire, Ptr<Entry>(entry)));
+}
+
+uint64_t
+TimerWheel::GetNextTick() const
+{
+    // The slots of a level are all later than those of the levels below
+    for (uint32_t level = 0; level < LEVELS; level++)
+    {
+        uint32_t index = (m_now >> (BITS * level)) & (SLOTS - 1);
+        uint64_t ahead = 0;
+        if (index < SLOTS - 1)
+        {
+            ahead = m_occupied[level] & (~uint64_t(0) << (index + 1));
+        }
+        if (ahead != 0)
+        {
+            uint32_t shift = BITS * (level + 1);
+            return ((m_now >> shift) << shift) |
+                   (uint64_t(std::countr_zero(ahead)) << (BITS * level));
+        }
+    }
+    if (m_slots[OVERFLOW_SLOT] != nullptr)
+    {
+        uint32_t shift = BITS * LEVELS;
+        return ((m_now >> shift) + 1) << shift;
+    }
+    return NO_TICK;
+}
+
+void
+TimerWheel::ScheduleTick()
+{
+    uint64_t next = GetNextTick();
+    if (next == NO_TICK || (m_tickEvent.IsPending() && m_nextTick <= next))
+    {
+        return;
+    }
+    m_tickEvent.Cancel();
+    m_nextTick = next;
+    Time delay = TimeStep(next * m_granularity - Simulator::Now().GetTimeStep());
+    m_tickEvent = Simulator::Schedule(delay, &TimerWheel::Tick, this);
+}
+
+void
+TimerWheel::Tick()
+{
+    NS_LOG_FUNCTION(this);
+    uint64_t previous = m_now;
+    m_now = Simulator::Now().GetTimeStep() / m_granularity;
+    m_nextTick = NO_TICK;
+    NS_ASSERT(m_now > previous);
+
+    // Spread the slots reached by the current tick into the lower levels,
+    // then schedule the expirations of the current tick in the simulator
+    std::vector<Ptr<Entry>> entries;
+    std::vector<Ptr<Entry>> due;
+    auto take = [this](uint32_t slot, std::vector<Ptr<Entry>>& list) {
+        while (m_slots[slot] != nullptr)
+        {
+            list.emplace_back(m_slots[slot]);
+            Unlink(m_slots[slot]);
+        }
+    };
+    if ((m_now >> (BITS * LEVELS)) != (previous >> (BITS * LEVELS)))
+    {
+        take(OVERFLOW_SLOT, entries);
+    }
+    for (uint32_t level = LEVELS - 1; level > 0; level--)
+    {
+        take(level * SLOTS + ((m_now >> (BITS * level)) & (SLOTS - 1)), entries);
+    }
+    for (const auto& entry : entries)
+    {
+        if (entry->m_ts / m_granularity == m_now)
+        {
+            due.push_back(entry);
+        }
+        else
+        {
+            Insert(PeekPointer(entry));
+        }
+    }
+    take(m_now & (SLOTS - 1), due);
+
+    // Entries cascaded from different levels are not in scheduling order
+    std::sort(due.begin(), due.end(), [](const Ptr<Entry>& a, const Ptr<Entry>& b) {
+        return a->m_ts < b->m_ts || (a->m_ts == b->m_ts && a->m_seq < b->m_seq);
+    });
+    for (const auto& entry : due)
+    {
+        ScheduleEntry(PeekPointer(entry));
+    }
+    NS_LOG_LOGIC("tick " << m_now << ": " << due.size() << " expirations, " << m_size
+                         << " entries left");
+    ScheduleTick();
+}
+
+} // namespace ns3
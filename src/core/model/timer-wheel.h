@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "event-id.h"
+#include "event-impl.h"
+#include "nstime.h"
+#include "ptr.h"
+#include "simple-ref-count.h"
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::TimerWheel declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup timer
+ * @brief A hashed hierarchical timing wheel for the expirations of
+ * Timer objects in Timer::WHEEL_MODE.
+ *
+ * There is one wheel per simulation, created on first use and deleted by
+ * Simulator::Destroy(). Time is divided in ticks of the
+ * \c TimerWheelGranularity global value. The wheel has LEVELS levels of
+ * SLOTS slots each: level 0 holds the expirations of the next SLOTS
+ * ticks, one slot per tick, and each level above covers SLOTS times the
+ * range of the level below. Expirations beyond the last level wait in an
+ * overflow list.
+ *
+ * The wheel keeps a single event in the simulator, at the start of the
+ * next non-empty slot. When the event runs, the expirations of a
+ * higher-level slot are spread into the lower levels, and those of a
+ * level 0 slot are scheduled in the simulator at their exact time and in
+ * the context of the Timer::Schedule() call. Timers cancelled before
+ * their slot is reached, which is the common case of retransmission
+ * timers, never reach the simulator event queue.
+ *
+ * Timers with the same expiration time expire in the order they were
+ * scheduled, but their order with respect to other events with the same
+ * timestamp may differ from the Timer::SCHEDULER_MODE.
+ *
+ * The wheel is not thread-safe: it must not be used with the
+ * multithreaded simulator implementation.
+ */
+class TimerWheel
+{
+  public:
+    /**
+     * @brief An expiration stored in the wheel.
+     *
+     * The Timer keeps a reference to its entry to query and cancel it.
+     */
+    class Entry : public SimpleRefCount<Entry>
+    {
+      public:
+        /** @returns \c true if the entry has neither expired nor been cancelled. */
+        bool IsPending() const;
+        /** @returns The time left until the entry expires, or zero. */
+        Time GetDelayLeft() const;
+        /**
+         * Cancel the entry: it is removed from the wheel, or its event is
+         * cancelled if it has already been scheduled in the simulator.
+         */
+        void Cancel();
+
+      private:
+        friend class TimerWheel;
+
+        /** Invoke the expiration event from the simulator. */
+        void Expire();
+
+        uint64_t m_ts{0};             //!< Expiration timestamp
+        uint64_t m_seq{0};            //!< Insertion order in the wheel
+        uint32_t m_context{0};        //!< Context of the expiration event
+        uint32_t m_slot{0};           //!< Slot index in the wheel
+        bool m_done{false};           //!< Expired or cancelled
+        Ptr<EventImpl> m_event;       //!< The expiration function
+        TimerWheel* m_wheel{nullptr}; //!< Wheel holding the entry, while in a slot
+        Entry* m_prev{nullptr};       //!< Previous entry in the slot
+        Entry* m_next{nullptr};       //!< Next entry in the slot
+    };
+
+    /** Constructor. */
+    TimerWheel();
+    /** Destructor: the pending entries never expire. */
+    ~TimerWheel();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * Schedule an expiration in the wheel of the current simulation.
+     *
+     * @param [in] delay The delay until the expiration.
+     * @param [in] event The expiration function.
+     * @returns The wheel entry.
+     */
+    static Ptr<Entry> Schedule(const Time& delay, EventImpl* event);
+
+    /** @returns The wheel of the current simulation. */
+    static TimerWheel* Get();
+
+    /** @returns The number of entries in the slots of the wheel. */
+    uint64_t GetSize() const;
+    /** @returns The number of entries scheduled in the simulator so far. */
+    uint64_t GetScheduledCount() const;
+    /** @returns The tick granularity. */
+    Time GetGranularity() const;
+
+  private:
+    /** Number of bits of the slot index in each level. */
+    static constexpr uint32_t BITS = 6;
+    /** Number of slots in each level. */
+    static constexpr uint32_t SLOTS = 1 << BITS;
+    /** Number of levels. */
+    static constexpr uint32_t LEVELS = 4;
+    /** Index of the overflow list in m_slots. */
+    static constexpr uint32_t OVERFLOW_SLOT = LEVELS * SLOTS;
+    /** Value of m_nextTick when no tick event is scheduled. */
+    static constexpr uint64_t NO_TICK = UINT64_MAX;
+
+    /**
+     * Insert an entry in the slot of its tick, or schedule it in the
+     * simulator if its tick has been reached.
+     *
+     * @param [in] entry The entry.
+     */
+    void Insert(Entry* entry);
+    /**
+     * Append an entry to a slot.
+     *
+     * @param [in] entry The entry.
+     * @param [in] slot The slot index in m_slots.
+     */
+    void Link(Entry* entry, uint32_t slot);
+    /**
+     * Remove an entry from its slot.
+     *
+     * @param [in] entry The entry.
+     */
+    void Unlink(Entry* entry);
+    /**
+     * Schedule the expiration event of an entry in the simulator.
+     *
+     * @param [in] entry The entry, which is no longer in a slot.
+     */
+    void ScheduleEntry(Entry* entry);
+    /** @returns The next tick at which a slot must be processed, or NO_TICK. */
+    uint64_t GetNextTick() const;
+    /** Schedule the tick event at the next tick, if it moved earlier. */
+    void ScheduleTick();
+    /** Process the slots of the current tick. */
+    void Tick();
+
+    uint64_t m_granularity;                            //!< Tick length, in time steps
+    uint64_t m_now;                                    //!< Last processed tick
+    uint64_t m_seq;                                    //!< Next entry insertion order
+    uint64_t m_size;                                   //!< Number of entries in the slots
+    uint64_t m_scheduledCount;                         //!< Entries scheduled in the simulator
+    std::array<Entry*, LEVELS * SLOTS + 1> m_slots;    //!< Head of each slot
+    std::array<Entry*, LEVELS * SLOTS + 1> m_tails;    //!< Tail of each slot
+    std::array<uint64_t, LEVELS> m_occupied;           //!< Non-empty slots of each level
+    uint64_t m_nextTick;                               //!< Tick of the tick event
+    EventId m_tickEvent;                               //!< The tick event
+};
+
+} // namespace ns3
+
+#endif /* TIMER_WHEEL_H */
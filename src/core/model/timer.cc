@@ -40,23 +40,28 @@ Timer::Timer(DestroyPolicy destroyPolicy)
     NS_LOG_FUNCTION(this << destroyPolicy);
 }
 
+Timer::Timer(DestroyPolicy destroyPolicy, Mode mode)
+    : m_flags(destroyPolicy | (mode == WHEEL_MODE ? TIMER_WHEEL : 0)),
+      m_delay(),
+      m_event(),
+      m_impl(nullptr)
+{
+    NS_LOG_FUNCTION(this << destroyPolicy << mode);
+}
+
 Timer::~Timer()
 {
     NS_LOG_FUNCTION(this);
     if (m_flags & CHECK_ON_DESTROY)
     {
-        if (m_event.IsPending())
+        if (IsPending())
         {
             NS_FATAL_ERROR("Event is still running while destroying.");
         }
     }
-    else if (m_flags & CANCEL_ON_DESTROY)
-    {
-        m_event.Cancel();
-    }
-    else if (m_flags & REMOVE_ON_DESTROY)
+    else
     {
-        m_event.Remove();
+        DoCancel();
     }
     delete m_impl;
 }
@@ -82,7 +87,7 @@ Timer::GetDelayLeft() const
     switch (GetState())
     {
     case Timer::RUNNING:
-        return Simulator::GetDelayLeft(m_event);
+        return (m_flags & TIMER_WHEEL) ? m_entry->GetDelayLeft() : Simulator::GetDelayLeft(m_event);
     case Timer::EXPIRED:
         return TimeStep(0);
     case Timer::SUSPENDED:
@@ -97,28 +102,59 @@ void
 Timer::Cancel()
 {
     NS_LOG_FUNCTION(this);
-    m_event.Cancel();
+    if (m_flags & TIMER_WHEEL)
+    {
+        if (m_entry)
+        {
+            m_entry->Cancel();
+        }
+    }
+    else
+    {
+        m_event.Cancel();
+    }
 }
 
 void
 Timer::Remove()
 {
     NS_LOG_FUNCTION(this);
-    m_event.Remove();
+    if (m_flags & TIMER_WHEEL)
+    {
+        // An entry still in the wheel is removed by Cancel()
+        if (m_entry)
+        {
+            m_entry->Cancel();
+        }
+    }
+    else
+    {
+        m_event.Remove();
+    }
 }
 
 bool
 Timer::IsExpired() const
 {
     NS_LOG_FUNCTION(this);
-    return !IsSuspended() && m_event.IsExpired();
+    return !IsSuspended() && !IsPending();
 }
 
 bool
 Timer::IsRunning() const
 {
     NS_LOG_FUNCTION(this);
-    return !IsSuspended() && m_event.IsPending();
+    return !IsSuspended() && IsPending();
+}
+
+bool
+Timer::IsPending() const
+{
+    if (m_flags & TIMER_WHEEL)
+    {
+        return m_entry && m_entry->IsPending();
+    }
+    return m_event.IsPending();
 }
 
 bool
@@ -147,6 +183,13 @@ Timer::GetState() const
     }
 }
 
+Timer::Mode
+Timer::GetMode() const
+{
+    NS_LOG_FUNCTION(this);
+    return (m_flags & TIMER_WHEEL) ? WHEEL_MODE : SCHEDULER_MODE;
+}
+
 void
 Timer::Schedule()
 {
@@ -159,20 +202,37 @@ Timer::Schedule(Time delay)
 {
     NS_LOG_FUNCTION(this << delay);
     NS_ASSERT(m_impl != nullptr);
-    if (m_event.IsPending())
+    if (IsPending())
     {
         NS_FATAL_ERROR("Event is still running while re-scheduling.");
     }
-    m_event = m_impl->Schedule(delay);
+    DoSchedule(delay);
 }
 
 void
-Timer::Suspend()
+Timer::DoSchedule(const Time& delay)
 {
-    NS_LOG_FUNCTION(this);
-    NS_ASSERT(IsRunning());
-    m_delayLeft = Simulator::GetDelayLeft(m_event);
-    if (m_flags & CANCEL_ON_DESTROY)
+    if (m_flags & TIMER_WHEEL)
+    {
+        m_entry = TimerWheel::Schedule(delay, m_impl->MakeEvent());
+    }
+    else
+    {
+        m_event = m_impl->Schedule(delay);
+    }
+}
+
+void
+Timer::DoCancel()
+{
+    if (m_flags & TIMER_WHEEL)
+    {
+        if (m_entry && (m_flags & (CANCEL_ON_DESTROY | REMOVE_ON_DESTROY)))
+        {
+            m_entry->Cancel();
+        }
+    }
+    else if (m_flags & CANCEL_ON_DESTROY)
     {
         m_event.Cancel();
     }
@@ -180,6 +240,15 @@ Timer::Suspend()
     {
         m_event.Remove();
     }
+}
+
+void
+Timer::Suspend()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(IsRunning());
+    m_delayLeft = GetDelayLeft();
+    DoCancel();
     m_flags |= TIMER_SUSPENDED;
 }
 
@@ -188,7 +257,7 @@ Timer::Resume()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_flags & TIMER_SUSPENDED);
-    m_event = m_impl->Schedule(m_delayLeft);
+    DoSchedule(m_delayLeft);
     m_flags &= ~TIMER_SUSPENDED;
 }
 
@@ -11,6 +11,7 @@
 #include "event-id.h"
 #include "fatal-error.h"
 #include "nstime.h"
+#include "timer-wheel.h"
 
 /**
  * @file
@@ -61,6 +62,12 @@ class TimerImpl;
  * management policies. These policies are specified at construction time
  * and cannot be changed after.
  *
+ * A timer constructed in WHEEL_MODE stores its expiration in the
+ * TimerWheel of the simulation instead of scheduling one event per
+ * expiration, which keeps the simulator event queue small when many
+ * timers are rescheduled or cancelled long before they expire, like
+ * retransmission timers.
+ *
  * @see Watchdog for a simpler interface for a watchdog timer.
  */
 class Timer
@@ -97,6 +104,20 @@ class Timer
         CHECK_ON_DESTROY = (1 << 5)
     };
 
+    /** Where a running timer stores its expiration. */
+    enum Mode
+    {
+        /** Schedule one simulator event for each expiration. */
+        SCHEDULER_MODE,
+        /**
+         * Store the expiration in the TimerWheel of the simulation, which
+         * schedules it in the simulator only shortly before it expires.
+         * Cancelling or removing the timer then costs constant time,
+         * whatever the DestroyPolicy.
+         */
+        WHEEL_MODE,
+    };
+
     /** The possible states of the Timer. */
     enum State
     {
@@ -115,6 +136,12 @@ class Timer
      * to use for destroy events
      */
     Timer(DestroyPolicy destroyPolicy);
+    /**
+     * @param [in] destroyPolicy the event lifetime management policies
+     * to use for destroy events
+     * @param [in] mode Where the timer stores its expiration
+     */
+    Timer(DestroyPolicy destroyPolicy, Mode mode);
     ~Timer();
 
     /**
@@ -192,6 +219,10 @@ class Timer
      * @returns The current state of the timer.
      */
     Timer::State GetState() const;
+    /**
+     * @returns Where the timer stores its expiration.
+     */
+    Timer::Mode GetMode() const;
     /**
      * Schedule a new event using the currently-configured delay, function,
      * and arguments.
@@ -228,9 +259,21 @@ class Timer
   private:
     /** Internal bit marking the suspended timer state */
     static constexpr auto TIMER_SUSPENDED{1 << 7};
+    /** Internal bit marking the WHEEL_MODE */
+    static constexpr auto TIMER_WHEEL{1 << 6};
+
+    /** @returns \c true if the expiration is scheduled and not cancelled. */
+    bool IsPending() const;
+    /** Cancel the scheduled expiration, according to the DestroyPolicy. */
+    void DoCancel();
+    /**
+     * Schedule the expiration.
+     * @param [in] delay The delay until the expiration.
+     */
+    void DoSchedule(const Time& delay);
 
     /**
-     * Bitfield for Timer State, DestroyPolicy and InternalSuspended.
+     * Bitfield for Timer State, DestroyPolicy, Mode and InternalSuspended.
      *
      * @internal
      * The DestroyPolicy, State and InternalSuspended state are stored
@@ -243,6 +286,8 @@ class Timer
     Time m_delay;
     /** The future event scheduled to expire the timer. */
     EventId m_event;
+    /** The wheel entry of the timer in WHEEL_MODE. */
+    Ptr<TimerWheel::Entry> m_entry;
     /**
      * The timer implementation, which contains the bound callback
      * function and arguments.
@@ -11,7 +11,7 @@
 
 #include "callback.h"
 
-#include <list>
+#include <vector>
 
 /**
  * @file
@@ -36,6 +36,14 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * Most trace sources have no Callback connected, or a single one.
+ * The first Callback is stored inline, and the others in a contiguous
+ * vector, so that invoking an empty chain only tests a pointer. The
+ * arguments are still passed by value, since models bind operator()
+ * with MakeCallback, so the per-packet call sites, and those which must
+ * build their arguments, for example by copying a packet, should check
+ * IsEmpty() first.
+ *
  * @tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -98,12 +106,21 @@ class TracedCallback
 
   private:
     /**
-     * Container type for holding the chain of Callbacks.
+     * Append a Callback to the chain.
+     *
+     * @param [in] callback Callback to add to chain.
+     */
+    void Append(const Callback<void, Ts...>& callback);
+
+    /**
+     * Container type for holding the chain of Callbacks after the first.
      *
      * @tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+    /** The first Callback of the chain, or a null Callback if it is empty. */
+    Callback<void, Ts...> m_first;
+    /** The rest of the chain, empty if m_first is null. */
     CallbackList m_callbackList;
 };
 
@@ -118,10 +135,25 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_first(),
+      m_callbackList()
 {
 }
 
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Append(const Callback<void, Ts...>& callback)
+{
+    if (m_first.IsNull())
+    {
+        m_first = callback;
+    }
+    else
+    {
+        m_callbackList.push_back(callback);
+    }
+}
+
 template <typename... Ts>
 void
 TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
@@ -131,7 +163,7 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    Append(cb);
 }
 
 template <typename... Ts>
@@ -144,7 +176,7 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
         NS_FATAL_ERROR("when connecting to " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    Append(realCb);
 }
 
 template <typename... Ts>
@@ -162,6 +194,16 @@ TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
             i++;
         }
     }
+    if (!m_first.IsNull() && m_first.IsEqual(callback))
+    {
+        // Keep the chain order: the second Callback becomes the first
+        m_first.Nullify();
+        if (!m_callbackList.empty())
+        {
+            m_first = m_callbackList.front();
+            m_callbackList.erase(m_callbackList.begin());
+        }
+    }
 }
 
 template <typename... Ts>
@@ -181,9 +223,15 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    if (m_first.IsNull())
+    {
+        return;
+    }
+    m_first(args...);
+    // A Callback may connect another one: index the vector, which may grow
+    for (std::size_t i = 0; i < m_callbackList.size(); i++)
     {
-        (*i)(args...);
+        m_callbackList[i](args...);
     }
 }
 
@@ -191,7 +239,7 @@ template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
-    return m_callbackList.empty();
+    return m_first.IsNull();
 }
 
 } // namespace ns3
@@ -7,16 +7,25 @@
  */
 #include "type-id.h"
 
+#include "environment-variable.h"
 #include "hash.h"
 #include "log.h" // NS_ASSERT and NS_LOG
 #include "singleton.h"
 #include "trace-source-accessor.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <map>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#ifndef __WIN32__
+#include <dlfcn.h>
+#endif
+
 /**
  * @file
  * @ingroup object
@@ -224,6 +233,11 @@ class IidManager : public Singleton<IidManager>
      * @returns The number of attributes associated to this TypeId
      */
     std::size_t GetAttributeN(uint16_t uid) const;
+    /**
+     * Get the number of changes to the attributes of all the types.
+     * @returns The number of attributes added and initial values set.
+     */
+    uint64_t GetAttributeChangeCount() const;
     /**
      * Get Attribute information by index.
      * @param [in] uid The id.
@@ -348,6 +362,9 @@ class IidManager : public Singleton<IidManager>
     /** The by-hash index. */
     hashmap_t m_hashmap;
 
+    /** The number of attributes added and initial values set. */
+    uint64_t m_attributeChanges{0};
+
     /** IidManager constants. */
     enum
     {
@@ -713,6 +730,7 @@ IidManager::AddAttribute(uint16_t uid,
     info.supportLevel = supportLevel;
     info.supportMsg = supportMsg;
     information->attributes.push_back(info);
+    m_attributeChanges++;
     NS_LOG_LOGIC(IIDL << information->attributes.size() - 1);
 }
 
@@ -725,6 +743,14 @@ IidManager::SetAttributeInitialValue(uint16_t uid,
     IidInformation* information = LookupInformation(uid);
     NS_ASSERT(i < information->attributes.size());
     information->attributes[i].initialValue = initialValue;
+    m_attributeChanges++;
+}
+
+uint64_t
+IidManager::GetAttributeChangeCount() const
+{
+    NS_LOG_FUNCTION(IID);
+    return m_attributeChanges;
 }
 
 std::size_t
@@ -834,10 +860,214 @@ IidManager::MustHideFromDocumentation(uint16_t uid) const
     return hide;
 }
 
-} // namespace ns3
+namespace
+{
 
-namespace ns3
+/**
+ * @ingroup object
+ * @brief The registrations of the types by NS_OBJECT_ENSURE_REGISTERED().
+ *
+ * This is used before main() by the static initializers, so it is held
+ * by a function local static, constructed on first use.
+ */
+struct Registrations
+{
+    /** Constructor. */
+    Registrations()
+        : lazy(EnvironmentVariable::Get("NS_TYPEID_LAZY").first),
+          pendingN(0)
+    {
+    }
+
+    /** A registration. */
+    struct Registration
+    {
+        const char* className; //!< The name of the class.
+        void (*function)();    //!< The registration function.
+        bool deferred;         //!< Whether the registration was deferred.
+        bool pending;          //!< Whether the registration is still deferred.
+        int64_t startNs;       //!< The start of the registration.
+        int64_t durationNs;    //!< The duration of the registration.
+    };
+
+    /**
+     * Run a registration.
+     *
+     * @param [in] i The index of the registration.
+     */
+    void Run(std::size_t i);
+    /**
+     * Run the deferred registrations.
+     *
+     * @param [in] name The name of a TypeId, to run only the registrations
+     *             of the classes with this name, or empty to run all of them.
+     */
+    void RunPending(std::string_view name);
+
+    bool lazy;                      //!< Whether to defer the registrations.
+    std::vector<Registration> list; //!< The registrations, in order.
+    std::unordered_multimap<std::string_view, std::size_t>
+        pending;          //!< The deferred registrations, by class name.
+    std::size_t pendingN; //!< The number of deferred registrations.
+};
+
+/**
+ * Get the time since the epoch of the steady clock.
+ *
+ * @returns The time, in ns.
+ */
+int64_t
+GetNowNs()
 {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void
+Registrations::Run(std::size_t i)
+{
+    list[i].startNs = GetNowNs();
+    list[i].function();
+    list[i].durationNs = GetNowNs() - list[i].startNs;
+}
+
+void
+Registrations::RunPending(std::string_view name)
+{
+    if (name.empty())
+    {
+        for (std::size_t i = 0; i < list.size() && pendingN > 0; ++i)
+        {
+            if (list[i].pending)
+            {
+                list[i].pending = false;
+                pendingN--;
+                Run(i);
+            }
+        }
+        pending.clear();
+        return;
+    }
+    // The TypeId name is the namespace followed by the class name, and the
+    // template arguments, if any.
+    std::size_t scope = name.rfind("::", name.find('<'));
+    if (scope != std::string_view::npos)
+    {
+        name.remove_prefix(scope + 2);
+    }
+    auto [begin, end] = pending.equal_range(name);
+    std::vector<std::size_t> indexes;
+    for (auto it = begin; it != end; ++it)
+    {
+        indexes.push_back(it->second);
+    }
+    pending.erase(begin, end);
+    for (auto i : indexes)
+    {
+        if (list[i].pending)
+        {
+            list[i].pending = false;
+            pendingN--;
+            Run(i);
+        }
+    }
+}
+
+/**
+ * Get the registrations.
+ *
+ * @returns The registrations.
+ */
+Registrations&
+GetRegistrations()
+{
+    static Registrations registrations;
+    return registrations;
+}
+
+/**
+ * Run the deferred registrations which may define a TypeId.
+ *
+ * @param [in] name The name of the TypeId, or empty for all the TypeIds.
+ * @returns \c true if some registrations were run.
+ */
+bool
+RunPendingRegistrations(std::string_view name = {})
+{
+    Registrations& registrations = GetRegistrations();
+    if (registrations.pendingN == 0)
+    {
+        return false;
+    }
+    registrations.RunPending(name);
+    return true;
+}
+
+/**
+ * Get the uid of a TypeId by name, running the deferred registrations
+ * if it is not registered yet.
+ *
+ * The registrations of the classes with the same name as the TypeId are
+ * run first, then all of them if the TypeId is still not found.
+ *
+ * @param [in] name The name of the TypeId.
+ * @returns The uid, or 0 if it is not found.
+ */
+uint16_t
+GetRegisteredUid(const std::string& name)
+{
+    uint16_t uid = IidManager::Get()->GetUid(name);
+    if (uid == 0 && RunPendingRegistrations(name))
+    {
+        uid = IidManager::Get()->GetUid(name);
+        if (uid == 0 && RunPendingRegistrations())
+        {
+            uid = IidManager::Get()->GetUid(name);
+        }
+    }
+    return uid;
+}
+
+/**
+ * Get the uid of a TypeId by hash, running the deferred registrations
+ * if it is not registered yet.
+ *
+ * @param [in] hash The hash of the TypeId.
+ * @returns The uid, or 0 if it is not found.
+ */
+uint16_t
+GetRegisteredUid(TypeId::hash_t hash)
+{
+    uint16_t uid = IidManager::Get()->GetUid(hash);
+    if (uid == 0 && RunPendingRegistrations())
+    {
+        uid = IidManager::Get()->GetUid(hash);
+    }
+    return uid;
+}
+
+/**
+ * Get the name of the library which contains a function.
+ *
+ * @param [in] function The function.
+ * @returns The file name of the library, without its directory.
+ */
+std::string
+GetLibraryName(void (*function)())
+{
+#ifndef __WIN32__
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void*>(function), &info) != 0 && info.dli_fname != nullptr)
+    {
+        std::string name = info.dli_fname;
+        return name.substr(name.find_last_of('/') + 1);
+    }
+#endif
+    return "unknown";
+}
+
+} // unnamed namespace
 
 /*********************************************************************
  *         The TypeId class
@@ -872,7 +1102,7 @@ TypeId
 TypeId::LookupByName(std::string name)
 {
     NS_LOG_FUNCTION(name);
-    uint16_t uid = IidManager::Get()->GetUid(name);
+    uint16_t uid = GetRegisteredUid(name);
     NS_ASSERT_MSG(uid, "Assert in TypeId::LookupByName: " << name << " not found");
     if (IidManager::Get()->GetDeprecatedName(uid) == name)
     {
@@ -886,7 +1116,7 @@ bool
 TypeId::LookupByNameFailSafe(std::string name, TypeId* tid)
 {
     NS_LOG_FUNCTION(name << tid->GetUid());
-    uint16_t uid = IidManager::Get()->GetUid(name);
+    uint16_t uid = GetRegisteredUid(name);
     if (uid == 0)
     {
         return false;
@@ -903,7 +1133,7 @@ TypeId::LookupByNameFailSafe(std::string name, TypeId* tid)
 TypeId
 TypeId::LookupByHash(hash_t hash)
 {
-    uint16_t uid = IidManager::Get()->GetUid(hash);
+    uint16_t uid = GetRegisteredUid(hash);
     NS_ASSERT_MSG(uid != 0,
                   "Assert in TypeId::LookupByHash: 0x" << std::hex << hash << std::dec
                                                        << " not found");
@@ -913,7 +1143,7 @@ TypeId::LookupByHash(hash_t hash)
 bool
 TypeId::LookupByHashFailSafe(hash_t hash, TypeId* tid)
 {
-    uint16_t uid = IidManager::Get()->GetUid(hash);
+    uint16_t uid = GetRegisteredUid(hash);
     if (uid == 0)
     {
         return false;
@@ -926,13 +1156,109 @@ uint16_t
 TypeId::GetRegisteredN()
 {
     NS_LOG_FUNCTION_NOARGS();
+    RunPendingRegistrations();
     return IidManager::Get()->GetRegisteredN();
 }
 
+uint64_t
+TypeId::GetAttributeChangeCount()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return IidManager::Get()->GetAttributeChangeCount();
+}
+
+void
+TypeId::Register(const char* className, void (*registration)())
+{
+    // This runs before main(), so it does not log
+    Registrations& registrations = GetRegistrations();
+    std::size_t i = registrations.list.size();
+    registrations.list.push_back({className, registration, registrations.lazy, false, 0, 0});
+    if (registrations.lazy)
+    {
+        registrations.list[i].pending = true;
+        registrations.pending.emplace(className, i);
+        registrations.pendingN++;
+    }
+    else
+    {
+        registrations.Run(i);
+    }
+}
+
+void
+TypeId::SetLazyRegistration(bool lazy)
+{
+    NS_LOG_FUNCTION(lazy);
+    GetRegistrations().lazy = lazy;
+}
+
+void
+TypeId::PrintStartupProfile(std::ostream& os)
+{
+    NS_LOG_FUNCTION(&os);
+
+    /** The registrations of a library. */
+    struct Library
+    {
+        std::size_t types{0};    //!< The number of registrations.
+        std::size_t deferred{0}; //!< The number of deferred registrations.
+        int64_t durationNs{0};   //!< The time spent in the registrations.
+        int64_t startNs{0};      //!< The start of the first registration.
+        int64_t endNs{0};        //!< The end of the last registration.
+    };
+
+    // Keep the libraries in the order of their initialization
+    std::vector<std::pair<std::string, Library>> libraries;
+    for (const auto& registration : GetRegistrations().list)
+    {
+        std::string name = GetLibraryName(registration.function);
+        auto it = std::find_if(libraries.begin(), libraries.end(), [&name](const auto& library) {
+            return library.first == name;
+        });
+        if (it == libraries.end())
+        {
+            it = libraries.insert(libraries.end(), {name, Library()});
+        }
+        Library& library = it->second;
+        library.types++;
+        if (registration.deferred)
+        {
+            library.deferred++;
+            continue;
+        }
+        library.durationNs += registration.durationNs;
+        if (library.startNs == 0)
+        {
+            library.startNs = registration.startNs;
+        }
+        library.endNs = registration.startNs + registration.durationNs;
+    }
+
+    Library total;
+    os << "Startup profile of the TypeId registrations:" << std::endl;
+    os << std::left << std::setw(40) << "library" << std::right << std::setw(8) << "types"
+       << std::setw(10) << "deferred" << std::setw(15) << "register (us)" << std::setw(12)
+       << "span (us)" << std::endl;
+    for (const auto& [name, library] : libraries)
+    {
+        os << std::left << std::setw(40) << name << std::right << std::setw(8) << library.types
+           << std::setw(10) << library.deferred << std::setw(15) << library.durationNs / 1000
+           << std::setw(12) << (library.endNs - library.startNs) / 1000 << std::endl;
+        total.types += library.types;
+        total.deferred += library.deferred;
+        total.durationNs += library.durationNs;
+    }
+    os << std::left << std::setw(40) << "total" << std::right << std::setw(8) << total.types
+       << std::setw(10) << total.deferred << std::setw(15) << total.durationNs / 1000
+       << std::endl;
+}
+
 TypeId
 TypeId::GetRegistered(uint16_t i)
 {
     NS_LOG_FUNCTION(i);
+    RunPendingRegistrations();
     return TypeId(IidManager::Get()->GetRegistered(i));
 }
 
@@ -1077,6 +1403,11 @@ TypeId::GetSize() const
 {
     NS_LOG_FUNCTION(this);
     std::size_t size = IidManager::Get()->GetSize(m_tid);
+    if (size == 0 && RunPendingRegistrations(GetName()))
+    {
+        // The type was registered by a direct call to GetTypeId()
+        size = IidManager::Get()->GetSize(m_tid);
+    }
     return size;
 }
 
@@ -176,6 +176,51 @@ class TypeId
      * @returns The TypeId instance whose index is \c i.
      */
     static TypeId GetRegistered(uint16_t i);
+    /**
+     * Get the number of changes to the attributes of all the TypeIds.
+     *
+     * The count increases when an attribute is added to a TypeId or
+     * when the initial value of an attribute is set, for example by
+     * Config::SetDefault(), so that the users which cache attribute
+     * information can tell when it is stale.
+     *
+     * @returns The number of changes to the attributes.
+     */
+    static uint64_t GetAttributeChangeCount();
+
+    /**
+     * Register a type with the TypeId system.
+     *
+     * This is called by NS_OBJECT_ENSURE_REGISTERED() and the related
+     * macros from the static initializers of the module libraries.
+     * The registration function calls the GetTypeId() method of the class.
+     * In the lazy registration mode the call is deferred until the type
+     * is first looked up by name or by hash, or until all the TypeIds
+     * are enumerated with GetRegisteredN().
+     *
+     * @param [in] className The name of the class, without namespace,
+     *             used to find the registration from the TypeId name.
+     * @param [in] registration The registration function.
+     */
+    static void Register(const char* className, void (*registration)());
+    /**
+     * Enable or disable the lazy registration mode.
+     *
+     * The lazy registration mode is enabled from the start of the program
+     * when the environment variable \c NS_TYPEID_LAZY is set.  Changing it
+     * only affects the types registered afterwards, for example by
+     * libraries loaded at run time.
+     *
+     * @param [in] lazy Whether to defer the registrations.
+     */
+    static void SetLazyRegistration(bool lazy);
+    /**
+     * Print the time spent in the registrations of the TypeIds at startup,
+     * for each module library.
+     *
+     * @param [in,out] os The output stream.
+     */
+    static void PrintStartupProfile(std::ostream& os);
 
     /**
      * Constructor.
@@ -6,12 +6,15 @@
 
 #include "wall-clock-synchronizer.h"
 
+#include "enum.h"
 #include "log.h"
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <ctime> // clock_t
 #include <mutex>
+#include <thread>
 
 /**
  * @file
@@ -30,11 +33,38 @@ TypeId
 WallClockSynchronizer::GetTypeId()
 {
     static TypeId tid =
-        TypeId("ns3::WallClockSynchronizer").SetParent<Synchronizer>().SetGroupName("Core");
+        TypeId("ns3::WallClockSynchronizer")
+            .SetParent<Synchronizer>()
+            .SetGroupName("Core")
+            .AddAttribute("WaitStrategy",
+                          "How to wait until the time of the next event.",
+                          EnumValue(SLEEP_SPIN),
+                          MakeEnumAccessor<WaitStrategy>(&WallClockSynchronizer::m_waitStrategy),
+                          MakeEnumChecker(SLEEP_SPIN, "SleepSpin", HYBRID, "Hybrid"))
+            .AddAttribute("SpinThreshold",
+                          "Time before the next event below which the Hybrid wait strategy "
+                          "busy-waits.",
+                          TimeValue(MicroSeconds(20)),
+                          MakeTimeAccessor(&WallClockSynchronizer::m_spinThreshold),
+                          MakeTimeChecker(Time(0)))
+            .AddAttribute("YieldThreshold",
+                          "Time before the next event below which the Hybrid wait strategy "
+                          "yields the processor instead of sleeping.",
+                          TimeValue(MicroSeconds(200)),
+                          MakeTimeAccessor(&WallClockSynchronizer::m_yieldThreshold),
+                          MakeTimeChecker(Time(0)))
+            .AddAttribute("SleepMargin",
+                          "Minimum time by which the Hybrid wait strategy shortens its "
+                          "sleeps; the margin grows with the observed sleep overshoots.",
+                          TimeValue(MicroSeconds(50)),
+                          MakeTimeAccessor(&WallClockSynchronizer::m_minSleepMargin),
+                          MakeTimeChecker(Time(0)));
     return tid;
 }
 
 WallClockSynchronizer::WallClockSynchronizer()
+    : m_sleepMargin(0),
+      m_condition(false)
 {
     NS_LOG_FUNCTION(this);
     //
@@ -102,6 +132,7 @@ WallClockSynchronizer::DoSetOrigin(uint64_t ns)
     //
     m_realtimeOriginNano = GetRealtime();
     NS_LOG_INFO("origin = " << m_realtimeOriginNano);
+    m_sleepMargin = m_minSleepMargin.GetNanoSeconds();
 }
 
 int64_t
@@ -170,6 +201,14 @@ WallClockSynchronizer::DoSynchronize(uint64_t nsCurrent, uint64_t nsDelay)
     // hand, print warning messages, or just ignore the situation and hope it will
     // go away.
     //
+    if (m_waitStrategy == HYBRID)
+    {
+        //
+        // The hybrid wait works on the absolute target time, which already
+        // accounts for the drift.
+        //
+        return HybridWait(nsCurrent + nsDelay);
+    }
     uint64_t ns = DriftCorrect(nsCurrent, nsDelay);
     NS_LOG_INFO("Synchronize ns = " << ns);
     //
@@ -332,6 +371,71 @@ WallClockSynchronizer::SleepWait(uint64_t ns)
     return finishedWaiting;
 }
 
+Time
+WallClockSynchronizer::GetSleepMargin() const
+{
+    return NanoSeconds(m_sleepMargin);
+}
+
+bool
+WallClockSynchronizer::HybridWait(uint64_t ns)
+{
+    NS_LOG_FUNCTION(this << ns);
+    auto spin = static_cast<uint64_t>(m_spinThreshold.GetNanoSeconds());
+    auto yield = static_cast<uint64_t>(m_yieldThreshold.GetNanoSeconds());
+    for (;;)
+    {
+        uint64_t nsNow = GetNormalizedRealtime();
+        if (nsNow >= ns)
+        {
+            return true;
+        }
+        if (m_condition)
+        {
+            return false;
+        }
+        uint64_t left = ns - nsNow;
+        if (left > yield + m_sleepMargin)
+        {
+            //
+            // Sleep until the yield threshold, early enough that the usual
+            // overshoot of the sleep does not take us past it.
+            //
+            uint64_t request = left - yield - m_sleepMargin;
+            SleepWait(request);
+            if (m_condition)
+            {
+                return false;
+            }
+            //
+            // Calibrate the margin: follow a larger overshoot at once, and
+            // decay slowly towards the smaller ones.
+            //
+            uint64_t elapsed = GetNormalizedRealtime() - nsNow;
+            uint64_t overshoot = elapsed > request ? elapsed - request : 0;
+            if (overshoot > m_sleepMargin)
+            {
+                m_sleepMargin = overshoot;
+            }
+            else
+            {
+                m_sleepMargin -= (m_sleepMargin - overshoot) / 16;
+            }
+            m_sleepMargin =
+                std::max<uint64_t>(m_sleepMargin, m_minSleepMargin.GetNanoSeconds());
+            NS_LOG_INFO("Sleep overshoot " << overshoot << " ns, margin " << m_sleepMargin);
+        }
+        else if (left > spin)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            return SpinWait(ns);
+        }
+    }
+}
+
 uint64_t
 WallClockSynchronizer::DriftCorrect(uint64_t nsNow, uint64_t nsDelay)
 {
@@ -7,6 +7,7 @@
 #ifndef WALL_CLOCK_CLOCK_SYNCHRONIZER_H
 #define WALL_CLOCK_CLOCK_SYNCHRONIZER_H
 
+#include "nstime.h"
 #include "synchronizer.h"
 
 #include <condition_variable>
@@ -51,6 +52,15 @@ namespace ns3
  * to use the function @c clock_nanosleep() to sleep until a simulation Time
  * specified by the caller.
  *
+ * The default \c SleepSpin wait strategy sleeps until the target time,
+ * then busy-waits for the sleep overshoot, so the wake-up latency of the
+ * system shows in the event times.  The \c Hybrid strategy sleeps until
+ * \pname{YieldThreshold} before the target time, less a margin which
+ * tracks the sleep overshoots, then yields the processor until
+ * \pname{SpinThreshold} before the target time, and busy-waits for the
+ * rest.  Less of the jitter of the wake-ups reaches the event times, at
+ * the cost of the processor time spent yielding and spinning.
+ *
  * @todo Add more on jiffies, sleep, processes, etc.
  *
  */
@@ -68,6 +78,21 @@ class WallClockSynchronizer : public Synchronizer
     /** Destructor. */
     ~WallClockSynchronizer() override;
 
+    /** How to wait until the time of the next event. */
+    enum WaitStrategy
+    {
+        SLEEP_SPIN, //!< Sleep until the target time, then spin.
+        HYBRID,     //!< Sleep, then yield, then spin, with calibrated thresholds.
+    };
+
+    /**
+     * Get the margin by which the Hybrid wait strategy currently shortens
+     * its sleeps, calibrated on their overshoots.
+     *
+     * @returns The margin.
+     */
+    Time GetSleepMargin() const;
+
     /** Conversion constant between &mu;s and ns. */
     static const uint64_t US_PER_NS = (uint64_t)1000;
     /** Conversion constant between &mu;s and seconds. */
@@ -114,6 +139,15 @@ class WallClockSynchronizer : public Synchronizer
      *          @c false if we returned because the condition was set.
      */
     bool SleepWait(uint64_t ns);
+    /**
+     * Wait with the HYBRID strategy until the normalized realtime equals the
+     * argument or the condition variable becomes @c true.
+     *
+     * @param [in] ns The target normalized real time we should wait for.
+     * @returns @c true if we reached the target time,
+     *          @c false if we returned because the condition was set.
+     */
+    bool HybridWait(uint64_t ns);
 
     // Inherited from Synchronizer
     void DoSetOrigin(uint64_t ns) override;
@@ -155,6 +189,17 @@ class WallClockSynchronizer : public Synchronizer
     /** Time recorded by DoEventStart. */
     uint64_t m_nsEventStart;
 
+    /** The wait strategy. */
+    WaitStrategy m_waitStrategy;
+    /** Time before the target time below which we busy-wait. */
+    Time m_spinThreshold;
+    /** Time before the target time below which we yield the processor. */
+    Time m_yieldThreshold;
+    /** Minimum margin subtracted from the sleeps. */
+    Time m_minSleepMargin;
+    /** Current margin subtracted from the sleeps, in ns, from their overshoots. */
+    uint64_t m_sleepMargin;
+
     /** Condition variable for thread synchronizer. */
     std::condition_variable m_conditionVariable;
     /** Mutex controlling access to the condition variable. */
@@ -19,6 +19,8 @@
 #include "ns3/traced-value.h"
 
 #include <sstream>
+#include <string>
+#include <vector>
 
 /**
  * @file
@@ -796,6 +798,222 @@ ObjectVectorTraceConfigTestCase::DoRun()
                           "Trace 1 did not provide expected context");
 }
 
+/**
+ * @ingroup config-tests
+ * Test for the ability to connect many trace sources at once.
+ */
+class ConnectManyConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ConnectManyConfigTestCase();
+
+    /** Destructor. */
+    ~ConnectManyConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback with context path.
+     * @param path The context path.
+     * @param old The old value.
+     * @param newValue The new value.
+     */
+    void TraceFirst(std::string path,
+                    int16_t old [[maybe_unused]],
+                    int16_t newValue [[maybe_unused]])
+    {
+        m_first.push_back(path);
+    }
+
+    /**
+     * Another trace callback with context path.
+     * @param path The context path.
+     * @param old The old value.
+     * @param newValue The new value.
+     */
+    void TraceSecond(std::string path,
+                     int16_t old [[maybe_unused]],
+                     int16_t newValue [[maybe_unused]])
+    {
+        m_second.push_back(path);
+    }
+
+  private:
+    void DoRun() override;
+
+    std::vector<std::string> m_first;  //!< Contexts of the first callback.
+    std::vector<std::string> m_second; //!< Contexts of the second callback.
+};
+
+ConnectManyConfigTestCase::ConnectManyConfigTestCase()
+    : TestCase("Check ConnectMany and the resolution of vector indexes")
+{
+}
+
+void
+ConnectManyConfigTestCase::DoRun()
+{
+    //
+    // Other test cases leave their objects in the root namespace, so name
+    // the root object to only match the objects of this test case.
+    //
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Names::Add("ConnectManyRoot", root);
+    std::string vector = "/Names/ConnectManyRoot/NodeA/NodeB/NodesB/";
+    Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+    root->SetNodeA(a);
+    Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject>();
+    a->SetNodeB(b);
+    std::vector<Ptr<ConfigTestObject>> objects;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        objects.push_back(CreateObject<ConfigTestObject>());
+        b->AddNodeB(objects.back());
+    }
+
+    //
+    // Indexes past the end of the vector are ignored, and matches are
+    // returned in index order whatever the order of the expression.
+    //
+    Config::MatchContainer matches = Config::LookupMatches(vector + "7|2|[0-1]");
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 3, "Unexpected number of matches");
+    NS_TEST_EXPECT_MSG_EQ(matches.GetMatchedPath(0), vector + "0/", "Unexpected first match");
+    NS_TEST_EXPECT_MSG_EQ(matches.GetMatchedPath(2), vector + "2/", "Unexpected last match");
+    matches = Config::LookupMatches(vector + "*");
+    NS_TEST_EXPECT_MSG_EQ(matches.GetN(), 4, "Unexpected number of matches");
+    matches = Config::LookupMatches(vector + "[3-7]");
+    NS_TEST_EXPECT_MSG_EQ(matches.GetN(), 1, "Unexpected number of matches");
+
+    //
+    // Connect two callbacks through the same leading path and one through
+    // another one.
+    //
+    Config::ConnectMany(
+        {{vector + "[0-1]|3/Source", MakeCallback(&ConnectManyConfigTestCase::TraceFirst, this)},
+         {vector + "2/Source", MakeCallback(&ConnectManyConfigTestCase::TraceFirst, this)},
+         {vector + "[0-1]|3/Source", MakeCallback(&ConnectManyConfigTestCase::TraceSecond, this)}});
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        objects[i]->SetAttribute("Source", IntegerValue(i));
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_first.size(), 4, "First callback not connected to all sources");
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_first[i],
+                              vector + std::to_string(i) + "/Source",
+                              "Unexpected context of the first callback");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_second.size(), 3, "Second callback not connected as expected");
+    NS_TEST_EXPECT_MSG_EQ(m_second[2],
+                          vector + "3/Source",
+                          "Unexpected context of the second callback");
+}
+
+/**
+ * @ingroup config-tests
+ * Test object whose TypeId gains attributes during the
+ * AttributeChangeConfigTestCase, and is not used by the other tests.
+ */
+class AttributeChangeConfigTestObject : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    AttributeChangeConfigTestObject()
+    {
+    }
+
+    /** Destructor */
+    ~AttributeChangeConfigTestObject() override
+    {
+    }
+
+    /**
+     * Set the Node attribute.
+     * @param [in] node The node.
+     */
+    void SetNode(Ptr<ConfigTestObject> node)
+    {
+        m_node = node;
+    }
+
+  private:
+    Ptr<ConfigTestObject> m_node; //!< The Node attribute
+};
+
+TypeId
+AttributeChangeConfigTestObject::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("AttributeChangeConfigTestObject")
+            .SetParent<Object>()
+            .AddAttribute("Node",
+                          "",
+                          PointerValue(),
+                          MakePointerAccessor(&AttributeChangeConfigTestObject::m_node),
+                          MakePointerChecker<ConfigTestObject>());
+    return tid;
+}
+
+/**
+ * @ingroup config-tests
+ * Test that the Resolver sees the attributes added to a TypeId after
+ * it looked up the attributes of this TypeId.
+ */
+class AttributeChangeConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    AttributeChangeConfigTestCase();
+
+    /** Destructor. */
+    ~AttributeChangeConfigTestCase() override
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+AttributeChangeConfigTestCase::AttributeChangeConfigTestCase()
+    : TestCase("Check that the Resolver sees the attributes added after a lookup")
+{
+}
+
+void
+AttributeChangeConfigTestCase::DoRun()
+{
+    Ptr<AttributeChangeConfigTestObject> root = CreateObject<AttributeChangeConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    root->SetNode(CreateObject<ConfigTestObject>());
+
+    // The attributes added by the previous runs stay in the TypeId
+    static uint32_t runs = 0;
+    std::string alias = "NodeAlias" + std::to_string(runs++);
+
+    Config::MatchContainer matches = Config::LookupMatches("/" + alias);
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 0, "Unexpected match of a missing attribute");
+
+    //
+    // Add an alias of the Node attribute, with the same accessor
+    //
+    TypeId tid = AttributeChangeConfigTestObject::GetTypeId();
+    TypeId::AttributeInformation info;
+    NS_TEST_ASSERT_MSG_EQ(tid.LookupAttributeByName("Node", &info), true, "Node not found");
+    tid.AddAttribute(alias, "", PointerValue(), info.accessor, info.checker);
+
+    matches = Config::LookupMatches("/" + alias);
+    NS_TEST_EXPECT_MSG_EQ(matches.GetN(), 1, "Added attribute not resolved");
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * @ingroup config-tests
  * Test for the ability to search attributes of parent classes
@@ -871,6 +1089,8 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new ConnectManyConfigTestCase);
+    AddTestCase(new AttributeChangeConfigTestCase);
 }
 
 /**
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include "ns3/int64x64-divider.h"
 #include "ns3/int64x64.h"
 #include "ns3/test.h"
 #include "ns3/valgrind.h" // Bug 1882
@@ -1106,6 +1107,104 @@ Int64x64InvertTestCase::DoRun()
     Check(1000000000000000LL);
 }
 
+/**
+ * @ingroup int64x64-tests
+ *
+ * Test: integral divisors, and Int64x64Divider.
+ */
+class Int64x64DividerTestCase : public TestCase
+{
+  public:
+    Int64x64DividerTestCase();
+    void DoRun() override;
+    /**
+     * Check the division of a numerator by a divisor.
+     * @param numerator The numerator.
+     * @param divisor The divisor.
+     */
+    void Check(const uint64_t numerator, const uint64_t divisor);
+};
+
+Int64x64DividerTestCase::Int64x64DividerTestCase()
+    : TestCase("Integral divisors and Int64x64Divider")
+{
+}
+
+void
+Int64x64DividerTestCase::Check(const uint64_t numerator, const uint64_t divisor)
+{
+    const int64x64_t n(numerator);
+    const int64x64_t d(divisor);
+    const int64x64_t q = n / d;
+
+    // The quotient is truncated: q * d <= n < (q + 2^-64) * d,
+    // where the products by an integer are exact
+    if (int64x64_t::implementation != int64x64_t::ld_impl)
+    {
+        const int64x64_t ulp(0, 1);
+        NS_TEST_ASSERT_MSG_EQ((q * d <= n),
+                              true,
+                              numerator << " / " << divisor << ": quotient too large");
+        NS_TEST_ASSERT_MSG_EQ((n < (q + ulp) * d),
+                              true,
+                              numerator << " / " << divisor << ": quotient too small");
+    }
+
+    const Int64x64Divider divider(divisor);
+    NS_TEST_ASSERT_MSG_EQ(divider.Divide(numerator),
+                          q,
+                          numerator << " / " << divisor << ": Int64x64Divider differs");
+}
+
+void
+Int64x64DividerTestCase::DoRun()
+{
+    std::cout << std::endl;
+    std::cout << GetParent()->GetName() << " Divider: " << GetName() << std::endl;
+
+    NS_TEST_ASSERT_MSG_EQ(int64x64_t(1) / int64x64_t(3),
+                          int64x64_t(0, 0x5555555555555555ULL),
+                          "1 / 3 not truncated");
+    NS_TEST_ASSERT_MSG_EQ(int64x64_t(-1) / int64x64_t(3),
+                          -int64x64_t(0, 0x5555555555555555ULL),
+                          "-1 / 3 not truncated toward zero");
+    NS_TEST_ASSERT_MSG_EQ(Int64x64Divider().GetDivisor(), 0, "Default divisor not zero");
+
+    const uint64_t divisors[] = {1,
+                                 2,
+                                 3,
+                                 7,
+                                 10,
+                                 1000,
+                                 56000,
+                                 1000000000,
+                                 0xffffffffULL,
+                                 0x100000001ULL,
+                                 100000000000ULL,
+                                 (1ULL << 62) + 1,
+                                 (1ULL << 63) - 1};
+    const uint64_t numerators[] =
+        {0, 1, 8, 12000, 0xffffffffULL, 1ULL << 40, (1ULL << 62) - 1, (1ULL << 63) - 1};
+    for (auto divisor : divisors)
+    {
+        for (auto numerator : numerators)
+        {
+            Check(numerator, divisor);
+        }
+    }
+
+    // Pseudo-random operands of every magnitude
+    uint64_t x = 1;
+    for (int i = 0; i < 10000; ++i)
+    {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        const uint64_t numerator = x >> (1 + (x >> 13) % 63);
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        const uint64_t divisor = (x >> (1 + (x >> 13) % 63)) | 1;
+        Check(numerator, divisor);
+    }
+}
+
 /**
  * @ingroup int64x64-tests
  *
@@ -1588,6 +1687,7 @@ class Int64x64TestSuite : public TestSuite
         AddTestCase(new Int64x64Bug863TestCase(), TestCase::Duration::QUICK);
         AddTestCase(new Int64x64Bug1786TestCase(), TestCase::Duration::QUICK);
         AddTestCase(new Int64x64InvertTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new Int64x64DividerTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new Int64x64DoubleTestCase(), TestCase::Duration::QUICK);
     }
 };
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/** Prefix the messages with a context, which must also be recorded. */
+#define NS_LOG_APPEND_CONTEXT std::clog << "[context] "
+
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifndef __WIN32__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup logbinary
+ * Binary logging test suite.
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup logbinary-tests Binary logging tests
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LogBinaryTest");
+
+namespace tests
+{
+
+/**
+ * @ingroup logbinary-tests
+ * A type printed through a non-const reference, as some models do.
+ */
+struct NonConstStreamable
+{
+    int value{3}; //!< The printed value.
+};
+
+/**
+ * Print a NonConstStreamable.
+ * @param [in,out] os The output stream.
+ * @param [in] streamable The value.
+ * @returns The output stream.
+ */
+std::ostream&
+operator<<(std::ostream& os, NonConstStreamable& streamable)
+{
+    return os << "streamable " << streamable.value;
+}
+
+/**
+ * @ingroup logbinary-tests
+ * Check that the decoded binary log is the text the messages print.
+ */
+class LogBinaryTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LogBinaryTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a simulation which logs messages of all kinds.
+     * @returns The text output of the messages, or an empty string for
+     * the binary logging.
+     */
+    std::string Log();
+
+    /** Log messages of all kinds. */
+    void LogMessages();
+
+    /**
+     * Log the parameters of a function.
+     * @param [in] i An integer.
+     * @param [in] s A string.
+     * @param [in] b A boolean.
+     * @param [in] c A character.
+     * @param [in] v A vector.
+     */
+    void LogParameters(int i, std::string s, bool b, char c, std::vector<uint16_t> v);
+
+    Ptr<Object> m_object; //!< An object, printed as a pointer in both logs.
+};
+
+LogBinaryTestCase::LogBinaryTestCase()
+    : TestCase("Check that binary logging gives the same messages as text logging")
+{
+}
+
+void
+LogBinaryTestCase::LogMessages()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_FUNCTION(this);
+    LogParameters(-3, "name", true, 'x', {1, 2, 3});
+
+    int64_t big = -1234567890123;
+    uint8_t byte = 'A';
+    const char* literal = "literal";
+    std::string string = "string";
+    NS_LOG_DEBUG("integers " << 42 << " " << -7 << " " << big << " " << 5U << " " << byte);
+    NS_LOG_INFO("floats " << 3.14159265 << " " << 1e-20 << " " << 2.5f);
+    NS_LOG_LOGIC("bool " << true << " " << false << " char " << 'c');
+    NS_LOG_WARN("strings " << literal << " " << string << " " << std::string_view("view"));
+    NS_LOG_ERROR("pointers " << this << " " << m_object << " " << static_cast<void*>(nullptr));
+    NS_LOG_DEBUG("time " << Seconds(1.5) << " after " << 7);
+    NS_LOG_DEBUG("manipulators " << 10 << " " << std::hex << 255 << " " << std::setw(6)
+                                 << std::left << 12 << "|" << 13);
+    NS_LOG_DEBUG("");
+    NonConstStreamable streamable;
+    int record = 5;
+    NS_LOG_DEBUG("non-const " << streamable << " record " << record);
+}
+
+void
+LogBinaryTestCase::LogParameters(int i, std::string s, bool b, char c, std::vector<uint16_t> v)
+{
+    NS_LOG_FUNCTION(this << i << s << b << c << v << 1.5);
+}
+
+std::string
+LogBinaryTestCase::Log()
+{
+    std::ostringstream text;
+    std::streambuf* clog = std::clog.rdbuf(text.rdbuf());
+
+    LogComponentEnable("LogBinaryTest", LOG_LEVEL_ALL);
+    LogComponentEnable("LogBinaryTest", LOG_PREFIX_ALL);
+    LogMessages();
+    Simulator::ScheduleWithContext(7, Seconds(2.25), &LogBinaryTestCase::LogMessages, this);
+    Simulator::Schedule(Seconds(3), &LogBinaryTestCase::LogMessages, this);
+    Simulator::Run();
+    LogComponentDisable("LogBinaryTest", LOG_PREFIX_ALL);
+    LogMessages();
+    LogComponentDisable("LogBinaryTest", LOG_LEVEL_ALL);
+    LogMessages();
+    Simulator::Destroy();
+
+    std::clog.rdbuf(clog);
+    return text.str();
+}
+
+void
+LogBinaryTestCase::DoRun()
+{
+    m_object = CreateObject<Object>();
+    std::string expected = Log();
+    NS_TEST_ASSERT_MSG_NE(expected, "", "No text output");
+
+    std::string filename = CreateTempDirFilename("log-binary.blog");
+    LogSetBinaryOutput(filename);
+    NS_TEST_ASSERT_MSG_EQ(LogIsBinaryEnabled(), true, "Binary logging not enabled");
+    std::string text = Log();
+    LogSetBinaryOutput("");
+    NS_TEST_ASSERT_MSG_EQ(LogIsBinaryEnabled(), false, "Binary logging not disabled");
+    NS_TEST_ASSERT_MSG_EQ(text, "", "Text output with binary logging");
+
+    std::ifstream is(filename, std::ios::binary);
+    std::ostringstream decoded;
+    NS_TEST_ASSERT_MSG_EQ(LogBinaryDecode(is, decoded), true, "Invalid binary log");
+    NS_TEST_ASSERT_MSG_EQ(decoded.str(), expected, "Different binary and text logs");
+    m_object = nullptr;
+
+    // Several threads record their context at once
+    const uint32_t threads = 4;
+    const uint32_t messages = 1000;
+    std::streambuf* clog = std::clog.rdbuf();
+    uint64_t dropped = LogBinaryGetDropped();
+    LogSetBinaryOutput(filename);
+    LogComponentEnable("LogBinaryTest", LOG_LEVEL_DEBUG);
+    std::vector<std::thread> loggers;
+    for (uint32_t i = 0; i < threads; ++i)
+    {
+        loggers.emplace_back([i]() {
+            for (uint32_t j = 0; j < messages; ++j)
+            {
+                NS_LOG_DEBUG("thread " << i << " message " << j);
+            }
+        });
+    }
+    for (auto& logger : loggers)
+    {
+        logger.join();
+    }
+    LogComponentDisable("LogBinaryTest", LOG_LEVEL_ALL);
+    LogSetBinaryOutput("");
+    NS_TEST_ASSERT_MSG_EQ(std::clog.rdbuf(), clog, "std::clog not restored");
+    std::ifstream threadLog(filename, std::ios::binary);
+    std::ostringstream threadText;
+    NS_TEST_ASSERT_MSG_EQ(LogBinaryDecode(threadLog, threadText), true, "Invalid binary log");
+    std::istringstream lines(threadText.str());
+    std::string line;
+    uint32_t count = 0;
+    while (std::getline(lines, line))
+    {
+        NS_TEST_EXPECT_MSG_EQ(line.rfind("[context] thread ", 0), 0, "Wrong message " << line);
+        count++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, threads * messages, "Messages lost");
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryGetDropped(), dropped, "Messages dropped while logging");
+}
+
+#ifndef __WIN32__
+/**
+ * @ingroup logbinary-tests
+ * Check that a child process created with fork() logs to a file of its own.
+ */
+class LogBinaryForkTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LogBinaryForkTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Decode a binary log.
+     * @param [in] filename The name of the binary log file.
+     * @returns The messages.
+     */
+    std::vector<std::string> Decode(const std::string& filename);
+};
+
+LogBinaryForkTestCase::LogBinaryForkTestCase()
+    : TestCase("Check the binary logging of the processes created with fork()")
+{
+}
+
+std::vector<std::string>
+LogBinaryForkTestCase::Decode(const std::string& filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    std::ostringstream text;
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryDecode(is, text), true, "Invalid binary log " << filename);
+    std::istringstream lines(text.str());
+    std::vector<std::string> messages;
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        messages.push_back(line);
+    }
+    return messages;
+}
+
+void
+LogBinaryForkTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("log-binary-fork.blog");
+    LogSetBinaryOutput(filename);
+    LogComponentEnable("LogBinaryTest", LOG_LEVEL_DEBUG);
+    NS_LOG_DEBUG("before fork");
+
+    // The child logs more than its ring buffer holds
+    const uint32_t messages = 50000;
+    pid_t pid = fork();
+    NS_TEST_ASSERT_MSG_NE(pid, -1, "fork() failed");
+    if (pid == 0)
+    {
+        // Do not hang the tests if the logging blocks
+        alarm(60);
+        for (uint32_t i = 0; i < messages; ++i)
+        {
+            NS_LOG_DEBUG("child message " << i);
+        }
+        LogSetBinaryOutput("");
+        _exit(0);
+    }
+    NS_LOG_DEBUG("after fork");
+    int status = 0;
+    waitpid(pid, &status, 0);
+    LogComponentDisable("LogBinaryTest", LOG_LEVEL_ALL);
+    LogSetBinaryOutput("");
+    NS_TEST_ASSERT_MSG_EQ((WIFEXITED(status) && WEXITSTATUS(status) == 0),
+                          true,
+                          "The child process failed with status " << status);
+
+    std::vector<std::string> parent = Decode(filename);
+    NS_TEST_ASSERT_MSG_EQ(parent.size(), 2U, "Wrong number of messages of the parent");
+    NS_TEST_EXPECT_MSG_EQ(parent[0], "[context] before fork", "Wrong message of the parent");
+    NS_TEST_EXPECT_MSG_EQ(parent[1], "[context] after fork", "Wrong message of the parent");
+    std::vector<std::string> child = Decode(filename + "." + std::to_string(pid));
+    NS_TEST_ASSERT_MSG_EQ(child.size(), messages, "Wrong number of messages of the child");
+    NS_TEST_EXPECT_MSG_EQ(child.empty() ? "" : child.back(),
+                          "[context] child message " + std::to_string(messages - 1),
+                          "Wrong message of the child");
+}
+#endif
+
+/**
+ * @ingroup logbinary-tests
+ * Binary logging test suite.
+ */
+class LogBinaryTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    LogBinaryTestSuite();
+};
+
+LogBinaryTestSuite::LogBinaryTestSuite()
+    : TestSuite("log-binary", Type::UNIT)
+{
+    AddTestCase(new LogBinaryTestCase());
+#ifndef __WIN32__
+    AddTestCase(new LogBinaryForkTestCase());
+#endif
+}
+
+/** Static variable for test initialization. */
+static LogBinaryTestSuite g_logBinaryTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
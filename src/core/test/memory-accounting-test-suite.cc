@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/memory-accounting.h"
+#include "ns3/object-factory.h"
+#include "ns3/object.h"
+#include "ns3/show-memory.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup memoryaccounting
+ * Memory accounting test suite.
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup memoryaccounting-tests Memory accounting tests
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup memoryaccounting-tests
+ * An object with some payload, to be counted.
+ */
+class MemoryAccountingTestObject : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::tests::MemoryAccountingTestObject")
+                                .SetParent<Object>()
+                                .SetGroupName("Core")
+                                .AddConstructor<MemoryAccountingTestObject>();
+        return tid;
+    }
+
+  private:
+    uint8_t m_payload[200]; //!< Payload
+};
+
+NS_OBJECT_ENSURE_REGISTERED(MemoryAccountingTestObject);
+
+/**
+ * Find the usage of an account.
+ * @param [in] name The name of the account.
+ * @returns The usage, or an empty usage if the account has not been used.
+ */
+MemoryAccounting::Usage
+FindUsage(const std::string& name)
+{
+    for (const auto& usage : MemoryAccounting::GetUsage())
+    {
+        if (usage.name == name)
+        {
+            return usage;
+        }
+    }
+    return {name, 0, 0, 0, 0};
+}
+
+/**
+ * @ingroup memoryaccounting-tests
+ * Check the accounting of the Objects by TypeId.
+ */
+class MemoryAccountingObjectTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MemoryAccountingObjectTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MemoryAccountingObjectTestCase::MemoryAccountingObjectTestCase()
+    : TestCase("Check the accounting of the objects")
+{
+}
+
+void
+MemoryAccountingObjectTestCase::DoRun()
+{
+    const std::string name = "ns3::tests::MemoryAccountingTestObject";
+    const auto size = static_cast<int64_t>(sizeof(MemoryAccountingTestObject));
+
+    Ptr<Object> before = CreateObject<MemoryAccountingTestObject>();
+    MemoryAccounting::Enable();
+    NS_TEST_ASSERT_MSG_EQ(MemoryAccounting::IsEnabled(), true, "Accounting not enabled");
+    std::vector<Ptr<Object>> objects;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        objects.push_back(CreateObject<MemoryAccountingTestObject>());
+    }
+    MemoryAccounting::Usage usage = FindUsage(name);
+    NS_TEST_EXPECT_MSG_EQ(usage.instances, 3, "Wrong number of instances");
+    NS_TEST_EXPECT_MSG_EQ(usage.bytes, 3 * size, "Wrong number of bytes");
+
+    // Objects created by an ObjectFactory are counted as well
+    ObjectFactory factory(name);
+    objects.push_back(factory.Create());
+    NS_TEST_EXPECT_MSG_EQ(FindUsage(name).instances, 4, "Factory object not counted");
+
+    MemoryAccounting::Enable(false);
+    objects.push_back(CreateObject<MemoryAccountingTestObject>());
+    NS_TEST_EXPECT_MSG_EQ(FindUsage(name).instances, 4, "Object counted while disabled");
+
+    // The objects created before or after the accounting are not released
+    before = nullptr;
+    objects.clear();
+    usage = FindUsage(name);
+    NS_TEST_EXPECT_MSG_EQ(usage.instances, 0, "Objects not released");
+    NS_TEST_EXPECT_MSG_EQ(usage.bytes, 0, "Bytes not released");
+    NS_TEST_EXPECT_MSG_EQ(usage.peakBytes, 4 * size, "Wrong peak bytes");
+    NS_TEST_EXPECT_MSG_EQ(usage.allocated, 4, "Wrong number of allocations");
+}
+
+/**
+ * @ingroup memoryaccounting-tests
+ * Check the accounting of the events and the ShowMemory reports.
+ */
+class MemoryAccountingShowTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MemoryAccountingShowTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record a usage report.
+     * @param [in] usage The usage.
+     */
+    void Usage(const std::vector<MemoryAccounting::Usage>& usage);
+
+    std::vector<MemoryAccounting::Usage> m_usage; //!< The last usage report
+    uint32_t m_reports;                           //!< The number of usage reports
+};
+
+MemoryAccountingShowTestCase::MemoryAccountingShowTestCase()
+    : TestCase("Check the accounting of the events and the memory reports")
+{
+}
+
+void
+MemoryAccountingShowTestCase::Usage(const std::vector<MemoryAccounting::Usage>& usage)
+{
+    m_usage = usage;
+    m_reports++;
+}
+
+void
+MemoryAccountingShowTestCase::DoRun()
+{
+    m_reports = 0;
+    std::ostringstream os;
+    {
+        ShowMemory memory(Seconds(1), os);
+        memory.TraceConnectWithoutContext(
+            "Usage",
+            MakeCallback(&MemoryAccountingShowTestCase::Usage, this));
+
+        int64_t events = FindUsage("ns3::EventImpl").instances;
+        std::vector<Ptr<Object>> objects;
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            Simulator::Schedule(Seconds(0.5) * (i + 1), [&objects]() {
+                objects.push_back(CreateObject<MemoryAccountingTestObject>());
+            });
+        }
+        NS_TEST_EXPECT_MSG_EQ(FindUsage("ns3::EventImpl").instances,
+                              events + 5,
+                              "Events not counted");
+
+        Simulator::Stop(Seconds(2.25));
+        Simulator::Run();
+        NS_TEST_EXPECT_MSG_EQ(m_reports, 2, "Wrong number of reports");
+        bool found = false;
+        for (const auto& usage : m_usage)
+        {
+            if (usage.name == "ns3::tests::MemoryAccountingTestObject")
+            {
+                NS_TEST_EXPECT_MSG_EQ(usage.instances, 4, "Wrong usage report");
+                found = true;
+            }
+        }
+        NS_TEST_EXPECT_MSG_EQ(found, true, "Object not in the usage report");
+        NS_TEST_EXPECT_MSG_EQ((os.str().find("+2.000000000s memory: ") != std::string::npos),
+                              true,
+                              "No memory report printed");
+        NS_TEST_EXPECT_MSG_EQ(
+            (os.str().find("  ns3::tests::MemoryAccountingTestObject") != std::string::npos),
+            true,
+            "Object not printed");
+        Simulator::Destroy();
+    }
+    MemoryAccounting::Enable(false);
+}
+
+/**
+ * @ingroup memoryaccounting-tests
+ * Memory accounting test suite.
+ */
+class MemoryAccountingTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    MemoryAccountingTestSuite();
+};
+
+MemoryAccountingTestSuite::MemoryAccountingTestSuite()
+    : TestSuite("memory-accounting", Type::UNIT)
+{
+    AddTestCase(new MemoryAccountingObjectTestCase());
+    AddTestCase(new MemoryAccountingShowTestCase());
+}
+
+/** Static variable for test initialization. */
+static MemoryAccountingTestSuite g_memoryAccountingTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
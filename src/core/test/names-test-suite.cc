@@ -700,6 +700,12 @@ FindPathTestCase::DoRun()
                           "/Names/Name/Child",
                           "Could not Names::Add and Names::FindPath a child Object");
 
+    Names::Rename("/Names/Name", "Renamed");
+    found = Names::FindPath(childOfObjectOne);
+    NS_TEST_ASSERT_MSG_EQ(found,
+                          "/Names/Renamed/Child",
+                          "Names::FindPath did not follow the rename of a parent Object");
+
     Ptr<TestObject> objectNotThere = CreateObject<TestObject>();
     found = Names::FindPath(objectNotThere);
     NS_TEST_ASSERT_MSG_EQ(found.empty(), true, "Unexpectedly found a non-existent Object");
@@ -7,9 +7,14 @@
  *          Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/assert.h"
+#include "ns3/config.h"
 #include "ns3/object-factory.h"
 #include "ns3/object.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 /**
  * @file
@@ -147,10 +152,53 @@ class DerivedB : public BaseB
     }
 };
 
+/**
+ * @ingroup object-tests
+ * Object with attributes, to test the construction plans of ObjectFactory.
+ */
+class FactoryObject : public ns3::Object
+{
+  public:
+    /**
+     * Register this type.
+     * @return The TypeId.
+     */
+    static ns3::TypeId GetTypeId()
+    {
+        static ns3::TypeId tid =
+            ns3::TypeId("ObjectTest:FactoryObject")
+                .SetParent<Object>()
+                .SetGroupName("Core")
+                .HideFromDocumentation()
+                .AddConstructor<FactoryObject>()
+                .AddAttribute("Value",
+                              "A value set by the factory.",
+                              ns3::UintegerValue(1),
+                              ns3::MakeUintegerAccessor(&FactoryObject::m_value),
+                              ns3::MakeUintegerChecker<uint32_t>())
+                .AddAttribute("Other",
+                              "A value left to its default.",
+                              ns3::UintegerValue(2),
+                              ns3::MakeUintegerAccessor(&FactoryObject::m_other),
+                              ns3::MakeUintegerChecker<uint32_t>())
+                .AddAttribute("Stream",
+                              "A random variable created for each object.",
+                              ns3::StringValue("ns3::ConstantRandomVariable[Constant=3]"),
+                              ns3::MakePointerAccessor(&FactoryObject::m_stream),
+                              ns3::MakePointerChecker<ns3::RandomVariableStream>());
+        return tid;
+    }
+
+    uint32_t m_value;                              //!< The Value attribute
+    uint32_t m_other;                              //!< The Other attribute
+    ns3::Ptr<ns3::RandomVariableStream> m_stream; //!< The Stream attribute
+};
+
 NS_OBJECT_ENSURE_REGISTERED(BaseA);
 NS_OBJECT_ENSURE_REGISTERED(DerivedA);
 NS_OBJECT_ENSURE_REGISTERED(BaseB);
 NS_OBJECT_ENSURE_REGISTERED(DerivedB);
+NS_OBJECT_ENSURE_REGISTERED(FactoryObject);
 
 } // unnamed namespace
 
@@ -521,6 +569,92 @@ UnidirectionalAggregateObjectTestCase::DoRun()
                           "Can GetObject (through baseB) for BaseA Object");
 }
 
+/**
+ * @ingroup object-tests
+ * Test the cache of the GetObject() lookups of an aggregation.
+ */
+class GetObjectCacheTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    GetObjectCacheTestCase();
+    /** Destructor. */
+    ~GetObjectCacheTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+GetObjectCacheTestCase::GetObjectCacheTestCase()
+    : TestCase("Check the cache of the Object aggregation lookups")
+{
+}
+
+GetObjectCacheTestCase::~GetObjectCacheTestCase()
+{
+}
+
+void
+GetObjectCacheTestCase::DoRun()
+{
+    TypeId baseATid = BaseA::GetTypeId();
+    TypeId baseBTid = BaseB::GetTypeId();
+    TypeId derivedATid = DerivedA::GetTypeId();
+    TypeId derivedBTid = DerivedB::GetTypeId();
+
+    Ptr<BaseA> baseA = CreateObject<BaseA>();
+    Ptr<BaseB> baseB = CreateObject<BaseB>();
+    baseA->AggregateObject(baseB);
+
+    //
+    // The first lookup searches the aggregates, the next ones hit the cache,
+    // which is shared by all the aggregated Objects.
+    //
+    uint64_t hits = Object::GetObjectCacheHits();
+    uint64_t misses = Object::GetObjectCacheMisses();
+#ifdef NS3_MTP
+    // The cache is disabled
+    uint64_t expectedHits = hits;
+    uint64_t expectedMisses = misses;
+#else
+    uint64_t expectedHits = hits + 2;
+    uint64_t expectedMisses = misses + 1;
+#endif
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(baseBTid), baseB, "Cannot GetObject BaseB");
+    NS_TEST_ASSERT_MSG_EQ(Object::GetObjectCacheMisses(), expectedMisses, "Lookup not searched");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(baseBTid), baseB, "Cannot GetObject BaseB");
+    NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<BaseB>(baseBTid), baseB, "Cannot GetObject BaseB");
+    NS_TEST_ASSERT_MSG_EQ(Object::GetObjectCacheHits(), expectedHits, "Lookup not cached");
+    NS_TEST_ASSERT_MSG_EQ(Object::GetObjectCacheMisses(), expectedMisses, "Lookup not cached");
+    NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<BaseA>(baseATid), baseA, "Cannot GetObject BaseA");
+
+    //
+    // Lookups which fail are not cached, and a new aggregation is found.
+    //
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedA>(derivedATid),
+                          nullptr,
+                          "Unexpectedly found a DerivedA");
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA>();
+    baseB->AggregateObject(derivedA);
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedA>(derivedATid),
+                          derivedA,
+                          "Cannot GetObject DerivedA after a new aggregation");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(baseBTid), baseB, "Cannot GetObject BaseB");
+
+    //
+    // Unidirectional aggregates are only visible from their own Object,
+    // so finding them must not fill the shared cache.
+    //
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+    derivedA->UnidirectionalAggregateObject(derivedB);
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<DerivedB>(derivedBTid),
+                          derivedB,
+                          "Cannot GetObject the unidirectional DerivedB");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(derivedBTid),
+                          nullptr,
+                          "Unexpectedly found the unidirectional DerivedB");
+}
+
 /**
  * @ingroup object-tests
  * Test an Object factory can create Objects
@@ -606,6 +740,65 @@ ObjectFactoryTestCase::DoRun()
                           "Unexpectedly able to work around C++ type system");
 }
 
+/**
+ * @ingroup object-tests
+ * Test the construction plans compiled by an Object factory.
+ */
+class ObjectFactoryCompileTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ObjectFactoryCompileTestCase();
+    /** Destructor. */
+    ~ObjectFactoryCompileTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+ObjectFactoryCompileTestCase::ObjectFactoryCompileTestCase()
+    : TestCase("Check ObjectFactory construction plans")
+{
+}
+
+ObjectFactoryCompileTestCase::~ObjectFactoryCompileTestCase()
+{
+}
+
+void
+ObjectFactoryCompileTestCase::DoRun()
+{
+    ObjectFactory factory("ObjectTest:FactoryObject", "Value", StringValue("5"));
+
+    //
+    // The plan sets the factory values, converted from strings, and the
+    // defaults, but gives each Object its own random variable.
+    //
+    Ptr<const ObjectFactory::Plan> plan = factory.Compile();
+    Ptr<FactoryObject> a = plan->Create<FactoryObject>();
+    Ptr<FactoryObject> b = plan->Create<FactoryObject>();
+    NS_TEST_ASSERT_MSG_EQ(a->m_value, 5, "Factory value not set");
+    NS_TEST_ASSERT_MSG_EQ(b->m_value, 5, "Factory value not set");
+    NS_TEST_ASSERT_MSG_EQ(a->m_other, 2, "Default value not set");
+    NS_TEST_ASSERT_MSG_NE(a->m_stream, nullptr, "Random variable not created");
+    NS_TEST_ASSERT_MSG_NE(a->m_stream, b->m_stream, "Random variable shared by the objects");
+    NS_TEST_ASSERT_MSG_EQ(a->m_stream->GetValue(), 3, "Random variable not configured");
+
+    //
+    // The factory keeps its plan until its configuration or the defaults
+    // change, but a plan is immutable.
+    //
+    NS_TEST_ASSERT_MSG_EQ(factory.Compile(), plan, "Plan not cached by the factory");
+    Config::SetDefault("ObjectTest:FactoryObject::Other", UintegerValue(7));
+    NS_TEST_ASSERT_MSG_NE(factory.Compile(), plan, "Plan not recompiled for new defaults");
+    NS_TEST_ASSERT_MSG_EQ(factory.Create<FactoryObject>()->m_other, 7, "New default not used");
+    NS_TEST_ASSERT_MSG_EQ(plan->Create<FactoryObject>()->m_other, 2, "Plan is not immutable");
+    Config::SetDefault("ObjectTest:FactoryObject::Other", UintegerValue(2));
+
+    factory.Set("Value", UintegerValue(6));
+    NS_TEST_ASSERT_MSG_EQ(factory.Create<FactoryObject>()->m_value, 6, "New value not used");
+}
+
 /**
  * @ingroup object-tests
  * The Test Suite that glues the Test Cases together.
@@ -623,7 +816,9 @@ ObjectTestSuite::ObjectTestSuite()
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
     AddTestCase(new UnidirectionalAggregateObjectTestCase);
+    AddTestCase(new GetObjectCacheTestCase);
     AddTestCase(new ObjectFactoryTestCase);
+    AddTestCase(new ObjectFactoryCompileTestCase);
 }
 
 /**
@@ -0,0 +1,397 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup rng-tests
+ * RngStream sequences, backends and batches tests.
+ *
+ * Unlike the statistical tests of the random number generators, these
+ * tests do not need GSL, and are always built.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup rng-tests
+ *
+ * Test case for the sequence of the MRG32k3a generator, checked against
+ * the values of the generator before its numbers were buffered.
+ */
+class RngStreamKnownAnswerTestCase : public TestCase
+{
+  public:
+    RngStreamKnownAnswerTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+RngStreamKnownAnswerTestCase::RngStreamKnownAnswerTestCase()
+    : TestCase("Known answers of the MRG32k3a random number generator")
+{
+}
+
+void
+RngStreamKnownAnswerTestCase::DoRun()
+{
+    // The first values of the seed 12, stream 3, substream 1
+    const double expected[] = {
+        0.82347921428356252,  0.094409524378641765,  0.54537926019143457, 0.0083582389025282332,
+        0.024759832571736813, 0.71414098738257903,   0.36782003322303458, 0.6881994016341576,
+        0.31778102137578013,  0.87271557038762582,   0.6674319475018059,  0.60856567383316817,
+        0.35406013686314891,  0.45515710154377792,   0.68745510396330201, 0.41352158342778905,
+        0.042630533889669711, 0.39918455109707701,   0.9878311067514286,  0.64695294656935454,
+    };
+
+    RngStream single(12, 3, 1, RngStream::MRG32K3A);
+    for (double value : expected)
+    {
+        NS_TEST_ASSERT_MSG_EQ(single.RandU01(), value, "Wrong value drawn alone");
+    }
+
+    // The same values, drawn in batches of various sizes
+    RngStream batch(12, 3, 1, RngStream::MRG32K3A);
+    std::size_t i = 0;
+    for (std::size_t n : {1, 2, 5, 12})
+    {
+        std::vector<double> values(n);
+        batch.RandU01(values);
+        for (double value : values)
+        {
+            NS_TEST_ASSERT_MSG_EQ(value, expected[i], "Wrong value drawn in a batch");
+            i++;
+        }
+    }
+
+    // The first values of the seed 12345, stream 2^40, substream 7
+    RngStream other(12345, 1ULL << 40, 7, RngStream::MRG32K3A);
+    for (double value : {0.39756715476838134, 0.66978684773567709, 0.79724775180861651})
+    {
+        NS_TEST_ASSERT_MSG_EQ(other.RandU01(), value, "Wrong value of another stream");
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ *
+ * Test case for the sequence of the Philox4x32-10 generator, checked
+ * against the outputs of a reference implementation of Philox4x32-10
+ * which gives the known answers of its authors.
+ */
+class RngStreamPhiloxKnownAnswerTestCase : public TestCase
+{
+  public:
+    RngStreamPhiloxKnownAnswerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Convert a 32 bit output of Philox4x32-10 to the random number
+     * returned by RngStream.
+     * @param x The output.
+     * @returns The random number on (0,1).
+     */
+    static double ToU01(uint32_t x);
+};
+
+RngStreamPhiloxKnownAnswerTestCase::RngStreamPhiloxKnownAnswerTestCase()
+    : TestCase("Known answers of the Philox4x32-10 random number generator")
+{
+}
+
+double
+RngStreamPhiloxKnownAnswerTestCase::ToU01(uint32_t x)
+{
+    return (x + 0.5) / 4294967296.0;
+}
+
+void
+RngStreamPhiloxKnownAnswerTestCase::DoRun()
+{
+    // The first three blocks of the seed 12, stream 3, substream 1, whose
+    // key is 0x147eb49a 0x9904c9b5
+    const uint32_t expected[] = {
+        0xccfc577d, 0x114fb0d7, 0x8c8e6337, 0x13ca0815,
+        0x84aa07a5, 0x3fb86428, 0x0594e350, 0xa28415e8,
+        0x98c3cd64, 0xe6abc479, 0x71630c48, 0x871c1718,
+    };
+
+    RngStream single(12, 3, 1, RngStream::PHILOX4X32_10);
+    for (uint32_t value : expected)
+    {
+        NS_TEST_ASSERT_MSG_EQ(single.RandU01(), ToU01(value), "Wrong value drawn alone");
+    }
+
+    // The same values, drawn in batches which do not end on the blocks
+    RngStream batch(12, 3, 1, RngStream::PHILOX4X32_10);
+    std::size_t i = 0;
+    for (std::size_t n : {1, 2, 6, 3})
+    {
+        std::vector<double> values(n);
+        batch.RandU01(values);
+        for (double value : values)
+        {
+            NS_TEST_ASSERT_MSG_EQ(value, ToU01(expected[i]), "Wrong value drawn in a batch");
+            i++;
+        }
+    }
+
+    // The block 2^32 + 5 of the substream 2^33, which sets all the words
+    // of the counter; it is reached in constant time.
+    RngStream far(12, 3, 1ULL << 33, RngStream::PHILOX4X32_10);
+    far.Advance(((1ULL << 32) + 5) * 4);
+    for (uint32_t value : {0x2344352dU, 0x68ae3ac0U, 0x8f0caa51U, 0x580e592eU})
+    {
+        NS_TEST_ASSERT_MSG_EQ(far.RandU01(), ToU01(value), "Wrong value of a far block");
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ *
+ * Test case for the streams, substreams and skip ahead of the
+ * random number generation algorithms, and for the selection of the
+ * algorithm.
+ */
+class RngStreamBackendTestCase : public TestCase
+{
+  public:
+    RngStreamBackendTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the streams, substreams and skip ahead of a backend.
+     * @param backend The random number generation algorithm.
+     */
+    void Check(RngStream::Backend backend);
+};
+
+RngStreamBackendTestCase::RngStreamBackendTestCase()
+    : TestCase("Streams, substreams and skip ahead of the random number generators")
+{
+}
+
+void
+RngStreamBackendTestCase::Check(RngStream::Backend backend)
+{
+    RngStream a(12, 3, 1, backend);
+    RngStream b(12, 3, 1, backend);
+    RngStream otherSeed(13, 3, 1, backend);
+    RngStream otherStream(12, 4, 1, backend);
+    RngStream otherSubstream(12, 3, 2, backend);
+    NS_TEST_ASSERT_MSG_EQ(a.GetBackend(), backend, "Wrong backend");
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        double u = a.RandU01();
+        NS_TEST_ASSERT_MSG_EQ(u, b.RandU01(), "Same stream, different values");
+        NS_TEST_ASSERT_MSG_GT(u, 0.0, "Value out of (0,1)");
+        NS_TEST_ASSERT_MSG_LT(u, 1.0, "Value out of (0,1)");
+        NS_TEST_ASSERT_MSG_NE(u, otherSeed.RandU01(), "Different seeds, same values");
+        NS_TEST_ASSERT_MSG_NE(u, otherStream.RandU01(), "Different streams, same values");
+        NS_TEST_ASSERT_MSG_NE(u, otherSubstream.RandU01(), "Different substreams, same values");
+    }
+
+    // Skip ahead from various positions in the blocks and buffers
+    for (uint64_t n : {0, 1, 2, 3, 5, 16, 17, 1000, 1001})
+    {
+        RngStream skipped(a);
+        skipped.Advance(n);
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            a.RandU01();
+        }
+        NS_TEST_ASSERT_MSG_EQ(skipped.RandU01(), a.RandU01(), "Wrong skip ahead of " << n);
+        std::vector<double> values(7);
+        skipped.RandU01(values);
+        for (double value : values)
+        {
+            NS_TEST_ASSERT_MSG_EQ(value, a.RandU01(), "Wrong values after skip ahead");
+        }
+    }
+}
+
+void
+RngStreamBackendTestCase::DoRun()
+{
+    Check(RngStream::MRG32K3A);
+    Check(RngStream::PHILOX4X32_10);
+
+    uint32_t seed = RngSeedManager::GetSeed();
+    uint64_t run = RngSeedManager::GetRun();
+    RngSeedManager::SetSeed(12);
+    RngSeedManager::SetRun(1);
+
+    // The streams of the random variables use the backend selected with
+    // RngSeedManager::SetBackend() or with the "RngBackend" global value,
+    // and their assignment is reproducible with either backend.
+    for (auto backend : {RngStream::PHILOX4X32_10, RngStream::MRG32K3A})
+    {
+        RngSeedManager::SetBackend(backend);
+        NS_TEST_ASSERT_MSG_EQ(RngSeedManager::GetBackend(), backend, "Backend not selected");
+        Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable>();
+        Ptr<UniformRandomVariable> y = CreateObject<UniformRandomVariable>();
+        x->SetStream(7);
+        y->SetStream(7);
+        RngStream expected(12, (1ULL << 63) + 7, 1, backend);
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            double value = x->GetValue();
+            NS_TEST_ASSERT_MSG_EQ(value, y->GetValue(), "Same stream, different values");
+            NS_TEST_ASSERT_MSG_EQ(value, expected.RandU01(), "Wrong backend used");
+        }
+    }
+
+    Config::SetGlobal("RngBackend", StringValue("Philox4x32-10"));
+    NS_TEST_ASSERT_MSG_EQ(RngSeedManager::GetBackend(),
+                          RngStream::PHILOX4X32_10,
+                          "Backend not selected by the global value");
+    Ptr<UniformRandomVariable> z = CreateObject<UniformRandomVariable>();
+    z->SetStream(7);
+    RngStream expected(12, (1ULL << 63) + 7, 1, RngStream::PHILOX4X32_10);
+    NS_TEST_ASSERT_MSG_EQ(z->GetValue(), expected.RandU01(), "Wrong backend used");
+
+    RngSeedManager::SetBackend(RngStream::MRG32K3A);
+    RngSeedManager::SetSeed(seed);
+    RngSeedManager::SetRun(run);
+}
+
+/**
+ * @ingroup rng-tests
+ * Test case for the values drawn at once by RandomVariableStream::GetValues()
+ */
+class RngGetValuesTestCase : public TestCase
+{
+  public:
+    RngGetValuesTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that GetValues() returns the same values as GetValue(), with
+     * two random variables using the same stream.
+     *
+     * @param [in] x The random variable drawing the values one by one.
+     * @param [in] y The random variable drawing the values at once.
+     * @param [in] what The random variable, for the messages.
+     */
+    void Compare(Ptr<RandomVariableStream> x, Ptr<RandomVariableStream> y, std::string what);
+};
+
+RngGetValuesTestCase::RngGetValuesTestCase()
+    : TestCase("RandomVariableStream values drawn at once")
+{
+}
+
+void
+RngGetValuesTestCase::Compare(Ptr<RandomVariableStream> x,
+                              Ptr<RandomVariableStream> y,
+                              std::string what)
+{
+    x->SetStream(1);
+    y->SetStream(1);
+    // Mix single values and batches of various sizes
+    for (std::size_t n : {1, 3, 17, 100, 1, 1000})
+    {
+        std::vector<double> values(n);
+        y->GetValues(values);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(values[i], x->GetValue(), what << ": different value");
+        }
+        NS_TEST_ASSERT_MSG_EQ(y->GetValue(), x->GetValue(), what << ": different value");
+    }
+}
+
+void
+RngGetValuesTestCase::DoRun()
+{
+    for (auto backend : {RngStream::MRG32K3A, RngStream::PHILOX4X32_10})
+    {
+        RngSeedManager::SetBackend(backend);
+        for (bool antithetic : {false, true})
+        {
+            auto uniform = [antithetic]() {
+                auto x = CreateObject<UniformRandomVariable>();
+                x->SetAttribute("Min", DoubleValue(-3.0));
+                x->SetAttribute("Max", DoubleValue(7.0));
+                x->SetAttribute("Antithetic", BooleanValue(antithetic));
+                return x;
+            };
+            Compare(uniform(), uniform(), "uniform");
+
+            for (double bound : {0.0, 2.0})
+            {
+                auto exponential = [antithetic, bound]() {
+                    auto x = CreateObject<ExponentialRandomVariable>();
+                    x->SetAttribute("Bound", DoubleValue(bound));
+                    x->SetAttribute("Antithetic", BooleanValue(antithetic));
+                    return x;
+                };
+                Compare(exponential(), exponential(), "exponential");
+            }
+
+            auto normal = [antithetic]() {
+                auto x = CreateObject<NormalRandomVariable>();
+                x->SetAttribute("Antithetic", BooleanValue(antithetic));
+                return x;
+            };
+            Compare(normal(), normal(), "normal");
+
+            // The base implementation
+            auto pareto = [antithetic]() {
+                auto x = CreateObject<ParetoRandomVariable>();
+                x->SetAttribute("Antithetic", BooleanValue(antithetic));
+                return x;
+            };
+            Compare(pareto(), pareto(), "pareto");
+        }
+    }
+    RngSeedManager::SetBackend(RngStream::MRG32K3A);
+}
+
+/**
+ * @ingroup rng-tests
+ *
+ * RngStream test suite.
+ */
+class RngStreamTestSuite : public TestSuite
+{
+  public:
+    RngStreamTestSuite();
+};
+
+RngStreamTestSuite::RngStreamTestSuite()
+    : TestSuite("rng-stream", Type::UNIT)
+{
+    AddTestCase(new RngStreamKnownAnswerTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new RngStreamPhiloxKnownAnswerTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new RngStreamBackendTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new RngGetValuesTestCase, TestCase::Duration::QUICK);
+}
+
+static RngStreamTestSuite g_rngStreamTestSuite; //!< Static variable for test initialization
+
+} // namespace tests
+
+} // namespace ns3
@@ -5,6 +5,7 @@
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
 #include "ns3/test.h"
 
 #include <cmath>
@@ -63,7 +64,11 @@ class RngUniformTestCase : public TestCase
     /// Number of measurements.
     static const uint32_t N_MEASUREMENTS = 1000000;
 
-    RngUniformTestCase();
+    /**
+     * Constructor
+     * @param backend The random number generation algorithm to test.
+     */
+    RngUniformTestCase(RngStream::Backend backend = RngStream::MRG32K3A);
     ~RngUniformTestCase() override;
 
     /**
@@ -75,10 +80,15 @@ class RngUniformTestCase : public TestCase
 
   private:
     void DoRun() override;
+
+    /// The random number generation algorithm to test.
+    RngStream::Backend m_backend;
 };
 
-RngUniformTestCase::RngUniformTestCase()
-    : TestCase("Uniform Random Number Generator")
+RngUniformTestCase::RngUniformTestCase(RngStream::Backend backend)
+    : TestCase(backend == RngStream::MRG32K3A ? "Uniform Random Number Generator"
+                                              : "Uniform Random Number Generator, Philox4x32-10"),
+      m_backend(backend)
 {
 }
 
@@ -125,6 +135,7 @@ void
 RngUniformTestCase::DoRun()
 {
     RngSeedManager::SetSeed(static_cast<uint32_t>(time(nullptr)));
+    RngSeedManager::SetBackend(m_backend);
 
     double sum = 0.;
     double maxStatistic = gsl_cdf_chisq_Qinv(0.05, N_BINS);
@@ -137,6 +148,7 @@ RngUniformTestCase::DoRun()
     }
 
     sum /= (double)N_RUNS;
+    RngSeedManager::SetBackend(RngStream::MRG32K3A);
 
     NS_TEST_ASSERT_MSG_LT(sum, maxStatistic, "Chi-squared statistic out of range");
 }
@@ -480,6 +492,7 @@ RngTestSuite::RngTestSuite()
     : TestSuite("random-number-generators", Type::UNIT)
 {
     AddTestCase(new RngUniformTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new RngUniformTestCase(RngStream::PHILOX4X32_10), TestCase::Duration::QUICK);
     AddTestCase(new RngNormalTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RngExponentialTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RngParetoTestCase, TestCase::Duration::QUICK);
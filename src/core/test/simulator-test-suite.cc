@@ -5,13 +5,35 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/adaptive-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-impl.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
+#include "ns3/object.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/realtime-simulator-impl.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/wall-clock-synchronizer.h"
+
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace ns3;
 
@@ -703,6 +725,894 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check the event order of a Scheduler against a sorted set, with a
+ * large population of events spread over several orders of magnitude.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the event order of " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    std::set<Scheduler::EventKey> expected;
+    std::mt19937_64 rng(1);
+    uint32_t uid = 0;
+    uint64_t now = 0;
+
+    auto insert = [&](uint64_t delay) {
+        Scheduler::Event ev{nullptr, {now + delay, uid++, 0}};
+        scheduler->Insert(ev);
+        expected.insert(ev.key);
+    };
+
+    // Bursts of simultaneous events, short and very long delays
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        insert(rng() % 4 == 0 ? 0 : rng() % (uint64_t(1) << (rng() % 40)));
+    }
+    // Listing the events leaves the scheduler unchanged
+    std::vector<Scheduler::Event> events;
+    scheduler->GetEvents(events);
+    NS_TEST_ASSERT_MSG_EQ(events.size(), expected.size(), "Wrong number of events listed");
+    auto key = expected.begin();
+    for (const auto& ev : events)
+    {
+        NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, key->m_uid, "Wrong order of the events listed");
+        ++key;
+    }
+    while (!expected.empty())
+    {
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), false, "Scheduler lost events");
+        std::vector<Scheduler::Event> batch;
+        if (rng() % 4 == 0)
+        {
+            scheduler->RemoveNextBatch(batch);
+        }
+        else
+        {
+            batch.push_back(scheduler->RemoveNext());
+        }
+        for (const auto& next : batch)
+        {
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, expected.begin()->m_uid, "Wrong event order");
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_ts, expected.begin()->m_ts, "Wrong event time");
+            expected.erase(expected.begin());
+        }
+        now = batch.front().key.m_ts;
+        if (batch.size() > 1 && !expected.empty())
+        {
+            NS_TEST_ASSERT_MSG_NE(expected.begin()->m_ts, now, "Incomplete batch");
+        }
+
+        if (uid < 20000)
+        {
+            uint32_t n = rng() % 3;
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                insert(rng() % 8 == 0 ? 0 : rng() % (uint64_t(1) << (rng() % 30)));
+            }
+        }
+        if (!expected.empty() && rng() % 16 == 0)
+        {
+            // Remove a random pending event
+            auto it = expected.begin();
+            std::advance(it, rng() % std::min<std::size_t>(expected.size(), 100));
+            scheduler->Remove(Scheduler::Event{nullptr, *it});
+            expected.erase(it);
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler should be empty");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the events release their bound arguments, that
+ * the event pool serves the events in steady state, and that it bounds
+ * the free lists of a thread which releases the events of another one.
+ */
+class EventPoolTestCase : public TestCase
+{
+  public:
+    EventPoolTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Test event with a reference counted argument.
+     * @param object The bound object.
+     * @param value The value to add.
+     */
+    void Add(Ptr<Object> object, uint32_t value);
+
+    /** Schedule a round of member and lambda events. */
+    void ScheduleRound();
+
+    uint64_t m_sum;       //!< Sum of the event values
+    Ptr<Object> m_object; //!< Object bound to the events
+};
+
+EventPoolTestCase::EventPoolTestCase()
+    : TestCase("Check the event pool")
+{
+}
+
+void
+EventPoolTestCase::Add(Ptr<Object> object, uint32_t value)
+{
+    m_sum += value;
+}
+
+void
+EventPoolTestCase::ScheduleRound()
+{
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        Simulator::Schedule(NanoSeconds(i), &EventPoolTestCase::Add, this, m_object, i);
+        Ptr<Object> object = m_object;
+        Simulator::Schedule(NanoSeconds(i), [this, object]() { m_sum++; });
+    }
+}
+
+void
+EventPoolTestCase::DoRun()
+{
+    m_sum = 0;
+    m_object = CreateObject<Object>();
+    ScheduleRound();
+    NS_TEST_ASSERT_MSG_EQ(m_object->GetReferenceCount(), 201, "Every event holds a reference");
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_sum, 4950 + 100, "Events did not run");
+    NS_TEST_ASSERT_MSG_EQ(m_object->GetReferenceCount(), 1, "Events did not release the object");
+
+    EventImpl::PoolStatistics before = EventImpl::GetPoolStatistics();
+    ScheduleRound();
+    Simulator::Run();
+    EventImpl::PoolStatistics after = EventImpl::GetPoolStatistics();
+    Simulator::Destroy();
+    m_object = nullptr;
+
+    if (after.enabled)
+    {
+        NS_TEST_ASSERT_MSG_EQ(after.misses, before.misses, "Events were allocated from the heap");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(after.hits - before.hits, 200, "Events missed the pool");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(after.highWaterBytes, 200 * 16, "Wrong high water mark");
+    }
+
+    // Another thread allocates more events than a free list keeps, and
+    // this thread releases them.
+    const uint32_t nEvents = EventImpl::POOL_MAX_CACHED_BYTES / 16 + 100;
+    std::vector<EventImpl*> events;
+    std::thread producer([&events, nEvents]() {
+        for (uint32_t i = 0; i < nEvents; ++i)
+        {
+            events.push_back(MakeEvent([]() {}));
+        }
+    });
+    producer.join();
+    for (auto event : events)
+    {
+        event->Unref();
+    }
+    for (const auto& sizeClass : EventImpl::GetPoolStatistics().classes)
+    {
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(sizeClass.cached * sizeClass.size,
+                                    EventImpl::POOL_MAX_CACHED_BYTES,
+                                    "Unbounded free list of " << sizeClass.size << " bytes");
+    }
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check the batch dispatch modes of the DefaultSimulatorImpl.
+ *
+ * Three contexts each schedule two events at the same time. The first
+ * event of context 1 cancels and removes events of the batch and
+ * schedules a new event at the same time; the first event of context 2
+ * stops the simulation.
+ */
+class BatchDispatchTestCase : public TestCase
+{
+  public:
+    BatchDispatchTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Schedule the events of a context.
+     * @param context The context.
+     */
+    void Setup(uint32_t context);
+
+    /**
+     * Log an event and run its action.
+     * @param tag The event tag: ten times the context plus the event index.
+     */
+    void Event(uint32_t tag);
+
+    /**
+     * Run the events with a dispatch mode.
+     * @param mode The DispatchMode attribute value.
+     * @returns The tags of the events, in execution order, with a 0 tag
+     * separating the two runs.
+     */
+    std::vector<uint32_t> RunEvents(std::string mode);
+
+    std::map<uint32_t, EventId> m_ids; //!< Events by tag
+    std::vector<uint32_t> m_log;       //!< Executed event tags
+};
+
+BatchDispatchTestCase::BatchDispatchTestCase()
+    : TestCase("Check the batch dispatch of simultaneous events")
+{
+}
+
+void
+BatchDispatchTestCase::Setup(uint32_t context)
+{
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        uint32_t tag = 10 * context + i;
+        m_ids[tag] = Simulator::Schedule(MicroSeconds(1), &BatchDispatchTestCase::Event, this, tag);
+    }
+}
+
+void
+BatchDispatchTestCase::Event(uint32_t tag)
+{
+    m_log.push_back(tag);
+    NS_TEST_EXPECT_MSG_EQ(m_ids[tag].IsExpired(), true, "Running event " << tag);
+    if (tag == 10)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_ids[11].IsPending(), true, "Event 11 is pending");
+        NS_TEST_EXPECT_MSG_EQ(m_ids[21].IsPending(), true, "Event 21 is pending");
+        NS_TEST_EXPECT_MSG_EQ(Simulator::GetDelayLeft(m_ids[21]), Time(0), "Same time");
+        m_ids[31].Cancel();
+        Simulator::Remove(m_ids[21]);
+        NS_TEST_EXPECT_MSG_EQ(m_ids[21].IsExpired(), true, "Event 21 was removed");
+        m_ids[99] = Simulator::ScheduleNow(&BatchDispatchTestCase::Event, this, 99);
+    }
+    else if (tag == 20)
+    {
+        Simulator::Stop();
+    }
+}
+
+std::vector<uint32_t>
+BatchDispatchTestCase::RunEvents(std::string mode)
+{
+    Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl>();
+    impl->SetAttribute("DispatchMode", StringValue(mode));
+    Simulator::SetImplementation(impl);
+    m_ids.clear();
+    m_log.clear();
+    for (uint32_t context : {3, 1, 2})
+    {
+        Simulator::ScheduleWithContext(context,
+                                       Seconds(0),
+                                       &BatchDispatchTestCase::Setup,
+                                       this,
+                                       context);
+    }
+    Simulator::Run();
+    m_log.push_back(0);
+    Simulator::Run();
+    for (const auto& [tag, id] : m_ids)
+    {
+        NS_TEST_EXPECT_MSG_EQ(id.IsExpired(), true, "Event " << tag << " still pending");
+    }
+    Simulator::Destroy();
+    return m_log;
+}
+
+void
+BatchDispatchTestCase::DoRun()
+{
+    std::vector<uint32_t> expected{30, 31, 10, 11, 20, 0, 99};
+    std::vector<uint32_t> log = RunEvents("Single");
+    NS_TEST_ASSERT_MSG_EQ((log == expected), true, "Wrong order with Single");
+    log = RunEvents("Batch");
+    NS_TEST_ASSERT_MSG_EQ((log == expected), true, "Wrong order with Batch");
+
+    // The events of context 3 run after the stop, the new event after the batch
+    expected = {10, 11, 20, 0, 30, 99};
+    log = RunEvents("BatchByContext");
+    NS_TEST_ASSERT_MSG_EQ((log == expected), true, "Wrong order with BatchByContext");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the AdaptiveScheduler selects the backend suited to
+ * the workload, and keeps the event order when it migrates.
+ */
+class AdaptiveSchedulerTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param name The workload name.
+     * @param population The number of pending events.
+     * @param delay The function returning the delay of a new event.
+     * @param removes Whether to remove some events early.
+     * @param expected The expected backend.
+     */
+    AdaptiveSchedulerTestCase(std::string name,
+                              uint32_t population,
+                              std::function<uint64_t(std::mt19937_64&)> delay,
+                              bool removes,
+                              TypeId expected);
+    void DoRun() override;
+
+  private:
+    uint32_t m_population;                              //!< Pending events
+    std::function<uint64_t(std::mt19937_64&)> m_delay; //!< Delay of the new events
+    bool m_removes;                                     //!< Remove some events early
+    TypeId m_expected;                                  //!< Expected backend
+};
+
+AdaptiveSchedulerTestCase::AdaptiveSchedulerTestCase(
+    std::string name,
+    uint32_t population,
+    std::function<uint64_t(std::mt19937_64&)> delay,
+    bool removes,
+    TypeId expected)
+    : TestCase("Check the AdaptiveScheduler selection with " + name),
+      m_population(population),
+      m_delay(delay),
+      m_removes(removes),
+      m_expected(expected)
+{
+}
+
+void
+AdaptiveSchedulerTestCase::DoRun()
+{
+    ObjectFactory factory("ns3::AdaptiveScheduler");
+    factory.Set("SamplePeriod", UintegerValue(2000));
+    Ptr<AdaptiveScheduler> scheduler = factory.Create<AdaptiveScheduler>();
+    NS_TEST_ASSERT_MSG_EQ(scheduler->GetBackendTypeId(),
+                          MapScheduler::GetTypeId(),
+                          "Wrong initial backend");
+
+    std::mt19937_64 rng(1);
+    uint32_t uid = 0;
+    uint64_t now = 0;
+    for (uint32_t i = 0; i < m_population; ++i)
+    {
+        scheduler->Insert({nullptr, {m_delay(rng), uid++, 0}});
+    }
+    // Hold model: each event removed is replaced by a new one
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        Scheduler::Event ev = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(ev.key.m_ts, now, "Wrong event order");
+        now = ev.key.m_ts;
+        scheduler->Insert({nullptr, {now + m_delay(rng), uid++, 0}});
+        if (m_removes && i % 10 == 0)
+        {
+            Scheduler::Event timer{nullptr, {now + m_delay(rng), uid++, 0}};
+            scheduler->Insert(timer);
+            scheduler->Remove(timer);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->GetBackendTypeId(), m_expected, "Wrong backend");
+    if (m_expected != MapScheduler::GetTypeId())
+    {
+        NS_TEST_EXPECT_MSG_GT(scheduler->GetSwitchCount(), 0, "No switch from the initial backend");
+    }
+
+    // All the events are still there, in order
+    uint32_t count = 0;
+    while (!scheduler->IsEmpty())
+    {
+        Scheduler::Event ev = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(ev.key.m_ts, now, "Wrong event order");
+        now = ev.key.m_ts;
+        count++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, m_population, "Events lost by the migrations");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the DefaultSimulatorImpl removes the cancelled events
+ * from its scheduler when they make up most of the pending events.
+ */
+class CompactionTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    CompactionTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Test event.
+     * @param i The event index.
+     */
+    void Event(uint32_t i);
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+    std::vector<uint32_t> m_log;      //!< Executed event indexes
+    Time m_last;                      //!< Time of the last event
+};
+
+CompactionTestCase::CompactionTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the compaction of cancelled events with " +
+               schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+CompactionTestCase::Event(uint32_t i)
+{
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(Simulator::Now(), m_last, "Events out of order");
+    m_last = Simulator::Now();
+    m_log.push_back(i);
+}
+
+void
+CompactionTestCase::DoRun()
+{
+    Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl>();
+    impl->SetAttribute("CompactionMinEvents", UintegerValue(100));
+    Simulator::SetImplementation(impl);
+    Simulator::SetScheduler(m_schedulerFactory);
+    m_log.clear();
+    m_last = Seconds(0);
+
+    const uint32_t n = 1000;
+    // The destroy events are not in the scheduler
+    Simulator::Cancel(Simulator::ScheduleDestroy(&CompactionTestCase::Event, this, n));
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetCancelledEventCount(), 0, "Destroy event counted");
+
+    std::mt19937 rng(1);
+    std::vector<EventId> ids;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        ids.push_back(
+            Simulator::Schedule(MicroSeconds(rng() % 500), &CompactionTestCase::Event, this, i));
+    }
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        if (i % 3 != 0)
+        {
+            Simulator::Cancel(ids[i]);
+            ids[i].Cancel();
+        }
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(Simulator::GetCancelledEventCount(),
+                                    n / 2 + 1,
+                                    "Cancelled events were not compacted");
+    }
+    uint64_t compacted = Simulator::GetCompactedEventCount();
+    NS_TEST_ASSERT_MSG_GT(compacted, 0, "No compaction");
+    NS_TEST_ASSERT_MSG_EQ(compacted + Simulator::GetCancelledEventCount(),
+                          n - (n + 2) / 3,
+                          "Wrong number of cancelled events");
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(ids[i].IsPending(), (i % 3 == 0), "Event " << i);
+    }
+
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_log.size(), (n + 2) / 3, "Wrong number of events executed");
+    for (auto i : m_log)
+    {
+        NS_TEST_ASSERT_MSG_EQ(i % 3, 0, "Cancelled event " << i << " executed");
+    }
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetCancelledEventCount(), 0, "Cancelled events left");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetEventCount(), n, "Wrong event count");
+    Simulator::Destroy();
+    NS_TEST_ASSERT_MSG_EQ(m_log.size(), (n + 2) / 3, "Cancelled destroy event executed");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that Simulator::RunReplications() runs each replication
+ * with its own run number from a scenario built once.
+ */
+class RunReplicationsTestCase : public TestCase
+{
+  public:
+    RunReplicationsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+RunReplicationsTestCase::RunReplicationsTestCase()
+    : TestCase("Check the replications of a scenario built once")
+{
+}
+
+void
+RunReplicationsTestCase::DoRun()
+{
+    const uint32_t n = 5;
+    uint64_t run = RngSeedManager::GetRun();
+    uint32_t setups = 0;
+    double value = -1;
+    Ptr<UniformRandomVariable> var;
+
+    auto setup = [&]() {
+        setups++;
+        // A value drawn during the setup is shared by all replications
+        Ptr<UniformRandomVariable> setupVar = CreateObject<UniformRandomVariable>();
+        setupVar->SetStream(1);
+        setupVar->GetValue();
+        var = CreateObject<UniformRandomVariable>();
+        var->SetStream(2);
+        Simulator::Schedule(Seconds(1), [&]() { value = var->GetValue(); });
+    };
+    auto collect = [&]() {
+        std::ostringstream oss;
+        oss << std::setprecision(17) << value << " " << Simulator::Now().As(Time::S);
+        return oss.str();
+    };
+    std::vector<std::string> results = Simulator::RunReplications(n, setup, collect, 2);
+
+    NS_TEST_ASSERT_MSG_EQ(setups, 1, "The scenario was not built once");
+    NS_TEST_ASSERT_MSG_EQ(value, -1, "The simulation ran in the calling process");
+    NS_TEST_ASSERT_MSG_EQ(results.size(), n, "Wrong number of results");
+    std::set<std::string> distinct(results.begin(), results.end());
+    NS_TEST_ASSERT_MSG_EQ(distinct.size(), n, "Replications with the same values");
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        // The value drawn by an independent run with the same run number
+        RngSeedManager::SetRun(run + i);
+        Ptr<UniformRandomVariable> expected = CreateObject<UniformRandomVariable>();
+        expected->SetStream(2);
+        std::ostringstream oss;
+        oss << std::setprecision(17) << expected->GetValue() << " " << Seconds(1).As(Time::S);
+        NS_TEST_EXPECT_MSG_EQ(results[i], oss.str(), "Wrong result of replication " << i);
+    }
+    RngSeedManager::SetRun(run);
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that Simulator::RunBranches() resumes each branch from
+ * the state of the checkpoint.
+ */
+class RunBranchesTestCase : public TestCase
+{
+  public:
+    RunBranchesTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Count a tick and schedule the next one. */
+    void Tick();
+
+    uint32_t m_ticks;  //!< Number of ticks
+    Time m_interval;   //!< Interval between the ticks
+    EventId m_cancel;  //!< An event cancelled before the checkpoint
+};
+
+RunBranchesTestCase::RunBranchesTestCase()
+    : TestCase("Check the branches from a checkpoint")
+{
+}
+
+void
+RunBranchesTestCase::Tick()
+{
+    m_ticks++;
+    Simulator::Schedule(m_interval, &RunBranchesTestCase::Tick, this);
+}
+
+void
+RunBranchesTestCase::DoRun()
+{
+    m_ticks = 0;
+    m_interval = Seconds(1);
+    Simulator::Schedule(Seconds(1), &RunBranchesTestCase::Tick, this);
+    Simulator::Schedule(Seconds(15), []() {});
+    m_cancel = Simulator::Schedule(Seconds(20), []() {});
+    Simulator::Schedule(Seconds(5), [this]() { Simulator::Cancel(m_cancel); });
+    Simulator::Stop(Seconds(20.5));
+
+    auto branch = [this](uint32_t i) { m_interval = Seconds(1) / (i + 1); };
+    auto collect = [this]() {
+        std::ostringstream oss;
+        oss << m_ticks << " " << Simulator::Now().As(Time::S);
+        return oss.str();
+    };
+    std::vector<std::string> results =
+        Simulator::RunBranches(Seconds(10.5), 3, branch, collect, 2);
+
+    // The calling process stays at the checkpoint
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), Seconds(10.5), "Wrong checkpoint time");
+    NS_TEST_ASSERT_MSG_EQ(m_ticks, 10, "Wrong state at the checkpoint");
+    std::vector<EventId> pending = Simulator::GetPendingEvents();
+    NS_TEST_ASSERT_MSG_EQ(pending.size(), 3, "Wrong number of pending events");
+    NS_TEST_EXPECT_MSG_EQ(TimeStep(pending[0].GetTs()), Seconds(11), "Wrong pending tick");
+    NS_TEST_EXPECT_MSG_EQ(TimeStep(pending[1].GetTs()), Seconds(15), "Wrong pending event");
+    NS_TEST_EXPECT_MSG_EQ(TimeStep(pending[2].GetTs()), Seconds(20.5), "Wrong pending stop");
+
+    // The interval changes after the tick at 11 s, pending at the checkpoint
+    NS_TEST_ASSERT_MSG_EQ(results.size(), 3, "Wrong number of results");
+    NS_TEST_EXPECT_MSG_EQ(results[0], "20 +20.5s", "Wrong result of branch 0");
+    NS_TEST_EXPECT_MSG_EQ(results[1], "29 +20.5s", "Wrong result of branch 1");
+    NS_TEST_EXPECT_MSG_EQ(results[2], "39 +20.5s", "Wrong result of branch 2");
+
+    // The calling process can also continue without changes
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_ticks, 20, "Wrong result of the calling process");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check the event profile written by the DefaultSimulatorImpl.
+ */
+class EventProfilerTestCase : public TestCase
+{
+  public:
+    EventProfilerTestCase();
+
+    /**
+     * Profiled function.
+     * @param i An argument.
+     */
+    static void Function(uint32_t i);
+
+  private:
+    void DoRun() override;
+
+    /** Profiled method. */
+    void Method();
+    /** Another profiled method, with the same signature. */
+    void OtherMethod();
+
+    uint32_t m_calls; //!< Number of calls of the profiled functions
+};
+
+EventProfilerTestCase::EventProfilerTestCase()
+    : TestCase("Check the event profiler")
+{
+}
+
+void
+EventProfilerTestCase::Function(uint32_t /* i */)
+{
+}
+
+void
+EventProfilerTestCase::Method()
+{
+    m_calls++;
+}
+
+void
+EventProfilerTestCase::OtherMethod()
+{
+    m_calls++;
+}
+
+void
+EventProfilerTestCase::DoRun()
+{
+    std::string prefix = CreateTempDirFilename("event-profile");
+    Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl>();
+    impl->SetAttribute("EventProfile", StringValue(prefix));
+    Simulator::SetImplementation(impl);
+    m_calls = 0;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        Simulator::ScheduleWithContext(1, MicroSeconds(i), &EventProfilerTestCase::Function, i);
+        Simulator::ScheduleWithContext(2, MicroSeconds(i), &EventProfilerTestCase::Method, this);
+    }
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        Simulator::ScheduleWithContext(2,
+                                       MicroSeconds(i),
+                                       &EventProfilerTestCase::OtherMethod,
+                                       this);
+    }
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        Simulator::Schedule(MicroSeconds(i), [this]() { m_calls++; });
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_ASSERT_MSG_EQ(m_calls, 19, "Events not executed");
+
+    std::ifstream csv(prefix + ".csv");
+    NS_TEST_ASSERT_MSG_EQ(csv.is_open(), true, "No CSV profile");
+    std::string line;
+    std::getline(csv, line);
+    NS_TEST_ASSERT_MSG_EQ(line, "context,event,calls,total_ns,mean_ns,max_ns", "Wrong CSV header");
+    std::map<std::string, std::string> rows;
+    while (std::getline(csv, line))
+    {
+        std::string calls = line.substr(line.rfind("\",") + 2);
+        rows[line.substr(0, line.rfind("\",") + 1)] = calls.substr(0, calls.find(','));
+    }
+    NS_TEST_ASSERT_MSG_EQ(rows.size(), 4, "Wrong number of profile records");
+    NS_TEST_EXPECT_MSG_EQ(rows["1,\"EventProfilerTestCase::Function(unsigned int)\""],
+                          "10",
+                          "Wrong profile of the function");
+    // The methods with the same signature have separate records
+    NS_TEST_EXPECT_MSG_EQ(rows["2,\"EventProfilerTestCase::Method()\""],
+                          "10",
+                          "Wrong profile of the method");
+    NS_TEST_EXPECT_MSG_EQ(rows["2,\"EventProfilerTestCase::OtherMethod()\""],
+                          "5",
+                          "Wrong profile of the other method");
+    uint32_t lambdas = 0;
+    for (const auto& [key, calls] : rows)
+    {
+        if (key.find("-1,\"EventProfilerTestCase::DoRun()::") == 0)
+        {
+            NS_TEST_EXPECT_MSG_EQ(calls, "4", "Wrong profile of the lambda");
+            lambdas++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(lambdas, 1, "No profile of the lambda");
+
+    std::ifstream folded(prefix + ".folded");
+    uint32_t lines = 0;
+    while (std::getline(folded, line))
+    {
+        NS_TEST_EXPECT_MSG_EQ((line.find(';') != std::string::npos), true, "Wrong folded line");
+        lines++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(lines, 4, "Wrong number of folded lines");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check the hybrid wait, the lateness trace and histogram, and the
+ * slip catch-up policy of the RealtimeSimulatorImpl.
+ *
+ * The checks only bound the real time from below, except the check of
+ * the slip, which assumes that the events are not delayed by much more
+ * than they should, and is only made on request.
+ */
+class RealtimeWaitTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param checkSlip Whether to check that the real time slips.
+     */
+    RealtimeWaitTestCase(bool checkSlip);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the lateness of an event.
+     * @param lateness The lateness.
+     */
+    void Lateness(Time lateness);
+
+    std::vector<Time> m_lateness; //!< Lateness of the events
+    bool m_checkSlip;             //!< Whether to check that the real time slips
+};
+
+RealtimeWaitTestCase::RealtimeWaitTestCase(bool checkSlip)
+    : TestCase(checkSlip ? "Check the realtime wait and the slip of the real time"
+                         : "Check the realtime wait and catch-up policy"),
+      m_checkSlip(checkSlip)
+{
+}
+
+void
+RealtimeWaitTestCase::Lateness(Time lateness)
+{
+    m_lateness.push_back(lateness);
+}
+
+void
+RealtimeWaitTestCase::DoRun()
+{
+    Config::SetDefault("ns3::WallClockSynchronizer::WaitStrategy", StringValue("Hybrid"));
+    Ptr<RealtimeSimulatorImpl> impl = CreateObject<RealtimeSimulatorImpl>();
+    Config::SetDefault("ns3::WallClockSynchronizer::WaitStrategy", StringValue("SleepSpin"));
+    impl->SetAttribute("CatchUpPolicy", StringValue("Slip"));
+    impl->SetAttribute("CatchUpLimit", TimeValue(MilliSeconds(1)));
+    impl->TraceConnectWithoutContext("Lateness",
+                                     MakeCallback(&RealtimeWaitTestCase::Lateness, this));
+    Simulator::SetImplementation(impl);
+
+    const uint32_t events = 20;
+    for (uint32_t i = 0; i < events; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(i), []() {});
+    }
+    // Fall far behind the real time once
+    Simulator::Schedule(MilliSeconds(5) + NanoSeconds(1),
+                        []() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); });
+    // The realtime simulator waits for external events when it runs out of events
+    Simulator::Stop(MilliSeconds(events));
+    m_lateness.clear();
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_lateness.size(), events + 2, "Lateness not traced for every event");
+    uint64_t total = 0;
+    for (auto count : impl->GetLatenessHistogram())
+    {
+        total += count;
+    }
+    NS_TEST_EXPECT_MSG_EQ(total, events + 2, "Wrong lateness histogram");
+    // Only the event after the long one is late by much; then the real time slips
+    uint32_t late = 0;
+    for (const auto& lateness : m_lateness)
+    {
+        late += (lateness > MilliSeconds(50));
+    }
+    NS_TEST_EXPECT_MSG_GT(late, 0, "The long event did not delay the next one");
+    if (m_checkSlip)
+    {
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(late, 2, "The real time did not slip");
+    }
+
+    impl->ResetLatenessHistogram();
+    total = 0;
+    for (auto count : impl->GetLatenessHistogram())
+    {
+        total += count;
+    }
+    NS_TEST_EXPECT_MSG_EQ(total, 0, "Lateness histogram not reset");
+    Simulator::Destroy();
+
+    // The hybrid wait sleeps, then calibrates its margin on the overshoot
+    // of the sleep, and still reaches the target time
+    Ptr<WallClockSynchronizer> synchronizer = CreateObject<WallClockSynchronizer>();
+    synchronizer->SetAttribute("WaitStrategy", StringValue("Hybrid"));
+    synchronizer->SetAttribute("SleepMargin", TimeValue(Time(0)));
+    synchronizer->SetOrigin(0);
+    NS_TEST_EXPECT_MSG_EQ(synchronizer->GetSleepMargin(), Time(0), "Wrong initial margin");
+    uint64_t target = MilliSeconds(5).GetTimeStep();
+    NS_TEST_EXPECT_MSG_EQ(synchronizer->Synchronize(0, target), true, "Wait interrupted");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(synchronizer->GetCurrentRealtime(),
+                                target,
+                                "Target time not reached");
+    NS_TEST_EXPECT_MSG_GT(synchronizer->GetSleepMargin(), Time(0), "Margin not calibrated");
+
+    // A signal interrupts the wait
+    synchronizer->SetCondition(true);
+    NS_TEST_EXPECT_MSG_EQ(synchronizer->Synchronize(target, target), false, "Wait not interrupted");
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -726,6 +1636,77 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(AdaptiveScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        AddTestCase(new EventPoolTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new BatchDispatchTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new EventProfilerTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new RealtimeWaitTestCase(false), TestCase::Duration::QUICK);
+        AddTestCase(new RealtimeWaitTestCase(true), TestCase::Duration::EXTENSIVE);
+        for (const auto& tid : {MapScheduler::GetTypeId(),
+                                HeapScheduler::GetTypeId(),
+                                CalendarScheduler::GetTypeId(),
+                                PriorityQueueScheduler::GetTypeId(),
+                                LadderScheduler::GetTypeId(),
+                                AdaptiveScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(tid);
+            AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        }
+        for (const auto& tid : {ListScheduler::GetTypeId(),
+                                MapScheduler::GetTypeId(),
+                                HeapScheduler::GetTypeId(),
+                                CalendarScheduler::GetTypeId(),
+                                PriorityQueueScheduler::GetTypeId(),
+                                LadderScheduler::GetTypeId(),
+                                AdaptiveScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(tid);
+            AddTestCase(new CompactionTestCase(factory), TestCase::Duration::QUICK);
+        }
+        auto uniform = [](uint64_t low, uint64_t high) {
+            return [low, high](std::mt19937_64& rng) { return low + rng() % (high - low); };
+        };
+        auto octaves = [](std::mt19937_64& rng) { return uint64_t(1) << (rng() % 40); };
+        AddTestCase(new AdaptiveSchedulerTestCase("a small queue",
+                                                  100,
+                                                  uniform(1, 1000),
+                                                  false,
+                                                  HeapScheduler::GetTypeId()),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new AdaptiveSchedulerTestCase("narrow horizons",
+                                                  5000,
+                                                  uniform(1000, 2000),
+                                                  false,
+                                                  CalendarScheduler::GetTypeId()),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new AdaptiveSchedulerTestCase("wide horizons",
+                                                  5000,
+                                                  octaves,
+                                                  false,
+                                                  LadderScheduler::GetTypeId()),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new AdaptiveSchedulerTestCase("early removals",
+                                                  5000,
+                                                  uniform(1000, 2000),
+                                                  true,
+                                                  MapScheduler::GetTypeId()),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new AdaptiveSchedulerTestCase("simultaneous events",
+                                                  5000,
+                                                  [](std::mt19937_64& rng) {
+                                                      return rng() % 2 == 0 ? 0 : rng() % 1000;
+                                                  },
+                                                  false,
+                                                  LadderScheduler::GetTypeId()),
+                    TestCase::Duration::QUICK);
+#ifndef __WIN32__
+        AddTestCase(new RunReplicationsTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new RunBranchesTestCase(), TestCase::Duration::QUICK);
+#endif
     }
 };
 
@@ -398,6 +398,58 @@ TimeWithSignTestCase::DoTeardown()
 {
 }
 
+/**
+ * @ingroup core-tests
+ * @brief Time from double test case
+ *
+ * Checks that Time::FromDouble() is bit-identical to the conversion
+ * through int64x64_t, including its fast path for integral values.
+ */
+class TimeFromDoubleTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief constructor for TimeFromDoubleTestCase.
+     */
+    TimeFromDoubleTestCase();
+
+  private:
+    /**
+     * @brief DoRun for TimeFromDoubleTestCase.
+     */
+    void DoRun() override;
+};
+
+TimeFromDoubleTestCase::TimeFromDoubleTestCase()
+    : TestCase("Conversion from double is identical to the int64x64_t conversion")
+{
+}
+
+void
+TimeFromDoubleTestCase::DoRun()
+{
+    // Values in range at the NS and FS resolutions
+    const double values[] = {1,    -1,     2,       1.5,   -1.5,  0.1,    -0.1,  1e-9, 1000,
+                             -999, 12345e-2, 123.25, 65535, 0.999, 0x1p-20, 1e-15, 1024};
+    for (auto value : values)
+    {
+        for (auto unit : {Time::S, Time::MS, Time::US, Time::NS, Time::PS, Time::FS})
+        {
+            std::ostringstream oss;
+            oss << value << " in unit " << unit;
+            NS_TEST_EXPECT_MSG_EQ(Time::FromDouble(value, unit),
+                                  Time::From(int64x64_t(value), unit),
+                                  oss.str());
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(Time::FromDouble(4e9, Time::NS),
+                          Time::From(int64x64_t(4e9), Time::NS),
+                          "4e9 in unit ns");
+    NS_TEST_EXPECT_MSG_EQ(Time::FromDouble(-4e9, Time::US),
+                          Time::From(int64x64_t(-4e9), Time::US),
+                          "-4e9 in unit us");
+}
+
 /**
  * @ingroup core-tests
  * @brief Input output Test Case for Time
@@ -535,6 +587,7 @@ static class TimeTestSuite : public TestSuite
     {
         AddTestCase(new TimeWithSignTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new TimeInputOutputTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new TimeFromDoubleTestCase(), TestCase::Duration::QUICK);
         // This should be last, since it changes the resolution
         AddTestCase(new TimeSimpleTestCase(), TestCase::Duration::QUICK);
     }
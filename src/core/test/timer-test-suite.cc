@@ -10,6 +10,11 @@
 #include "ns3/test.h"
 #include "ns3/timer.h"
 
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
 /**
  * @file
  * @ingroup timer-tests
@@ -51,19 +56,27 @@ using namespace ns3;
 class TimerStateTestCase : public TestCase
 {
   public:
-    TimerStateTestCase();
+    /**
+     * Constructor.
+     * @param mode The timer mode.
+     */
+    TimerStateTestCase(Timer::Mode mode);
     void DoRun() override;
+
+    Timer::Mode m_mode; //!< The timer mode.
 };
 
-TimerStateTestCase::TimerStateTestCase()
-    : TestCase("Check correct state transitions")
+TimerStateTestCase::TimerStateTestCase(Timer::Mode mode)
+    : TestCase(std::string("Check correct state transitions") +
+               (mode == Timer::WHEEL_MODE ? " in wheel mode" : "")),
+      m_mode(mode)
 {
 }
 
 void
 TimerStateTestCase::DoRun()
 {
-    Timer timer = Timer(Timer::CANCEL_ON_DESTROY);
+    Timer timer = Timer(Timer::CANCEL_ON_DESTROY, m_mode);
 
     timer.SetFunction(&bari);
     timer.SetArguments(1);
@@ -82,6 +95,7 @@ TimerStateTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(!timer.IsExpired(), true, "");
     NS_TEST_ASSERT_MSG_EQ(timer.IsSuspended(), true, "");
     NS_TEST_ASSERT_MSG_EQ(timer.GetState(), Timer::SUSPENDED, "");
+    NS_TEST_ASSERT_MSG_EQ(timer.GetDelayLeft(), Seconds(10), "");
     timer.Resume();
     NS_TEST_ASSERT_MSG_EQ(timer.IsRunning(), true, "");
     NS_TEST_ASSERT_MSG_EQ(!timer.IsExpired(), true, "");
@@ -92,6 +106,7 @@ TimerStateTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(timer.IsExpired(), true, "");
     NS_TEST_ASSERT_MSG_EQ(!timer.IsSuspended(), true, "");
     NS_TEST_ASSERT_MSG_EQ(timer.GetState(), Timer::EXPIRED, "");
+    Simulator::Destroy();
 }
 
 /**
@@ -205,6 +220,153 @@ TimerTemplateTestCase::DoTeardown()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup timer-tests
+ *
+ * @brief Check that timers in wheel mode expire at their exact time, in
+ * their context, and that cancelled timers do not reach the simulator.
+ *
+ * The delays range from a few nanoseconds to days, so that every level
+ * of the wheel and its overflow list are used.
+ */
+class TimerWheelTestCase : public TestCase
+{
+  public:
+    TimerWheelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Start a timer.
+     * @param i The timer index.
+     */
+    void Start(uint32_t i);
+    /**
+     * Cancel a timer, or reschedule it with a new delay.
+     * @param i The timer index.
+     * @param delay The new delay, or zero to cancel the timer.
+     */
+    void Change(uint32_t i, Time delay);
+    /**
+     * Timer expiration.
+     * @param i The timer index.
+     */
+    void Expire(uint32_t i);
+
+    std::vector<std::unique_ptr<Timer>> m_timers; //!< The timers
+    std::vector<Time> m_delays;                   //!< Initial delay of each timer
+    std::vector<Time> m_expected;                 //!< Expected expiration, or -1
+    std::vector<uint32_t> m_expired;              //!< Indexes of the expired timers
+};
+
+TimerWheelTestCase::TimerWheelTestCase()
+    : TestCase("Check the expiration of timers in wheel mode")
+{
+}
+
+void
+TimerWheelTestCase::Start(uint32_t i)
+{
+    m_timers[i]->Schedule(m_delays[i]);
+    m_expected[i] = Simulator::Now() + m_delays[i];
+}
+
+void
+TimerWheelTestCase::Change(uint32_t i, Time delay)
+{
+    if (!m_timers[i]->IsRunning())
+    {
+        return;
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_timers[i]->GetDelayLeft(),
+                          m_expected[i] - Simulator::Now(),
+                          "Wrong delay left for timer " << i);
+    m_timers[i]->Cancel();
+    m_expected[i] = Seconds(-1);
+    if (delay.IsStrictlyPositive())
+    {
+        m_timers[i]->Schedule(delay);
+        m_expected[i] = Simulator::Now() + delay;
+    }
+}
+
+void
+TimerWheelTestCase::Expire(uint32_t i)
+{
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), m_expected[i], "Wrong expiration of timer " << i);
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), i % 7, "Wrong context of timer " << i);
+    NS_TEST_EXPECT_MSG_EQ(m_timers[i]->IsExpired(), true, "Timer " << i << " still running");
+    m_expired.push_back(i);
+}
+
+void
+TimerWheelTestCase::DoRun()
+{
+    const uint32_t n = 3000;
+    std::mt19937_64 rng(1);
+    m_timers.clear();
+    m_delays.clear();
+    m_expected.assign(n, Seconds(-1));
+    m_expired.clear();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        m_timers.emplace_back(std::make_unique<Timer>(Timer::CANCEL_ON_DESTROY, Timer::WHEEL_MODE));
+        m_timers[i]->SetFunction(&TimerWheelTestCase::Expire, this);
+        m_timers[i]->SetArguments(i);
+        // One timer in ten is started at time zero and expires at the same
+        // time as the others of its group
+        bool together = i % 10 == 5;
+        uint64_t delay = together ? 5000000 : rng() % (uint64_t(1) << (rng() % 48));
+        m_delays.push_back(NanoSeconds(delay));
+        Simulator::ScheduleWithContext(i % 7,
+                                       NanoSeconds(together ? 0 : rng() % 1000),
+                                       &TimerWheelTestCase::Start,
+                                       this,
+                                       i);
+        if (i % 2 == 0)
+        {
+            // Cancel or reschedule the timer before it expires
+            Time when = NanoSeconds(1000 + rng() % std::max<uint64_t>(delay, 1));
+            Time delay = NanoSeconds(i % 4 == 0 ? 0 : rng() % (uint64_t(1) << (rng() % 40)));
+            Simulator::ScheduleWithContext(i % 7,
+                                           when,
+                                           &TimerWheelTestCase::Change,
+                                           this,
+                                           i,
+                                           delay);
+        }
+    }
+    Simulator::Run();
+
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        expected += m_expected[i].IsPositive();
+        NS_TEST_EXPECT_MSG_EQ(m_timers[i]->IsExpired(), true, "Timer " << i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_expired.size(), expected, "Wrong number of expirations");
+    // The timers which expire together do so in scheduling order
+    std::vector<uint32_t> together;
+    for (auto i : m_expired)
+    {
+        if (i % 10 == 5)
+        {
+            together.push_back(i);
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(together.size(), n / 10, "Wrong number of timers expired together");
+    NS_TEST_ASSERT_MSG_EQ(std::is_sorted(together.begin(), together.end()),
+                          true,
+                          "Timers expired together out of scheduling order");
+    NS_TEST_ASSERT_MSG_LT(TimerWheel::Get()->GetScheduledCount(),
+                          n,
+                          "Cancelled timers reached the simulator");
+    NS_TEST_ASSERT_MSG_EQ(TimerWheel::Get()->GetSize(), 0, "Entries left in the wheel");
+    m_timers.clear();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup timer-tests
  *
@@ -216,8 +378,10 @@ class TimerTestSuite : public TestSuite
     TimerTestSuite()
         : TestSuite("timer", Type::UNIT)
     {
-        AddTestCase(new TimerStateTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new TimerStateTestCase(Timer::SCHEDULER_MODE), TestCase::Duration::QUICK);
+        AddTestCase(new TimerStateTestCase(Timer::WHEEL_MODE), TestCase::Duration::QUICK);
         AddTestCase(new TimerTemplateTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new TimerWheelTestCase(), TestCase::Duration::QUICK);
     }
 };
 
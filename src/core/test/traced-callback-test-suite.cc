@@ -7,6 +7,8 @@
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -122,6 +124,79 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * @ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check that the Callbacks are invoked in
+ * connection order, whichever Callbacks are disconnected.
+ */
+class OrderTracedCallbackTestCase : public TestCase
+{
+  public:
+    OrderTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback which logs its identifier.
+     * @param id The Callback identifier.
+     * @param value The traced value.
+     */
+    void Log(uint32_t id, uint32_t value);
+
+    std::vector<uint32_t> m_log; //!< Identifiers of the invoked Callbacks
+};
+
+OrderTracedCallbackTestCase::OrderTracedCallbackTestCase()
+    : TestCase("Check the order of the TracedCallback chain")
+{
+}
+
+void
+OrderTracedCallbackTestCase::Log(uint32_t id, uint32_t /* value */)
+{
+    m_log.push_back(id);
+}
+
+void
+OrderTracedCallbackTestCase::DoRun()
+{
+    TracedCallback<uint32_t> trace;
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "New TracedCallback not empty");
+    std::vector<Callback<void, uint32_t>> callbacks;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        callbacks.push_back(MakeCallback(&OrderTracedCallbackTestCase::Log, this).Bind(i));
+        trace.ConnectWithoutContext(callbacks.back());
+        NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), false, "TracedCallback empty");
+    }
+    trace(0);
+    NS_TEST_ASSERT_MSG_EQ((m_log == std::vector<uint32_t>{0, 1, 2, 3}), true, "Wrong order");
+
+    // Disconnect the first Callback, then a middle one
+    trace.DisconnectWithoutContext(callbacks[0]);
+    trace.DisconnectWithoutContext(callbacks[2]);
+    m_log.clear();
+    trace(0);
+    NS_TEST_ASSERT_MSG_EQ((m_log == std::vector<uint32_t>{1, 3}), true, "Wrong order");
+
+    // Connect one again, it goes at the end
+    trace.ConnectWithoutContext(callbacks[0]);
+    m_log.clear();
+    trace(0);
+    NS_TEST_ASSERT_MSG_EQ((m_log == std::vector<uint32_t>{1, 3, 0}), true, "Wrong order");
+
+    for (const auto& cb : callbacks)
+    {
+        trace.DisconnectWithoutContext(cb);
+    }
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "TracedCallback not empty");
+    m_log.clear();
+    trace(0);
+    NS_TEST_ASSERT_MSG_EQ(m_log.empty(), true, "Callback of an empty TracedCallback invoked");
+}
+
 /**
  * @ingroup tracedcallback-tests
  *
@@ -137,6 +212,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new OrderTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
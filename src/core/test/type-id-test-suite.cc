@@ -17,6 +17,7 @@
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 
 using namespace ns3;
 
@@ -336,6 +337,114 @@ DeprecatedAttributeTestCase::DoRun()
               << std::endl;
 }
 
+/**
+ * @ingroup typeid-tests
+ *
+ * Class registered lazily, whose TypeId is named after the class.
+ */
+class LazyRegistered : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::LazyRegistered").SetParent<Object>();
+        return tid;
+    }
+
+    static bool m_registered; //!< Whether the registration function ran.
+};
+
+bool LazyRegistered::m_registered = false;
+
+/**
+ * @ingroup typeid-tests
+ *
+ * Class registered lazily, whose TypeId is not named after the class.
+ */
+class LazyRenamed : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::LazyRegisteredOther").SetParent<Object>();
+        return tid;
+    }
+
+    static bool m_registered; //!< Whether the registration function ran.
+};
+
+bool LazyRenamed::m_registered = false;
+
+/**
+ * @ingroup typeid-tests
+ *
+ * Check the lazy registration of the TypeIds.
+ */
+class LazyRegistrationTestCase : public TestCase
+{
+  public:
+    LazyRegistrationTestCase();
+    ~LazyRegistrationTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+LazyRegistrationTestCase::LazyRegistrationTestCase()
+    : TestCase("Check the lazy registration of TypeIds")
+{
+}
+
+LazyRegistrationTestCase::~LazyRegistrationTestCase()
+{
+}
+
+void
+LazyRegistrationTestCase::DoRun()
+{
+    TypeId::SetLazyRegistration(true);
+    TypeId::Register("LazyRegistered", []() {
+        LazyRegistered::m_registered = true;
+        TypeId tid = LazyRegistered::GetTypeId();
+        tid.SetSize(sizeof(LazyRegistered));
+    });
+    TypeId::Register("LazyRenamed", []() {
+        LazyRenamed::m_registered = true;
+        TypeId tid = LazyRenamed::GetTypeId();
+        tid.SetSize(sizeof(LazyRenamed));
+    });
+    TypeId::SetLazyRegistration(false);
+
+    NS_TEST_ASSERT_MSG_EQ(LazyRegistered::m_registered, false, "registration not deferred");
+    NS_TEST_ASSERT_MSG_EQ(LazyRenamed::m_registered, false, "registration not deferred");
+
+    // The lookup runs the registration of the class named after the TypeId
+    TypeId tid;
+    bool found = TypeId::LookupByNameFailSafe("ns3::LazyRegistered", &tid);
+    NS_TEST_ASSERT_MSG_EQ(found, true, "deferred TypeId not found");
+    NS_TEST_ASSERT_MSG_EQ(LazyRegistered::m_registered, true, "registration did not run");
+    NS_TEST_ASSERT_MSG_EQ(LazyRenamed::m_registered, false, "unrelated registration ran");
+    NS_TEST_ASSERT_MSG_EQ(tid.GetSize(), sizeof(LazyRegistered), "wrong size");
+
+    // Otherwise all the deferred registrations run
+    found = TypeId::LookupByNameFailSafe("ns3::LazyRegisteredOther", &tid);
+    NS_TEST_ASSERT_MSG_EQ(found, true, "deferred TypeId not found");
+    NS_TEST_ASSERT_MSG_EQ(LazyRenamed::m_registered, true, "registration did not run");
+    NS_TEST_ASSERT_MSG_EQ(tid.GetSize(), sizeof(LazyRenamed), "wrong size");
+
+    std::ostringstream oss;
+    TypeId::PrintStartupProfile(oss);
+    NS_TEST_ASSERT_MSG_NE(oss.str().find("core"), std::string::npos, "core library not listed");
+}
+
 /**
  * @ingroup typeid-tests
  *
@@ -448,6 +557,7 @@ TypeIdTestSuite::TypeIdTestSuite()
     AddTestCase(new UniqueTypeIdTestCase, Duration::QUICK);
     AddTestCase(new CollisionTestCase, Duration::QUICK);
     AddTestCase(new DeprecatedAttributeTestCase, Duration::QUICK);
+    AddTestCase(new LazyRegistrationTestCase, Duration::QUICK);
 }
 
 /// Static variable for test initialization.
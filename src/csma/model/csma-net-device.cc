@@ -485,7 +485,10 @@ CsmaNetDevice::TransmitStart()
         }
         else
         {
-            m_macTxBackoffTrace(m_currentPkt);
+            if (!m_macTxBackoffTrace.IsEmpty())
+            {
+                m_macTxBackoffTrace(m_currentPkt);
+            }
 
             m_backoff.IncrNumRetries();
             Time backoffTime = m_backoff.GetBackoffTime();
@@ -500,7 +503,10 @@ CsmaNetDevice::TransmitStart()
         //
         // The channel is free, transmit the packet
         //
-        m_phyTxBeginTrace(m_currentPkt);
+        if (!m_phyTxBeginTrace.IsEmpty())
+        {
+            m_phyTxBeginTrace(m_currentPkt);
+        }
         if (!m_channel->TransmitStart(m_currentPkt, m_deviceId))
         {
             NS_LOG_WARN("Channel TransmitStart returns an error");
@@ -565,8 +571,14 @@ CsmaNetDevice::TransmitAbort()
         NS_ASSERT_MSG(packet,
                       "CsmaNetDevice::TransmitAbort(): IsEmpty false but no Packet on queue?");
         m_currentPkt = packet;
-        m_snifferTrace(m_currentPkt);
-        m_promiscSnifferTrace(m_currentPkt);
+        if (!m_snifferTrace.IsEmpty())
+        {
+            m_snifferTrace(m_currentPkt);
+        }
+        if (!m_promiscSnifferTrace.IsEmpty())
+        {
+            m_promiscSnifferTrace(m_currentPkt);
+        }
         TransmitStart();
     }
 }
@@ -596,7 +608,10 @@ CsmaNetDevice::TransmitCompleteEvent()
     NS_LOG_LOGIC("Pkt UID is " << m_currentPkt->GetUid() << ")");
 
     m_channel->TransmitEnd();
-    m_phyTxEndTrace(m_currentPkt);
+    if (!m_phyTxEndTrace.IsEmpty())
+    {
+        m_phyTxEndTrace(m_currentPkt);
+    }
     m_currentPkt = nullptr;
 
     NS_LOG_LOGIC("Schedule TransmitReadyEvent in " << m_tInterframeGap.As(Time::S));
@@ -637,8 +652,14 @@ CsmaNetDevice::TransmitReadyEvent()
         NS_ASSERT_MSG(packet,
                       "CsmaNetDevice::TransmitReadyEvent(): IsEmpty false but no Packet on queue?");
         m_currentPkt = packet;
-        m_snifferTrace(m_currentPkt);
-        m_promiscSnifferTrace(m_currentPkt);
+        if (!m_snifferTrace.IsEmpty())
+        {
+            m_snifferTrace(m_currentPkt);
+        }
+        if (!m_promiscSnifferTrace.IsEmpty())
+        {
+            m_promiscSnifferTrace(m_currentPkt);
+        }
         TransmitStart();
     }
 }
@@ -702,7 +723,10 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
     // Hit the trace hook.  This trace will fire on all packets received from the
     // channel except those originated by this device.
     //
-    m_phyRxEndTrace(packet);
+    if (!m_phyRxEndTrace.IsEmpty())
+    {
+        m_phyRxEndTrace(packet);
+    }
 
     //
     // Only receive if the send side of net device is enabled
@@ -801,10 +825,16 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
     // hook and pass a copy up to the promiscuous callback.  Pass a copy to
     // make sure that nobody messes with our packet.
     //
-    m_promiscSnifferTrace(packet);
+    if (!m_promiscSnifferTrace.IsEmpty())
+    {
+        m_promiscSnifferTrace(packet);
+    }
     if (!m_promiscRxCallback.IsNull())
     {
-        m_macPromiscRxTrace(packet);
+        if (!m_macPromiscRxTrace.IsEmpty())
+        {
+            m_macPromiscRxTrace(packet);
+        }
         m_promiscRxCallback(this,
                             pktCopy,
                             protocol,
@@ -820,8 +850,14 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
     //
     if (packetType != PACKET_OTHERHOST)
     {
-        m_snifferTrace(packet);
-        m_macRxTrace(packet);
+        if (!m_snifferTrace.IsEmpty())
+        {
+            m_snifferTrace(packet);
+        }
+        if (!m_macRxTrace.IsEmpty())
+        {
+            m_macRxTrace(packet);
+        }
         m_rxCallback(this, pktCopy, protocol, header.GetSource());
     }
 }
@@ -974,7 +1010,10 @@ CsmaNetDevice::SendFrom(Ptr<Packet> packet,
     Mac48Address source = Mac48Address::ConvertFrom(src);
     AddHeader(packet, source, destination, protocolNumber);
 
-    m_macTxTrace(packet);
+    if (!m_macTxTrace.IsEmpty())
+    {
+        m_macTxTrace(packet);
+    }
 
     //
     // Place the packet to be sent on the send queue.  Note that the
@@ -999,8 +1038,14 @@ CsmaNetDevice::SendFrom(Ptr<Packet> packet,
             NS_ASSERT_MSG(packet,
                           "CsmaNetDevice::SendFrom(): IsEmpty false but no Packet on queue?");
             m_currentPkt = packet;
-            m_promiscSnifferTrace(m_currentPkt);
-            m_snifferTrace(m_currentPkt);
+            if (!m_promiscSnifferTrace.IsEmpty())
+            {
+                m_promiscSnifferTrace(m_currentPkt);
+            }
+            if (!m_snifferTrace.IsEmpty())
+            {
+                m_snifferTrace(m_currentPkt);
+            }
             TransmitStart();
         }
     }
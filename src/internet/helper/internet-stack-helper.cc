@@ -126,6 +126,20 @@ InternetStackHelper::Initialize()
     listRouting.Add(globalRouting, -10);
     SetRoutingHelper(listRouting);
     SetRoutingHelper(staticRoutingv6);
+
+    // Keep one factory per protocol, so that the construction plan of the
+    // protocol is compiled once for all the nodes.
+    for (const auto& typeId : {"ns3::ArpL3Protocol",
+                               "ns3::Ipv4L3Protocol",
+                               "ns3::Icmpv4L4Protocol",
+                               "ns3::Ipv6L3Protocol",
+                               "ns3::Icmpv6L4Protocol",
+                               "ns3::TrafficControlLayer",
+                               "ns3::UdpL4Protocol",
+                               "ns3::TcpL4Protocol"})
+    {
+        m_factories[typeId].SetTypeId(typeId);
+    }
 }
 
 InternetStackHelper::~InternetStackHelper()
@@ -142,6 +156,7 @@ InternetStackHelper::InternetStackHelper(const InternetStackHelper& o)
     m_ipv6Enabled = o.m_ipv6Enabled;
     m_ipv4ArpJitterEnabled = o.m_ipv4ArpJitterEnabled;
     m_ipv6NsRsJitterEnabled = o.m_ipv6NsRsJitterEnabled;
+    m_factories = o.m_factories;
 }
 
 InternetStackHelper&
@@ -153,6 +168,7 @@ InternetStackHelper::operator=(const InternetStackHelper& o)
     }
     m_routing = o.m_routing->Copy();
     m_routingv6 = o.m_routingv6->Copy();
+    m_factories = o.m_factories;
     return *this;
 }
 
@@ -269,16 +285,15 @@ InternetStackHelper::InstallAll() const
 }
 
 void
-InternetStackHelper::CreateAndAggregateObjectFromTypeId(Ptr<Node> node, const std::string typeId)
+InternetStackHelper::CreateAndAggregateObjectFromTypeId(Ptr<Node> node,
+                                                        const std::string typeId) const
 {
-    TypeId tid = TypeId::LookupByName(typeId);
-    if (node->GetObject<Object>(tid))
+    const ObjectFactory& factory = m_factories.at(typeId);
+    if (node->GetObject<Object>(factory.GetTypeId()))
     {
         return;
     }
 
-    ObjectFactory factory;
-    factory.SetTypeId(typeId);
     Ptr<Object> protocol = factory.Create<Object>();
     node->AggregateObject(protocol);
 }
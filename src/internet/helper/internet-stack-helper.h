@@ -19,6 +19,9 @@
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
 
+#include <map>
+#include <string>
+
 namespace ns3
 {
 
@@ -281,7 +284,7 @@ class InternetStackHelper : public PcapHelperForIpv4,
      * @param node the node
      * @param typeId the object TypeId
      */
-    static void CreateAndAggregateObjectFromTypeId(Ptr<Node> node, const std::string typeId);
+    void CreateAndAggregateObjectFromTypeId(Ptr<Node> node, const std::string typeId) const;
 
     /**
      * @brief checks if there is an hook to a Pcap wrapper
@@ -330,6 +333,12 @@ class InternetStackHelper : public PcapHelperForIpv4,
      * @brief IPv6 IPv6 NS and RS Jitter state (enabled/disabled) ?
      */
     bool m_ipv6NsRsJitterEnabled;
+
+    /**
+     * @brief The factories of the protocols, by TypeId name, so that the
+     * construction plan of each protocol is compiled once for all the nodes.
+     */
+    std::map<std::string, ObjectFactory> m_factories;
 };
 
 } // namespace ns3
@@ -571,7 +571,11 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
 
     if (ipv4Interface->IsUp())
     {
-        m_rxTrace(packet, this, interface);
+        // Avoid building the Ptr<Ipv4> argument when nothing is connected
+        if (!m_rxTrace.IsEmpty())
+        {
+            m_rxTrace(packet, this, interface);
+        }
     }
     else
     {
@@ -786,7 +790,10 @@ Ipv4L3Protocol::Send(Ptr<Packet> packet,
         // 1b) with a valid gateway
         NS_LOG_LOGIC("Ipv4L3Protocol::Send case 1b:  passed in with route and valid gateway");
         int32_t interface = GetInterfaceForDevice(route->GetOutputDevice());
-        m_sendOutgoingTrace(ipHeader, packet, interface);
+        if (!m_sendOutgoingTrace.IsEmpty())
+        {
+            m_sendOutgoingTrace(ipHeader, packet, interface);
+        }
         if (m_enableDpd && ipHeader.GetDestination().IsMulticast())
         {
             UpdateDuplicate(packet, ipHeader);
@@ -1029,7 +1036,10 @@ Ipv4L3Protocol::IpMulticastForward(Ptr<Ipv4MulticastRoute> mrtentry,
         rtentry->SetGateway(Ipv4Address::GetAny());
         rtentry->SetOutputDevice(GetNetDevice(interface));
 
-        m_multicastForwardTrace(ipHeader, packet, interface);
+        if (!m_multicastForwardTrace.IsEmpty())
+        {
+            m_multicastForwardTrace(ipHeader, packet, interface);
+        }
         SendRealOut(rtentry, packet, ipHeader);
     }
 }
@@ -1068,7 +1078,10 @@ Ipv4L3Protocol::IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv
         packet->AddPacketTag(priorityTag);
     }
 
-    m_unicastForwardTrace(ipHeader, packet, interface);
+    if (!m_unicastForwardTrace.IsEmpty())
+    {
+        m_unicastForwardTrace(ipHeader, packet, interface);
+    }
     SendRealOut(rtentry, packet, ipHeader);
 }
 
@@ -1093,7 +1106,10 @@ Ipv4L3Protocol::LocalDeliver(Ptr<const Packet> packet, const Ipv4Header& ip, uin
         ipHeader.SetPayloadSize(p->GetSize());
     }
 
-    m_localDeliverTrace(ipHeader, p, iif);
+    if (!m_localDeliverTrace.IsEmpty())
+    {
+        m_localDeliverTrace(ipHeader, p, iif);
+    }
 
     Ptr<IpL4Protocol> protocol = GetProtocol(ipHeader.GetProtocol(), iif);
     if (protocol)
@@ -0,0 +1,968 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/packet-metadata.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <barrier>
+#include <limits>
+#include <numeric>
+#include <unordered_set>
+
+/**
+ * @file
+ * @ingroup mtp
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+/** Timestamp used as "no event" and as an unbounded lookahead. */
+static constexpr uint64_t MAX_TS = std::numeric_limits<int64_t>::max();
+
+thread_local MultithreadedSimulatorImpl::LogicalProcess* MultithreadedSimulatorImpl::m_currentLp =
+    nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads (and partitions) to use. "
+                          "Zero selects the number of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("LookaheadThreshold",
+                          "Nodes connected by a channel whose delay is not larger than "
+                          "this value are kept in the same partition.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_lookaheadThreshold),
+                          MakeTimeChecker());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    m_serial.sequence = EventId::UID::VALID;
+    m_serial.currentUid = EventId::UID::INVALID;
+    m_serial.currentContext = Simulator::NO_CONTEXT;
+    m_serial.minSentTs = MAX_TS;
+    m_eventsWithContextEmpty = true;
+    m_partitioned = false;
+    m_uidStride = 1;
+    m_sequenceLimit = std::numeric_limits<uint32_t>::max();
+    m_lookahead = MAX_TS;
+    m_maxThreads = 0;
+    m_window = 0;
+    m_windowEnd = 0;
+    m_nextLp = 0;
+    m_finished = false;
+    m_stop = false;
+    m_mainThreadId = std::this_thread::get_id();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
+
+    auto drain = [](LogicalProcess& lp) {
+        while (!lp.events->IsEmpty())
+        {
+            Scheduler::Event next = lp.events->RemoveNext();
+            next.impl->Unref();
+        }
+        lp.events = nullptr;
+        for (auto& outboxes : lp.outboxes)
+        {
+            for (auto& outbox : outboxes)
+            {
+                for (auto& message : outbox)
+                {
+                    message.event->Unref();
+                }
+                outbox.clear();
+            }
+        }
+    };
+    for (auto& lp : m_lps)
+    {
+        drain(*lp);
+    }
+    drain(m_serial);
+    m_lps.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ASSERT_MSG(m_currentLp == nullptr,
+                  "MultithreadedSimulatorImpl::SetScheduler() called while running");
+    m_schedulerFactory = schedulerFactory;
+
+    auto replace = [&schedulerFactory](LogicalProcess& lp) {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (lp.events)
+        {
+            while (!lp.events->IsEmpty())
+            {
+                Scheduler::Event next = lp.events->RemoveNext();
+                scheduler->Insert(next);
+            }
+        }
+        lp.events = scheduler;
+    };
+    replace(m_serial);
+    for (auto& lp : m_lps)
+    {
+        replace(*lp);
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+Scheduler::Event
+MultithreadedSimulatorImpl::Insert(LogicalProcess& lp,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   uint32_t uid,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = uid;
+    lp.unscheduledEvents++;
+    lp.events->Insert(ev);
+    return ev;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::NextUid(LogicalProcess& lp) const
+{
+    NS_ABORT_MSG_IF(lp.sequence >= m_sequenceLimit,
+                    "MultithreadedSimulatorImpl: event uids exhausted after "
+                        << m_sequenceLimit << " events scheduled by a partition");
+    return lp.sequence++ * m_uidStride + lp.id;
+}
+
+void
+MultithreadedSimulatorImpl::AlignSequences()
+{
+    uint32_t sequence = m_serial.sequence;
+    for (const auto& lp : m_lps)
+    {
+        sequence = std::max(sequence, lp->sequence);
+    }
+    m_serial.sequence = sequence;
+    for (auto& lp : m_lps)
+    {
+        lp->sequence = sequence;
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsConcurrent(const LogicalProcess& lp) const
+{
+    return m_currentLp != nullptr && m_currentLp != &m_serial && m_currentLp != &lp &&
+           &lp != &m_serial;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::GetOwner(uint32_t context)
+{
+    uint32_t partition = GetPartition(context);
+    if (partition < m_lps.size())
+    {
+        return *m_lps[partition];
+    }
+    return m_serial;
+}
+
+const MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::GetOwner(uint32_t context) const
+{
+    uint32_t partition = GetPartition(context);
+    if (partition < m_lps.size())
+    {
+        return *m_lps[partition];
+    }
+    return m_serial;
+}
+
+const MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::GetCurrent() const
+{
+    return m_currentLp ? *m_currentLp : m_serial;
+}
+
+Time
+MultithreadedSimulatorImpl::GetChannelDelay(Ptr<Channel> channel)
+{
+    // PointToPointChannel, CsmaChannel and SimpleChannel
+    TimeValue delay;
+    if (channel->GetAttributeFailSafe("Delay", delay))
+    {
+        return delay.Get();
+    }
+    // Wireless channels, e.g., YansWifiChannel
+    PointerValue model;
+    if (channel->GetAttributeFailSafe("PropagationDelayModel", model))
+    {
+        Ptr<PropagationDelayModel> delayModel = model.Get<PropagationDelayModel>();
+        if (delayModel)
+        {
+            return delayModel->GetMinimumDelay();
+        }
+    }
+    return Seconds(0);
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t nNodes = NodeList::GetNNodes();
+    uint32_t maxThreads = m_maxThreads;
+    if (maxThreads == 0)
+    {
+        maxThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    // Merge the nodes connected by channels too fast to give a useful
+    // lookahead into clusters, which cannot be split across partitions.
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t n) {
+        while (parent[n] != n)
+        {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    };
+
+    std::vector<std::pair<Time, std::vector<uint32_t>>> links;
+    std::unordered_set<const Channel*> visited;
+    for (auto i = NodeList::Begin(); i != NodeList::End(); ++i)
+    {
+        for (uint32_t j = 0; j < (*i)->GetNDevices(); ++j)
+        {
+            Ptr<Channel> channel = (*i)->GetDevice(j)->GetChannel();
+            if (!channel || !visited.insert(PeekPointer(channel)).second)
+            {
+                continue;
+            }
+            std::vector<uint32_t> nodes;
+            for (std::size_t k = 0; k < channel->GetNDevices(); ++k)
+            {
+                Ptr<NetDevice> device = channel->GetDevice(k);
+                if (device && device->GetNode())
+                {
+                    nodes.push_back(device->GetNode()->GetId());
+                }
+            }
+            if (nodes.size() < 2)
+            {
+                continue;
+            }
+            Time delay = GetChannelDelay(channel);
+            if (delay <= m_lookaheadThreshold)
+            {
+                for (auto node : nodes)
+                {
+                    parent[find(node)] = find(nodes.front());
+                }
+            }
+            else
+            {
+                links.emplace_back(delay, std::move(nodes));
+            }
+        }
+    }
+
+    std::vector<uint32_t> clusterSize(nNodes, 0);
+    uint32_t nClusters = 0;
+    for (uint32_t n = 0; n < nNodes; ++n)
+    {
+        if (clusterSize[find(n)]++ == 0)
+        {
+            nClusters++;
+        }
+    }
+
+    // Fill the partitions with whole clusters taken in node id order,
+    // so that the neighbors created together by the topology helpers
+    // tend to share a partition.
+    uint32_t nLps = std::max(1U, std::min(maxThreads, nClusters));
+    uint32_t target = (nNodes + nLps - 1) / nLps;
+    std::vector<uint32_t> partitionOfCluster(nNodes, nLps);
+    m_partitionOf.assign(nNodes, 0);
+    uint32_t current = 0;
+    uint32_t currentSize = 0;
+    for (uint32_t n = 0; n < nNodes; ++n)
+    {
+        uint32_t root = find(n);
+        if (partitionOfCluster[root] == nLps)
+        {
+            if (currentSize >= target && current + 1 < nLps)
+            {
+                current++;
+                currentSize = 0;
+            }
+            partitionOfCluster[root] = current;
+            currentSize += clusterSize[root];
+        }
+        m_partitionOf[n] = partitionOfCluster[root];
+    }
+    nLps = current + 1;
+
+    m_lookahead = MAX_TS;
+    for (const auto& [delay, nodes] : links)
+    {
+        uint32_t first = m_partitionOf[nodes.front()];
+        if (std::any_of(nodes.begin(), nodes.end(), [this, first](uint32_t node) {
+                return m_partitionOf[node] != first;
+            }))
+        {
+            m_lookahead = std::min<uint64_t>(m_lookahead, delay.GetTimeStep());
+        }
+    }
+
+    // Interleave the uids of the partitions after those of the events
+    // scheduled so far, which are moved to the partitions below.
+    m_uidStride = nLps + 1;
+    m_sequenceLimit = (std::numeric_limits<uint32_t>::max() - nLps) / m_uidStride;
+    uint32_t sequence = (m_serial.sequence + m_uidStride - 1) / m_uidStride;
+    m_serial.sequence = sequence;
+
+    m_lps.clear();
+    for (uint32_t p = 0; p < nLps; ++p)
+    {
+        auto lp = std::make_unique<LogicalProcess>();
+        lp->id = p;
+        lp->events = m_schedulerFactory.Create<Scheduler>();
+        lp->sequence = sequence;
+        lp->currentUid = m_serial.currentUid;
+        lp->currentTs = m_serial.currentTs;
+        lp->windowUid = m_serial.currentUid;
+        lp->windowTs = m_serial.currentTs;
+        // The serial partition keeps the global counters
+        lp->packetUid = static_cast<uint64_t>(p + 1) << 32;
+        lp->streamIndex = static_cast<uint64_t>(p + 1) << 48;
+        lp->currentContext = Simulator::NO_CONTEXT;
+        lp->minSentTs = MAX_TS;
+        for (auto& outboxes : lp->outboxes)
+        {
+            outboxes.resize(nLps + 1);
+        }
+        m_lps.push_back(std::move(lp));
+    }
+    m_serial.id = nLps;
+    m_partitioned = true;
+
+    // Move the node events scheduled so far into their partition
+    Ptr<Scheduler> serial = m_schedulerFactory.Create<Scheduler>();
+    while (!m_serial.events->IsEmpty())
+    {
+        Scheduler::Event next = m_serial.events->RemoveNext();
+        LogicalProcess& owner = GetOwner(next.key.m_context);
+        if (&owner == &m_serial)
+        {
+            serial->Insert(next);
+            continue;
+        }
+        m_serial.unscheduledEvents--;
+        owner.unscheduledEvents++;
+        owner.events->Insert(next);
+    }
+    m_serial.events = serial;
+
+    NS_LOG_INFO("Partitioned " << nNodes << " nodes (" << nClusters << " clusters) into " << nLps
+                               << " partitions, lookahead " << GetLookahead().As(Time::S));
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow(LogicalProcess& lp)
+{
+    m_currentLp = &lp;
+    // A single partition never runs concurrently with the serial events,
+    // so it keeps the global counters, as the DefaultSimulatorImpl does.
+    if (m_lps.size() > 1)
+    {
+        Packet::SetThreadUidCounter(&lp.packetUid);
+        RngSeedManager::SetThreadStreamIndexCounter(&lp.streamIndex);
+        PacketMetadata::SetThreadChunkUidCounter(&lp.chunkUid);
+    }
+
+    // Receive the messages sent during the previous window
+    uint32_t incoming = (m_window + 1) % 2;
+    for (auto& source : m_lps)
+    {
+        auto& outbox = source->outboxes[incoming][lp.id];
+        for (const auto& message : outbox)
+        {
+            Insert(lp, message.timestamp, message.context, message.uid, message.event);
+        }
+        outbox.clear();
+    }
+
+    // A single partition runs on the main thread and also owns the events
+    // without context, so it executes them as the DefaultSimulatorImpl.
+    bool single = m_lps.size() == 1;
+    while (!lp.events->IsEmpty())
+    {
+        if (lp.events->PeekNext().key.m_ts >= m_windowEnd || (single && m_stop))
+        {
+            break;
+        }
+        Scheduler::Event next = lp.events->RemoveNext();
+
+        if (single)
+        {
+            PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+        }
+
+        NS_ASSERT(next.key.m_ts >= lp.currentTs);
+        lp.unscheduledEvents--;
+        lp.eventCount++;
+
+        lp.currentTs = next.key.m_ts;
+        lp.currentContext = next.key.m_context;
+        lp.currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+
+        if (single)
+        {
+            ProcessEventsWithContext();
+        }
+    }
+
+    Packet::SetThreadUidCounter(nullptr);
+    RngSeedManager::SetThreadStreamIndexCounter(nullptr);
+    PacketMetadata::SetThreadChunkUidCounter(nullptr);
+    m_currentLp = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessSerialEvents(uint64_t ts)
+{
+    while (!m_stop && !m_serial.events->IsEmpty() && m_serial.events->PeekNext().key.m_ts == ts)
+    {
+        Scheduler::Event next = m_serial.events->RemoveNext();
+
+        PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+        NS_ASSERT(next.key.m_ts >= m_serial.currentTs);
+        m_serial.unscheduledEvents--;
+        m_serial.eventCount++;
+
+        m_serial.currentTs = next.key.m_ts;
+        m_serial.currentContext = next.key.m_context;
+        m_serial.currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+
+        ProcessEventsWithContext();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::EndWindow()
+{
+    m_currentLp = &m_serial;
+
+    // Receive the messages sent to the serial partition and find the
+    // earliest pending event of the node partitions.
+    uint32_t parity = m_window % 2;
+    uint64_t next = MAX_TS;
+    for (auto& lp : m_lps)
+    {
+        auto& outbox = lp->outboxes[parity][m_serial.id];
+        for (const auto& message : outbox)
+        {
+            Insert(m_serial, message.timestamp, message.context, message.uid, message.event);
+        }
+        outbox.clear();
+        next = std::min(next, lp->minSentTs);
+        lp->minSentTs = MAX_TS;
+        lp->windowTs = lp->currentTs;
+        lp->windowUid = lp->currentUid;
+    }
+    m_window++;
+    AlignSequences();
+    ProcessEventsWithContext();
+
+    while (true)
+    {
+        for (auto& lp : m_lps)
+        {
+            if (!lp->events->IsEmpty())
+            {
+                next = std::min(next, lp->events->PeekNext().key.m_ts);
+            }
+        }
+        uint64_t serialNext =
+            m_serial.events->IsEmpty() ? MAX_TS : m_serial.events->PeekNext().key.m_ts;
+        if (m_stop || (next == MAX_TS && serialNext == MAX_TS))
+        {
+            m_finished = true;
+            break;
+        }
+        if (serialNext <= next)
+        {
+            // The serial events may schedule new node events, so look
+            // again at the partitions once they have been executed.
+            ProcessSerialEvents(serialNext);
+            continue;
+        }
+        m_windowEnd = (next > MAX_TS - m_lookahead) ? MAX_TS : next + m_lookahead;
+        m_windowEnd = std::min(m_windowEnd, serialNext);
+        break;
+    }
+
+    AlignSequences();
+    m_nextLp = 0;
+    m_currentLp = nullptr;
+}
+
+template <typename BARRIER>
+void
+MultithreadedSimulatorImpl::WorkerLoop(BARRIER& barrier)
+{
+    while (!m_finished)
+    {
+        for (uint32_t i = m_nextLp++; i < m_lps.size(); i = m_nextLp++)
+        {
+            ProcessWindow(*m_lps[i]);
+        }
+        barrier.arrive_and_wait();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    return m_serial.events->IsEmpty() &&
+           std::all_of(m_lps.begin(), m_lps.end(), [](const auto& lp) {
+               return lp->events->IsEmpty();
+           });
+}
+
+void
+MultithreadedSimulatorImpl::ProcessEventsWithContext()
+{
+    if (m_eventsWithContextEmpty)
+    {
+        return;
+    }
+
+    // swap queues
+    EventsWithContext eventsWithContext;
+    {
+        std::unique_lock lock{m_eventsWithContextMutex};
+        m_eventsWithContext.swap(eventsWithContext);
+        m_eventsWithContextEmpty = true;
+    }
+
+    // Foreign threads cannot know the time of the partitions; schedule
+    // relative to the most advanced of them.
+    uint64_t now = m_serial.currentTs;
+    for (const auto& lp : m_lps)
+    {
+        now = std::max(now, lp->currentTs);
+    }
+    while (!eventsWithContext.empty())
+    {
+        EventWithContext event = eventsWithContext.front();
+        eventsWithContext.pop_front();
+        Insert(GetOwner(event.context),
+               now + event.timestamp,
+               event.context,
+               NextUid(m_serial),
+               event.event);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    NS_ABORT_MSG_IF(NodeList::GetNNodes() != m_partitionOf.size(),
+                    "MultithreadedSimulatorImpl: nodes cannot be added once the "
+                    "simulation has started");
+    m_stop = false;
+    m_finished = false;
+
+    EndWindow();
+    if (!m_finished)
+    {
+        std::barrier barrier(static_cast<std::ptrdiff_t>(m_lps.size()),
+                             [this]() noexcept { EndWindow(); });
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < m_lps.size(); ++i)
+        {
+            threads.emplace_back([this, &barrier]() { WorkerLoop(barrier); });
+        }
+        WorkerLoop(barrier);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Deliver the messages still in flight if the simulation was stopped,
+    // and move the serial clock to the most advanced partition.
+    for (auto& source : m_lps)
+    {
+        for (auto& outboxes : source->outboxes)
+        {
+            for (uint32_t dest = 0; dest < outboxes.size(); ++dest)
+            {
+                LogicalProcess& owner = dest < m_lps.size() ? *m_lps[dest] : m_serial;
+                for (const auto& message : outboxes[dest])
+                {
+                    Insert(owner, message.timestamp, message.context, message.uid, message.event);
+                }
+                outboxes[dest].clear();
+            }
+        }
+        source->minSentTs = MAX_TS;
+        m_serial.currentTs = std::max(m_serial.currentTs, source->currentTs);
+    }
+
+    // If the simulator stopped naturally by lack of events, make a
+    // consistency test to check that we didn't lose any events along the way.
+    for (const auto& lp : m_lps)
+    {
+        NS_ASSERT(!lp->events->IsEmpty() || lp->unscheduledEvents == 0);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(m_currentLp != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    LogicalProcess& lp = m_currentLp ? *m_currentLp : m_serial;
+    LogicalProcess& owner = GetOwner(lp.currentContext);
+    Scheduler::Event ev =
+        Insert(owner, lp.currentTs + delay.GetTimeStep(), lp.currentContext, NextUid(lp), event);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    LogicalProcess* current = m_currentLp;
+    if (current == nullptr && m_mainThreadId != std::this_thread::get_id())
+    {
+        EventWithContext ev;
+        ev.context = context;
+        // Current time added in ProcessEventsWithContext()
+        ev.timestamp = delay.GetTimeStep();
+        ev.event = event;
+        {
+            std::unique_lock lock{m_eventsWithContextMutex};
+            m_eventsWithContext.push_back(ev);
+            m_eventsWithContextEmpty = false;
+        }
+        return;
+    }
+    if (current == nullptr)
+    {
+        current = &m_serial;
+    }
+
+    uint64_t ts = current->currentTs + delay.GetTimeStep();
+    uint32_t uid = NextUid(*current);
+    LogicalProcess& owner = GetOwner(context);
+    if (&owner == current || current == &m_serial)
+    {
+        // The partitions are paused while serial events are executed
+        Insert(owner, ts, context, uid, event);
+        return;
+    }
+    if (&owner == &m_serial)
+    {
+        // The serial events cannot run before the end of the window
+        ts = std::max(ts, m_windowEnd);
+    }
+    NS_ABORT_MSG_IF(ts < m_windowEnd,
+                    "MultithreadedSimulatorImpl: event for context "
+                        << context << " scheduled from another partition with a delay of "
+                        << delay.As(Time::S) << ", below the lookahead of "
+                        << GetLookahead().As(Time::S));
+    current->outboxes[m_window % 2][owner.id].push_back({ts, context, uid, event});
+    current->minSentTs = std::min(current->minSentTs, ts);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_currentLp != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleNow Thread-unsafe invocation!");
+
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_currentLp != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false), GetCurrent().currentTs, 0xffffffff, 2);
+    std::unique_lock lock{m_destroyEventsMutex};
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrent().currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - GetCurrent().currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        std::unique_lock lock{m_destroyEventsMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    LogicalProcess& lp = GetOwner(id.GetContext());
+    NS_ASSERT_MSG(m_currentLp == nullptr || m_currentLp == &m_serial || m_currentLp == &lp,
+                  "MultithreadedSimulatorImpl: cannot remove an event of another partition");
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    lp.events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    lp.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        NS_ABORT_MSG_IF(IsConcurrent(GetOwner(id.GetContext())) && id.GetTs() < m_windowEnd,
+                        "MultithreadedSimulatorImpl: event for context "
+                            << id.GetContext()
+                            << " cancelled from another partition before the end of the window");
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        std::unique_lock lock{m_destroyEventsMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    const LogicalProcess& lp = GetOwner(id.GetContext());
+    // Another partition may be running: only rely on its state at the
+    // start of the window.
+    bool concurrent = IsConcurrent(lp);
+    uint64_t currentTs = concurrent ? lp.windowTs : lp.currentTs;
+    uint32_t currentUid = concurrent ? lp.windowUid : lp.currentUid;
+    return id.PeekEventImpl() == nullptr || id.GetTs() < currentTs ||
+           (id.GetTs() == currentTs && id.GetUid() <= currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrent().currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = m_serial.eventCount;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->eventCount;
+    }
+    return count;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions() const
+{
+    return m_lps.size();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    if (m_partitioned && m_lps.size() == 1)
+    {
+        return 0;
+    }
+    if (m_partitioned && context < m_partitionOf.size())
+    {
+        return m_partitionOf[context];
+    }
+    return m_lps.size();
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return TimeStep(m_lookahead);
+}
+
+} // namespace ns3
@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mtp
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+class Channel;
+
+/**
+ * @ingroup mtp
+ *
+ * @brief Shared-memory parallel simulator implementation.
+ *
+ * The nodes of the simulation are split into partitions (logical
+ * processes) when Run() is first called. Every partition owns its
+ * own event queue and is executed by one thread at a time; the
+ * partitions advance in parallel inside time windows bounded by a
+ * conservative lookahead, and synchronize at a barrier between
+ * windows.
+ *
+ * Nodes connected by a channel whose delay is not larger than the
+ * LookaheadThreshold attribute are always kept in the same partition.
+ * The lookahead is the smallest delay of the channels which connect
+ * two different partitions. The channel delay is read from its
+ * "Delay" attribute (PointToPointChannel, CsmaChannel, SimpleChannel)
+ * or from the minimum of its "PropagationDelayModel" attribute
+ * (PropagationDelayModel::GetMinimumDelay); channels exposing neither
+ * are assumed to have no delay.
+ *
+ * The event context selects the partition: events scheduled with the
+ * id of a node as context run in the partition of that node. Events
+ * without a node context (for example those scheduled with
+ * Simulator::Schedule before the simulation starts) run serially
+ * between two windows, while every partition is paused, before the
+ * node events with the same timestamp.
+ *
+ * Events exchanged between partitions are delivered at the next window.
+ * The event uids are assigned when the events are scheduled, from
+ * sequences owned by the partitions, and each partition draws the packet
+ * uids and the automatic random streams from its own range, so that two
+ * runs with the same partitions produce identical results.
+ *
+ * A single partition keeps the global counters and also owns the events
+ * without a node context, so that it produces the same results as the
+ * DefaultSimulatorImpl. With several partitions the results may differ
+ * from those of the DefaultSimulatorImpl.
+ *
+ * The event uids of the partitions are interleaved in the 32 bits of
+ * the uid and realigned at each window: the simulation aborts when the
+ * busiest partition has scheduled about 2^32 / (number of partitions + 1)
+ * events.
+ *
+ * IsExpired() on an event of another partition reflects the state of
+ * that partition at the start of the window; cancelling such an event
+ * while it may execute during the window aborts.
+ *
+ * This implementation is only available when ns-3 is configured with
+ * NS3_MTP, which makes reference counting and packet buffers thread-safe.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Get the number of partitions.
+     *
+     * The nodes are partitioned by the first call to Run(); before that
+     * this returns zero.
+     *
+     * @returns The number of partitions.
+     */
+    uint32_t GetNPartitions() const;
+
+    /**
+     * Get the partition which executes the events of a context.
+     *
+     * @param [in] context The event context (node id).
+     * @returns The partition index, or GetNPartitions() for the contexts
+     *          which are executed serially. With a single partition, every
+     *          context is executed by partition 0.
+     */
+    uint32_t GetPartition(uint32_t context) const;
+
+    /**
+     * Get the lookahead between partitions.
+     *
+     * @returns The lookahead, or the maximum simulation time if no
+     *          channel connects two different partitions.
+     */
+    Time GetLookahead() const;
+
+    /**
+     * Get the minimum delay of a channel, used to derive the lookahead.
+     *
+     * @param [in] channel The channel.
+     * @returns The minimum delay between the transmission of a packet
+     *          on this channel and its reception.
+     */
+    static Time GetChannelDelay(Ptr<Channel> channel);
+
+  private:
+    void DoDispose() override;
+
+    /** An event sent to a different partition. */
+    struct Message
+    {
+        /** Absolute timestamp. */
+        uint64_t timestamp;
+        /** The event context. */
+        uint32_t context;
+        /** The event uid, assigned by the sending partition. */
+        uint32_t uid;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** Container type for the messages sent to each partition. */
+    typedef std::vector<std::vector<Message>> Outboxes;
+
+    /** The state of a partition. */
+    struct LogicalProcess
+    {
+        /** Index of this partition. */
+        uint32_t id{0};
+        /** The event priority queue. */
+        Ptr<Scheduler> events;
+        /** Sequence number of the next event scheduled by this partition. */
+        uint32_t sequence{0};
+        /** Unique id of the current event. */
+        uint32_t currentUid{0};
+        /** Timestamp of the current event. */
+        uint64_t currentTs{0};
+        /** Unique id of the last event executed before the current window. */
+        uint32_t windowUid{0};
+        /** Timestamp of the last event executed before the current window. */
+        uint64_t windowTs{0};
+        /** Next uid of the packets created by this partition. */
+        uint64_t packetUid{0};
+        /** Next automatic stream index of the random variables of this partition. */
+        uint64_t streamIndex{0};
+        /** Next uid of the headers and trailers added by this partition. */
+        uint16_t chunkUid{0};
+        /** Execution context of the current event. */
+        uint32_t currentContext{0};
+        /** The event count. */
+        uint64_t eventCount{0};
+        /** Number of events that have been inserted but not yet executed. */
+        int unscheduledEvents{0};
+        /** Earliest timestamp of the messages sent in the current window. */
+        uint64_t minSentTs{0};
+        /**
+         * Messages sent to the other partitions, double-buffered by window
+         * parity and indexed by destination partition. The last index is
+         * reserved for the serial partition.
+         */
+        Outboxes outboxes[2];
+    };
+
+    /**
+     * Insert an event in the queue of a partition.
+     *
+     * @param [in] lp The partition.
+     * @param [in] ts The absolute timestamp.
+     * @param [in] context The event context.
+     * @param [in] uid The event uid.
+     * @param [in] event The event.
+     * @returns The scheduler key of the event.
+     */
+    static Scheduler::Event Insert(LogicalProcess& lp,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   uint32_t uid,
+                                   EventImpl* event);
+    /**
+     * Get the uid of a new event.
+     *
+     * The uids of the events scheduled by a partition are its sequence
+     * numbers, interleaved with those of the other partitions, so that
+     * they are unique in every event queue.
+     *
+     * @param [in] lp The partition which schedules the event.
+     * @returns The event uid.
+     */
+    uint32_t NextUid(LogicalProcess& lp) const;
+    /**
+     * Align the sequence numbers of the partitions on the largest one,
+     * so that the events scheduled in the next window get larger uids
+     * than all the events scheduled before.
+     */
+    void AlignSequences();
+    /**
+     * Check whether a partition may be executing concurrently with the
+     * calling thread.
+     *
+     * @param [in] lp The partition.
+     * @returns \c true if the calling thread executes another node partition.
+     */
+    bool IsConcurrent(const LogicalProcess& lp) const;
+    /**
+     * Get the partition which owns the events of a context.
+     *
+     * @param [in] context The event context.
+     * @returns The partition.
+     */
+    LogicalProcess& GetOwner(uint32_t context);
+    /**
+     * @copydoc GetOwner(uint32_t)
+     */
+    const LogicalProcess& GetOwner(uint32_t context) const;
+    /**
+     * Get the partition of the calling thread.
+     *
+     * @returns The partition currently executed by this thread, or the
+     *          serial partition.
+     */
+    const LogicalProcess& GetCurrent() const;
+
+    /** Split the nodes into partitions and compute the lookahead. */
+    void Partition();
+    /**
+     * Execute the events of a partition within the current window.
+     *
+     * @param [in] lp The partition.
+     */
+    void ProcessWindow(LogicalProcess& lp);
+    /**
+     * Synchronize the partitions at the end of a window: deliver the
+     * messages to the serial partition, execute the serial events and
+     * compute the bound of the next window.
+     *
+     * Executed by a single thread while every partition is paused.
+     */
+    void EndWindow();
+    /**
+     * Execute the serial events with the given timestamp.
+     *
+     * @param [in] ts The timestamp.
+     */
+    void ProcessSerialEvents(uint64_t ts);
+    /** Move events scheduled from foreign threads into the event queues. */
+    void ProcessEventsWithContext();
+    /**
+     * Execution loop of a worker thread.
+     *
+     * @tparam BARRIER \deduced The barrier type.
+     * @param [in] barrier The barrier which ends every window.
+     */
+    template <typename BARRIER>
+    void WorkerLoop(BARRIER& barrier);
+
+    /** Wrap an event scheduled from a foreign thread. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Event delay. */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** Container type for the events from a foreign thread. */
+    typedef std::list<EventWithContext> EventsWithContext;
+    /** The container of events from a foreign thread. */
+    EventsWithContext m_eventsWithContext;
+    /**
+     * Flag \c true if all events with context have been moved to the
+     * primary event queue.
+     */
+    std::atomic<bool> m_eventsWithContextEmpty;
+    /** Mutex to control access to the list of events with context. */
+    std::mutex m_eventsWithContextMutex;
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+    /** Mutex to control access to the list of destroy events. */
+    mutable std::mutex m_destroyEventsMutex;
+
+    /** The factory of the partition event queues. */
+    ObjectFactory m_schedulerFactory;
+    /**
+     * The serial partition: holds every event before the nodes are
+     * partitioned, and the events without a node context afterwards.
+     */
+    LogicalProcess m_serial;
+    /** The node partitions. */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** Partition index of each node, indexed by node id. */
+    std::vector<uint32_t> m_partitionOf;
+    /** Flag \c true once the nodes have been partitioned. */
+    bool m_partitioned;
+
+    /** Number of interleaved sequences of event uids. */
+    uint32_t m_uidStride;
+    /** The sequence numbers from this one on would overflow the uids. */
+    uint32_t m_sequenceLimit;
+    /** The lookahead, in time steps. */
+    uint64_t m_lookahead;
+    /** Channels with a smaller delay do not cross partitions. */
+    Time m_lookaheadThreshold;
+    /** Maximum number of threads, or zero for the hardware concurrency. */
+    uint32_t m_maxThreads;
+
+    /** Window counter, its parity selects the outboxes. */
+    uint64_t m_window;
+    /** Exclusive upper bound of the timestamps of the current window. */
+    uint64_t m_windowEnd;
+    /** Index of the next partition to execute in the current window. */
+    std::atomic<uint32_t> m_nextLp;
+    /** Flag \c true when the worker threads must leave Run(). */
+    bool m_finished;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+
+    /** The partition executed by the calling thread, if any. */
+    static thread_local LogicalProcess* m_currentLp;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,558 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mtp-tests
+ * Multithreaded simulator test suite.
+ */
+
+/**
+ * @ingroup mtp
+ * @defgroup mtp-tests mtp module tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Compare the execution of a ring of nodes with the
+ * DefaultSimulatorImpl and with the MultithreadedSimulatorImpl.
+ *
+ * Every node starts a packet around the ring; each node forwards the
+ * packets it receives with one byte less until they are empty. One link
+ * has no delay, so its two nodes must share a partition.
+ */
+class MultithreadedSimulatorRingTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorRingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Log of the receptions of a node: timestamp and packet size. */
+    typedef std::vector<std::pair<int64_t, uint32_t>> ReceptionLog;
+
+    /**
+     * Build the ring, run the simulation and destroy it.
+     *
+     * @param [in] impl The simulator implementation.
+     * @returns The reception log of each node.
+     */
+    std::vector<ReceptionLog> RunRing(Ptr<SimulatorImpl> impl);
+
+    /**
+     * Start a packet from a node.
+     *
+     * @param [in] node The node.
+     */
+    void Start(Ptr<Node> node);
+
+    /**
+     * Receive a packet and forward a smaller one to the next node.
+     *
+     * @param [in] device The receiving device.
+     * @param [in] packet The packet.
+     * @param [in] protocol The protocol number.
+     * @param [in] from The sender address.
+     * @returns \c true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /** Record the time of the serial event. */
+    void Serial();
+
+    static constexpr uint32_t N_NODES = 8; //!< Number of nodes in the ring
+    static constexpr uint32_t N_HOPS = 40; //!< Initial packet size
+    std::vector<ReceptionLog> m_logs;      //!< Reception log of each node
+    std::vector<Ptr<NetDevice>> m_next;    //!< Device towards the next node
+    Time m_serialTime;                     //!< Time of the serial event
+    uint32_t m_serialContext;              //!< Context of the serial event
+};
+
+MultithreadedSimulatorRingTestCase::MultithreadedSimulatorRingTestCase()
+    : TestCase("Check that partitions give the same results as the default simulator")
+{
+}
+
+void
+MultithreadedSimulatorRingTestCase::Start(Ptr<Node> node)
+{
+    m_next[node->GetId()]->Send(Create<Packet>(N_HOPS), Mac48Address::GetBroadcast(), 0);
+}
+
+bool
+MultithreadedSimulatorRingTestCase::Receive(Ptr<NetDevice> device,
+                                            Ptr<const Packet> packet,
+                                            uint16_t protocol,
+                                            const Address& from)
+{
+    uint32_t id = device->GetNode()->GetId();
+    NS_ASSERT(Simulator::GetContext() == id);
+    m_logs[id].emplace_back(Simulator::Now().GetTimeStep(), packet->GetSize());
+    if (packet->GetSize() > 0)
+    {
+        m_next[id]->Send(Create<Packet>(packet->GetSize() - 1), Mac48Address::GetBroadcast(), 0);
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorRingTestCase::Serial()
+{
+    m_serialTime = Simulator::Now();
+    m_serialContext = Simulator::GetContext();
+}
+
+std::vector<MultithreadedSimulatorRingTestCase::ReceptionLog>
+MultithreadedSimulatorRingTestCase::RunRing(Ptr<SimulatorImpl> impl)
+{
+    Simulator::SetImplementation(impl);
+    m_logs.assign(N_NODES, ReceptionLog());
+    m_next.assign(N_NODES, nullptr);
+
+    NodeContainer nodes;
+    nodes.Create(N_NODES);
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        Ptr<Node> a = nodes.Get(i);
+        Ptr<Node> b = nodes.Get((i + 1) % N_NODES);
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        channel->SetAttribute("Delay", TimeValue(i == 0 ? Seconds(0) : MilliSeconds(1)));
+        Ptr<SimpleNetDevice> tx = CreateObject<SimpleNetDevice>();
+        Ptr<SimpleNetDevice> rx = CreateObject<SimpleNetDevice>();
+        tx->SetAddress(Mac48Address::Allocate());
+        rx->SetAddress(Mac48Address::Allocate());
+        a->AddDevice(tx);
+        b->AddDevice(rx);
+        tx->SetChannel(channel);
+        rx->SetChannel(channel);
+        rx->SetReceiveCallback(MakeCallback(&MultithreadedSimulatorRingTestCase::Receive, this));
+        m_next[i] = tx;
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(10 * i),
+                                       &MultithreadedSimulatorRingTestCase::Start,
+                                       this,
+                                       a);
+    }
+    m_serialContext = 0;
+    Simulator::Schedule(MicroSeconds(5010), &MultithreadedSimulatorRingTestCase::Serial, this);
+
+    Simulator::Run();
+    Simulator::Destroy();
+    return m_logs;
+}
+
+void
+MultithreadedSimulatorRingTestCase::DoRun()
+{
+    std::vector<ReceptionLog> expected = RunRing(CreateObject<DefaultSimulatorImpl>());
+    Time expectedSerialTime = m_serialTime;
+
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(4));
+    std::vector<ReceptionLog> logs = RunRing(impl);
+
+    NS_TEST_ASSERT_MSG_EQ(impl->GetNPartitions(), 4, "Unexpected number of partitions");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetPartition(0),
+                          impl->GetPartition(1),
+                          "Nodes linked without delay must share a partition");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetPartition(Simulator::NO_CONTEXT),
+                          impl->GetNPartitions(),
+                          "Events without context must be serial");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLookahead(), MilliSeconds(1), "Unexpected lookahead");
+    NS_TEST_ASSERT_MSG_EQ(m_serialTime, expectedSerialTime, "Wrong time of serial event");
+    NS_TEST_ASSERT_MSG_EQ(m_serialContext,
+                          Simulator::NO_CONTEXT,
+                          "Wrong context of serial event");
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(logs[i].size(), expected[i].size(), "Node " << i);
+        NS_TEST_ASSERT_MSG_EQ((logs[i] == expected[i]), true, "Node " << i);
+    }
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Check that two runs with the same partitions give identical
+ * results.
+ *
+ * The nodes form a ring in which every node is also linked to the node
+ * after its successor. The packets are forwarded on either link, so that
+ * events of several partitions share timestamps. Each reception records
+ * the packet uid and a value drawn from a new random variable, cancels a
+ * timeout of another partition and, for one packet size, schedules an
+ * event without context.
+ */
+class MultithreadedSimulatorDeterminismTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorDeterminismTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Reception: timestamp, packet size, packet uid and random value. */
+    typedef std::tuple<int64_t, uint32_t, uint64_t, double> Reception;
+    /** Log of the receptions of a node. */
+    typedef std::vector<Reception> ReceptionLog;
+
+    /**
+     * Build the topology, run the simulation and destroy it.
+     *
+     * @param [in] impl The simulator implementation.
+     * @returns The reception log of each node.
+     */
+    std::vector<ReceptionLog> RunMesh(Ptr<SimulatorImpl> impl);
+
+    /**
+     * Start a packet from a node and schedule its timeout.
+     *
+     * @param [in] node The node.
+     */
+    void Start(Ptr<Node> node);
+
+    /**
+     * Receive a packet and forward a smaller one.
+     *
+     * @param [in] device The receiving device.
+     * @param [in] packet The packet.
+     * @param [in] protocol The protocol number.
+     * @param [in] from The sender address.
+     * @returns \c true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /**
+     * Count the timeout of a node.
+     *
+     * @param [in] node The node index.
+     */
+    void Timeout(uint32_t node);
+
+    /** Count the serial events. */
+    void Serial();
+
+    static constexpr uint32_t N_NODES = 8;   //!< Number of nodes
+    static constexpr uint32_t N_HOPS = 40;   //!< Initial packet size
+    std::vector<ReceptionLog> m_logs;        //!< Reception log of each node
+    std::vector<Ptr<NetDevice>> m_next;      //!< Device towards the next node
+    std::vector<Ptr<NetDevice>> m_skip;      //!< Device towards the node after
+    std::vector<EventId> m_timeouts;         //!< Timeout of each node
+    std::vector<uint32_t> m_timeoutsExpired; //!< Number of timeouts of each node
+    uint32_t m_serialEvents;                 //!< Number of serial events
+};
+
+MultithreadedSimulatorDeterminismTestCase::MultithreadedSimulatorDeterminismTestCase()
+    : TestCase("Check that runs with the same partitions give identical results")
+{
+}
+
+void
+MultithreadedSimulatorDeterminismTestCase::Start(Ptr<Node> node)
+{
+    uint32_t id = node->GetId();
+    m_timeouts[id] = Simulator::Schedule(MilliSeconds(100),
+                                         &MultithreadedSimulatorDeterminismTestCase::Timeout,
+                                         this,
+                                         id);
+    m_next[id]->Send(Create<Packet>(N_HOPS), Mac48Address::GetBroadcast(), 0);
+}
+
+bool
+MultithreadedSimulatorDeterminismTestCase::Receive(Ptr<NetDevice> device,
+                                                   Ptr<const Packet> packet,
+                                                   uint16_t protocol,
+                                                   const Address& from)
+{
+    uint32_t id = device->GetNode()->GetId();
+    uint32_t size = packet->GetSize();
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    m_logs[id].emplace_back(Simulator::Now().GetTimeStep(),
+                            size,
+                            packet->GetUid(),
+                            random->GetValue());
+    // The timeouts are all scheduled during the first window
+    EventId& timeout = m_timeouts[(id + N_NODES / 2) % N_NODES];
+    if (size == N_HOPS / 2 && timeout.IsPending())
+    {
+        timeout.Cancel();
+    }
+    if (size == N_HOPS / 4)
+    {
+        Simulator::ScheduleWithContext(Simulator::NO_CONTEXT,
+                                       Time(0),
+                                       &MultithreadedSimulatorDeterminismTestCase::Serial,
+                                       this);
+    }
+    if (size > 0)
+    {
+        Ptr<NetDevice> out = size % 2 ? m_skip[id] : m_next[id];
+        out->Send(Create<Packet>(size - 1), Mac48Address::GetBroadcast(), 0);
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorDeterminismTestCase::Timeout(uint32_t node)
+{
+    m_timeoutsExpired[node]++;
+}
+
+void
+MultithreadedSimulatorDeterminismTestCase::Serial()
+{
+    m_serialEvents++;
+}
+
+std::vector<MultithreadedSimulatorDeterminismTestCase::ReceptionLog>
+MultithreadedSimulatorDeterminismTestCase::RunMesh(Ptr<SimulatorImpl> impl)
+{
+    Simulator::SetImplementation(impl);
+    m_logs.assign(N_NODES, ReceptionLog());
+    m_next.assign(N_NODES, nullptr);
+    m_skip.assign(N_NODES, nullptr);
+    m_timeouts.assign(N_NODES, EventId());
+    m_timeoutsExpired.assign(N_NODES, 0);
+    m_serialEvents = 0;
+
+    NodeContainer nodes;
+    nodes.Create(N_NODES);
+    auto link = [this](Ptr<Node> a, Ptr<Node> b) {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        channel->SetAttribute("Delay", TimeValue(MilliSeconds(1)));
+        Ptr<SimpleNetDevice> tx = CreateObject<SimpleNetDevice>();
+        Ptr<SimpleNetDevice> rx = CreateObject<SimpleNetDevice>();
+        tx->SetAddress(Mac48Address::Allocate());
+        rx->SetAddress(Mac48Address::Allocate());
+        a->AddDevice(tx);
+        b->AddDevice(rx);
+        tx->SetChannel(channel);
+        rx->SetChannel(channel);
+        rx->SetReceiveCallback(
+            MakeCallback(&MultithreadedSimulatorDeterminismTestCase::Receive, this));
+        return tx;
+    };
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        m_next[i] = link(nodes.Get(i), nodes.Get((i + 1) % N_NODES));
+        m_skip[i] = link(nodes.Get(i), nodes.Get((i + 2) % N_NODES));
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(10 * (i % 2)),
+                                       &MultithreadedSimulatorDeterminismTestCase::Start,
+                                       this,
+                                       nodes.Get(i));
+    }
+
+    Simulator::Run();
+    Simulator::Destroy();
+    return m_logs;
+}
+
+void
+MultithreadedSimulatorDeterminismTestCase::DoRun()
+{
+    std::vector<ReceptionLog> expected = RunMesh(CreateObject<DefaultSimulatorImpl>());
+    std::vector<uint32_t> expectedTimeouts = m_timeoutsExpired;
+    uint32_t expectedSerialEvents = m_serialEvents;
+
+    std::vector<std::vector<ReceptionLog>> runs;
+    for (uint32_t run = 0; run < 2; ++run)
+    {
+        Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+        impl->SetAttribute("MaxThreads", UintegerValue(4));
+        runs.push_back(RunMesh(impl));
+        NS_TEST_ASSERT_MSG_EQ(impl->GetNPartitions(), 4, "Unexpected number of partitions");
+        NS_TEST_ASSERT_MSG_EQ((m_timeoutsExpired == expectedTimeouts), true, "Run " << run);
+        NS_TEST_ASSERT_MSG_EQ(m_serialEvents, expectedSerialEvents, "Run " << run);
+    }
+
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ((runs[0][i] == runs[1][i]), true, "Node " << i);
+
+        // The packet uids and the random streams are allocated per
+        // partition, so only the timestamps and sizes match the default
+        // simulator.
+        std::vector<std::pair<int64_t, uint32_t>> receptions;
+        std::vector<std::pair<int64_t, uint32_t>> expectedReceptions;
+        for (const auto& reception : runs[0][i])
+        {
+            receptions.emplace_back(std::get<0>(reception), std::get<1>(reception));
+        }
+        for (const auto& reception : expected[i])
+        {
+            expectedReceptions.emplace_back(std::get<0>(reception), std::get<1>(reception));
+        }
+        std::sort(receptions.begin(), receptions.end());
+        std::sort(expectedReceptions.begin(), expectedReceptions.end());
+        NS_TEST_ASSERT_MSG_EQ((receptions == expectedReceptions), true, "Node " << i);
+    }
+
+    // A single partition keeps the global counters and gives the same
+    // results as the default simulator. The counters are not reset
+    // between the runs, so the packet uids are compared relative to the
+    // first packet of each run.
+    auto rebase = [](std::vector<ReceptionLog>& logs) {
+        uint64_t first = std::numeric_limits<uint64_t>::max();
+        for (const auto& log : logs)
+        {
+            for (const auto& reception : log)
+            {
+                first = std::min(first, std::get<2>(reception));
+            }
+        }
+        for (auto& log : logs)
+        {
+            for (auto& reception : log)
+            {
+                std::get<2>(reception) -= first;
+            }
+        }
+    };
+    RngSeedManager::ResetNextStreamIndex();
+    expected = RunMesh(CreateObject<DefaultSimulatorImpl>());
+    rebase(expected);
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(1));
+    RngSeedManager::ResetNextStreamIndex();
+    std::vector<ReceptionLog> single = RunMesh(impl);
+    rebase(single);
+    NS_TEST_ASSERT_MSG_EQ(impl->GetNPartitions(), 1, "Unexpected number of partitions");
+    NS_TEST_ASSERT_MSG_EQ((m_timeoutsExpired == expectedTimeouts), true, "Single partition");
+    NS_TEST_ASSERT_MSG_EQ(m_serialEvents, expectedSerialEvents, "Single partition");
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ((single[i] == expected[i]), true, "Node " << i);
+    }
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Check that Simulator::Stop halts all the partitions and that
+ * the simulation can be resumed.
+ */
+class MultithreadedSimulatorStopTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorStopTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Count the events of a node and reschedule.
+     *
+     * @param [in] node The node index.
+     */
+    void Tick(uint32_t node);
+
+    std::vector<uint32_t> m_ticks; //!< Number of ticks of each node
+};
+
+MultithreadedSimulatorStopTestCase::MultithreadedSimulatorStopTestCase()
+    : TestCase("Check Simulator::Stop with several partitions")
+{
+}
+
+void
+MultithreadedSimulatorStopTestCase::Tick(uint32_t node)
+{
+    m_ticks[node]++;
+    Simulator::Schedule(MilliSeconds(1), &MultithreadedSimulatorStopTestCase::Tick, this, node);
+}
+
+void
+MultithreadedSimulatorStopTestCase::DoRun()
+{
+    Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl>();
+    impl->SetAttribute("MaxThreads", UintegerValue(3));
+    Simulator::SetImplementation(impl);
+
+    // Unconnected nodes: every node is its own cluster
+    NodeContainer nodes;
+    nodes.Create(6);
+    m_ticks.assign(6, 0);
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       Seconds(0),
+                                       &MultithreadedSimulatorStopTestCase::Tick,
+                                       this,
+                                       i);
+    }
+
+    Simulator::Stop(MilliSeconds(9) + NanoSeconds(1));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(impl->GetNPartitions(), 3, "Unexpected number of partitions");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLookahead(),
+                          Simulator::GetMaximumSimulationTime(),
+                          "Unconnected partitions have no lookahead bound");
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_ticks[i], 10, "Node " << i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), MilliSeconds(9) + NanoSeconds(1), "Wrong stop time");
+    // Node initialization, ticks and the stop event
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetEventCount(), 6 + 60 + 1, "Wrong event count");
+
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_ticks[i], 20, "Node " << i);
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Multithreaded simulator TestSuite
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+  public:
+    MultithreadedSimulatorTestSuite();
+};
+
+MultithreadedSimulatorTestSuite::MultithreadedSimulatorTestSuite()
+    : TestSuite("mtp", Type::UNIT)
+{
+    AddTestCase(new MultithreadedSimulatorRingTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new MultithreadedSimulatorDeterminismTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new MultithreadedSimulatorStopTestCase(), TestCase::Duration::QUICK);
+}
+
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite; //!< Static variable for test initialization
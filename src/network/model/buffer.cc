@@ -9,6 +9,10 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/memory-accounting.h"
+#include "ns3/packet-memory-pool.h"
+
+#include <algorithm>
 
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
@@ -44,138 +48,262 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
 uint32_t Buffer::g_recommendedStart = 0;
-#ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
+
+void
+Buffer::Recycle(Buffer::Data* data)
+{
+    NS_LOG_FUNCTION(data);
+    NS_ASSERT(data->m_count == 0);
+    Deallocate(data);
+}
+
+Buffer::Data*
+Buffer::Create(uint32_t size)
+{
+    NS_LOG_FUNCTION(size);
+    return Allocate(size);
+}
+
+constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+/// Maximum size of the concatenated buffers which are copied rather than fragmented.
+constexpr uint32_t MAX_COPY_SIZE = 128;
+
+/**
+ * Get the memory account of the buffer data.
+ * @returns The account.
  */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
+static MemoryAccounting::Account*
+GetBufferAccount()
 {
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
+    static auto account = MemoryAccounting::GetAccount("ns3::Buffer");
+    return account;
+}
+
+Buffer::Data*
+Buffer::Allocate(uint32_t reqSize)
+{
+    NS_LOG_FUNCTION(reqSize);
+    if (reqSize == 0)
     {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
-        {
-            Buffer::Deallocate(*i);
-        }
-        delete g_freeList;
-        g_freeList = DESTROYED;
+        reqSize = 1;
+    }
+    NS_ASSERT(reqSize >= 1);
+    reqSize += ALLOC_OVER_PROVISION;
+    // Use the whole block of the size class
+    auto size = static_cast<uint32_t>(
+        PacketMemoryPool::GetBlockSize(reqSize - 1 + sizeof(Buffer::Data)));
+    auto data = static_cast<Buffer::Data*>(PacketMemoryPool::Allocate(size));
+    data->m_size = size + 1 - sizeof(Buffer::Data);
+    data->m_count = 1;
+    data->m_accounted = MemoryAccounting::IsEnabled();
+    if (data->m_accounted)
+    {
+        MemoryAccounting::Allocate(GetBufferAccount(), size);
     }
+    return data;
 }
 
 void
-Buffer::Recycle(Buffer::Data* data)
+Buffer::Deallocate(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
+    uint32_t size = data->m_size - 1 + sizeof(Buffer::Data);
+    if (data->m_accounted)
     {
-        Buffer::Deallocate(data);
+        MemoryAccounting::Release(GetBufferAccount(), size);
     }
-    else
+    PacketMemoryPool::Deallocate(data, size);
+}
+
+Buffer::Fragments*
+Buffer::CreateFragments(uint32_t capacity)
+{
+    NS_LOG_FUNCTION(capacity);
+    // Use the whole block of the size class
+    std::size_t size = PacketMemoryPool::GetBlockSize(
+        sizeof(Buffer::Fragments) + (std::max(capacity, 1U) - 1) * sizeof(Fragments::Fragment));
+    auto fragments = static_cast<Buffer::Fragments*>(PacketMemoryPool::Allocate(size));
+    fragments->m_count = 1;
+    fragments->m_capacity = (size - sizeof(Buffer::Fragments)) / sizeof(Fragments::Fragment) + 1;
+    fragments->m_used = 0;
+    fragments->m_size = 0;
+    fragments->m_accounted = MemoryAccounting::IsEnabled();
+    if (fragments->m_accounted)
     {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
+        MemoryAccounting::Allocate(GetBufferAccount(), size);
     }
+    return fragments;
 }
 
-Buffer::Data*
-Buffer::Create(uint32_t dataSize)
+void
+Buffer::RecycleFragments(Buffer::Fragments* fragments)
 {
-    NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
+    NS_LOG_FUNCTION(fragments);
+    if (--fragments->m_count != 0)
     {
-        g_freeList = new Buffer::FreeList();
+        return;
     }
-    else if (IS_INITIALIZED(g_freeList))
+    for (uint32_t i = 0; i < fragments->m_used; i++)
     {
-        while (!g_freeList->empty())
+        Buffer::Data* data = fragments->m_fragments[i].m_data;
+        if (data != nullptr && --data->m_count == 0)
         {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
+            Buffer::Recycle(data);
         }
     }
-    Buffer::Data* data = Buffer::Allocate(dataSize);
-    NS_ASSERT(data->m_count == 1);
-    return data;
+    std::size_t size = PacketMemoryPool::GetBlockSize(
+        sizeof(Buffer::Fragments) + (fragments->m_capacity - 1) * sizeof(Fragments::Fragment));
+    if (fragments->m_accounted)
+    {
+        MemoryAccounting::Release(GetBufferAccount(), size);
+    }
+    PacketMemoryPool::Deallocate(fragments, size);
 }
-#else  /* BUFFER_FREE_LIST */
+
 void
-Buffer::Recycle(Buffer::Data* data)
+Buffer::AppendFragment(Buffer::Fragments*& fragments,
+                       Buffer::Data* data,
+                       uint32_t start,
+                       uint32_t size)
 {
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    Deallocate(data);
+    NS_LOG_FUNCTION(fragments << data << start << size);
+    NS_ASSERT(fragments->m_count == 1);
+    if (size == 0)
+    {
+        return;
+    }
+    if (fragments->m_used > 0)
+    {
+        Fragments::Fragment& last = fragments->m_fragments[fragments->m_used - 1];
+        if (last.m_data == data && (data == nullptr || last.m_start + last.m_size == start))
+        {
+            last.m_size += size;
+            fragments->m_size += size;
+            return;
+        }
+    }
+    if (fragments->m_used == fragments->m_capacity)
+    {
+        Buffer::Fragments* larger = CreateFragments(2 * fragments->m_capacity);
+        memcpy(larger->m_fragments,
+               fragments->m_fragments,
+               fragments->m_used * sizeof(Fragments::Fragment));
+        larger->m_used = fragments->m_used;
+        larger->m_size = fragments->m_size;
+        // The fragments move to the larger storage with their data counts
+        fragments->m_used = 0;
+        RecycleFragments(fragments);
+        fragments = larger;
+    }
+    if (data != nullptr)
+    {
+        data->m_count++;
+    }
+    fragments->m_fragments[fragments->m_used] = {data, start, size, fragments->m_size};
+    fragments->m_used++;
+    fragments->m_size += size;
 }
 
-Buffer::Data*
-Buffer::Create(uint32_t size)
+void
+Buffer::AppendPayload(Buffer::Fragments*& fragments) const
 {
-    NS_LOG_FUNCTION(size);
-    return Allocate(size);
+    NS_LOG_FUNCTION(this << fragments);
+    uint32_t size = m_zeroAreaEnd - m_zeroAreaStart;
+    if (m_fragments == nullptr)
+    {
+        AppendFragment(fragments, nullptr, 0, size);
+        return;
+    }
+    uint32_t offset = m_fragmentsOffset;
+    for (uint32_t i = 0; i < m_fragments->m_used && size > 0; i++)
+    {
+        const Fragments::Fragment& fragment = m_fragments->m_fragments[i];
+        if (offset >= fragment.m_offset + fragment.m_size)
+        {
+            continue;
+        }
+        uint32_t skip = offset - fragment.m_offset;
+        uint32_t length = std::min(size, fragment.m_size - skip);
+        AppendFragment(fragments, fragment.m_data, fragment.m_start + skip, length);
+        offset += length;
+        size -= length;
+    }
 }
-#endif /* BUFFER_FREE_LIST */
 
-constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+void
+Buffer::AppendFragments(Buffer::Fragments*& fragments) const
+{
+    NS_LOG_FUNCTION(this << fragments);
+    AppendFragment(fragments, m_data, m_start, m_zeroAreaStart - m_start);
+    AppendPayload(fragments);
+    AppendFragment(fragments, m_data, m_zeroAreaStart, m_end - m_zeroAreaEnd);
+}
 
-Buffer::Data*
-Buffer::Allocate(uint32_t reqSize)
+void
+Buffer::CopyPayload(const Buffer::Fragments* fragments,
+                    uint32_t offset,
+                    uint8_t* buffer,
+                    uint32_t size)
 {
-    NS_LOG_FUNCTION(reqSize);
-    if (reqSize == 0)
+    NS_LOG_FUNCTION(fragments << offset << &buffer << size);
+    if (fragments == nullptr)
     {
-        reqSize = 1;
+        memset(buffer, 0, size);
+        return;
+    }
+    NS_ASSERT(offset + size <= fragments->m_size);
+    const Fragments::Fragment* fragment =
+        std::upper_bound(fragments->m_fragments,
+                         fragments->m_fragments + fragments->m_used,
+                         offset,
+                         [](uint32_t o, const Fragments::Fragment& f) { return o < f.m_offset; }) -
+        1;
+    while (size > 0)
+    {
+        uint32_t skip = offset - fragment->m_offset;
+        uint32_t length = std::min(size, fragment->m_size - skip);
+        if (fragment->m_data == nullptr)
+        {
+            memset(buffer, 0, length);
+        }
+        else
+        {
+            memcpy(buffer, fragment->m_data->m_data + fragment->m_start + skip, length);
+        }
+        buffer += length;
+        offset += length;
+        size -= length;
+        fragment++;
     }
-    NS_ASSERT(reqSize >= 1);
-    reqSize += ALLOC_OVER_PROVISION;
-    uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
-    auto b = new uint8_t[size];
-    auto data = reinterpret_cast<Buffer::Data*>(b);
-    data->m_size = reqSize;
-    data->m_count = 1;
-    return data;
 }
 
 void
-Buffer::Deallocate(Buffer::Data* data)
+Buffer::CopyPayload(const Buffer::Fragments* fragments,
+                    uint32_t offset,
+                    std::ostream* os,
+                    uint32_t size)
 {
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    auto buf = reinterpret_cast<uint8_t*>(data);
-    delete[] buf;
+    NS_LOG_FUNCTION(fragments << offset << &os << size);
+    if (fragments == nullptr)
+    {
+        while (size > 0)
+        {
+            uint32_t toWrite = std::min(size, g_zeroes.size);
+            os->write(g_zeroes.buffer, toWrite);
+            size -= toWrite;
+        }
+        return;
+    }
+    uint8_t chunk[256];
+    while (size > 0)
+    {
+        uint32_t toWrite = std::min<uint32_t>(size, sizeof(chunk));
+        CopyPayload(fragments, offset, chunk, toWrite);
+        os->write(reinterpret_cast<const char*>(chunk), toWrite);
+        offset += toWrite;
+        size -= toWrite;
+    }
 }
 
 Buffer::Buffer()
@@ -193,6 +321,8 @@ Buffer::Buffer(uint32_t dataSize)
 Buffer::Buffer(uint32_t dataSize, bool initialize)
 {
     NS_LOG_FUNCTION(this << dataSize << initialize);
+    m_fragments = nullptr;
+    m_fragmentsOffset = 0;
     if (initialize)
     {
         Initialize(dataSize);
@@ -238,6 +368,8 @@ Buffer::Initialize(uint32_t zeroSize)
 {
     NS_LOG_FUNCTION(this << zeroSize);
     m_data = Buffer::Create(0);
+    m_fragments = nullptr;
+    m_fragmentsOffset = 0;
     m_start = std::min(m_data->m_size, g_recommendedStart);
     m_maxZeroAreaStart = m_start;
     m_zeroAreaStart = m_start;
@@ -255,14 +387,26 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
         m_data = o.m_data;
         m_data->m_count++;
     }
+    if (m_fragments != o.m_fragments)
+    {
+        if (o.m_fragments != nullptr)
+        {
+            o.m_fragments->m_count++;
+        }
+        if (m_fragments != nullptr)
+        {
+            RecycleFragments(m_fragments);
+        }
+        m_fragments = o.m_fragments;
+    }
+    m_fragmentsOffset = o.m_fragmentsOffset;
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
     m_maxZeroAreaStart = o.m_maxZeroAreaStart;
     m_zeroAreaStart = o.m_zeroAreaStart;
@@ -278,11 +422,14 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
+    if (m_fragments != nullptr)
+    {
+        RecycleFragments(m_fragments);
+    }
 }
 
 uint32_t
@@ -304,7 +451,13 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // the other owners of shared data may live in a concurrently running
+    // partition, so the area around the dirty area cannot be claimed safely.
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -322,8 +475,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -350,7 +502,12 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // see Buffer::AddAtStart
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -368,8 +525,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -396,7 +552,15 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
+    if (&o == this)
+    {
+        Buffer copy = o;
+        AddAtEnd(copy);
+        return;
+    }
+
+    if (m_fragments == nullptr && o.m_fragments == nullptr && m_data->m_count == 1 &&
+        (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
         m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
         o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
@@ -424,11 +588,78 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
-    *this = CreateFullCopy();
-    AddAtEnd(o.GetSize());
-    Buffer::Iterator destStart = End();
-    destStart.Prev(o.GetSize());
-    destStart.Write(o.Begin(), o.End());
+    if (o.GetSize() == 0)
+    {
+        return;
+    }
+    if (GetSize() == 0)
+    {
+        *this = o;
+        return;
+    }
+
+    if (m_fragments == nullptr && o.m_fragments == nullptr &&
+        GetSize() + o.GetSize() <= MAX_COPY_SIZE)
+    {
+        // o may share the data of this buffer, before the added bytes
+        *this = CreateFullCopy();
+        uint32_t size = o.GetSize();
+        AddAtEnd(size);
+        o.CopyData(m_data->m_data + GetInternalEnd() - size, size);
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    /* Share the bytes of o, rather than copying them, in the payload area.
+     * Keep the start of this buffer in place if it is not shared and has
+     * no end, else make all its bytes fragments of a new buffer.
+     * Before: |xxx0000|     + |yyy0000...|
+     * After:  |xxx0000yyy0000...|
+     */
+    if (m_data->m_count == 1 && m_end == m_zeroAreaEnd)
+    {
+        Buffer::Fragments* fragments = m_fragments;
+        if (fragments == nullptr || fragments->m_count != 1 ||
+            m_fragmentsOffset + m_zeroAreaEnd - m_zeroAreaStart != fragments->m_size)
+        {
+            fragments = CreateFragments(4);
+            AppendPayload(fragments);
+            if (m_fragments != nullptr)
+            {
+                RecycleFragments(m_fragments);
+            }
+            m_fragmentsOffset = 0;
+        }
+        o.AppendFragments(fragments);
+        m_fragments = fragments;
+        m_zeroAreaEnd = m_zeroAreaStart + fragments->m_size - m_fragmentsOffset;
+        m_end = m_zeroAreaEnd;
+        m_data->m_dirtyEnd = m_end;
+    }
+    else
+    {
+        Buffer::Fragments* fragments = CreateFragments(6);
+        AppendFragments(fragments);
+        o.AppendFragments(fragments);
+        if (--m_data->m_count == 0)
+        {
+            Recycle(m_data);
+        }
+        if (m_fragments != nullptr)
+        {
+            RecycleFragments(m_fragments);
+        }
+        uint32_t size = fragments->m_size;
+        uint32_t maxZeroAreaStart = m_maxZeroAreaStart;
+        Initialize(0);
+        m_maxZeroAreaStart = maxZeroAreaStart;
+        m_fragments = fragments;
+        m_zeroAreaEnd = m_zeroAreaStart + size;
+        m_end = m_zeroAreaEnd;
+        m_data->m_dirtyEnd = m_end;
+    }
+    m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
+    LOG_INTERNAL_STATE("add fragments=" << m_fragments->m_used << ", ");
     NS_ASSERT(CheckInternalState());
 }
 
@@ -452,6 +683,7 @@ Buffer::RemoveAtStart(uint32_t start)
         m_start = m_zeroAreaStart;
         m_zeroAreaEnd -= delta;
         m_end -= delta;
+        m_fragmentsOffset += delta;
     }
     else if (newStart <= m_end)
     {
@@ -473,6 +705,12 @@ Buffer::RemoveAtStart(uint32_t start)
         m_zeroAreaEnd = m_end;
         m_zeroAreaStart = m_end;
     }
+    if (m_fragments != nullptr && m_zeroAreaStart == m_zeroAreaEnd)
+    {
+        RecycleFragments(m_fragments);
+        m_fragments = nullptr;
+        m_fragmentsOffset = 0;
+    }
     m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
     LOG_INTERNAL_STATE("rem start=" << start << ", ");
     NS_ASSERT(CheckInternalState());
@@ -509,6 +747,12 @@ Buffer::RemoveAtEnd(uint32_t end)
         m_zeroAreaEnd = m_start;
         m_zeroAreaStart = m_start;
     }
+    if (m_fragments != nullptr && m_zeroAreaStart == m_zeroAreaEnd)
+    {
+        RecycleFragments(m_fragments);
+        m_fragments = nullptr;
+        m_fragmentsOffset = 0;
+    }
     m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
     LOG_INTERNAL_STATE("rem end=" << end << ", ");
     NS_ASSERT(CheckInternalState());
@@ -535,7 +779,10 @@ Buffer::CreateFullCopy() const
     {
         Buffer tmp;
         tmp.AddAtStart(m_zeroAreaEnd - m_zeroAreaStart);
-        tmp.Begin().WriteU8(0, m_zeroAreaEnd - m_zeroAreaStart);
+        CopyPayload(m_fragments,
+                    m_fragmentsOffset,
+                    tmp.m_data->m_data + tmp.m_start,
+                    m_zeroAreaEnd - m_zeroAreaStart);
         uint32_t dataStart = m_zeroAreaStart - m_start;
         tmp.AddAtStart(dataStart);
         tmp.Begin().Write(m_data->m_data + m_start, dataStart);
@@ -555,6 +802,10 @@ uint32_t
 Buffer::GetSerializedSize() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_fragments != nullptr)
+    {
+        return CreateFullCopy().GetSerializedSize();
+    }
     uint32_t dataStart = (m_zeroAreaStart - m_start + 3) & (~0x3);
     uint32_t dataEnd = (m_end - m_zeroAreaEnd + 3) & (~0x3);
 
@@ -571,6 +822,10 @@ uint32_t
 Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
     NS_LOG_FUNCTION(this << &buffer << maxSize);
+    if (m_fragments != nullptr)
+    {
+        return CreateFullCopy().Serialize(buffer, maxSize);
+    }
     auto p = reinterpret_cast<uint32_t*>(buffer);
     uint32_t size = 0;
 
@@ -710,13 +965,7 @@ Buffer::CopyData(std::ostream* os, uint32_t size) const
         {
             size -= m_zeroAreaStart - m_start;
             tmpsize = std::min(m_zeroAreaEnd - m_zeroAreaStart, size);
-            uint32_t left = tmpsize;
-            while (left > 0)
-            {
-                uint32_t toWrite = std::min(left, g_zeroes.size);
-                os->write(g_zeroes.buffer, toWrite);
-                left -= toWrite;
-            }
+            CopyPayload(m_fragments, m_fragmentsOffset, os, tmpsize);
             if (size > tmpsize)
             {
                 size -= tmpsize;
@@ -741,14 +990,8 @@ Buffer::CopyData(uint8_t* buffer, uint32_t size) const
         if (size > 0)
         {
             tmpsize = std::min(m_zeroAreaEnd - m_zeroAreaStart, size);
-            uint32_t left = tmpsize;
-            while (left > 0)
-            {
-                uint32_t toWrite = std::min(left, g_zeroes.size);
-                memcpy(buffer, g_zeroes.buffer, toWrite);
-                left -= toWrite;
-                buffer += toWrite;
-            }
+            CopyPayload(m_fragments, m_fragmentsOffset, buffer, tmpsize);
+            buffer += tmpsize;
             size -= tmpsize;
             if (size > 0)
             {
@@ -810,6 +1053,20 @@ Buffer::Iterator::Check(uint32_t i) const
     return i >= m_dataStart && !(i >= m_zeroStart && i < m_zeroEnd) && i <= m_dataEnd;
 }
 
+void
+Buffer::Iterator::CopyOnWrite()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_buffer != nullptr && m_buffer->m_fragments == m_fragments &&
+                      m_buffer->m_start == m_dataStart && m_buffer->m_end == m_dataEnd &&
+                      m_buffer->m_zeroAreaStart == m_zeroStart,
+                  "The buffer of this iterator was changed, or is gone");
+    uint32_t offset = m_current - m_dataStart;
+    m_buffer->TransformIntoRealBuffer();
+    Construct(m_buffer);
+    m_current = m_dataStart + offset;
+}
+
 void
 Buffer::Iterator::Write(Iterator start, Iterator end)
 {
@@ -820,28 +1077,40 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(start.m_zeroEnd == end.m_zeroEnd);
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
+    PrepareWrite(m_current, m_current + size);
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    uint8_t* to;
+    if (m_current <= m_zeroStart)
+    {
+        to = &m_data[m_current];
+    }
+    else
+    {
+        to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        CopyPayload(start.m_fragments,
+                    start.m_fragmentsOffset + start.m_current - start.m_zeroStart,
+                    to,
+                    toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
@@ -937,6 +1206,7 @@ void
 Buffer::Iterator::Write(const uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &buffer << size);
+    PrepareWrite(m_current, m_current + size);
     NS_ASSERT_MSG(CheckNoZero(m_current, size), GetWriteErrorMessage());
     uint8_t* to;
     if (m_current <= m_zeroStart)
@@ -955,17 +1225,14 @@ uint32_t
 Buffer::Iterator::ReadU32()
 {
     NS_LOG_FUNCTION(this);
-    uint8_t byte0 = ReadU8();
-    uint8_t byte1 = ReadU8();
-    uint8_t byte2 = ReadU8();
-    uint8_t byte3 = ReadU8();
-    uint32_t data = byte3;
-    data <<= 8;
-    data |= byte2;
-    data <<= 8;
-    data |= byte1;
-    data <<= 8;
-    data |= byte0;
+    uint8_t buffer[4];
+    Read(buffer, 4);
+    uint32_t data = 0;
+    for (int j = 3; j >= 0; j--)
+    {
+        data <<= 8;
+        data |= buffer[j];
+    }
     return data;
 }
 
@@ -973,30 +1240,14 @@ uint64_t
 Buffer::Iterator::ReadU64()
 {
     NS_LOG_FUNCTION(this);
-    uint8_t byte0 = ReadU8();
-    uint8_t byte1 = ReadU8();
-    uint8_t byte2 = ReadU8();
-    uint8_t byte3 = ReadU8();
-    uint8_t byte4 = ReadU8();
-    uint8_t byte5 = ReadU8();
-    uint8_t byte6 = ReadU8();
-    uint8_t byte7 = ReadU8();
-    uint64_t data = byte7;
-    data <<= 8;
-    data |= byte6;
-    data <<= 8;
-    data |= byte5;
-    data <<= 8;
-    data |= byte4;
-    data <<= 8;
-    data |= byte3;
-    data <<= 8;
-    data |= byte2;
-    data <<= 8;
-    data |= byte1;
-    data <<= 8;
-    data |= byte0;
-
+    uint8_t buffer[8];
+    Read(buffer, 8);
+    uint64_t data = 0;
+    for (int j = 7; j >= 0; j--)
+    {
+        data <<= 8;
+        data |= buffer[j];
+    }
     return data;
 }
 
@@ -1004,10 +1255,14 @@ uint16_t
 Buffer::Iterator::SlowReadNtohU16()
 {
     NS_LOG_FUNCTION(this);
+    uint8_t buffer[2];
+    Read(buffer, 2);
     uint16_t retval = 0;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
+    for (int j = 0; j < 2; j++)
+    {
+        retval <<= 8;
+        retval |= buffer[j];
+    }
     return retval;
 }
 
@@ -1015,14 +1270,14 @@ uint32_t
 Buffer::Iterator::SlowReadNtohU32()
 {
     NS_LOG_FUNCTION(this);
+    uint8_t buffer[4];
+    Read(buffer, 4);
     uint32_t retval = 0;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
+    for (int j = 0; j < 4; j++)
+    {
+        retval <<= 8;
+        retval |= buffer[j];
+    }
     return retval;
 }
 
@@ -1030,22 +1285,14 @@ uint64_t
 Buffer::Iterator::ReadNtohU64()
 {
     NS_LOG_FUNCTION(this);
+    uint8_t buffer[8];
+    Read(buffer, 8);
     uint64_t retval = 0;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
-    retval <<= 8;
-    retval |= ReadU8();
+    for (int j = 0; j < 8; j++)
+    {
+        retval <<= 8;
+        retval |= buffer[j];
+    }
     return retval;
 }
 
@@ -1053,11 +1300,14 @@ uint16_t
 Buffer::Iterator::ReadLsbtohU16()
 {
     NS_LOG_FUNCTION(this);
-    uint8_t byte0 = ReadU8();
-    uint8_t byte1 = ReadU8();
-    uint16_t data = byte1;
-    data <<= 8;
-    data |= byte0;
+    uint8_t buffer[2];
+    Read(buffer, 2);
+    uint16_t data = 0;
+    for (int j = 1; j >= 0; j--)
+    {
+        data <<= 8;
+        data |= buffer[j];
+    }
     return data;
 }
 
@@ -1065,17 +1315,14 @@ uint32_t
 Buffer::Iterator::ReadLsbtohU32()
 {
     NS_LOG_FUNCTION(this);
-    uint8_t byte0 = ReadU8();
-    uint8_t byte1 = ReadU8();
-    uint8_t byte2 = ReadU8();
-    uint8_t byte3 = ReadU8();
-    uint32_t data = byte3;
-    data <<= 8;
-    data |= byte2;
-    data <<= 8;
-    data |= byte1;
-    data <<= 8;
-    data |= byte0;
+    uint8_t buffer[4];
+    Read(buffer, 4);
+    uint32_t data = 0;
+    for (int j = 3; j >= 0; j--)
+    {
+        data <<= 8;
+        data |= buffer[j];
+    }
     return data;
 }
 
@@ -1083,30 +1330,14 @@ uint64_t
 Buffer::Iterator::ReadLsbtohU64()
 {
     NS_LOG_FUNCTION(this);
-    uint8_t byte0 = ReadU8();
-    uint8_t byte1 = ReadU8();
-    uint8_t byte2 = ReadU8();
-    uint8_t byte3 = ReadU8();
-    uint8_t byte4 = ReadU8();
-    uint8_t byte5 = ReadU8();
-    uint8_t byte6 = ReadU8();
-    uint8_t byte7 = ReadU8();
-    uint64_t data = byte7;
-    data <<= 8;
-    data |= byte6;
-    data <<= 8;
-    data |= byte5;
-    data <<= 8;
-    data |= byte4;
-    data <<= 8;
-    data |= byte3;
-    data <<= 8;
-    data |= byte2;
-    data <<= 8;
-    data |= byte1;
-    data <<= 8;
-    data |= byte0;
-
+    uint8_t buffer[8];
+    Read(buffer, 8);
+    uint64_t data = 0;
+    for (int j = 7; j >= 0; j--)
+    {
+        data <<= 8;
+        data |= buffer[j];
+    }
     return data;
 }
 
@@ -1114,12 +1345,81 @@ void
 Buffer::Iterator::Read(uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &buffer << size);
-    for (uint32_t i = 0; i < size; i++)
+    NS_ASSERT_MSG(m_current >= m_dataStart && m_current + size <= m_dataEnd,
+                  GetReadErrorMessage());
+    while (size > 0)
     {
-        buffer[i] = ReadU8();
+        const uint8_t* span;
+        uint32_t toCopy = std::min(size, PeekSpan(&span));
+        if (span == nullptr)
+        {
+            memset(buffer, 0, toCopy);
+        }
+        else
+        {
+            memcpy(buffer, span, toCopy);
+        }
+        m_current += toCopy;
+        buffer += toCopy;
+        size -= toCopy;
     }
 }
 
+uint8_t
+Buffer::Iterator::PeekPayloadU8()
+{
+    const uint8_t* span;
+    PeekSpan(&span);
+    return span == nullptr ? 0 : *span;
+}
+
+uint32_t
+Buffer::Iterator::PeekSpan(const uint8_t** span)
+{
+    NS_ASSERT_MSG(m_current >= m_dataStart && m_current < m_dataEnd, GetReadErrorMessage());
+    if (m_current < m_zeroStart)
+    {
+        *span = &m_data[m_current];
+        return m_zeroStart - m_current;
+    }
+    if (m_current >= m_zeroEnd)
+    {
+        *span = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        return m_dataEnd - m_current;
+    }
+    if (m_fragments == nullptr)
+    {
+        *span = nullptr;
+        return m_zeroEnd - m_current;
+    }
+    const Fragments::Fragment* fragments = m_fragments->m_fragments;
+    uint32_t offset = m_fragmentsOffset + m_current - m_zeroStart;
+    auto contains = [this, fragments, offset](uint32_t index) {
+        return index < m_fragments->m_used && offset >= fragments[index].m_offset &&
+               offset - fragments[index].m_offset < fragments[index].m_size;
+    };
+    if (!contains(m_fragmentIndex))
+    {
+        // the sequential reads move on to the next fragment
+        m_fragmentIndex++;
+        if (!contains(m_fragmentIndex))
+        {
+            m_fragmentIndex =
+                std::upper_bound(fragments,
+                                 fragments + m_fragments->m_used,
+                                 offset,
+                                 [](uint32_t o, const Fragments::Fragment& f) {
+                                     return o < f.m_offset;
+                                 }) -
+                fragments - 1;
+        }
+    }
+    const Fragments::Fragment& fragment = fragments[m_fragmentIndex];
+    uint32_t skip = offset - fragment.m_offset;
+    *span = fragment.m_data == nullptr ? nullptr : fragment.m_data->m_data + fragment.m_start + skip;
+    return std::min(fragment.m_size - skip, m_zeroEnd - m_current);
+}
+
 uint16_t
 Buffer::Iterator::CalculateIpChecksum(uint16_t size)
 {
@@ -1133,15 +1433,37 @@ Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
     NS_LOG_FUNCTION(this << size << initialChecksum);
     /* see RFC 1071 to understand this code. */
     uint32_t sum = initialChecksum;
+    // whether the next byte is the second byte of a 16-bit word
+    bool odd = false;
 
-    for (int j = 0; j < size / 2; j++)
+    uint32_t left = size;
+    while (left > 0)
     {
-        sum += ReadU16();
-    }
-
-    if (size & 1)
-    {
-        sum += ReadU8();
+        const uint8_t* span;
+        uint32_t length = std::min(left, PeekSpan(&span));
+        m_current += length;
+        left -= length;
+        if (span == nullptr)
+        {
+            // the virtual zero bytes do not change the sum
+            odd ^= (length & 1);
+            continue;
+        }
+        const uint8_t* spanEnd = span + length;
+        if (odd)
+        {
+            sum += *span++ << 8;
+            odd = false;
+        }
+        for (; span + 1 < spanEnd; span += 2)
+        {
+            sum += span[0] | (span[1] << 8);
+        }
+        if (span < spanEnd)
+        {
+            sum += *span;
+            odd = true;
+        }
     }
 
     while (sum >> 16)
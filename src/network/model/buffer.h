@@ -14,7 +14,9 @@
 #include <stdint.h>
 #include <vector>
 
-#define BUFFER_FREE_LIST 1
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 namespace ns3
 {
@@ -28,9 +30,10 @@ namespace ns3
  * automatically adjusted to hold any data prepended
  * or appended by the user. Its implementation is optimized
  * to ensure that the number of buffer resizes is minimized,
- * by creating new Buffers of the maximum size ever used.
- * The correct maximum size is learned at runtime during use by
- * recording the maximum size of each packet.
+ * by reserving room at the start of new Buffers for the largest
+ * headers ever prepended.  The correct room is learned at runtime
+ * during use by recording the headers of each packet.  The data of
+ * the Buffers is allocated from the PacketMemoryPool.
  *
  * @internal
  * The implementation of the Buffer class uses a COW (Copy On Write)
@@ -78,9 +81,25 @@ namespace ns3
  * @endverbatim
  *
  * A simple state invariant is that m_start <= m_zeroStart <= m_zeroEnd <= m_end
+ *
+ * The area between m_zeroAreaStart and m_zeroAreaEnd is the payload area
+ * of the buffer. It usually holds virtual zero bytes, but the
+ * concatenation of two buffers with AddAtEnd (const Buffer &) turns it
+ * into a list of refcounted fragments, Buffer::Fragments, which reference
+ * the BufferData of the concatenated buffers and the virtual zero bytes
+ * of their payload areas, instead of copying their bytes. The fragments
+ * are read through the Iterator like the other bytes. The first write
+ * of an Iterator into them copies the bytes of the buffer into a new
+ * BufferData, as the concatenation did before, so that the buffers which
+ * share the fragments are not modified: this write, like AddAtStart and
+ * the other changes of the buffer, invalidates the other iterators of
+ * the buffer.
  */
 class Buffer
 {
+  private:
+    struct Fragments;
+
   public:
     /**
      * @brief iterator in a Buffer instance
@@ -393,6 +412,38 @@ class Buffer
          * @param buffer the buffer this iterator refers to
          */
         inline void Construct(const Buffer* buffer);
+        /**
+         * Make the bytes [start, end) writable: if they overlap the
+         * payload fragments, copy the bytes of the buffer into its own
+         * data first.
+         *
+         * @param start start buffer position
+         * @param end end buffer position
+         */
+        inline void PrepareWrite(uint32_t start, uint32_t end);
+        /**
+         * Copy the payload fragments of the buffer into its own data,
+         * and point this iterator to the same position in the copy.
+         */
+        void CopyOnWrite();
+        /**
+         * @return the byte of the payload area at the current position.
+         *
+         * @warning this is the slow version of PeekU8 () for the payload
+         * fragments
+         */
+        uint8_t PeekPayloadU8();
+        /**
+         * @brief Get the contiguous bytes which start at the current position
+         *
+         * The bytes end at the end of the area, or of the payload fragment,
+         * which holds the current position.
+         *
+         * @param [out] span the first of the bytes, or nullptr if they are
+         *        virtual zero bytes
+         * @returns the number of bytes
+         */
+        uint32_t PeekSpan(const uint8_t** span);
         /**
          * Checks that the [start, end) is not in the "virtual zero area".
          *
@@ -472,6 +523,25 @@ class Buffer
          * to this pointer.
          */
         uint8_t* m_data;
+        /**
+         * the fragments of the payload area, or nullptr if the payload
+         * area holds virtual zero bytes.
+         */
+        const Fragments* m_fragments;
+        /**
+         * offset in bytes of the start of the payload area in m_fragments.
+         */
+        uint32_t m_fragmentsOffset;
+        /**
+         * index in m_fragments of the fragment last read, from which
+         * the sequential reads find the next one without a search.
+         */
+        uint32_t m_fragmentIndex;
+        /**
+         * the buffer this iterator refers to, whose payload fragments
+         * are copied on the first write into them.
+         */
+        const Buffer* m_buffer;
     };
 
     /**
@@ -514,7 +584,10 @@ class Buffer
     /**
      * @param o the buffer to append to the end of this buffer.
      *
-     * Add bytes at the end of the Buffer.
+     * Add bytes at the end of the Buffer. Unless both buffers are small,
+     * the bytes of this buffer and of o are not copied: they become
+     * shared fragments of the payload area of this buffer, and are
+     * read-only from then on. Writing them with an Iterator asserts.
      * Any call to this method invalidates any Iterator
      * pointing to this Buffer.
      */
@@ -654,7 +727,11 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
          * the size of the m_data field below.
          */
@@ -669,6 +746,10 @@ class Buffer
          * end of the area in which user bytes were written.
          */
         uint32_t m_dirtyEnd;
+        /**
+         * Whether this instance is counted by the MemoryAccounting.
+         */
+        bool m_accounted;
         /**
          * The real data buffer holds _at least_ one byte.
          * Its real size is stored in the m_size field.
@@ -676,6 +757,59 @@ class Buffer
         uint8_t m_data[1];
     };
 
+    /**
+     * The fragments of the payload area of one or more Buffer instances.
+     *
+     * This data structure is variable-sized through its last member, like
+     * Buffer::Data. Each fragment holds a count of the Buffer::Data it
+     * references. The fragments are never modified once they are shared:
+     * only the Buffer which holds the single count may append fragments.
+     */
+    struct Fragments
+    {
+        /**
+         * A fragment of the payload area.
+         */
+        struct Fragment
+        {
+            Data* m_data;      //!< the referenced data, or nullptr for virtual zero bytes
+            uint32_t m_start;  //!< offset of the fragment in m_data->m_data
+            uint32_t m_size;   //!< size of the fragment
+            uint32_t m_offset; //!< offset of the fragment in the payload area
+        };
+
+        /**
+         * The reference count of an instance of this data structure.
+         * Each buffer which references an instance holds a count.
+         */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
+        uint32_t m_count;
+#endif
+        /**
+         * the number of fragments which fit in the m_fragments field below.
+         */
+        uint32_t m_capacity;
+        /**
+         * the number of fragments in the m_fragments field below.
+         */
+        uint32_t m_used;
+        /**
+         * the total size of the fragments.
+         */
+        uint32_t m_size;
+        /**
+         * Whether this instance is counted by the MemoryAccounting.
+         */
+        bool m_accounted;
+        /**
+         * The fragments, sorted by offset. Their real number is
+         * stored in the m_used field.
+         */
+        Fragment m_fragments[1];
+    };
+
     /**
      * @brief Create a full copy of the buffer, including
      * all the internal structures.
@@ -740,7 +874,79 @@ class Buffer
      */
     static void Deallocate(Buffer::Data* data);
 
+    /**
+     * @brief Allocate the fragments of a payload area
+     * @param capacity the minimum number of fragments
+     * @returns a pointer to the allocated fragments, with a count of one
+     */
+    static Buffer::Fragments* CreateFragments(uint32_t capacity);
+    /**
+     * @brief Release a count of the fragments of a payload area, and
+     * their memory and their data when no buffer references them anymore
+     * @param fragments the fragments
+     */
+    static void RecycleFragments(Buffer::Fragments* fragments);
+    /**
+     * @brief Append a fragment to the fragments of a payload area
+     *
+     * The fragment is merged with the last fragment if they are adjacent.
+     * The fragments are reallocated if they are full.
+     *
+     * @param fragments the fragments, referenced by a single buffer
+     * @param data the data referenced by the fragment, or nullptr for
+     *        virtual zero bytes
+     * @param start offset of the fragment in data->m_data
+     * @param size size of the fragment
+     */
+    static void AppendFragment(Buffer::Fragments*& fragments,
+                               Buffer::Data* data,
+                               uint32_t start,
+                               uint32_t size);
+    /**
+     * @brief Append the payload area of this buffer to fragments
+     * @param fragments the fragments, referenced by a single buffer
+     */
+    void AppendPayload(Buffer::Fragments*& fragments) const;
+    /**
+     * @brief Append all the bytes of this buffer to fragments
+     * @param fragments the fragments, referenced by a single buffer
+     */
+    void AppendFragments(Buffer::Fragments*& fragments) const;
+    /**
+     * @brief Copy bytes of a payload area
+     * @param fragments the fragments of the payload area, or nullptr for
+     *        virtual zero bytes
+     * @param offset offset of the first byte in the fragments
+     * @param buffer the output buffer
+     * @param size the number of bytes to copy
+     */
+    static void CopyPayload(const Buffer::Fragments* fragments,
+                            uint32_t offset,
+                            uint8_t* buffer,
+                            uint32_t size);
+    /**
+     * @brief Copy bytes of a payload area to an output stream
+     * @param fragments the fragments of the payload area, or nullptr for
+     *        virtual zero bytes
+     * @param offset offset of the first byte in the fragments
+     * @param os the output stream
+     * @param size the number of bytes to copy
+     */
+    static void CopyPayload(const Buffer::Fragments* fragments,
+                            uint32_t offset,
+                            std::ostream* os,
+                            uint32_t size);
+
     Data* m_data; //!< the buffer data storage
+    /**
+     * the fragments of the payload area, or nullptr if the payload area
+     * holds virtual zero bytes
+     */
+    Fragments* m_fragments;
+    /**
+     * offset of the start of the payload area in m_fragments
+     */
+    uint32_t m_fragmentsOffset;
 
     /**
      * keep track of the maximum value of m_zeroAreaStart across
@@ -780,21 +986,6 @@ class Buffer
      * instance from the start of m_data->m_data
      */
     uint32_t m_end;
-
-#ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
-
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
-
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
 };
 
 } // namespace ns3
@@ -812,7 +1003,11 @@ Buffer::Iterator::Iterator()
       m_dataStart(0),
       m_dataEnd(0),
       m_current(0),
-      m_data(nullptr)
+      m_data(nullptr),
+      m_fragments(nullptr),
+      m_fragmentsOffset(0),
+      m_fragmentIndex(0),
+      m_buffer(nullptr)
 {
 }
 
@@ -836,6 +1031,19 @@ Buffer::Iterator::Construct(const Buffer* buffer)
     m_dataStart = buffer->m_start;
     m_dataEnd = buffer->m_end;
     m_data = buffer->m_data->m_data;
+    m_fragments = buffer->m_fragments;
+    m_fragmentsOffset = buffer->m_fragmentsOffset;
+    m_fragmentIndex = 0;
+    m_buffer = buffer;
+}
+
+void
+Buffer::Iterator::PrepareWrite(uint32_t start, uint32_t end)
+{
+    if (m_fragments != nullptr && end > m_zeroStart && start < m_zeroEnd)
+    {
+        CopyOnWrite();
+    }
 }
 
 void
@@ -869,6 +1077,7 @@ Buffer::Iterator::Prev(uint32_t delta)
 void
 Buffer::Iterator::WriteU8(uint8_t data)
 {
+    PrepareWrite(m_current, m_current + 1);
     NS_ASSERT_MSG(Check(m_current), GetWriteErrorMessage());
 
     if (m_current < m_zeroStart)
@@ -886,6 +1095,7 @@ Buffer::Iterator::WriteU8(uint8_t data)
 void
 Buffer::Iterator::WriteU8(uint8_t data, uint32_t len)
 {
+    PrepareWrite(m_current, m_current + len);
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + len), GetWriteErrorMessage());
     if (m_current <= m_zeroStart)
     {
@@ -903,6 +1113,7 @@ Buffer::Iterator::WriteU8(uint8_t data, uint32_t len)
 void
 Buffer::Iterator::WriteHtonU16(uint16_t data)
 {
+    PrepareWrite(m_current, m_current + 2);
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + 2), GetWriteErrorMessage());
     uint8_t* buffer;
     if (m_current + 2 <= m_zeroStart)
@@ -921,6 +1132,7 @@ Buffer::Iterator::WriteHtonU16(uint16_t data)
 void
 Buffer::Iterator::WriteHtonU32(uint32_t data)
 {
+    PrepareWrite(m_current, m_current + 4);
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + 4), GetWriteErrorMessage());
 
     uint8_t* buffer;
@@ -1003,7 +1215,11 @@ Buffer::Iterator::PeekU8()
     }
     else if (m_current < m_zeroEnd)
     {
-        return 0;
+        if (m_fragments == nullptr)
+        {
+            return 0;
+        }
+        return PeekPayloadU8();
     }
     else
     {
@@ -1023,6 +1239,12 @@ Buffer::Iterator::ReadU8()
 uint16_t
 Buffer::Iterator::ReadU16()
 {
+    if (m_fragments != nullptr && m_current + 2 > m_zeroStart && m_current < m_zeroEnd)
+    {
+        uint8_t buffer[2];
+        Read(buffer, 2);
+        return buffer[0] | (buffer[1] << 8);
+    }
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint16_t data = byte1;
@@ -1043,6 +1265,8 @@ Buffer::Iterator::Read(Buffer::Iterator start, uint32_t size)
 
 Buffer::Buffer(const Buffer& o)
     : m_data(o.m_data),
+      m_fragments(o.m_fragments),
+      m_fragmentsOffset(o.m_fragmentsOffset),
       m_maxZeroAreaStart(o.m_zeroAreaStart),
       m_zeroAreaStart(o.m_zeroAreaStart),
       m_zeroAreaEnd(o.m_zeroAreaEnd),
@@ -1050,6 +1274,10 @@ Buffer::Buffer(const Buffer& o)
       m_end(o.m_end)
 {
     m_data->m_count++;
+    if (m_fragments != nullptr)
+    {
+        m_fragments->m_count++;
+    }
     NS_ASSERT(CheckInternalState());
 }
 
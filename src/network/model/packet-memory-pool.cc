@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-memory-pool.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <mutex>
+#include <new>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::PacketMemoryPool implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketMemoryPool");
+
+std::atomic<bool> PacketMemoryPool::m_enabled{true};
+
+namespace
+{
+
+/** The index of the statistics of the unpooled allocations. */
+constexpr uint32_t UNPOOLED = PacketMemoryPool::SIZE_CLASSES;
+
+/**
+ * The counters of a size class of a thread.
+ *
+ * Only the thread owning the counters writes them, so that they are
+ * incremented without atomic read-modify-write operations; the other
+ * threads only read them.
+ */
+struct Counters
+{
+    std::atomic<uint64_t> allocations{0}; //!< Allocations
+    std::atomic<uint64_t> hits{0};        //!< Allocations served by the cache
+    std::atomic<uint64_t> releases{0};    //!< Releases
+    std::atomic<uint64_t> cached{0};      //!< Blocks in the cache
+};
+
+/**
+ * Add to a counter written by a single thread.
+ * @param [in,out] counter The counter.
+ * @param [in] delta The value to add.
+ */
+inline void
+Add(std::atomic<uint64_t>& counter, uint64_t delta)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+/**
+ * Subtract from a counter written by a single thread.
+ * @param [in,out] counter The counter.
+ * @param [in] delta The value to subtract.
+ */
+inline void
+Subtract(std::atomic<uint64_t>& counter, uint64_t delta)
+{
+    counter.store(counter.load(std::memory_order_relaxed) - delta, std::memory_order_relaxed);
+}
+
+/** The caches of the released blocks of a thread, per size class. */
+struct Cache
+{
+    /** The cached blocks, linked through their first word. */
+    void* heads[PacketMemoryPool::SIZE_CLASSES]{};
+    /** The counters of each size class, then of the unpooled allocations. */
+    Counters counters[PacketMemoryPool::SIZE_CLASSES + 1];
+};
+
+/** The caches of the running threads, and the counters of the exited threads. */
+struct Registry
+{
+    std::mutex mutex;                                    //!< Protects the registry
+    std::vector<Cache*> caches;                          //!< The caches of the running threads
+    PacketMemoryPool::Statistics retired[UNPOOLED + 1]; //!< The statistics of the exited threads
+};
+
+/**
+ * Get the registry of the caches.
+ *
+ * The registry is never destroyed, so that the threads which exit during
+ * the static destruction can still unregister their caches.
+ *
+ * @returns The registry.
+ */
+Registry&
+GetRegistry()
+{
+    static auto registry = new Registry;
+    return *registry;
+}
+
+/** The marker of the cache of a thread which is exiting. */
+Cache* const DESTROYED = reinterpret_cast<Cache*>(~static_cast<uintptr_t>(0));
+
+/**
+ * The cache of the calling thread: \c nullptr until its first use, then
+ * DESTROYED when the thread exits.  It is a plain pointer, still valid
+ * while the other thread-local objects are destroyed.
+ */
+thread_local Cache* t_cache = nullptr;
+
+/** Release the cache of a thread when it exits. */
+struct CacheGuard
+{
+    Cache* cache{nullptr}; //!< The cache of the thread
+
+    /** Return the cached blocks to the system, and retire the counters. */
+    ~CacheGuard()
+    {
+        if (cache == nullptr)
+        {
+            return;
+        }
+        PacketMemoryPool::Flush();
+        t_cache = DESTROYED;
+        Registry& registry = GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.caches.erase(std::find(registry.caches.begin(), registry.caches.end(), cache));
+        for (uint32_t i = 0; i <= UNPOOLED; ++i)
+        {
+            registry.retired[i].allocations += cache->counters[i].allocations;
+            registry.retired[i].hits += cache->counters[i].hits;
+            registry.retired[i].releases += cache->counters[i].releases;
+        }
+        delete cache;
+    }
+};
+
+/** The guard of the cache of the calling thread. */
+thread_local CacheGuard t_guard;
+
+/**
+ * Get the cache of the calling thread, creating it if needed.
+ * @returns The cache, or DESTROYED if the thread is exiting.
+ */
+inline Cache*
+GetCache()
+{
+    if (t_cache != nullptr)
+    {
+        return t_cache;
+    }
+    auto cache = new Cache;
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.caches.push_back(cache);
+    }
+    t_guard.cache = cache;
+    t_cache = cache;
+    return cache;
+}
+
+/**
+ * Get the size class of an allocation.
+ * @param [in] size The requested size, at most MAX_BLOCK_SIZE.
+ * @returns The size class.
+ */
+inline uint32_t
+GetSizeClass(std::size_t size)
+{
+    if (size <= PacketMemoryPool::MIN_BLOCK_SIZE)
+    {
+        return 0;
+    }
+    return std::bit_width((size - 1) / PacketMemoryPool::MIN_BLOCK_SIZE);
+}
+
+} // unnamed namespace
+
+void
+PacketMemoryPool::Enable(bool enable)
+{
+    NS_LOG_FUNCTION(enable);
+    m_enabled.store(enable, std::memory_order_relaxed);
+}
+
+std::size_t
+PacketMemoryPool::GetBlockSize(std::size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+    {
+        return size;
+    }
+    return MIN_BLOCK_SIZE << GetSizeClass(size);
+}
+
+void*
+PacketMemoryPool::Allocate(std::size_t size)
+{
+    Cache* cache = GetCache();
+    if (size > MAX_BLOCK_SIZE)
+    {
+        if (cache != DESTROYED)
+        {
+            Add(cache->counters[UNPOOLED].allocations, 1);
+        }
+        return ::operator new(size);
+    }
+    uint32_t sizeClass = GetSizeClass(size);
+    if (cache == DESTROYED)
+    {
+        return ::operator new(MIN_BLOCK_SIZE << sizeClass);
+    }
+    Counters& counters = cache->counters[sizeClass];
+    Add(counters.allocations, 1);
+    void* block = IsEnabled() ? cache->heads[sizeClass] : nullptr;
+    if (block != nullptr)
+    {
+        cache->heads[sizeClass] = *static_cast<void**>(block);
+        Add(counters.hits, 1);
+        Subtract(counters.cached, 1);
+        return block;
+    }
+    return ::operator new(MIN_BLOCK_SIZE << sizeClass);
+}
+
+void
+PacketMemoryPool::Deallocate(void* block, std::size_t size)
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+    Cache* cache = t_cache;
+    if (size > MAX_BLOCK_SIZE)
+    {
+        if (cache != nullptr && cache != DESTROYED)
+        {
+            Add(cache->counters[UNPOOLED].releases, 1);
+        }
+        ::operator delete(block);
+        return;
+    }
+    if (cache == nullptr)
+    {
+        cache = GetCache();
+    }
+    if (cache == DESTROYED)
+    {
+        ::operator delete(block);
+        return;
+    }
+    uint32_t sizeClass = GetSizeClass(size);
+    Counters& counters = cache->counters[sizeClass];
+    Add(counters.releases, 1);
+    if (IsEnabled() &&
+        counters.cached.load(std::memory_order_relaxed) <
+            MAX_CACHED_BYTES / (MIN_BLOCK_SIZE << sizeClass))
+    {
+        *static_cast<void**>(block) = cache->heads[sizeClass];
+        cache->heads[sizeClass] = block;
+        Add(counters.cached, 1);
+        return;
+    }
+    ::operator delete(block);
+}
+
+void
+PacketMemoryPool::Flush()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Cache* cache = t_cache;
+    if (cache == nullptr || cache == DESTROYED)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < SIZE_CLASSES; ++i)
+    {
+        while (cache->heads[i] != nullptr)
+        {
+            void* block = cache->heads[i];
+            cache->heads[i] = *static_cast<void**>(block);
+            ::operator delete(block);
+        }
+        cache->counters[i].cached.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::vector<PacketMemoryPool::Statistics>
+PacketMemoryPool::GetStatistics()
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    std::vector<Statistics> statistics(registry.retired, registry.retired + UNPOOLED + 1);
+    for (uint32_t i = 0; i <= UNPOOLED; ++i)
+    {
+        statistics[i].blockSize = i < UNPOOLED ? MIN_BLOCK_SIZE << i : 0;
+        for (const auto cache : registry.caches)
+        {
+            const Counters& counters = cache->counters[i];
+            statistics[i].allocations += counters.allocations.load(std::memory_order_relaxed);
+            statistics[i].hits += counters.hits.load(std::memory_order_relaxed);
+            statistics[i].releases += counters.releases.load(std::memory_order_relaxed);
+            statistics[i].cached += counters.cached.load(std::memory_order_relaxed);
+        }
+    }
+    return statistics;
+}
+
+void
+PacketMemoryPool::Print(std::ostream& os)
+{
+    Statistics total;
+    os << std::setw(10) << "Block" << std::setw(14) << "Allocations" << std::setw(14) << "Hits"
+       << std::setw(14) << "Releases" << std::setw(10) << "Cached" << std::endl;
+    for (const auto& statistics : GetStatistics())
+    {
+        if (statistics.allocations == 0 && statistics.releases == 0)
+        {
+            continue;
+        }
+        if (statistics.blockSize != 0)
+        {
+            os << std::setw(10) << statistics.blockSize;
+        }
+        else
+        {
+            os << std::setw(10) << "unpooled";
+        }
+        os << std::setw(14) << statistics.allocations << std::setw(14) << statistics.hits
+           << std::setw(14) << statistics.releases << std::setw(10) << statistics.cached
+           << std::endl;
+        total.allocations += statistics.allocations;
+        total.hits += statistics.hits;
+        total.releases += statistics.releases;
+        total.cached += statistics.cached;
+    }
+    os << std::setw(10) << "total" << std::setw(14) << total.allocations << std::setw(14)
+       << total.hits << std::setw(14) << total.releases << std::setw(10) << total.cached
+       << std::endl;
+}
+
+} // namespace ns3
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PACKET_MEMORY_POOL_H
+#define PACKET_MEMORY_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::PacketMemoryPool declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ * @brief size-classed, per-thread pool of the packet memory
+ *
+ * The Packet instances, and the variable-sized data of their Buffer,
+ * PacketMetadata, ByteTagList and PacketTagList, are allocated and
+ * released at a high rate, mostly with a few sizes.  This pool rounds
+ * each allocation up to a size class, a power of two from
+ * MIN_BLOCK_SIZE to MAX_BLOCK_SIZE bytes, and keeps the released
+ * blocks in a cache per class, to be reused by the next allocations of
+ * the class.  The larger allocations are not pooled.
+ *
+ * Each thread has its own caches, so that the threads of a parallel
+ * simulation allocate without locks.  A block released by another
+ * thread than the one which allocated it goes to the cache of the
+ * releasing thread.  Each cache keeps at most MAX_CACHED_BYTES, and
+ * returns the other blocks to the system.  The caches of a thread are
+ * returned to the system when the thread exits.
+ *
+ * The pool is enabled by default; when disabled, the allocations and
+ * releases bypass the caches and go directly to the system.  The sizes
+ * are still rounded up to their size class, so that the blocks allocated
+ * while the pool is disabled can be cached once it is enabled again.
+ * The statistics of the pool, per size class and for all the threads,
+ * are given by GetStatistics() and Print().
+ */
+class PacketMemoryPool
+{
+  public:
+    /** The size of the smallest size class. */
+    static constexpr std::size_t MIN_BLOCK_SIZE = 32;
+    /** The number of size classes. */
+    static constexpr uint32_t SIZE_CLASSES = 12;
+    /** The size of the largest size class. */
+    static constexpr std::size_t MAX_BLOCK_SIZE = MIN_BLOCK_SIZE << (SIZE_CLASSES - 1);
+    /** The maximum number of bytes in the cache of a size class of a thread. */
+    static constexpr std::size_t MAX_CACHED_BYTES = 1 << 20;
+
+    /** The statistics of a size class. */
+    struct Statistics
+    {
+        std::size_t blockSize{0}; //!< Size of the blocks, or 0 for the unpooled allocations
+        uint64_t allocations{0};  //!< Allocations
+        uint64_t hits{0};         //!< Allocations served by a cache
+        uint64_t releases{0};     //!< Releases
+        uint64_t cached{0};       //!< Blocks in the caches
+    };
+
+    /**
+     * Start or stop pooling the allocations and the releases.
+     *
+     * The blocks already cached stay in the caches, unused, until Flush()
+     * or the end of their thread.
+     *
+     * @param [in] enable Whether to pool the allocations and the releases.
+     */
+    static void Enable(bool enable = true);
+
+    /**
+     * Check if the allocations and the releases are pooled.
+     * @returns \c true if the pool is enabled.
+     */
+    static bool IsEnabled()
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the usable size of an allocation.
+     *
+     * @param [in] size The requested size.
+     * @returns The size of the block allocated for \pname{size} bytes,
+     *          at least \pname{size}.
+     */
+    static std::size_t GetBlockSize(std::size_t size);
+
+    /**
+     * Allocate a block.
+     *
+     * @param [in] size The requested size.
+     * @returns A block of GetBlockSize() bytes, aligned like the
+     *          blocks of operator new.
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * Release a block.
+     *
+     * @param [in] block The block.
+     * @param [in] size The size requested to allocate the block, or its
+     *             block size.
+     */
+    static void Deallocate(void* block, std::size_t size);
+
+    /** Return the blocks cached by the calling thread to the system. */
+    static void Flush();
+
+    /**
+     * Get the statistics of the pool, for all the threads.
+     * @returns The statistics of each size class, then of the unpooled
+     *          allocations.
+     */
+    static std::vector<Statistics> GetStatistics();
+
+    /**
+     * Print the statistics of the pool, for all the threads.
+     * @param [in,out] os The output stream.
+     */
+    static void Print(std::ostream& os);
+
+  private:
+    static std::atomic<bool> m_enabled; //!< Whether the pool is enabled
+};
+
+} // namespace ns3
+
+#endif /* PACKET_MEMORY_POOL_H */
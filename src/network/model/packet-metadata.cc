@@ -9,11 +9,13 @@
 
 #include "buffer.h"
 #include "header.h"
+#include "packet-memory-pool.h"
 #include "trailer.h"
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/memory-accounting.h"
 
 #include <list>
 #include <utility>
@@ -26,19 +28,14 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
+#ifdef NS3_MTP
+std::atomic<uint32_t> PacketMetadata::m_maxSize = 0;
+/// The chunk uid counter of the calling thread, if not the global one.
+static thread_local uint16_t* g_threadChunkUid = nullptr;
+#else
 uint32_t PacketMetadata::m_maxSize = 0;
+#endif
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        PacketMetadata::Deallocate(*i);
-    }
-    PacketMetadata::m_enable = false;
-}
 
 void
 PacketMetadata::Enable()
@@ -62,6 +59,26 @@ PacketMetadata::EnableChecking()
     m_enableChecking = true;
 }
 
+#ifdef NS3_MTP
+void
+PacketMetadata::SetThreadChunkUidCounter(uint16_t* counter)
+{
+    g_threadChunkUid = counter;
+}
+#endif
+
+uint16_t
+PacketMetadata::AllocateChunkUid()
+{
+#ifdef NS3_MTP
+    if (g_threadChunkUid != nullptr)
+    {
+        return (*g_threadChunkUid)++;
+    }
+#endif
+    return m_chunkUid++;
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -69,8 +86,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -93,8 +109,15 @@ PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
-    if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+#ifdef NS3_MTP
+    // the other owners of shared data may live in a concurrently running
+    // partition, so the area after the dirty end cannot be claimed safely,
+    // even by an empty list.
+    bool isDirty = m_data->m_count != 1;
+#else
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1 && m_data->m_dirtyEnd != m_used;
+#endif
+    if (m_data->m_size >= m_used + size && !isDirty)
     {
         /* enough room, not dirty. */
     }
@@ -245,6 +268,14 @@ PacketMetadata::Append32(uint32_t value, uint8_t* buffer)
     buffer[3] = (value >> 24) & 0xff;
 }
 
+void
+PacketMetadata::Append64(uint64_t value, uint8_t* buffer)
+{
+    NS_LOG_FUNCTION(this << value << &buffer);
+    Append32(value & 0xffffffff, buffer);
+    Append32(value >> 32, buffer + 4);
+}
+
 void
 PacketMetadata::AppendValueExtra(uint32_t value, uint8_t* buffer)
 {
@@ -373,8 +404,13 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+#ifdef NS3_MTP
+    // see PacketMetadata::Reserve
+    bool isDirty = m_data->m_count != 1;
+#else
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd;
+#endif
+    if (m_used + n > m_data->m_size || isDirty)
     {
         ReserveCopy(n);
     }
@@ -408,10 +444,15 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t fragStartSize = GetUleb128Size(extraItem->fragmentStart);
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
-    uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
+    uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 8;
 
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+#ifdef NS3_MTP
+    // see PacketMetadata::Reserve
+    bool isDirty = m_data->m_count != 1;
+#else
+    bool isDirty = m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd;
+#endif
+    if (m_used + n > m_data->m_size || isDirty)
     {
         ReserveCopy(n);
     }
@@ -432,7 +473,7 @@ PacketMetadata::AddBig(uint32_t next,
     buffer += fragStartSize;
     AppendValue(extraItem->fragmentEnd, buffer);
     buffer += fragEndSize;
-    Append32(extraItem->packetUid, buffer);
+    Append64(extraItem->packetUid, buffer);
 
     return n;
 }
@@ -462,7 +503,7 @@ PacketMetadata::ReplaceTail(PacketMetadata::SmallItem* item,
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t fragStartSize = GetUleb128Size(extraItem->fragmentStart);
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
-    uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
+    uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 8;
 
     if (available >= n && m_data->m_count == 1)
     {
@@ -481,7 +522,7 @@ PacketMetadata::ReplaceTail(PacketMetadata::SmallItem* item,
         buffer += fragStartSize;
         AppendValue(extraItem->fragmentEnd, buffer);
         buffer += fragEndSize;
-        Append32(extraItem->packetUid, buffer);
+        Append64(extraItem->packetUid, buffer);
         m_used = std::max(m_used, static_cast<uint32_t>(buffer - &m_data->m_data[0]));
         m_data->m_dirtyEnd = m_used;
         return;
@@ -536,11 +577,12 @@ PacketMetadata::ReadItems(uint16_t current,
     {
         extraItem->fragmentStart = ReadUleb128(&buffer);
         extraItem->fragmentEnd = ReadUleb128(&buffer);
-        extraItem->packetUid = buffer[0];
-        extraItem->packetUid |= buffer[1] << 8;
-        extraItem->packetUid |= buffer[2] << 16;
-        extraItem->packetUid |= buffer[3] << 24;
-        buffer += 4;
+        extraItem->packetUid = 0;
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            extraItem->packetUid |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+        }
+        buffer += 8;
     }
     else
     {
@@ -556,47 +598,42 @@ PacketMetadata::Data*
 PacketMetadata::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
-    NS_LOG_LOGIC("create size=" << size << ", max=" << m_maxSize);
-    if (size > m_maxSize)
+    uint32_t maxSize = m_maxSize;
+    NS_LOG_LOGIC("create size=" << size << ", max=" << maxSize);
+#ifdef NS3_MTP
+    // the other partitions may raise the maximum concurrently
+    while (size > maxSize && !m_maxSize.compare_exchange_weak(maxSize, size))
     {
-        m_maxSize = size;
     }
-    while (!m_freeList.empty())
+#else
+    if (size > maxSize)
     {
-        PacketMetadata::Data* data = m_freeList.back();
-        m_freeList.pop_back();
-        if (data->m_size >= size)
-        {
-            NS_LOG_LOGIC("create found size=" << data->m_size);
-            data->m_count = 1;
-            return data;
-        }
-        NS_LOG_LOGIC("create dealloc size=" << data->m_size);
-        PacketMetadata::Deallocate(data);
+        m_maxSize = size;
     }
-    NS_LOG_LOGIC("create alloc size=" << m_maxSize);
-    return PacketMetadata::Allocate(m_maxSize);
+#endif
+    maxSize = std::max(maxSize, size);
+    NS_LOG_LOGIC("create alloc size=" << maxSize);
+    return PacketMetadata::Allocate(maxSize);
 }
 
 void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
-    {
-        PacketMetadata::Deallocate(data);
-        return;
-    }
-    NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
+    NS_LOG_LOGIC("recycle size=" << data->m_size);
     NS_ASSERT(data->m_count == 0);
-    if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
-    {
-        PacketMetadata::Deallocate(data);
-    }
-    else
-    {
-        m_freeList.push_back(data);
-    }
+    PacketMetadata::Deallocate(data);
+}
+
+/**
+ * Get the memory account of the packet metadata.
+ * @returns The account.
+ */
+static MemoryAccounting::Account*
+GetMetadataAccount()
+{
+    static auto account = MemoryAccounting::GetAccount("ns3::PacketMetadata");
+    return account;
 }
 
 PacketMetadata::Data*
@@ -609,11 +646,15 @@ PacketMetadata::Allocate(uint32_t n)
         n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
     size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
+    auto data = static_cast<PacketMetadata::Data*>(PacketMemoryPool::Allocate(size));
     data->m_size = n;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
+    data->m_accounted = MemoryAccounting::IsEnabled();
+    if (data->m_accounted)
+    {
+        MemoryAccounting::Allocate(GetMetadataAccount(), size);
+    }
     return data;
 }
 
@@ -621,8 +662,12 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    uint32_t size = sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE;
+    if (data->m_accounted)
+    {
+        MemoryAccounting::Release(GetMetadataAccount(), size);
+    }
+    PacketMemoryPool::Deallocate(data, size);
 }
 
 PacketMetadata
@@ -659,8 +704,7 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     item.prev = 0xffff;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = AllocateChunkUid();
     uint16_t written = AddSmall(&item);
     UpdateHead(written);
 }
@@ -725,8 +769,7 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     item.prev = m_tail;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = AllocateChunkUid();
     uint16_t written = AddSmall(&item);
     UpdateTail(written);
     NS_ASSERT(IsStateOk());
@@ -18,6 +18,10 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -159,6 +163,20 @@ class PacketMetadata
      */
     static void EnableChecking();
 
+#ifdef NS3_MTP
+    /**
+     * @brief Set the chunk uid counter of the calling thread.
+     *
+     * The MultithreadedSimulatorImpl gives each partition its own chunk
+     * uid counter, like its packet uid counter (see
+     * Packet::SetThreadUidCounter).
+     *
+     * @param [in] counter The next chunk uid of the calling thread, or
+     *             nullptr to use the global counter.
+     */
+    static void SetThreadChunkUidCounter(uint16_t* counter);
+#endif
+
     /**
      * @brief Constructor
      * @param uid packet uid
@@ -415,11 +433,17 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /** size (in bytes) of m_data buffer below */
         uint32_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
         uint16_t m_dirtyEnd;
+        /** whether this instance is counted by the MemoryAccounting */
+        bool m_accounted;
         /** variable-sized buffer of bytes */
         uint8_t m_data[PACKET_METADATA_DATA_M_DATA_SIZE];
     };
@@ -498,16 +522,6 @@ class PacketMetadata
         uint64_t packetUid;
     };
 
-    /**
-     * @brief Class to hold all the metadata
-     */
-    class DataFreeList : public std::vector<Data*>
-    {
-      public:
-        ~DataFreeList();
-    };
-
-    friend DataFreeList::~DataFreeList();
     /// Friend class
     friend class ItemIterator;
 
@@ -574,6 +588,12 @@ class PacketMetadata
      * @param buffer the buffer to write to
      */
     inline void Append32(uint32_t value, uint8_t* buffer);
+    /**
+     * @brief Append a 64-bit value to the buffer
+     * @param value the value to add
+     * @param buffer the buffer to write to
+     */
+    inline void Append64(uint64_t value, uint8_t* buffer);
     /**
      * @brief Append a value to the buffer
      * @param value the value to add
@@ -664,9 +684,8 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
 
     /**
      * Set to true when adding metadata to a packet is skipped because
@@ -675,7 +694,17 @@ class PacketMetadata
      */
     static bool m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
+    /**
+     * @brief Allocate the uid of a new header or trailer.
+     * @returns the uid.
+     */
+    static uint16_t AllocateChunkUid();
+
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_maxSize; //!< maximum metadata size
+#else
+    static uint32_t m_maxSize; //!< maximum metadata size
+#endif
     static uint16_t m_chunkUid; //!< Chunk Uid
 
     Data* m_data; //!< Metadata storage
@@ -728,8 +757,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
@@ -747,8 +775,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -33,8 +33,8 @@ PacketTagList::CreateTagData(size_t dataSize)
                   "Requested TagData size " << dataSize << " exceeds maximum "
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    void* p = PacketMemoryPool::Allocate(sizeof(TagData) + dataSize - 1);
+    // The matching releases are in DeleteTagData
 
     auto tag = new (p) TagData;
     tag->size = dataSize;
@@ -184,8 +184,7 @@ PacketTagList::RemoveWriter(Tag& tag,
     if (preMerge)
     {
         // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        DeleteTagData(cur);
     }
     else
     {
@@ -13,11 +13,17 @@
 \brief  Defines a linked list of Packet tags, including copy-on-write semantics.
 */
 
+#include "packet-memory-pool.h"
+
 #include "ns3/type-id.h"
 
 #include <ostream>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -131,7 +137,11 @@ class PacketTagList
     struct TagData
     {
         TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
+#ifdef NS3_MTP
+        std::atomic<uint32_t> count; //!< Number of incoming links
+#else
+        uint32_t count; //!< Number of incoming links
+#endif
         TypeId tid;      //!< Type of the tag serialized into #data
         uint32_t size;   //!< Size of the \c data buffer
         uint8_t data[1]; //!< Serialization buffer
@@ -242,6 +252,13 @@ class PacketTagList
      */
     static TagData* CreateTagData(size_t dataSize);
 
+    /**
+     * Destroy and release a TagData struct created by CreateTagData().
+     *
+     * @param [in] tag The TagData object.
+     */
+    static inline void DeleteTagData(TagData* tag);
+
     /**
      * Typedef of method function pointer for copy-on-write operations
      *
@@ -341,28 +358,33 @@ PacketTagList::~PacketTagList()
     RemoveAll();
 }
 
+void
+PacketTagList::DeleteTagData(TagData* tag)
+{
+    std::size_t size = sizeof(TagData) + tag->size - 1;
+    tag->~TagData();
+    PacketMemoryPool::Deallocate(tag, size);
+}
+
 void
 PacketTagList::RemoveAll()
 {
     TagData* prev = nullptr;
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
-        cur->count--;
-        if (cur->count > 0)
+        if (--cur->count > 0)
         {
             break;
         }
         if (prev != nullptr)
         {
-            prev->~TagData();
-            std::free(prev);
+            DeleteTagData(prev);
         }
         prev = cur;
     }
     if (prev != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        DeleteTagData(prev);
     }
     m_next = nullptr;
 }
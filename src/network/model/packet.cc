@@ -19,7 +19,13 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+/// The packet uid counter of the calling thread, if not the global one.
+static thread_local uint64_t* g_threadUid = nullptr;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -129,16 +135,9 @@ Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(AllocateUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -169,16 +168,9 @@ Packet::Packet(uint32_t size)
     : m_buffer(size),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -196,16 +188,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -595,6 +580,32 @@ Packet::EnableChecking()
     PacketMetadata::EnableChecking();
 }
 
+#ifdef NS3_MTP
+void
+Packet::SetThreadUidCounter(uint64_t* counter)
+{
+    g_threadUid = counter;
+}
+#endif
+
+uint64_t
+Packet::AllocateUid()
+{
+#ifdef NS3_MTP
+    if (g_threadUid != nullptr)
+    {
+        return (*g_threadUid)++;
+    }
+#endif
+    /* The upper 32 bits of the packet id in
+     * metadata is for the system id. For non-
+     * distributed simulations, this is simply
+     * zero.  The lower 32 bits are for the
+     * global UID
+     */
+    return static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++;
+}
+
 uint32_t
 Packet::GetSerializedSize() const
 {
@@ -12,6 +12,7 @@
 #include "byte-tag-list.h"
 #include "header.h"
 #include "nix-vector.h"
+#include "packet-memory-pool.h"
 #include "packet-metadata.h"
 #include "packet-tag-list.h"
 #include "tag.h"
@@ -20,10 +21,15 @@
 #include "ns3/assert.h"
 #include "ns3/callback.h"
 #include "ns3/mac48-address.h"
+#include "ns3/memory-accounting.h"
 #include "ns3/ptr.h"
 
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -279,6 +285,26 @@ class Packet : public SimpleRefCount<Packet>
      * @param size the size of the input buffer.
      */
     Packet(const uint8_t* buffer, uint32_t size);
+    /**
+     * @brief Allocate a packet from the PacketMemoryPool.
+     * @param size the size of the packet
+     * @returns the memory of the packet
+     */
+    static void* operator new(std::size_t size)
+    {
+        return PacketMemoryPool::Allocate(size);
+    }
+
+    /**
+     * @brief Release a packet to the PacketMemoryPool.
+     * @param p the memory of the packet
+     * @param size the size of the packet
+     */
+    static void operator delete(void* p, std::size_t size)
+    {
+        PacketMemoryPool::Deallocate(p, size);
+    }
+
     /**
      * @brief Create a new packet which contains a fragment of the original
      * packet.
@@ -526,6 +552,21 @@ class Packet : public SimpleRefCount<Packet>
      */
     static void EnableChecking();
 
+#ifdef NS3_MTP
+    /**
+     * @brief Set the uid counter of the packets created by the calling thread.
+     *
+     * The MultithreadedSimulatorImpl gives each partition its own range
+     * of packet uids, so that the uids of the packets created during the
+     * simulation do not depend on the order in which the threads execute
+     * the partitions.
+     *
+     * @param [in] counter The next packet uid of the calling thread, or
+     *             nullptr to use the global counter.
+     */
+    static void SetThreadUidCounter(uint64_t* counter);
+#endif
+
     /**
      * @brief Returns number of bytes required for packet
      * serialization.
@@ -776,6 +817,12 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * @brief Allocate the uid of a new packet.
+     * @returns the uid.
+     */
+    static uint64_t AllocateUid();
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -784,7 +831,14 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+    /** Accounts for the packet in the MemoryAccounting */
+    MemoryAccounted<Packet> m_accounted{"ns3::Packet"};
+
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
 };
 
 /**
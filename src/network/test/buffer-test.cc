@@ -8,9 +8,13 @@
 
 #include "ns3/buffer.h"
 #include "ns3/double.h"
+#include "ns3/memory-accounting.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -384,6 +388,296 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Buffer payload fragments unit tests: random operations on buffers,
+ * compared with the same operations on byte vectors.
+ */
+class BufferFragmentsTest : public TestCase
+{
+  public:
+    BufferFragmentsTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Checks the buffer content, through all the read methods.
+     * @param b The buffer to check
+     * @param expected The bytes that should be in the buffer
+     * @param step The step of the random operations
+     */
+    void Check(const Buffer& b, const std::vector<uint8_t>& expected, uint32_t step);
+
+    /**
+     * Create a buffer with random bytes.
+     * @param size The size of the buffer
+     * @param [out] bytes The bytes of the buffer
+     * @returns The buffer
+     */
+    Buffer CreateRealBuffer(uint32_t size, std::vector<uint8_t>& bytes);
+
+    Ptr<UniformRandomVariable> m_rng; //!< Random variable
+};
+
+BufferFragmentsTest::BufferFragmentsTest()
+    : TestCase("Buffer payload fragments")
+{
+}
+
+Buffer
+BufferFragmentsTest::CreateRealBuffer(uint32_t size, std::vector<uint8_t>& bytes)
+{
+    bytes.resize(size);
+    for (auto& byte : bytes)
+    {
+        byte = m_rng->GetInteger(0, 255);
+    }
+    Buffer b;
+    b.AddAtStart(size);
+    b.Begin().Write(bytes.data(), size);
+    return b;
+}
+
+void
+BufferFragmentsTest::Check(const Buffer& b, const std::vector<uint8_t>& expected, uint32_t step)
+{
+    NS_TEST_ASSERT_MSG_EQ(b.GetSize(), expected.size(), "Wrong size at step " << step);
+
+    std::vector<uint8_t> bytes(b.GetSize());
+    b.Begin().Read(bytes.data(), bytes.size());
+    NS_TEST_ASSERT_MSG_EQ((bytes == expected), true, "Wrong bytes read at step " << step);
+
+    std::vector<uint8_t> copied(b.GetSize());
+    NS_TEST_ASSERT_MSG_EQ(b.CopyData(copied.data(), copied.size()),
+                          copied.size(),
+                          "Wrong copy size at step " << step);
+    NS_TEST_ASSERT_MSG_EQ((copied == expected), true, "Wrong bytes copied at step " << step);
+
+    std::ostringstream os;
+    b.CopyData(&os, b.GetSize());
+    NS_TEST_ASSERT_MSG_EQ((os.str() == std::string(expected.begin(), expected.end())),
+                          true,
+                          "Wrong bytes written at step " << step);
+
+    Buffer::Iterator i = b.Begin();
+    for (uint32_t j = 0; j < b.GetSize(); j++)
+    {
+        if (i.ReadU8() != expected[j])
+        {
+            NS_TEST_ASSERT_MSG_EQ(j, b.GetSize(), "Wrong byte at step " << step);
+        }
+    }
+
+    // The multi-byte reads, across the fragment boundaries
+    i = b.Begin();
+    i.Next(expected.size() % 3);
+    while (i.GetRemainingSize() >= 14)
+    {
+        uint32_t j = expected.size() - i.GetRemainingSize();
+        uint16_t u16 = expected[j] | (expected[j + 1] << 8);
+        uint32_t u32 = 0;
+        uint64_t u64 = 0;
+        for (uint32_t k = 0; k < 4; k++)
+        {
+            u32 = (u32 << 8) | expected[j + 2 + k];
+        }
+        for (uint32_t k = 8; k > 0; k--)
+        {
+            u64 = (u64 << 8) | expected[j + 5 + k];
+        }
+        NS_TEST_ASSERT_MSG_EQ(i.ReadU16(), u16, "Wrong U16 read at step " << step);
+        NS_TEST_ASSERT_MSG_EQ(i.ReadNtohU32(), u32, "Wrong U32 read at step " << step);
+        NS_TEST_ASSERT_MSG_EQ(i.ReadLsbtohU64(), u64, "Wrong U64 read at step " << step);
+    }
+
+    // The checksum of a real copy of the buffer
+    auto size = static_cast<uint16_t>(std::min<std::size_t>(expected.size(), 65535));
+    Buffer real;
+    real.AddAtStart(expected.size());
+    real.Begin().Write(expected.data(), expected.size());
+    NS_TEST_ASSERT_MSG_EQ(b.Begin().CalculateIpChecksum(size),
+                          real.Begin().CalculateIpChecksum(size),
+                          "Wrong checksum at step " << step);
+    if (size > 2)
+    {
+        // A checksum from an odd offset, over an odd size
+        Buffer::Iterator j = b.Begin();
+        Buffer::Iterator k = real.Begin();
+        j.Next(1);
+        k.Next(1);
+        uint16_t oddSize = (size - 2) | 1;
+        NS_TEST_ASSERT_MSG_EQ(j.CalculateIpChecksum(oddSize),
+                              k.CalculateIpChecksum(oddSize),
+                              "Wrong odd checksum at step " << step);
+    }
+
+    std::vector<uint8_t> serialized(b.GetSerializedSize());
+    NS_TEST_ASSERT_MSG_EQ(b.Serialize(serialized.data(), serialized.size()),
+                          1,
+                          "Serialization failed at step " << step);
+    // The size given to Deserialize includes 4 bytes for the size, as in Packet
+    Buffer deserialized(0, false);
+    deserialized.Deserialize(serialized.data(), serialized.size() + 4);
+    std::vector<uint8_t> deserializedBytes(deserialized.GetSize());
+    deserialized.CopyData(deserializedBytes.data(), deserializedBytes.size());
+    NS_TEST_ASSERT_MSG_EQ((deserializedBytes == expected),
+                          true,
+                          "Wrong bytes deserialized at step " << step);
+}
+
+void
+BufferFragmentsTest::DoRun()
+{
+    m_rng = CreateObject<UniformRandomVariable>();
+
+    // The bytes of concatenated buffers are shared, not copied
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> otherBytes;
+    Buffer a = CreateRealBuffer(20000, bytes);
+    Buffer b = CreateRealBuffer(30000, otherBytes);
+    MemoryAccounting::Account* account = MemoryAccounting::GetAccount("ns3::Buffer");
+    int64_t liveBytes = account->bytes.load();
+    MemoryAccounting::Enable();
+    a.AddAtEnd(b);
+    a.AddAtEnd(Buffer(40000));
+    MemoryAccounting::Enable(false);
+    // Only the fragments and the data of the dataless buffer are allocated
+    NS_TEST_EXPECT_MSG_GT(account->bytes.load(), liveBytes, "Fragments not accounted");
+    NS_TEST_EXPECT_MSG_LT(account->bytes.load() - liveBytes, 1000, "Payload copied");
+    bytes.insert(bytes.end(), otherBytes.begin(), otherBytes.end());
+    bytes.resize(bytes.size() + 40000, 0);
+    Check(a, bytes, 0);
+
+    // Headers and trailers are added around the fragments
+    a.AddAtStart(4);
+    a.Begin().WriteHtonU32(0x01020304);
+    a.AddAtEnd(2);
+    Buffer::Iterator i = a.End();
+    i.Prev(2);
+    i.WriteU16(0x0605);
+    bytes.insert(bytes.begin(), {1, 2, 3, 4});
+    bytes.insert(bytes.end(), {5, 6});
+    Check(a, bytes, 0);
+
+    // The fragments are released with the last buffer which references them
+    Buffer copy = a;
+    a = Buffer();
+    NS_TEST_EXPECT_MSG_GT(account->bytes.load(), liveBytes, "Fragments released too early");
+    copy = Buffer();
+    b = Buffer();
+    NS_TEST_EXPECT_MSG_EQ(account->bytes.load(), liveBytes, "Fragments not released");
+
+    // The first write into the fragments copies them, and leaves the
+    // buffers which share them unchanged
+    std::vector<uint8_t> first;
+    std::vector<uint8_t> second;
+    Buffer c = CreateRealBuffer(1000, first);
+    c.AddAtEnd(CreateRealBuffer(1000, second));
+    c.AddAtEnd(Buffer(1000));
+    Buffer shared = c;
+    std::vector<uint8_t> sharedBytes = first;
+    sharedBytes.insert(sharedBytes.end(), second.begin(), second.end());
+    sharedBytes.resize(sharedBytes.size() + 1000, 0);
+    std::vector<uint8_t> written = sharedBytes;
+    Buffer::Iterator j = c.Begin();
+    j.Next(998);
+    j.WriteHtonU32(0x0a0b0c0d);
+    j.Next(996);
+    j.WriteU8(0xff, 4);
+    const uint8_t word[] = {0x0a, 0x0b, 0x0c, 0x0d};
+    std::copy_n(word, 4, written.begin() + 998);
+    std::fill_n(written.begin() + 1998, 4, 0xff);
+    Check(c, written, 0);
+    Check(shared, sharedBytes, 0);
+    Buffer::Iterator k = shared.End();
+    k.Prev(1500);
+    k.Write(first.data(), 1000);
+    std::copy_n(first.begin(), 1000, sharedBytes.begin() + 1500);
+    Check(shared, sharedBytes, 0);
+    Check(c, written, 0);
+
+    // Random operations on a few buffers
+    std::vector<Buffer> buffers(4);
+    std::vector<std::vector<uint8_t>> expected(4);
+    for (uint32_t step = 1; step <= 2000; step++)
+    {
+        uint32_t k = m_rng->GetInteger(0, buffers.size() - 1);
+        Buffer& buffer = buffers[k];
+        std::vector<uint8_t>& content = expected[k];
+        uint32_t size = m_rng->GetInteger(0, 300);
+        switch (m_rng->GetInteger(0, 9))
+        {
+        case 0:
+            buffer = CreateRealBuffer(size, content);
+            break;
+        case 1:
+            buffer = Buffer(size);
+            content.assign(size, 0);
+            break;
+        case 2: {
+            std::vector<uint8_t> header;
+            CreateRealBuffer(size % 40, header);
+            buffer.AddAtStart(header.size());
+            buffer.Begin().Write(header.data(), header.size());
+            content.insert(content.begin(), header.begin(), header.end());
+            break;
+        }
+        case 3: {
+            std::vector<uint8_t> trailer;
+            CreateRealBuffer(size % 40, trailer);
+            buffer.AddAtEnd(trailer.size());
+            Buffer::Iterator end = buffer.End();
+            end.Prev(trailer.size());
+            end.Write(trailer.data(), trailer.size());
+            content.insert(content.end(), trailer.begin(), trailer.end());
+            break;
+        }
+        case 4:
+            size = std::min<uint32_t>(size, content.size());
+            buffer.RemoveAtStart(size);
+            content.erase(content.begin(), content.begin() + size);
+            break;
+        case 5:
+            size = std::min<uint32_t>(size, content.size());
+            buffer.RemoveAtEnd(size);
+            content.resize(content.size() - size);
+            break;
+        case 6: {
+            uint32_t start = m_rng->GetInteger(0, content.size());
+            uint32_t length = m_rng->GetInteger(0, content.size() - start);
+            buffer = buffer.CreateFragment(start, length);
+            content = std::vector<uint8_t>(content.begin() + start,
+                                           content.begin() + start + length);
+            break;
+        }
+        case 7:
+        case 8: {
+            uint32_t other = m_rng->GetInteger(0, buffers.size() - 1);
+            std::vector<uint8_t> otherContent = expected[other];
+            buffer.AddAtEnd(buffers[other]);
+            content.insert(content.end(), otherContent.begin(), otherContent.end());
+            break;
+        }
+        default:
+            if (step % 10 == 0)
+            {
+                // Make the buffer real
+                buffer.PeekData();
+            }
+            break;
+        }
+        if (content.size() > 20000)
+        {
+            buffer.RemoveAtStart(content.size() - 20000);
+            content.erase(content.begin(), content.end() - 20000);
+        }
+        Check(buffer, content, step);
+    }
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -400,6 +694,7 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferFragmentsTest, TestCase::Duration::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -13,6 +13,7 @@
 
 #include <cstdarg>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 using namespace ns3;
@@ -868,6 +869,38 @@ PacketMetadataTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(msg,
                           std::string("hello world"),
                           "Could not find original data in received packet");
+
+    // The packet uids of distributed and multithreaded simulations do not
+    // fit in 32 bits: the fragments of two packets whose uids only differ
+    // in the upper bits must not be merged, even when their headers got
+    // the same chunk uid.
+    HistoryHeader<5> header;
+    PacketMetadata first(static_cast<uint64_t>(1) << 32 | 7, 0);
+    first.AddHeader(header, 5);
+    PacketMetadata second(static_cast<uint64_t>(2) << 32 | 7, 0);
+    for (uint32_t i = 0; i < std::numeric_limits<uint16_t>::max(); i++)
+    {
+        second.AddHeader(header, 5);
+        second.RemoveHeader(header, 5);
+    }
+    second.AddHeader(header, 5);
+    PacketMetadata merged = first.CreateFragment(0, 3);
+    merged.AddAtEnd(second.CreateFragment(2, 0));
+    uint32_t nItems = 0;
+    PacketMetadata::ItemIterator k = merged.BeginItem(Buffer(5));
+    while (k.HasNext())
+    {
+        NS_TEST_EXPECT_MSG_EQ(k.Next().isFragment, true, "Fragments of two packets were merged");
+        nItems++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(nItems, 2, "Fragments of two packets were merged");
+
+    merged = first.CreateFragment(0, 3);
+    merged.AddAtEnd(first.CreateFragment(2, 0));
+    k = merged.BeginItem(Buffer(5));
+    NS_TEST_ASSERT_MSG_EQ(k.HasNext(), true, "Missing header");
+    NS_TEST_EXPECT_MSG_EQ(k.Next().isFragment, false, "Fragments of a packet were not merged");
+    NS_TEST_EXPECT_MSG_EQ(k.HasNext(), false, "Fragments of a packet were not merged");
 }
 
 /**
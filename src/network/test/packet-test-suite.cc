@@ -5,6 +5,8 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/memory-accounting.h"
+#include "ns3/packet-memory-pool.h"
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
 #include "ns3/test.h"
@@ -15,6 +17,7 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -1257,6 +1260,175 @@ PacketTagListTest::DoRun()
     } // Timing
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Packet memory accounting Test
+ */
+class PacketMemoryAccountingTest : public TestCase
+{
+  public:
+    PacketMemoryAccountingTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get the live instances and bytes of an account.
+     * @param [in] name The name of the account.
+     * @returns The live instances and bytes.
+     */
+    std::pair<int64_t, int64_t> Live(const std::string& name);
+};
+
+PacketMemoryAccountingTest::PacketMemoryAccountingTest()
+    : TestCase("Packet memory accounting")
+{
+}
+
+std::pair<int64_t, int64_t>
+PacketMemoryAccountingTest::Live(const std::string& name)
+{
+    MemoryAccounting::Account* account = MemoryAccounting::GetAccount(name);
+    return {account->instances.load(), account->bytes.load()};
+}
+
+void
+PacketMemoryAccountingTest::DoRun()
+{
+    auto packets = Live("ns3::Packet");
+    auto buffers = Live("ns3::Buffer");
+
+    MemoryAccounting::Enable();
+    // Real data, so that the buffer is allocated
+    std::vector<uint8_t> data(100000, 0x5a);
+    Ptr<Packet> packet = Create<Packet>(data.data(), data.size());
+    Ptr<Packet> copy = packet->Copy();
+    ATestHeader<10> header;
+    copy->AddHeader(header);
+    MemoryAccounting::Enable(false);
+
+    NS_TEST_EXPECT_MSG_EQ(Live("ns3::Packet").first, packets.first + 2, "Packets not counted");
+    NS_TEST_EXPECT_MSG_EQ(Live("ns3::Packet").second,
+                          packets.second + 2 * static_cast<int64_t>(sizeof(Packet)),
+                          "Wrong packet bytes");
+    NS_TEST_EXPECT_MSG_GT(Live("ns3::Buffer").second,
+                          buffers.second + 100000,
+                          "Buffer data not counted");
+
+    packet = nullptr;
+    copy = nullptr;
+    NS_TEST_EXPECT_MSG_EQ((Live("ns3::Packet") == packets), true, "Packets not released");
+    // The released buffers are not counted, even if their memory is pooled
+    NS_TEST_EXPECT_MSG_EQ((Live("ns3::Buffer").first <= buffers.first + 2),
+                          true,
+                          "Buffer data not released");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Packet memory pool Test
+ */
+class PacketMemoryPoolTest : public TestCase
+{
+  public:
+    PacketMemoryPoolTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get the statistics of the size class of a block.
+     * @param [in] size The requested size of the block.
+     * @returns The statistics of the size class.
+     */
+    PacketMemoryPool::Statistics Get(std::size_t size);
+};
+
+PacketMemoryPoolTest::PacketMemoryPoolTest()
+    : TestCase("Packet memory pool")
+{
+}
+
+PacketMemoryPool::Statistics
+PacketMemoryPoolTest::Get(std::size_t size)
+{
+    for (const auto& statistics : PacketMemoryPool::GetStatistics())
+    {
+        if (statistics.blockSize == PacketMemoryPool::GetBlockSize(size))
+        {
+            return statistics;
+        }
+    }
+    return PacketMemoryPool::GetStatistics().back();
+}
+
+void
+PacketMemoryPoolTest::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(1), 32U, "Wrong smallest block");
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(32), 32U, "Wrong block");
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(33), 64U, "Wrong block");
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(1500), 2048U, "Wrong block");
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(PacketMemoryPool::MAX_BLOCK_SIZE),
+                          PacketMemoryPool::MAX_BLOCK_SIZE,
+                          "Wrong largest block");
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(100000), 100000U, "Large block pooled");
+
+    bool enabled = PacketMemoryPool::IsEnabled();
+    PacketMemoryPool::Enable();
+
+    // A released block is reused by the next allocation of its size class
+    void* block = PacketMemoryPool::Allocate(1000);
+    PacketMemoryPool::Deallocate(block, 1000);
+    auto before = Get(1000);
+    NS_TEST_EXPECT_MSG_GT(before.cached, 0U, "Block not cached");
+    void* reused = PacketMemoryPool::Allocate(900);
+    NS_TEST_EXPECT_MSG_EQ(reused, block, "Block not reused");
+    NS_TEST_EXPECT_MSG_EQ(Get(1000).hits, before.hits + 1, "Hit not counted");
+    NS_TEST_EXPECT_MSG_EQ(Get(1000).allocations, before.allocations + 1, "Allocation not counted");
+    NS_TEST_EXPECT_MSG_EQ(Get(1000).cached, before.cached - 1, "Block still cached");
+
+    // The packets, and the data of their buffers, come from the pool
+    before = Get(sizeof(Packet));
+    Ptr<Packet> packet = Create<Packet>(100);
+    packet = nullptr;
+    packet = Create<Packet>(100);
+    NS_TEST_EXPECT_MSG_GT(Get(sizeof(Packet)).hits, before.hits, "Packet not pooled");
+    packet = nullptr;
+
+    // When the pool is disabled, the released blocks are not cached, and
+    // the cached blocks are not reused
+    PacketMemoryPool::Enable(false);
+    before = Get(1000);
+    PacketMemoryPool::Deallocate(reused, 1000);
+    NS_TEST_EXPECT_MSG_EQ(Get(1000).releases, before.releases + 1, "Release not counted");
+    NS_TEST_EXPECT_MSG_EQ(Get(1000).cached, before.cached, "Block cached");
+    PacketMemoryPool::Enable();
+    PacketMemoryPool::Deallocate(PacketMemoryPool::Allocate(1000), 1000);
+    PacketMemoryPool::Enable(false);
+    before = Get(1000);
+    NS_TEST_EXPECT_MSG_GT(before.cached, 0U, "Block not cached");
+    block = PacketMemoryPool::Allocate(1000);
+    NS_TEST_EXPECT_MSG_EQ(Get(1000).hits, before.hits, "Cached block reused");
+    NS_TEST_EXPECT_MSG_EQ(Get(1000).cached, before.cached, "Cached block reused");
+    PacketMemoryPool::Deallocate(block, 1000);
+
+    // The larger blocks are not pooled
+    before = Get(100000);
+    NS_TEST_EXPECT_MSG_EQ(before.blockSize, 0U, "Large block pooled");
+    PacketMemoryPool::Deallocate(PacketMemoryPool::Allocate(100000), 100000);
+    NS_TEST_EXPECT_MSG_EQ(Get(100000).allocations, before.allocations + 1, "Not counted");
+    NS_TEST_EXPECT_MSG_EQ(Get(100000).releases, before.releases + 1, "Not counted");
+
+    PacketMemoryPool::Flush();
+    NS_TEST_EXPECT_MSG_EQ(Get(1000).cached, 0U, "Blocks not flushed");
+    PacketMemoryPool::Enable(enabled);
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1446,8 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketMemoryAccountingTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketMemoryPoolTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
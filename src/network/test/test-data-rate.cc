@@ -71,6 +71,11 @@ void
 DataRateTestCase::CheckDataRateEqual(DataRate d1, DataRate d2, const std::string msg)
 {
     NS_TEST_EXPECT_MSG_EQ(d1, d2, msg);
+    // The reciprocal of the rate follows the arithmetic
+    if (d2.GetBitRate() != 0)
+    {
+        CheckTimesEqual(d1.CalculateBytesTxTime(1500), d2.CalculateBytesTxTime(1500), msg);
+    }
 }
 
 /**
@@ -109,6 +114,9 @@ DataRateTestCase1::SingleTest(std::string rate, size_t nBits, Time correctTime)
     DataRate dr(rate);
     Time bitsTime = dr.CalculateBitsTxTime(nBits);
     CheckTimesEqual(bitsTime, correctTime, "CalculateBitsTxTime returned incorrect value");
+    CheckTimesEqual(bitsTime,
+                    Seconds(int64x64_t(nBits) / int64x64_t(dr.GetBitRate())),
+                    "CalculateBitsTxTime differs from the int64x64_t division");
     if ((nBits % 8) == 0)
     {
         Time bytesTime = dr.CalculateBytesTxTime(nBits / 8);
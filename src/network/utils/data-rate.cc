@@ -115,13 +115,15 @@ DataRate::DoParse(const std::string s, uint64_t* v)
 }
 
 DataRate::DataRate()
-    : m_bps(0)
+    : m_bps(0),
+      m_divider(0)
 {
     NS_LOG_FUNCTION(this);
 }
 
 DataRate::DataRate(uint64_t bps)
-    : m_bps(bps)
+    : m_bps(bps),
+      m_divider(bps)
 {
     NS_LOG_FUNCTION(this << bps);
 }
@@ -136,6 +138,7 @@ DataRate&
 DataRate::operator+=(DataRate rhs)
 {
     m_bps += rhs.m_bps;
+    m_divider = Int64x64Divider(m_bps);
     return *this;
 }
 
@@ -151,6 +154,7 @@ DataRate::operator-=(DataRate rhs)
 {
     NS_ASSERT_MSG(m_bps >= rhs.m_bps, "Data Rate cannot be negative.");
     m_bps -= rhs.m_bps;
+    m_divider = Int64x64Divider(m_bps);
     return *this;
 }
 
@@ -164,6 +168,7 @@ DataRate&
 DataRate::operator*=(double rhs)
 {
     m_bps *= rhs;
+    m_divider = Int64x64Divider(m_bps);
     return *this;
 }
 
@@ -177,6 +182,7 @@ DataRate&
 DataRate::operator*=(uint64_t rhs)
 {
     m_bps *= rhs;
+    m_divider = Int64x64Divider(m_bps);
     return *this;
 }
 
@@ -227,7 +233,7 @@ Time
 DataRate::CalculateBitsTxTime(uint32_t bits) const
 {
     NS_LOG_FUNCTION(this << bits);
-    return Seconds(int64x64_t(bits) / m_bps);
+    return Seconds(m_divider.Divide(bits));
 }
 
 uint64_t
@@ -245,6 +251,7 @@ DataRate::DataRate(std::string rate)
     {
         NS_FATAL_ERROR("Could not parse rate: " << rate);
     }
+    m_divider = Int64x64Divider(m_bps);
 }
 
 /* For printing of data rate */
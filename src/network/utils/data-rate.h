@@ -11,6 +11,7 @@
 
 #include "ns3/attribute-helper.h"
 #include "ns3/attribute.h"
+#include "ns3/int64x64-divider.h"
 #include "ns3/nstime.h"
 
 #include <iostream>
@@ -261,7 +262,8 @@ class DataRate
     // Uses DoParse
     friend std::istream& operator>>(std::istream& is, DataRate& rate);
 
-    uint64_t m_bps; //!< data rate [bps]
+    uint64_t m_bps;             //!< data rate [bps]
+    Int64x64Divider m_divider; //!< Reciprocal of the data rate, for the transmission times
 };
 
 /**
@@ -526,7 +526,10 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& r
     m_nTotalReceivedPackets++;
 
     NS_LOG_LOGIC("m_traceEnqueue (p)");
-    m_traceEnqueue(item);
+    if (!m_traceEnqueue.IsEmpty())
+    {
+        m_traceEnqueue(item);
+    }
 
     return true;
 }
@@ -555,7 +558,10 @@ Queue<Item, Container>::DoDequeue(ConstIterator pos)
         m_nPackets--;
 
         NS_LOG_LOGIC("m_traceDequeue (p)");
-        m_traceDequeue(item);
+        if (!m_traceDequeue.IsEmpty())
+        {
+            m_traceDequeue(item);
+        }
     }
     return item;
 }
@@ -585,7 +591,10 @@ Queue<Item, Container>::DoRemove(ConstIterator pos)
 
         // packets are first dequeued and then dropped
         NS_LOG_LOGIC("m_traceDequeue (p)");
-        m_traceDequeue(item);
+        if (!m_traceDequeue.IsEmpty())
+        {
+            m_traceDequeue(item);
+        }
 
         DropAfterDequeue(item);
     }
@@ -236,7 +236,10 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     NS_ASSERT_MSG(m_txMachineState == READY, "Must be READY to transmit");
     m_txMachineState = BUSY;
     m_currentPkt = p;
-    m_phyTxBeginTrace(m_currentPkt);
+    if (!m_phyTxBeginTrace.IsEmpty())
+    {
+        m_phyTxBeginTrace(m_currentPkt);
+    }
 
     Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
     Time txCompleteTime = txTime + m_tInterframeGap;
@@ -268,7 +271,10 @@ PointToPointNetDevice::TransmitComplete()
 
     NS_ASSERT_MSG(m_currentPkt, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
 
-    m_phyTxEndTrace(m_currentPkt);
+    if (!m_phyTxEndTrace.IsEmpty())
+    {
+        m_phyTxEndTrace(m_currentPkt);
+    }
     m_currentPkt = nullptr;
 
     Ptr<Packet> p = m_queue->Dequeue();
@@ -281,8 +287,14 @@ PointToPointNetDevice::TransmitComplete()
     //
     // Got another packet off of the queue, so start the transmit process again.
     //
-    m_snifferTrace(p);
-    m_promiscSnifferTrace(p);
+    if (!m_snifferTrace.IsEmpty())
+    {
+        m_snifferTrace(p);
+    }
+    if (!m_promiscSnifferTrace.IsEmpty())
+    {
+        m_promiscSnifferTrace(p);
+    }
     TransmitStart(p);
 }
 
@@ -339,15 +351,28 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
         // device because it is so simple, but this is not usually the case in
         // more complicated devices.
         //
-        m_snifferTrace(packet);
-        m_promiscSnifferTrace(packet);
-        m_phyRxEndTrace(packet);
+        if (!m_snifferTrace.IsEmpty())
+        {
+            m_snifferTrace(packet);
+        }
+        if (!m_promiscSnifferTrace.IsEmpty())
+        {
+            m_promiscSnifferTrace(packet);
+        }
+        if (!m_phyRxEndTrace.IsEmpty())
+        {
+            m_phyRxEndTrace(packet);
+        }
 
         //
         // Trace sinks will expect complete packets, not packets without some of the
         // headers.
         //
-        Ptr<Packet> originalPacket = packet->Copy();
+        Ptr<Packet> originalPacket;
+        if (!m_macPromiscRxTrace.IsEmpty() || !m_macRxTrace.IsEmpty())
+        {
+            originalPacket = packet->Copy();
+        }
 
         //
         // Strip off the point-to-point protocol header and forward this packet
@@ -359,7 +384,10 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
 
         if (!m_promiscCallback.IsNull())
         {
-            m_macPromiscRxTrace(originalPacket);
+            if (!m_macPromiscRxTrace.IsEmpty())
+            {
+                m_macPromiscRxTrace(originalPacket);
+            }
             m_promiscCallback(this,
                               packet,
                               protocol,
@@ -368,7 +396,10 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
                               NetDevice::PACKET_HOST);
         }
 
-        m_macRxTrace(originalPacket);
+        if (!m_macRxTrace.IsEmpty())
+        {
+            m_macRxTrace(originalPacket);
+        }
         m_rxCallback(this, packet, protocol, GetRemote());
     }
 }
@@ -521,7 +552,10 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     //
     AddHeader(packet, protocolNumber);
 
-    m_macTxTrace(packet);
+    if (!m_macTxTrace.IsEmpty())
+    {
+        m_macTxTrace(packet);
+    }
 
     //
     // We should enqueue and dequeue the packet to hit the tracing hooks.
@@ -534,8 +568,14 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
         if (m_txMachineState == READY)
         {
             packet = m_queue->Dequeue();
-            m_snifferTrace(packet);
-            m_promiscSnifferTrace(packet);
+            if (!m_snifferTrace.IsEmpty())
+            {
+                m_snifferTrace(packet);
+            }
+            if (!m_promiscSnifferTrace.IsEmpty())
+            {
+                m_promiscSnifferTrace(packet);
+            }
             bool ret = TransmitStart(packet);
             return ret;
         }
@@ -12,6 +12,8 @@
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -29,6 +31,12 @@ PropagationDelayModel::~PropagationDelayModel()
 {
 }
 
+Time
+PropagationDelayModel::GetMinimumDelay() const
+{
+    return Seconds(0);
+}
+
 int64_t
 PropagationDelayModel::AssignStreams(int64_t stream)
 {
@@ -69,6 +77,22 @@ RandomPropagationDelayModel::GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b
     return Seconds(m_variable->GetValue());
 }
 
+Time
+RandomPropagationDelayModel::GetMinimumDelay() const
+{
+    // Only the bounded distributions have a known minimum
+    double min = 0;
+    if (auto uniform = DynamicCast<UniformRandomVariable>(m_variable))
+    {
+        min = uniform->GetMin();
+    }
+    else if (auto constant = DynamicCast<ConstantRandomVariable>(m_variable))
+    {
+        min = constant->GetConstant();
+    }
+    return Seconds(std::max(min, 0.0));
+}
+
 int64_t
 RandomPropagationDelayModel::DoAssignStreams(int64_t stream)
 {
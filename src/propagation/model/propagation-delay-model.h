@@ -41,6 +41,14 @@ class PropagationDelayModel : public Object
      * source and destination.
      */
     virtual Time GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const = 0;
+    /**
+     * @returns a lower bound of the delays returned by GetDelay()
+     *
+     * Parallel simulator implementations use this bound as the lookahead
+     * of the channels using this model. The default implementation returns
+     * zero, which is always safe.
+     */
+    virtual Time GetMinimumDelay() const;
     /**
      * If this delay model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -85,6 +93,7 @@ class RandomPropagationDelayModel : public PropagationDelayModel
     RandomPropagationDelayModel();
     ~RandomPropagationDelayModel() override;
     Time GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const override;
+    Time GetMinimumDelay() const override;
 
   private:
     int64_t DoAssignStreams(int64_t stream) override;
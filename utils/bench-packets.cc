@@ -9,8 +9,10 @@
 // This program can be used to benchmark packet serialization/deserialization
 // operations using Headers and Tags, for various numbers of packets 'n'
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
+// Use --pool=false to compare with the system allocator.
 
 #include "ns3/command-line.h"
+#include "ns3/packet-memory-pool.h"
 #include "ns3/packet-metadata.h"
 #include "ns3/packet.h"
 #include "ns3/system-wall-clock-ms.h"
@@ -21,6 +23,7 @@
 #include <sstream>
 #include <stdlib.h> // for exit ()
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -339,6 +342,25 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchAllocation(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    BenchHeader<8> udp;
+    BenchTag<16> tag;
+
+    // Packets of various sizes in flight, as in the queues of a network
+    std::vector<Ptr<Packet>> queue(256);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(64 + (i * 37) % 1437);
+        p->AddHeader(udp);
+        p->AddHeader(ipv4);
+        p->AddPacketTag(tag);
+        queue[i % queue.size()] = p;
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -371,6 +393,7 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool pool = true;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -379,6 +402,7 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("pool", "pool the packet memory", pool);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -387,7 +411,9 @@ main(int argc, char* argv[])
                   << "by command-line argument --n=(number of packets)" << std::endl;
         exit(1);
     }
-    std::cout << "Running bench-packets with n=" << n << std::endl;
+    PacketMemoryPool::Enable(pool);
+    std::cout << "Running bench-packets with n=" << n << (pool ? "" : ", without memory pool")
+              << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
     runBench(&benchA, n, minIterations, "Copy packet, remove headers");
@@ -396,6 +422,13 @@ main(int argc, char* argv[])
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchAllocation, n, minIterations, "Allocate packets of various sizes");
+
+    if (pool)
+    {
+        std::cout << "Packet memory pool:" << std::endl;
+        PacketMemoryPool::Print(std::cout);
+    }
 
     return 0;
 }
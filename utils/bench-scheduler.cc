@@ -8,6 +8,7 @@
 
 #include "ns3/core-module.h"
 
+#include <algorithm>
 #include <cmath> // sqrt
 #include <fstream>
 #include <iomanip>
@@ -164,6 +165,14 @@ Bench::Cb()
     ++m_count;
 }
 
+/**
+ * Rewind a RandomVariableStream created by GetRandomStream()
+ * to its first value.
+ *
+ * @param [in] stream The random stream of event delays.
+ */
+void RewindRandomStream(Ptr<RandomVariableStream> stream);
+
 /** Benchmark which performs an ensemble of runs. */
 class BenchSuite
 {
@@ -193,6 +202,18 @@ class BenchSuite
     /** Write the results to \c LOG() */
     void Log() const;
 
+    /**
+     * Get the scheduler description.
+     * @returns The descriptive string for the scheduler.
+     */
+    std::string GetScheduler() const;
+
+    /**
+     * Get the average simulation event rate over the runs.
+     * @returns The average rate (events/s), or the priming rate if there are no runs.
+     */
+    double GetRunRate() const;
+
   private:
     /** Print the table header. */
     void Header() const;
@@ -230,6 +251,7 @@ class BenchSuite
 
     std::string m_scheduler;       /**< Descriptive string for the scheduler. */
     std::vector<Result> m_results; /**< Store for the run results. */
+    Result m_prime;                /**< The priming run result. */
 
 }; // BenchSuite
 
@@ -280,10 +302,14 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     m_results.reserve(runs);
     Header();
 
+    // Every scheduler sees the same sequence of event delays
+    RewindRandomStream(eventStream);
+
     // Prime
     DEB("priming");
     auto prime = bench.Run();
-    Result::Bench(prime).Log("prime");
+    m_prime = Result::Bench(prime);
+    m_prime.Log("prime");
 
     // Perform the actual runs
     for (uint64_t i = 0; i < runs; i++)
@@ -317,6 +343,27 @@ BenchSuite::Header() const
                           << std::right << std::setw(g_fwidth) << " " << std::setfill(' '));
 }
 
+std::string
+BenchSuite::GetScheduler() const
+{
+    return m_scheduler;
+}
+
+double
+BenchSuite::GetRunRate() const
+{
+    if (m_results.empty())
+    {
+        return m_prime.run.rate;
+    }
+    double rate = 0;
+    for (const auto& result : m_results)
+    {
+        rate += result.run.rate;
+    }
+    return rate / m_results.size();
+}
+
 void
 BenchSuite::Log() const
 {
@@ -376,6 +423,9 @@ BenchSuite::Log() const
 
 } // BenchSuite::Log()
 
+/** Event delays read from a file, in ns. */
+std::vector<double> g_nsValues;
+
 /**
  *  Create a RandomVariableStream to generate next event delays.
  *
@@ -397,6 +447,8 @@ GetRandomStream(std::string filename)
         LOG("  Event time distribution:      default exponential");
         auto erv = CreateObject<ExponentialRandomVariable>();
         erv->SetAttribute("Mean", DoubleValue(100));
+        // Fixed stream, which can be rewound
+        erv->SetStream(1);
         stream = erv;
     }
     else
@@ -415,7 +467,7 @@ GetRandomStream(std::string filename)
         }
 
         double value;
-        std::vector<double> nsValues;
+        std::vector<double>& nsValues = g_nsValues;
 
         while (!input->eof())
         {
@@ -440,12 +492,121 @@ GetRandomStream(std::string filename)
     return stream;
 }
 
+void
+RewindRandomStream(Ptr<RandomVariableStream> stream)
+{
+    if (auto drv = DynamicCast<DeterministicRandomVariable>(stream))
+    {
+        drv->SetValueArray(g_nsValues);
+    }
+    else
+    {
+        stream->SetStream(stream->GetStream());
+    }
+}
+
+/**
+ * Run the hold model directly on a scheduler, without the simulator:
+ * each event removed from the head is replaced by a new one.
+ *
+ * @param [in] scheduler The scheduler.
+ * @param [in] pop The event population size.
+ * @param [in] total The total number of events to remove.
+ * @param [in] eventStream The random stream of event delays.
+ * @returns The event rate (events/s).
+ */
+double
+HoldRate(Ptr<Scheduler> scheduler,
+         uint64_t pop,
+         uint64_t total,
+         Ptr<RandomVariableStream> eventStream)
+{
+    RewindRandomStream(eventStream);
+    uint32_t uid = 0;
+    for (uint64_t i = 0; i < pop; ++i)
+    {
+        scheduler->Insert({nullptr, {static_cast<uint64_t>(eventStream->GetValue()), uid++, 0}});
+    }
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint64_t i = 0; i < total; ++i)
+    {
+        Scheduler::Event ev = scheduler->RemoveNext();
+        ev.key.m_ts += static_cast<uint64_t>(eventStream->GetValue());
+        ev.key.m_uid = uid++;
+        scheduler->Insert(ev);
+    }
+    double time = timer.End() / 1000.0;
+    while (!scheduler->IsEmpty())
+    {
+        scheduler->RemoveNext();
+    }
+    return total / time;
+}
+
+/**
+ * Validate the backend selected by the AdaptiveScheduler against each
+ * fixed backend, with the hold model.
+ *
+ * @param [in] pop The event population size.
+ * @param [in] total The total number of events to remove.
+ * @param [in] eventStream The random stream of event delays.
+ */
+void
+Validate(uint64_t pop, uint64_t total, Ptr<RandomVariableStream> eventStream)
+{
+    LOG("");
+    LOG("Validation of the AdaptiveScheduler selection (hold model):");
+    std::vector<std::pair<std::string, double>> rates;
+    double best = 0;
+    for (const auto& name : {"ns3::CalendarScheduler",
+                             "ns3::HeapScheduler",
+                             "ns3::LadderScheduler",
+                             "ns3::MapScheduler",
+                             "ns3::PriorityQueueScheduler"})
+    {
+        ObjectFactory factory(name);
+        double rate = HoldRate(factory.Create<Scheduler>(), pop, total, eventStream);
+        rates.emplace_back(name, rate);
+        best = std::max(best, rate);
+    }
+
+    ObjectFactory factory("ns3::AdaptiveScheduler");
+    Ptr<AdaptiveScheduler> adaptive = factory.Create<AdaptiveScheduler>();
+    double rate = HoldRate(adaptive, pop, total, eventStream);
+    std::string selected = adaptive->GetBackendTypeId().GetName();
+
+    uint32_t rank = 1;
+    double selectedRate = 0;
+    for (const auto& [scheduler, fixedRate] : rates)
+    {
+        LOG(std::left << std::setw(2 * g_fwidth) << fixedRate << std::setw(g_fwidth)
+                      << fixedRate / best << scheduler
+                      << (scheduler == selected ? " (selected)" : ""));
+        if (scheduler == selected)
+        {
+            selectedRate = fixedRate;
+        }
+    }
+    for (const auto& [scheduler, fixedRate] : rates)
+    {
+        rank += (fixedRate > selectedRate) ? 1 : 0;
+    }
+    LOG(std::left << std::setw(2 * g_fwidth) << rate << std::setw(g_fwidth) << rate / best
+                  << "ns3::AdaptiveScheduler, " << adaptive->GetSwitchCount() << " switches");
+    LOG("Selected " << selected << ", rank " << rank << " of " << rates.size()
+                    << " fixed backends");
+    LOG("");
+}
+
 int
 main(int argc, char* argv[])
 {
     bool allSched = false;
+    bool schedAdaptive = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -455,6 +616,7 @@ main(int argc, char* argv[])
     uint64_t runs = 1;
     std::string filename = "";
     bool calRev = false;
+    bool validate = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark the simulator scheduler.\n"
@@ -466,11 +628,19 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
-              "If no scheduler is specified the MapScheduler will be run.");
+              "If no scheduler is specified the MapScheduler will be run.\n"
+              "When several schedulers are run, every scheduler executes the\n"
+              "same sequence of event delays, and their event rates are\n"
+              "compared at the end.\n"
+              "\n"
+              "With --validate, the backend selected by the AdaptiveScheduler\n"
+              "is compared with each fixed backend, driven directly by a hold model.");
     cmd.AddValue("all", "use all schedulers", allSched);
+    cmd.AddValue("adaptive", "use AdaptiveScheduler", schedAdaptive);
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -480,6 +650,7 @@ main(int argc, char* argv[])
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
+    cmd.AddValue("validate", "validate the AdaptiveScheduler selection", validate);
     cmd.Parse(argc, argv);
 
     g_me = cmd.GetName() + ": ";
@@ -494,32 +665,41 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedAdaptive = schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ =
+            true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedAdaptive || schedCal || schedHeap || schedLadder || schedList || schedMap ||
+          schedPQ || validate))
     {
         schedMap = true;
     }
 
     auto eventStream = GetRandomStream(filename);
 
+    // Average run rate of each scheduler, for the final comparison
+    std::vector<std::pair<std::string, double>> rates;
+    auto Compare = [&rates](const BenchSuite& suite) {
+        suite.Log();
+        rates.emplace_back(suite.GetScheduler(), suite.GetRunRate());
+    };
+
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
     {
         factory.SetTypeId("ns3::CalendarScheduler");
         factory.Set("Reverse", BooleanValue(calRev));
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        Compare(BenchSuite(factory, pop, total, runs, eventStream, calRev));
         if (allSched)
         {
             factory.Set("Reverse", BooleanValue(!calRev));
-            BenchSuite(factory, pop, total, runs, eventStream, !calRev).Log();
+            Compare(BenchSuite(factory, pop, total, runs, eventStream, !calRev));
         }
     }
     if (schedHeap)
     {
         factory.SetTypeId("ns3::HeapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        Compare(BenchSuite(factory, pop, total, runs, eventStream, calRev));
     }
     if (schedList)
     {
@@ -530,17 +710,49 @@ main(int argc, char* argv[])
             LOG("Running List scheduler with 1/10 total events");
             listTotal /= 10;
         }
-        BenchSuite(factory, pop, listTotal, runs, eventStream, calRev).Log();
+        Compare(BenchSuite(factory, pop, listTotal, runs, eventStream, calRev));
     }
     if (schedMap)
     {
         factory.SetTypeId("ns3::MapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        Compare(BenchSuite(factory, pop, total, runs, eventStream, calRev));
     }
     if (schedPQ)
     {
         factory.SetTypeId("ns3::PriorityQueueScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        Compare(BenchSuite(factory, pop, total, runs, eventStream, calRev));
+    }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        Compare(BenchSuite(factory, pop, total, runs, eventStream, calRev));
+    }
+    if (schedAdaptive)
+    {
+        factory.SetTypeId("ns3::AdaptiveScheduler");
+        Compare(BenchSuite(factory, pop, total, runs, eventStream, calRev));
+    }
+
+    if (rates.size() > 1)
+    {
+        // Compare the simulation event rates to the fastest scheduler
+        double best = 0;
+        for (const auto& [scheduler, rate] : rates)
+        {
+            best = std::max(best, rate);
+        }
+        LOG("Comparison of the simulation event rates:");
+        for (const auto& [scheduler, rate] : rates)
+        {
+            LOG(std::left << std::setw(2 * g_fwidth) << rate << std::setw(g_fwidth)
+                          << rate / best << scheduler);
+        }
+        LOG("");
+    }
+
+    if (validate)
+    {
+        Validate(pop, total, eventStream);
     }
 
     return 0;
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the Time and int64x64_t arithmetic used by the
+// rate and duration computations, and validates the fast paths against
+// the generic int64x64_t computations.
+// Sample usage:  ./ns3 run 'bench-time --n=10000000 --validate'
+
+#include "ns3/command-line.h"
+#include "ns3/data-rate.h"
+#include "ns3/int64x64-divider.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace ns3;
+
+/** Sink for the results, so the compiler keeps the computations. */
+volatile int64_t g_sink = 0;
+
+/**
+ * Time a computation, and print its cost per operation.
+ *
+ * @param [in] name The name of the computation.
+ * @param [in] n The number of operations.
+ * @param [in] op The computation of the operation i.
+ */
+void
+Run(const std::string& name, uint64_t n, std::function<int64_t(uint64_t)> op)
+{
+    int64_t sum = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        sum += op(i);
+    }
+    double ms = timer.End();
+    g_sink = g_sink + sum;
+    std::cout << std::left << std::setw(44) << name << std::right << std::setw(10)
+              << std::setprecision(4) << ms * 1e6 / n << " ns/op" << std::endl;
+}
+
+/**
+ * Compare the fast paths with the generic computations on random inputs.
+ *
+ * @param [in] n The number of inputs.
+ * @returns The number of mismatches.
+ */
+uint64_t
+Validate(uint64_t n)
+{
+    std::mt19937_64 rng(1);
+    uint64_t errors = 0;
+    auto check = [&errors](const std::string& what, int64x64_t fast, int64x64_t generic) {
+        if (fast != generic)
+        {
+            std::cout << "mismatch " << what << ": " << fast << " != " << generic << std::endl;
+            errors++;
+        }
+    };
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        uint64_t bps = (rng() >> (1 + rng() % 63)) + 1;
+        auto bits = static_cast<uint32_t>(rng() >> (32 + rng() % 32));
+        std::string what = std::to_string(bits) + " bits at " + std::to_string(bps) + " bps";
+        check(what, Int64x64Divider(bps).Divide(bits), int64x64_t(bits) / int64x64_t(bps));
+        check(what,
+              DataRate(bps).CalculateBitsTxTime(bits).GetTimeStep(),
+              Seconds(int64x64_t(bits) / int64x64_t(bps)).GetTimeStep());
+
+        // Integral values, then an integral numerator and denominator
+        auto value = static_cast<double>(static_cast<int64_t>(rng() % 2000000) - 1000000);
+        for (auto unit : {Time::S, Time::MS, Time::US, Time::NS})
+        {
+            check(std::to_string(value),
+                  Time::FromDouble(value, unit).GetTimeStep(),
+                  Time::From(int64x64_t(value), unit).GetTimeStep());
+        }
+        auto num = static_cast<int64_t>(rng() >> (1 + rng() % 63));
+        auto den = static_cast<int64_t>(rng() >> (1 + rng() % 63)) + 1;
+        check(std::to_string(num) + " / " + std::to_string(den),
+              TimeStep(num) / TimeStep(den),
+              int64x64_t(num) / int64x64_t(den));
+    }
+    std::cout << "Validated " << n << " random inputs: " << errors << " mismatches" << std::endl;
+    return errors;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t n = 10000000;
+    bool validate = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the Time and int64x64_t arithmetic.");
+    cmd.AddValue("n", "number of operations per benchmark", n);
+    cmd.AddValue("validate", "compare the fast paths with the generic computations", validate);
+    cmd.Parse(argc, argv);
+
+    if (validate && Validate(n / 100) != 0)
+    {
+        return 1;
+    }
+
+    // Freeze the resolution, as in a simulation, so that the new Times are not recorded
+    Simulator::Run();
+
+    DataRate rate("1Gbps");
+    Int64x64Divider divider(rate.GetBitRate());
+    int64x64_t fraction(2, 1ULL << 62);
+    Time t = Seconds(1.5);
+
+    // The packet sizes vary, so that the results are not constant
+    Run("int64x64_t (bits) / int64x64_t (bps)", n, [&rate](uint64_t i) {
+        return (int64x64_t(8 * (i & 1023)) / int64x64_t(rate.GetBitRate())).GetHigh();
+    });
+    Run("Int64x64Divider::Divide (bits)", n, [&divider](uint64_t i) {
+        return divider.Divide(8 * (i & 1023)).GetHigh();
+    });
+    Run("DataRate::CalculateBytesTxTime (bytes)", n, [&rate](uint64_t i) {
+        return rate.CalculateBytesTxTime(i & 1023).GetTimeStep();
+    });
+    Run("Time / Time", n, [&t](uint64_t i) { return (t / TimeStep(i + 1)).GetHigh(); });
+    Run("Time / int64_t", n, [&t](uint64_t i) {
+        return (t / static_cast<int64_t>(i + 1)).GetTimeStep();
+    });
+    Run("Time / int64x64_t (non-integral)", n, [&fraction](uint64_t i) {
+        return (TimeStep(i) / fraction).GetTimeStep();
+    });
+    Run("Seconds (double) (integral)", n, [](uint64_t i) {
+        return Seconds(static_cast<double>(i & 1023)).GetTimeStep();
+    });
+    Run("Seconds (double) (non-integral)", n, [](uint64_t i) {
+        return Seconds(static_cast<double>(i & 1023) + 0.5).GetTimeStep();
+    });
+    Run("Seconds (int64x64_t)", n, [](uint64_t i) {
+        return Seconds(int64x64_t(static_cast<int64_t>(i & 1023))).GetTimeStep();
+    });
+    Simulator::Destroy();
+    return 0;
+}
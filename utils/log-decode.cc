@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 ns-3 project
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/log.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * @file
+ * @ingroup logbinary
+ * Convert a binary log to text.
+ *
+ * The program prints the messages of a binary log file, written with
+ * NS_LOG_BINARY or ns3::LogSetBinaryOutput(), as the NS_LOG macros would
+ * have printed them.
+ *
+ * @code
+ * NS_LOG="Ipv4L3Protocol=logic|prefix_time" NS_LOG_BINARY=run.blog ./ns3 run my-program
+ * ./build/utils/ns3-dev-log-decode-default --input=run.blog --output=run.log
+ * @endcode
+ */
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary log to text.");
+    cmd.AddValue("input", "The binary log file", input);
+    cmd.AddValue("output", "The text file, or the standard output if empty", output);
+    cmd.Parse(argc, argv);
+
+    std::ifstream is(input, std::ios::binary);
+    if (!is)
+    {
+        std::cerr << "Cannot open " << input << std::endl;
+        return 1;
+    }
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output);
+        if (!file)
+        {
+            std::cerr << "Cannot open " << output << std::endl;
+            return 1;
+        }
+    }
+    if (!LogBinaryDecode(is, output.empty() ? std::cout : file))
+    {
+        std::cerr << input << " is not a valid binary log" << std::endl;
+        return 1;
+    }
+    return 0;
+}